@@ -9,17 +9,18 @@
 #define AUTONROUTINES_H
 
 /**
- * Angle that the robot must be from the vertical to shoot into the close goal while still being able to turn without hitting the wall.
+ * Default angle that the robot must be from the vertical to shoot into the close goal while still being able to turn without hitting the wall.
+ * The values in use are the runtime parameters in params.h, which start at these defaults.
  */
 #define CLOSE_GOAL_ANGLE 5
 
 /**
- * Angle that the robot must be from the vertical to shoot into the goal on the opposite side of the field while still being able to turn without hitting the wall.
+ * Default angle that the robot must be from the vertical to shoot into the goal on the opposite side of the field while still being able to turn without hitting the wall.
  */
 #define FAR_GOAL_ANGLE 1
 
 /**
- * Distance that the robot must travel to reach the other tile to shoot preloads.
+ * Default distance that the robot must travel to reach the other tile to shoot preloads.
  */
 #define DISTANCE_TO_OTHER_SIDE 50
 
@@ -0,0 +1,120 @@
+/** @file autotune.h
+ * @brief Header file for the gyroscope PID autotuner
+ *
+ * This file contains definitions and function declarations for tuning the gyroscope turning loop (targetNet())
+ * with a relay feedback experiment (Astrom and Hagglund).
+ * The drive is turned at a fixed speed towards the heading it started at, switching direction every time the heading
+ * crosses it. This makes the robot oscillate around the starting heading at the loop's ultimate period,
+ * the period at which a proportional controller would start to oscillate on its own.
+ * The ultimate gain, the proportional gain at which that happens, follows from the relay speed and the amplitude
+ * of the oscillation, and the PID gains follow from the ultimate gain and period.
+ *
+ * The relay switches with some hysteresis, so that gyroscope noise does not make it chatter,
+ * and the first few cycles are ignored while the oscillation builds up.
+ * The proportional and derivative gains are computed with the Ziegler-Nichols "no overshoot" rule, since the turns
+ * in the autonomous routines only count as done once the robot has stopped on the target.
+ *
+ * @see autotune.c
+ */
+
+#ifndef AUTOTUNE_H_
+#define AUTOTUNE_H_
+
+/**
+ * Defines the period of the relay experiment, in milliseconds. Matches the loops that call targetNet().
+ */
+#define AUTOTUNE_PERIOD 20
+
+/**
+ * Defines the turning speed applied by the relay.
+ */
+#define AUTOTUNE_RELAY 50
+
+/**
+ * Defines how far past the starting heading the robot must turn before the relay switches, in degrees.
+ */
+#define AUTOTUNE_HYSTERESIS 1
+
+/**
+ * Defines the number of oscillation cycles ignored while the oscillation builds up.
+ */
+#define AUTOTUNE_SKIP_CYCLES 2
+
+/**
+ * Defines the number of oscillation cycles measured after the ignored cycles.
+ */
+#define AUTOTUNE_CYCLES 4
+
+/**
+ * Defines how long the experiment may take before it is abandoned, in milliseconds.
+ */
+#define AUTOTUNE_TIMEOUT 15000
+
+/**
+ * Defines the proportional gain as a fraction of the ultimate gain.
+ */
+#define AUTOTUNE_KP_FACTOR 0.2
+
+/**
+ * Defines the integral time as a multiple of the ultimate period.
+ * The Ziegler-Nichols rule uses half the ultimate period, but targetNet() integrates the error from the start of
+ * every turn, so an integral that strong winds up during the turn and overshoots. This long integral time
+ * only trims the remaining steady-state error.
+ */
+#define AUTOTUNE_TI_FACTOR 100
+
+/**
+ * Defines the derivative time as a fraction of the ultimate period.
+ */
+#define AUTOTUNE_TD_FACTOR (1.0 / 3.0)
+
+/**
+ * @brief The results of a relay feedback experiment.
+ */
+typedef struct AutotuneResult {
+    /**
+     * The ultimate gain, in turning speed per degree of error.
+     */
+    double ultimateGain;
+
+    /**
+     * The ultimate period, in seconds.
+     */
+    double ultimatePeriod;
+
+    /**
+     * The proportional gain, in the units of gyroKp.
+     */
+    double kP;
+
+    /**
+     * The integral gain, in the units of gyroKi.
+     */
+    double kI;
+
+    /**
+     * The derivative gain, in the units of gyroKd.
+     */
+    double kD;
+} AutotuneResult;
+
+/**
+ * Runs a relay feedback experiment on the drive and computes gains for the gyroscope turning loop.
+ * The robot turns back and forth in place, so it needs room to turn.
+ * Pressing any LCD button stops the motors and cancels the experiment.
+ *
+ * @param result a pointer to store the results in
+ *
+ * @return true if the experiment completed, false if it was cancelled or the robot did not oscillate in time
+ */
+bool autotuneGyro(AutotuneResult *result);
+
+/**
+ * Makes the results of an experiment the gyroscope turning loop's gains.
+ * The gains are not saved to the flash memory; see saveParams().
+ *
+ * @param result the results of the experiment
+ */
+void autotuneApply(const AutotuneResult *result);
+
+#endif
@@ -0,0 +1,165 @@
+/** @file battery.h
+ * @brief Header file for the battery monitor
+ *
+ * This file contains definitions and function declarations for the battery monitor.
+ * A low-rate task samples all three batteries, filters their voltages, and keeps their minimum and average voltage.
+ * The average is kept as a 64-bit sum and a sample count, and only divided when it is read, so it never stops moving.
+ * For the main battery, it also keeps a history of the minimum and average voltage over each second.
+ *
+ * The monitor also provides a voltage compensation factor, which the closed-loop drive functions and
+ * moveRobot() apply through motorSetCompensated(). Outputs are scaled so that a commanded power gives the same
+ * motor voltage as at BATTERY_NOMINAL: down on a charged battery, and up once it sags below BATTERY_NOMINAL.
+ * BATTERY_NOMINAL is low enough that a battery in use can always reach it, so a full-power command on a
+ * charged battery can still be matched on a tired one, and recorded autonomous runs play back the same way.
+ *
+ * @see battery.c
+ */
+
+#ifndef BATTERY_H_
+#define BATTERY_H_
+
+/**
+ * Defines the period at which the batteries are sampled, in milliseconds.
+ */
+#define BATTERY_SAMPLE_PERIOD 100
+
+/**
+ * Defines the weight of each new sample in the filtered battery voltage.
+ */
+#define BATTERY_FILTER 0.2
+
+/**
+ * Defines the voltage below which a battery is considered disconnected, in millivolts.
+ */
+#define BATTERY_MIN_VALID 1000
+
+/**
+ * Defines the battery voltage that compensated motor outputs are scaled to match, in millivolts.
+ */
+#define BATTERY_NOMINAL 7000
+
+/**
+ * Defines the smallest factor motor outputs are scaled by on a charged battery.
+ */
+#define BATTERY_SCALE_MIN 0.75
+
+/**
+ * Defines the largest factor motor outputs are scaled up by on a low battery.
+ */
+#define BATTERY_SCALE_MAX 1.25
+
+/**
+ * Defines the number of entries in the main battery sag history.
+ * Each entry covers BATTERY_HISTORY_PERIOD milliseconds.
+ */
+#define BATTERY_HISTORY_SIZE 60
+
+/**
+ * Defines the length of time covered by each entry of the sag history, in milliseconds.
+ */
+#define BATTERY_HISTORY_PERIOD 1000
+
+/**
+ * @brief Statistics about the voltage of a battery.
+ *
+ * All voltages are in millivolts, and are 0 if the battery has not been connected.
+ */
+typedef struct BatteryStats {
+    /**
+     * The filtered voltage of the battery.
+     */
+    unsigned int filtered;
+
+    /**
+     * The lowest voltage seen since the statistics were reset.
+     */
+    unsigned int minimum;
+
+    /**
+     * The sum of the voltage samples since the statistics were reset.
+     * This is 64 bits wide, so read it with batteryAverage() rather than directly.
+     */
+    unsigned long long sum;
+
+    /**
+     * The number of samples in the sum.
+     */
+    unsigned long samples;
+} BatteryStats;
+
+/**
+ * @brief The sag of the main battery over one history period.
+ */
+typedef struct BatterySag {
+    /**
+     * The lowest voltage during the period, in millivolts.
+     */
+    unsigned short minimum;
+
+    /**
+     * The average voltage during the period, in millivolts.
+     */
+    unsigned short average;
+} BatterySag;
+
+/**
+ * The statistics of each battery, indexed by battery ID number (BATT_MAIN, BATT_BKUP or BATT_PEXP).
+ */
+extern BatteryStats batteryStats[NUM_BATTS];
+
+/**
+ * The factor motor outputs are scaled by to compensate for the main battery voltage.
+ * This is between BATTERY_SCALE_MIN and BATTERY_SCALE_MAX, and is 1 if compensation is disabled
+ * or the battery voltage is not known.
+ */
+extern float batteryScale;
+
+/**
+ * Stores whether motor outputs are compensated for the main battery voltage.
+ */
+extern bool batteryCompensation;
+
+/**
+ * Object representing the battery monitor task.
+ */
+extern TaskHandle batteryTask;
+
+/**
+ * Starts the battery monitor task.
+ */
+void startBatteryMonitor();
+
+/**
+ * Reads the current voltage of a battery.
+ *
+ * @param batt the battery ID number (BATT_MAIN, BATT_BKUP or BATT_PEXP)
+ *
+ * @return the voltage of the battery, in millivolts
+ */
+unsigned int batteryRead(int batt);
+
+/**
+ * Gets the average voltage of a battery since the statistics were reset.
+ *
+ * @param batt the battery ID number (BATT_MAIN, BATT_BKUP or BATT_PEXP)
+ *
+ * @return the average voltage, in millivolts, or 0 if the battery has not been connected
+ */
+unsigned int batteryAverage(int batt);
+
+/**
+ * Gets the sag of the main battery over a previous history period.
+ *
+ * @param age how many periods ago to get the sag from (0 is the last completed period)
+ * @param sag a pointer to store the sag in
+ *
+ * @return true if the history goes back that far, false otherwise
+ */
+bool batterySagAt(int age, BatterySag *sag);
+
+/**
+ * Clears the minimum and average voltages and the sag history.
+ */
+void resetBatteryStats();
+
+#endif
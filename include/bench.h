@@ -0,0 +1,158 @@
+/** @file bench.h
+ * @brief Header file for the control path microbenchmarks
+ *
+ * This file contains definitions and function declarations for the microbenchmark harness.
+ * Each benchmark case calls one control path or LCD formatting function repeatedly, timing every call separately,
+ * and reports the mean, standard deviation, minimum and maximum time per call.
+ *
+ * On the Cortex, calls are timed with the Cortex-M3 DWT cycle counter and reported in CPU cycles.
+ * In the host simulator, calls are timed with the host's monotonic clock and reported in nanoseconds.
+ * The cost of reading the counter is measured first and subtracted from every sample.
+ *
+ * Results are printed one case per line as key=value pairs, so that they can be compared between runs.
+ *
+ * @see bench.c
+ */
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+/**
+ * Defines the number of timed calls of each case when the benchmarks are run from the LCD menu.
+ */
+#define BENCH_ITERATIONS 200
+
+/**
+ * Defines the number of untimed calls of each case made before timing starts, to warm up caches and state.
+ */
+#define BENCH_WARMUP 8
+
+/**
+ * The number of benchmark cases.
+ */
+#define BENCH_CASE_COUNT 9
+
+#ifdef SIMULATOR
+/**
+ * The unit that benchmark times are measured in.
+ */
+#define BENCH_UNIT "ns"
+#else
+/**
+ * The unit that benchmark times are measured in.
+ */
+#define BENCH_UNIT "cycles"
+#endif
+
+/**
+ * @brief A function to benchmark.
+ */
+typedef struct BenchCase {
+    /**
+     * The name of the case, as printed in its results.
+     */
+    const char *name;
+
+    /**
+     * Makes one call of the function being benchmarked.
+     */
+    void (*run)();
+} BenchCase;
+
+/**
+ * @brief The timing statistics of a benchmark case.
+ */
+typedef struct BenchResult {
+    /**
+     * The name of the case.
+     */
+    const char *name;
+
+    /**
+     * The number of timed calls.
+     */
+    unsigned long calls;
+
+    /**
+     * The mean time per call, in BENCH_UNIT.
+     */
+    double mean;
+
+    /**
+     * The variance of the time per call, in BENCH_UNIT squared.
+     */
+    double variance;
+
+    /**
+     * The shortest call, in BENCH_UNIT.
+     */
+    unsigned long minimum;
+
+    /**
+     * The longest call, in BENCH_UNIT.
+     */
+    unsigned long maximum;
+} BenchResult;
+
+/**
+ * The benchmark cases, in the order they are run.
+ */
+extern const BenchCase benchCases[BENCH_CASE_COUNT];
+
+/**
+ * The cost of reading the counter around an empty call, in BENCH_UNIT, as measured by benchCalibrate().
+ */
+extern unsigned long benchOverhead;
+
+/**
+ * Enables the counter used to time benchmark calls.
+ */
+void benchCounterInit();
+
+/**
+ * Reads the counter used to time benchmark calls.
+ *
+ * @return the counter value, in BENCH_UNIT; it wraps around, so only differences are meaningful
+ */
+unsigned long benchCounter();
+
+/**
+ * Measures the cost of reading the counter around an empty call, which is subtracted from every later sample.
+ */
+void benchCalibrate();
+
+/**
+ * Times a benchmark case.
+ *
+ * @param bench the case to time
+ * @param iterations the number of timed calls
+ * @param result the statistics to fill
+ */
+void benchFunction(const BenchCase *bench, unsigned int iterations, BenchResult *result);
+
+/**
+ * Times every benchmark case, then resets the control loop state the cases disturbed and stops the motors.
+ * The sensor task is suspended while the cases run, so that it does not preempt the timed calls.
+ *
+ * @param iterations the number of timed calls of each case
+ * @param results the statistics to fill, indexed in the same order as benchCases
+ */
+void benchRunAll(unsigned int iterations, BenchResult results[BENCH_CASE_COUNT]);
+
+/**
+ * Formats the statistics of a benchmark case as a line of key=value pairs.
+ *
+ * @param result the statistics to format
+ * @param buffer the buffer to write the line to, without a trailing newline
+ * @param size the size of the buffer
+ *
+ * @return the length of the formatted line
+ */
+int benchFormat(const BenchResult *result, char *buffer, size_t size);
+
+/**
+ * Runs every benchmark case BENCH_ITERATIONS times and prints the results.
+ */
+void benchDump();
+
+#endif
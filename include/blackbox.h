@@ -0,0 +1,245 @@
+/** @file blackbox.h
+ * @brief Header file for the black box recorder
+ *
+ * This file contains definitions and function declarations for the black box recorder.
+ * The recorder is always on. While the robot is enabled, every BLACKBOX_PERIOD milliseconds, the sensor task
+ * records a compact, timestamped frame of the joystick, motor outputs, encoders, gyroscope, ultrasonic sensor,
+ * main battery and loop timing into a ring of BLACKBOX_SLOTS blocks in RAM, overwriting the oldest block.
+ * Recording a frame only copies values, so its cost per tick is fixed. Blocks in which no motor was running
+ * are reused rather than kept, so an idle robot does not push a match out of the ring.
+ *
+ * Writing flash stalls every task, and the space of an overwritten file is only reclaimed when the Cortex
+ * restarts, so nothing is written while the robot is enabled. When the robot is disabled, or the recording is
+ * dumped from the LCD diagnostic menu, a low-priority task saves each block changed since the last save to its
+ * own one of BLACKBOX_SLOTS fixed flash files. The flash therefore holds the last
+ * BLACKBOX_SLOTS * BLACKBOX_BLOCK_FRAMES frames the robot was driven for before it was last disabled.
+ *
+ * The recording is dumped over the debug terminal from the LCD diagnostic menu, one slot per line,
+ * and the host decoder in sim/bbdecode.c turns a capture of the dump into CSV.
+ *
+ * This header only uses standard C types, so that the host decoder can include it without the PROS API.
+ *
+ * @see blackbox.c
+ */
+
+#ifndef BLACKBOX_H_
+#define BLACKBOX_H_
+
+/**
+ * Defines the period at which frames are recorded, in milliseconds.
+ * Must be a multiple of SENSOR_POLL_PERIOD.
+ */
+#define BLACKBOX_PERIOD 50
+
+/**
+ * Defines the number of frames in each block, and so in each flash file.
+ */
+#define BLACKBOX_BLOCK_FRAMES 64
+
+/**
+ * Defines the number of blocks in the ring, and so the number of flash files the recording is saved to.
+ * With the default period and block size, the recording holds the last 12.8 seconds of driving in 11 kilobytes.
+ */
+#define BLACKBOX_SLOTS 4
+
+/**
+ * Defines the magic number identifying a black box block ("BX").
+ */
+#define BLACKBOX_MAGIC 0x4258
+
+/**
+ * Defines the version of the black box block format. Blocks with any other version are ignored.
+ */
+#define BLACKBOX_VERSION 1
+
+/**
+ * Defines the period at which the writer task checks whether the ring should be saved, in milliseconds.
+ */
+#define BLACKBOX_WRITE_POLL 100
+
+/**
+ * Defines the number of bytes read from flash and printed at a time when dumping a slot.
+ */
+#define BLACKBOX_DUMP_CHUNK 32
+
+/**
+ * Frame mode flag set while the robot is enabled.
+ */
+#define BLACKBOX_ENABLED 0x01
+
+/**
+ * Frame mode flag set while the robot is in autonomous mode.
+ */
+#define BLACKBOX_AUTONOMOUS 0x02
+
+/**
+ * Frame mode flag set while the robot is connected to a competition switch or field controller.
+ */
+#define BLACKBOX_ONLINE 0x04
+
+/**
+ * @brief A single recorded sample of the robot's state.
+ *
+ * Fields are ordered so that the structure has no padding, and it is stored in flash exactly as laid out in memory.
+ */
+typedef struct BlackBoxFrame {
+    /**
+     * The time the frame was recorded, in milliseconds since the robot started up.
+     */
+    uint32_t time;
+
+    /**
+     * The accumulated tick count of each drive encoder, indexed by encoder ID number.
+     */
+    int32_t encoders[3];
+
+    /**
+     * The gyroscope angle, in degrees.
+     */
+    int16_t gyro;
+
+    /**
+     * The ultrasonic sensor range, in centimeters, or -1 if no echo was received.
+     */
+    int16_t sonar;
+
+    /**
+     * The main battery voltage, in millivolts.
+     */
+    uint16_t battery;
+
+    /**
+     * The most recent operator control loop period, in microseconds, saturating at 65535.
+     */
+    uint16_t opcontrolPeriod;
+
+    /**
+     * The most recent sensor task loop period, in microseconds, saturating at 65535.
+     */
+    uint16_t sensorPeriod;
+
+    /**
+     * The main joystick's buttons. Each of groups 5 to 8 takes four bits, starting from the least significant,
+     * holding the OR of the pressed buttons' JOY_DOWN, JOY_LEFT, JOY_UP and JOY_RIGHT values.
+     */
+    uint16_t buttons;
+
+    /**
+     * The main joystick's analog channels 1 to 4.
+     */
+    int8_t joystick[4];
+
+    /**
+     * The output of each motor port, indexed from port 1.
+     */
+    int8_t motors[10];
+
+    /**
+     * The competition mode when the frame was recorded (BLACKBOX_ENABLED, BLACKBOX_AUTONOMOUS and BLACKBOX_ONLINE).
+     */
+    uint8_t mode;
+
+    /**
+     * Reserved, always 0.
+     */
+    uint8_t reserved;
+} BlackBoxFrame;
+
+/**
+ * @brief The header of a black box block.
+ */
+typedef struct BlackBoxHeader {
+    /**
+     * Always BLACKBOX_MAGIC.
+     */
+    uint16_t magic;
+
+    /**
+     * Always BLACKBOX_VERSION.
+     */
+    uint8_t version;
+
+    /**
+     * The number of frames in the block.
+     */
+    uint8_t count;
+
+    /**
+     * Incremented for every block started, so that the blocks can be put back in order.
+     */
+    uint32_t sequence;
+
+    /**
+     * The number of frames lost since the previous block because the ring was being saved.
+     */
+    uint16_t dropped;
+
+    /**
+     * The frame period the block was recorded with, in milliseconds.
+     */
+    uint16_t period;
+
+    /**
+     * The CRC-16 of the header, with this field set to 0, followed by the frames.
+     */
+    uint16_t crc;
+
+    /**
+     * Reserved, always 0.
+     */
+    uint16_t reserved;
+} BlackBoxHeader;
+
+/**
+ * @brief A black box block, as stored in one flash file.
+ */
+typedef struct BlackBoxBlock {
+    /**
+     * The block header.
+     */
+    BlackBoxHeader header;
+
+    /**
+     * The frames, oldest first. Only the first header.count are valid.
+     */
+    BlackBoxFrame frames[BLACKBOX_BLOCK_FRAMES];
+} BlackBoxBlock;
+
+/**
+ * Returns the CRC of a black box block.
+ *
+ * @param block the block to check; its header.count must not exceed BLACKBOX_BLOCK_FRAMES
+ *
+ * @return the CRC-16 of the header with its crc field set to 0, followed by the valid frames
+ */
+unsigned short blackBoxCrc(const BlackBoxBlock *block);
+
+/**
+ * Checks whether a black box block is valid.
+ *
+ * @param block the block to check
+ * @param size the number of bytes of the block that were read
+ *
+ * @return true if the block has the right magic number, version and size, and its CRC matches
+ */
+bool blackBoxValid(const BlackBoxBlock *block, size_t size);
+
+/**
+ * Finds where the last recording left off, and starts the black box writer task.
+ * The sensor task does not record frames until this has been called.
+ */
+void startBlackBox();
+
+/**
+ * Records a frame if BLACKBOX_PERIOD has elapsed since the last one.
+ * This is called by the sensor task every tick, and should not normally be called elsewhere.
+ */
+void blackBoxSample();
+
+/**
+ * Saves the ring to flash, then prints every slot of the recording over the debug terminal.
+ * Each slot is printed as a line of the form "blackbox slot=N hex=...", with the flash file's bytes in hexadecimal.
+ */
+void blackBoxDump();
+
+#endif
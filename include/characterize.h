@@ -0,0 +1,164 @@
+/** @file characterize.h
+ * @brief Header file for motor characterization
+ *
+ * This file contains definitions and function declarations for characterizing a motor group.
+ * Characterization measures the feed-forward constants of the motors driving a set of drive encoders:
+ *     - kS, the output needed to overcome static friction
+ *     - kV, the output needed per inch per second of velocity
+ *     - kA, the output needed per inch per second squared of acceleration
+ *
+ * This is done in two stages. First, the output is ramped up slowly, so the acceleration is negligible,
+ * and kS and kV are fit to the output and velocity with a least-squares line.
+ * Then, a step output is applied from rest, and kA is fit to the acceleration and the output left over after kS and kV.
+ * Either stage ends early if the motors have driven CHARACTERIZE_MAX_DISTANCE, so the robot stays within its space.
+ *
+ * The drive constants are saved to the Cortex flash memory, loaded at boot, and used by followPath().
+ *
+ * @see characterize.c
+ */
+
+#ifndef CHARACTERIZE_H_
+#define CHARACTERIZE_H_
+
+/**
+ * Defines the period at which the encoders are sampled during characterization, in milliseconds.
+ */
+#define CHARACTERIZE_PERIOD 20
+
+/**
+ * Defines the number of samples the velocity is measured over.
+ */
+#define CHARACTERIZE_WINDOW 5
+
+/**
+ * Defines how much the output increases each period during the ramp stage.
+ * At 0.5 per 20 milliseconds, the ramp takes about 4 seconds.
+ */
+#define CHARACTERIZE_RAMP_RATE 0.5
+
+/**
+ * Defines the output at which the ramp stage stops.
+ */
+#define CHARACTERIZE_RAMP_MAX 100
+
+/**
+ * Defines the output applied during the step stage.
+ */
+#define CHARACTERIZE_STEP_SPEED 80
+
+/**
+ * Defines how long the step stage lasts, in milliseconds.
+ */
+#define CHARACTERIZE_STEP_TIME 1000
+
+/**
+ * Defines how long the motors are stopped between the two stages, in milliseconds.
+ */
+#define CHARACTERIZE_REST_TIME 1500
+
+/**
+ * Defines the farthest the drive encoders may travel during each stage, in inches.
+ * A stage that reaches this distance ends early; the ramp is then fit to the samples taken so far.
+ */
+#define CHARACTERIZE_MAX_DISTANCE 48
+
+/**
+ * Defines the velocity below which ramp samples are ignored, in inches per second.
+ * The motors are still static below this velocity, so the samples would distort the fit.
+ */
+#define CHARACTERIZE_MIN_VELOCITY 1.0
+
+/**
+ * Defines the acceleration below which step samples are ignored, in inches per second squared.
+ */
+#define CHARACTERIZE_MIN_ACCEL 5.0
+
+/**
+ * Identifies a feed-forward record in the flash memory ("FF").
+ */
+#define FEEDFORWARD_MAGIC 0x4646
+
+/**
+ * The version of the feed-forward record format.
+ */
+#define FEEDFORWARD_VERSION 1
+
+/**
+ * The name of the file the drive feed-forward constants are saved in.
+ */
+#define FEEDFORWARD_FILE "ff"
+
+/**
+ * @brief Feed-forward constants of a set of motors.
+ *
+ * The output needed to move at a velocity v (in inches per second) with an acceleration a (in inches per second squared)
+ * is kS * sign(v) + kV * v + kA * a.
+ */
+typedef struct Feedforward {
+    /**
+     * The output needed to overcome static friction.
+     */
+    double kS;
+
+    /**
+     * The output needed per inch per second of velocity.
+     */
+    double kV;
+
+    /**
+     * The output needed per inch per second squared of acceleration.
+     */
+    double kA;
+} Feedforward;
+
+/**
+ * The feed-forward constants of the drive, measured by characterization.
+ */
+extern Feedforward driveFeedforward;
+
+/**
+ * Stores whether the drive feed-forward constants have been measured.
+ */
+extern bool driveFeedforwardValid;
+
+/**
+ * Characterizes a motor group.
+ * The velocity is measured from the connected drive encoders of the drive motors in the group.
+ * If the group contains the left or right drive motor, its strafe motor is not run.
+ * The robot drives during characterization, so it needs CHARACTERIZE_MAX_DISTANCE of open space in front of it.
+ * Pressing any LCD button stops the motors and cancels characterization.
+ *
+ * @param group the motor group to characterize
+ * @param result a pointer to store the feed-forward constants in
+ *
+ * @return true if characterization completed, false if it was cancelled, the group has no drive encoders,
+ *         or the ramp reached CHARACTERIZE_MAX_DISTANCE before the motors started moving
+ */
+bool characterize(const MotorGroup *group, Feedforward *result);
+
+/**
+ * Computes the output needed to move with a given velocity and acceleration.
+ *
+ * @param ff the feed-forward constants
+ * @param velocity the velocity, in inches per second
+ * @param acceleration the acceleration, in inches per second squared
+ *
+ * @return the output, limited to the motor range
+ */
+int feedforwardOutput(const Feedforward *ff, double velocity, double acceleration);
+
+/**
+ * Loads the drive feed-forward constants from the flash memory.
+ *
+ * @return true if a valid record was loaded, false otherwise
+ */
+bool loadFeedforward();
+
+/**
+ * Saves the drive feed-forward constants to the flash memory.
+ *
+ * @return true if the record was written completely, false otherwise
+ */
+bool saveFeedforward();
+
+#endif
@@ -0,0 +1,42 @@
+/** @file cobs.h
+ * @brief Header file for Consistent Overhead Byte Stuffing
+ *
+ * This file contains definitions and function declarations for COBS framing.
+ * COBS removes every zero byte from a packet at a cost of at most one byte in 254, so that a zero byte
+ * can mark the end of each packet on a serial line. A receiver that starts listening part of the way
+ * through a packet, or loses bytes, resynchronizes at the next zero.
+ *
+ * @see cobs.c
+ */
+
+#ifndef COBS_H_
+#define COBS_H_
+
+/**
+ * Returns the largest size of a packet of the given length after COBS encoding, not including the zero delimiter.
+ */
+#define COBS_MAX_ENCODED(length) ((length) + (length) / 254 + 1)
+
+/**
+ * Encodes a packet with COBS.
+ *
+ * @param data the packet
+ * @param length the length of the packet, in bytes
+ * @param out the buffer to write the encoded packet to, of at least COBS_MAX_ENCODED(length) bytes
+ *
+ * @return the length of the encoded packet, which contains no zero bytes
+ */
+unsigned int cobsEncode(const void *data, unsigned int length, unsigned char *out);
+
+/**
+ * Decodes a COBS-encoded packet.
+ *
+ * @param data the encoded packet, without its zero delimiter
+ * @param length the length of the encoded packet, in bytes
+ * @param out the buffer to write the packet to, of at least length bytes
+ *
+ * @return the length of the decoded packet, or 0 if the encoded packet is malformed
+ */
+unsigned int cobsDecode(const unsigned char *data, unsigned int length, void *out);
+
+#endif
@@ -0,0 +1,30 @@
+/** @file crc.h
+ * @brief Header file for cyclic redundancy checks
+ *
+ * This file contains definitions and function declarations for computing CRC-16/CCITT checksums.
+ * Checksums are used to detect corrupted records in the Cortex flash memory.
+ *
+ * @see crc.c
+ */
+
+#ifndef CRC_H_
+#define CRC_H_
+
+/**
+ * The initial value of a CRC-16/CCITT checksum.
+ */
+#define CRC16_INIT 0xFFFF
+
+/**
+ * Updates a CRC-16/CCITT checksum with a block of data.
+ * Checksums of data split across several blocks are computed by passing the result of each call to the next.
+ *
+ * @param crc the checksum of the data so far (CRC16_INIT for the first block)
+ * @param data the block of data
+ * @param length the length of the block, in bytes
+ *
+ * @return the checksum including the block
+ */
+unsigned short crc16(unsigned short crc, const void *data, unsigned int length);
+
+#endif
@@ -22,6 +22,12 @@
  */
 #define ROBOT_START_ANGLE 90
 
+/**
+ * Defines the length of each side of the (square) field, in inches.
+ * The field walls lie along X = 0, X = FIELD_LENGTH, Y = 0 and Y = FIELD_LENGTH.
+ */
+#define FIELD_LENGTH 144
+
 /**
  * @brief Representation of a point on the field.
  */
@@ -53,6 +59,32 @@ typedef struct lineSegment {
 	point p2;
 } lineSegment;
 
+/**
+ * Defines the number of poses kept in the pose history.
+ * A pose is recorded every SENSOR_POLL_PERIOD milliseconds, so this covers the last 640 milliseconds.
+ */
+#define POSE_HISTORY_SIZE 64
+
+/**
+ * @brief Representation of the robot's pose (position and heading) at a point in time.
+ */
+typedef struct poseSample {
+	/**
+	 * The time at which the pose was recorded, in milliseconds since startup.
+	 */
+	unsigned long time;
+
+	/**
+	 * The robot's position on the field.
+	 */
+	point position;
+
+	/**
+	 * The robot's heading on the field, in radians.
+	 */
+	double heading;
+} poseSample;
+
 /**
  * Coordinates of each of the white lines on the field.
  */
@@ -63,6 +95,12 @@ extern const lineSegment LINE_COORDS[8];
  */
 extern point position;
 
+/**
+ * Initializes the field positioning system and places the robot at its starting position.
+ * This must be called once, before the sensor task is started.
+ */
+void initFieldPosition();
+
 /**
  * Updates the robot's estimate of its position based on sensor input.
  */
@@ -76,4 +114,42 @@ void updatePosition();
  */
 void resetPosition(double x, double y);
 
+/**
+ * Looks up the robot's pose at a given time, interpolating between recorded poses.
+ * This allows measurements taken some time ago to be compared against the pose the robot had when they were taken.
+ * Times newer than the latest recorded pose return the latest pose.
+ *
+ * @param time the time to look up, in milliseconds since startup
+ * @param pose a pointer to store the pose in
+ *
+ * @return true if the pose was found, false if the time is older than the pose history
+ */
+bool poseAt(unsigned long time, poseSample *pose);
+
+/**
+ * Corrects the robot's position based on a measurement taken at a given time.
+ * The correction is applied to the current position and to every recorded pose from that time onward,
+ * so that later lookups in the pose history agree with the corrected position.
+ *
+ * @param time the time the measurement was taken, in milliseconds since startup
+ * @param dx the correction to the X-coordinate, in inches
+ * @param dy the correction to the Y-coordinate, in inches
+ */
+void correctPosition(unsigned long time, double dx, double dy);
+
+/**
+ * Returns the robot's heading on the field.
+ * A heading of zero points along the positive X axis, and the heading increases counterclockwise.
+ * Unlike gyroGet(), this value is not affected by resetting the gyroscope with resetGyroHeading().
+ *
+ * @return the robot's heading in radians, in the range [0, 2*pi)
+ */
+double fieldHeading();
+
+/**
+ * Resets the gyroscope to zero while preserving the robot's heading on the field.
+ * This should be used instead of gyroReset() so that the field positioning system does not lose track of the robot's heading.
+ */
+void resetGyroHeading();
+
 #endif
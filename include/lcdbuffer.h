@@ -0,0 +1,76 @@
+/** @file lcdbuffer.h
+ * @brief Header file for the LCD framebuffer
+ *
+ * This file contains definitions and function declarations for the LCD framebuffer.
+ * Code that displays text on the LCD draws into a 2x16 shadow copy of the screen instead of writing to the LCD directly.
+ * A single flusher task compares the shadow copy with what was last sent to the LCD,
+ * and transmits only the lines that changed, no more often than LCD_REFRESH_PERIOD.
+ * Redrawing a screen with the same text therefore costs nothing on the LCD's UART, and the screen does not flicker.
+ *
+ * @see lcdbuffer.c
+ */
+
+#ifndef LCDBUFFER_H_
+#define LCDBUFFER_H_
+
+/**
+ * The number of lines on the LCD.
+ */
+#define LCD_LINES 2
+
+/**
+ * Defines the minimum time between transmissions of the framebuffer to the LCD, in milliseconds.
+ */
+#define LCD_REFRESH_PERIOD 50
+
+/**
+ * Object representing the LCD flusher task.
+ */
+extern TaskHandle lcdFlushTask;
+
+/**
+ * Starts the LCD flusher task.
+ * The LCD must be initialized with lcdInit() before this is called.
+ */
+void startLcdFlushTask();
+
+/**
+ * Sets the text of a line of the LCD.
+ * This is a drop-in replacement for lcdSetText() that draws into the framebuffer.
+ * The line will be transmitted by the flusher task if its text has changed.
+ *
+ * @param lcdport the LCD screen's port (if this is not LCD_PORT, the text is sent directly)
+ * @param line the line to set (1 or 2)
+ * @param text the text to display, which is truncated to LCD_MESSAGE_MAX_LENGTH characters
+ */
+void lcdBufferSetText(FILE *lcdport, unsigned char line, const char *text);
+
+/**
+ * Clears the LCD.
+ * This is a drop-in replacement for lcdClear() that draws into the framebuffer.
+ *
+ * @param lcdport the LCD screen's port
+ */
+void lcdBufferClear(FILE *lcdport);
+
+/**
+ * Prints formatted text to a line of the LCD.
+ * This is a drop-in replacement for lcdPrint() that draws into the framebuffer.
+ *
+ * @param lcdport the LCD screen's port
+ * @param line the line to set (1 or 2)
+ * @param ... the format string and its arguments, as for printf()
+ */
+#define lcdBufferPrint(lcdport, line, ...) do { \
+        char lcdBufferLine[LCD_MESSAGE_MAX_LENGTH+1]; \
+        snprintf(lcdBufferLine, sizeof(lcdBufferLine), __VA_ARGS__); \
+        lcdBufferSetText(lcdport, line, lcdBufferLine); \
+    } while (0)
+
+/**
+ * Transmits any lines of the framebuffer that have changed since they were last transmitted.
+ * This is called by the flusher task, and should not normally be called elsewhere.
+ */
+void flushLcdBuffer();
+
+#endif
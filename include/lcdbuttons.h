@@ -0,0 +1,96 @@
+/** @file lcdbuttons.h
+ * @brief Header file for the LCD button event queue
+ *
+ * This file contains definitions and function declarations for reading the LCD buttons without blocking.
+ * The buttons are sampled periodically by the sensor task, debounced, and turned into events
+ * (press, release and long press) that are placed in a queue.
+ * The LCD diagnostic menu consumes these events instead of waiting for buttons to be released,
+ * so holding a button no longer freezes the menu or hides presses of the other buttons.
+ *
+ * @see lcdbuttons.c
+ */
+
+#ifndef LCDBUTTONS_H_
+#define LCDBUTTONS_H_
+
+/**
+ * The number of buttons on the LCD.
+ */
+#define LCD_BUTTON_COUNT 3
+
+/**
+ * Defines the number of consecutive identical samples required before a button's state change is accepted.
+ */
+#define LCD_DEBOUNCE_SAMPLES 3
+
+/**
+ * Defines how long a button must be held to generate a long press event, in milliseconds.
+ */
+#define LCD_LONG_PRESS_TIME 750
+
+/**
+ * Defines the number of events the button event queue can hold.
+ * If the queue is full, new events are dropped.
+ */
+#define LCD_EVENT_QUEUE_SIZE 16
+
+/**
+ * Event type generated when a button is pressed.
+ */
+#define LCD_EVENT_PRESS 0
+
+/**
+ * Event type generated when a button is released.
+ */
+#define LCD_EVENT_RELEASE 1
+
+/**
+ * Event type generated once when a button has been held for LCD_LONG_PRESS_TIME.
+ */
+#define LCD_EVENT_LONG_PRESS 2
+
+/**
+ * @brief Representation of a single LCD button event.
+ */
+typedef struct lcdEvent {
+    /**
+     * The button that generated the event (LCD_BTN_LEFT, LCD_BTN_CENTER or LCD_BTN_RIGHT).
+     */
+    unsigned char button;
+
+    /**
+     * The type of event (LCD_EVENT_PRESS, LCD_EVENT_RELEASE or LCD_EVENT_LONG_PRESS).
+     */
+    unsigned char type;
+} lcdEvent;
+
+/**
+ * Samples the LCD buttons once, debouncing them and queueing any resulting events.
+ * This is called periodically by the sensor task, every SENSOR_POLL_PERIOD milliseconds.
+ */
+void sampleLcdButtons();
+
+/**
+ * Removes the oldest event from the button event queue.
+ * This function does not block.
+ *
+ * @param event a pointer to store the event in
+ *
+ * @return true if an event was removed, false if the queue was empty
+ */
+bool lcdNextEvent(lcdEvent *event);
+
+/**
+ * Removes all events from the button event queue, returning the buttons that were pressed.
+ * This function does not block, so it should be called once per menu loop iteration and its value stored.
+ *
+ * @return a bitmask of the buttons (LCD_BTN_LEFT, LCD_BTN_CENTER, LCD_BTN_RIGHT) that were pressed since the last call
+ */
+unsigned int lcdPressedButtons();
+
+/**
+ * Discards all events in the button event queue.
+ */
+void lcdFlushEvents();
+
+#endif
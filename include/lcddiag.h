@@ -5,10 +5,14 @@
  * The menu provides live debugging and testing functionality.
  * It provides the following functions:
  *     - Motor testing functionality (individual and group)
+ *     - Motor characterization
+ *     - Gyroscope PID autotuning
  *     - Motor group management
+ *     - Runtime parameter editing
  *     - Battery voltage information
  *     - Joystick connection status
  *     - Robot sensory data
+ *     - Performance telemetry
  *     - Autonomous recorder status
  *     - LCD backlight toggle
  *     - Screensaver that displays during operator control
@@ -27,106 +31,83 @@
 #define LCDDIAG_H
 
 /**
- * Checks if the specified LCD button is pressed.
- * This function's valid parameters are: 
- *     - LCD_BTN_LEFT
- *     - LCD_BTN_RIGHT
- *     - LCD_BTN_CENTER.
- *
- * This function waits for the specified button to be released before terminating.
- * Due to this, it can only be called once per loop iteration.
- * Its value should be stored in a boolean variable.
- *
- * @param btn the button to check
- *
- * @return true if pressed, false if not
+ * Defines the maximum depth of nested menus in the LCD diagnostic menu tree.
  */
-inline bool lcdButtonPressed(int btn){
-    if(lcdReadButtons(LCD_PORT) & btn){
-        do{
-            delay(20);
-        } while (lcdReadButtons(LCD_PORT) & btn);
-        return true;
-    } else {
-        return false;
-    }
-    return true;
-}
+#define LCD_MENU_MAX_DEPTH 4
 
 /**
- * Checks if the any LCD button is pressed.
- * This function waits for the button to be released before terminating.
- * Due to this, it can only be called once per loop iteration.
- * Its value should be stored in a boolean variable.
- *
- * @return true if pressed, false if not
+ * Defines the period of the LCD diagnostic menu's event loop, in milliseconds.
  */
-inline bool lcdAnyButtonPressed(){
-    if(lcdReadButtons(LCD_PORT)){
-        do{
-            delay(20);
-        } while (lcdReadButtons(LCD_PORT));
-    } else {
-        return false;
-    }
-    return true;
-}
+#define LCD_MENU_PERIOD 20
 
 /**
- * The number of top-level menus available in the LCD diagnostic menu system.
+ * Defines the stack size of the LCD diagnostic menu task.
+ * Menu actions run on this task, including the characterization sweep, the autotuner, the UART dumps and flash writes,
+ * so it keeps the default stack even though the menu tree itself is stored in flash.
  */
-#define LCD_MENU_COUNT 9
+#define LCD_DIAG_STACK_SIZE TASK_DEFAULT_STACK_SIZE
 
 /**
- * Menu ID number of the motor testing menu.
- */
-#define MENU_MOTOR 0
-
-/**
- * Menu ID number of the motor group manager.
+ * Function that renders the two lines of a live menu screen.
+ * The line buffers are cleared to spaces before this is called, and are rendered into using the widgets in lcdformat.h.
+ *
+ * @param page the page of the screen being displayed (0 to pageCount-1)
+ * @param line1 the first line buffer to render into
+ * @param line2 the second line buffer to render into
  */
-#define MENU_MOTOR_MGMT 1
+typedef void (*MenuScreen)(int page, char *line1, char *line2);
 
 /**
- * Menu ID number of the battery voltage readout.
+ * Function that runs when a menu item is selected.
+ * Actions may block and use the LCD themselves; the menu returns to the top level when they finish.
  */
-#define MENU_BATTERY 2
+typedef void (*MenuAction)();
 
 /**
- * Menu ID number of the joystick connection state indicator.
+ * @brief Represents a node of the LCD diagnostic menu tree.
+ *
+ * Each node is either a submenu (children is not NULL), a live screen (screen is not NULL), or an action.
+ * A node with none of these set returns to the parent menu.
+ * The whole tree is const, so it is stored in flash rather than RAM.
  */
-#define MENU_CONNECTION 3
+typedef struct MenuNode {
+    /**
+     * The name of the node, displayed when it is highlighted in its parent menu.
+     */
+    const char *name;
 
-/**
- * Menu ID number of the robot sensory state indicator.
- */
-#define MENU_ROBOT 4
+    /**
+     * The items of this submenu, or NULL if this node is not a submenu.
+     */
+    const struct MenuNode *children;
 
-/**
- * Menu ID number of the autonomous recorder status indicator.
- */
-#define MENU_AUTON 5
+    /**
+     * The number of items in this submenu.
+     */
+    unsigned char childCount;
 
-/**
- * Menu ID number of the backlight toggle.
- */
-#define MENU_BACKLIGHT 6
+    /**
+     * The function that fills in this live screen, or NULL if this node is not a live screen.
+     * Live screens are redrawn every LCD_MENU_PERIOD milliseconds until any button is pressed.
+     */
+    MenuScreen screen;
 
-/**
- * Menu ID number of the LCD message screensaver.
- */
-#define MENU_SCREENSAVER 7
+    /**
+     * The number of pages of this live screen.
+     * If there is more than one page, the left and right buttons switch between pages and the center button exits.
+     */
+    unsigned char pageCount;
 
-/**
- * Menu ID number of the credits menu.
- * Thanks again to Team 750W and Akram Sandhu.
- */
-#define MENU_CREDITS 8
+    /**
+     * The function that runs when this node is selected, or NULL if this node is not an action.
+     */
+    MenuAction action;
+} MenuNode;
 
 /**
- * Stores the top-level menu names.
+ * The root of the LCD diagnostic menu tree.
  */
-extern char menuChoices[LCD_MENU_COUNT][LCD_MESSAGE_MAX_LENGTH+1];
+extern const MenuNode menuRoot;
 
 /**
  * Object representing the LCD diagnostic menu task.
@@ -135,53 +116,12 @@ extern char menuChoices[LCD_MENU_COUNT][LCD_MESSAGE_MAX_LENGTH+1];
  */
 extern TaskHandle lcdDiagTask;
 
-/**
- * @brief Represents a logical motor grouping, to be used when testing motors.
- *
- * Has flags for each motor that belongs to the group, as well as a 16-character name.
- */
-typedef struct MotorGroup {
-    /** 
-     * Stores if each motor is contained in this group or not.
-     *
-     * This array contains 11 values. Element 0 is ignored. Elements 1-10 represent the respective motor ports.
-     */
-    bool motor[11];
-
-    /** 
-     * The name of the motor group.
-     *
-     * The name can be a maximum of 16 characters.
-     * The buffer is 17 characters to hold the null terminator.
-     */
-    char name[LCD_MESSAGE_MAX_LENGTH+1];
-} MotorGroup;
-
-/**
- * Array that stores the motor groups.
- * As this is a dynamic array, creating and editing new motor groups is possible.
- * These motor groups are added to the array via the Motor Group Management menu.
- */
-extern MotorGroup *groups;
-
-/**
- * Stores the number of motor groups.
- * This is functionally identical to the size of the motor group array.
- */
-extern int numgroups;
-
 /**
  * Disables operator control loop during motor testing.
  * Since running motors is not thread safe, it is necessary to stop operator control of the motors during testing.
  */
 extern bool disableOpControl;
 
-/**
- * Initializes the motor groups array to contain the standard set of groups.
- * This includes: Left Drive, Right Drive, Full Drive, Nautilus Shooter, Intake, and Strafe Motor.
- */
-void initGroups();
-
 /**
  * Uses the LCD and the autonomous potentiometer to type a string.
  * This is used to name motor groups and autonomous recordings.
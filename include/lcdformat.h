@@ -0,0 +1,132 @@
+/** @file lcdformat.h
+ * @brief Header file for the LCD text formatter and widgets
+ *
+ * This file contains function declarations for formatting text on the LCD.
+ * The widgets render directly into a line buffer of LCD_MESSAGE_MAX_LENGTH+1 characters,
+ * without allocating memory or using the printf family of functions.
+ * Every widget writes at a column and is clipped to the end of the line, so a line can be composed from several widgets.
+ *
+ * @see lcdformat.c
+ */
+
+#ifndef LCDFORMAT_H_
+#define LCDFORMAT_H_
+
+/**
+ * The character used for the filled part of a bar graph.
+ */
+#define LCD_BAR_FULL '#'
+
+/**
+ * The character used for the empty part of a bar graph.
+ */
+#define LCD_BAR_EMPTY '-'
+
+/**
+ * Fills a line buffer with spaces and terminates it.
+ *
+ * @param line the line buffer (must be at least LCD_MESSAGE_MAX_LENGTH+1 characters)
+ */
+void lcdLineClear(char *line);
+
+/**
+ * Writes text into a line buffer.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param text the text to write
+ *
+ * @return the column after the last character written
+ */
+int lcdPutText(char *line, int col, const char *text);
+
+/**
+ * Writes a single character into a line buffer.
+ *
+ * @param line the line buffer
+ * @param col the column to write at
+ * @param c the character to write
+ *
+ * @return the column after the character
+ */
+int lcdPutChar(char *line, int col, char c);
+
+/**
+ * Writes an integer into a line buffer.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param width the width of the field to right-align the integer in, or 0 to write it left-aligned at its natural width
+ * @param value the integer to write
+ *
+ * @return the column after the field
+ */
+int lcdPutInt(char *line, int col, int width, int value);
+
+/**
+ * Writes a fixed-point number into a line buffer.
+ * For example, a value of 785 with 2 decimals is written as 7.85.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param width the width of the field to right-align the number in, or 0 to write it left-aligned at its natural width
+ * @param value the number to write, in units of 10^-decimals
+ * @param decimals the number of digits after the decimal point
+ *
+ * @return the column after the field
+ */
+int lcdPutFixed(char *line, int col, int width, int value, int decimals);
+
+/**
+ * Writes a voltage into a line buffer, with two decimals and a trailing V.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param width the width of the field to right-align the voltage in (including the V), or 0 for its natural width
+ * @param millivolts the voltage to write, in millivolts
+ *
+ * @return the column after the field
+ */
+int lcdPutVoltage(char *line, int col, int width, int millivolts);
+
+/**
+ * Writes a horizontal bar graph into a line buffer.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param width the width of the bar graph
+ * @param value the value to display, clamped to the range [0, full]
+ * @param full the value corresponding to a full bar
+ *
+ * @return the column after the bar graph
+ */
+int lcdPutBar(char *line, int col, int width, int value, int full);
+
+/**
+ * Centers the first characters of a line buffer within the line.
+ * This is used to center a line that was composed from several widgets.
+ *
+ * @param line the line buffer
+ * @param len the number of characters at the start of the line to center
+ */
+void lcdCenterLine(char *line, int len);
+
+/**
+ * Writes text centered in a line buffer, clearing the rest of the line.
+ *
+ * @param line the line buffer
+ * @param text the text to write
+ */
+void lcdPutCenter(char *line, const char *text);
+
+/**
+ * Writes two fields into a line buffer, one left-aligned and one right-aligned, clearing the rest of the line.
+ * If the fields overlap, the right field takes priority.
+ *
+ * @param line the line buffer
+ * @param left the text to left-align
+ * @param right the text to right-align
+ */
+void lcdPutSplit(char *line, const char *left, const char *right);
+
+#endif
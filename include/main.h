@@ -81,6 +81,16 @@
  */
 #include <bitwise.h>
 
+/**
+ * Cyclic redundancy check function declarations.
+ */
+#include <crc.h>
+
+/**
+ * Consistent Overhead Byte Stuffing function declarations.
+ */
+#include <cobs.h>
+
 /**
 * Robot physical constant definitions and function declarations.
 */
@@ -91,21 +101,106 @@
  */
 #include <sensors.h>
 
+/**
+ * Precompiled speaker song definitions and function declarations.
+ */
+#include <songs.h>
+
+/**
+ * Battery monitor definitions and function declarations.
+ */
+#include <battery.h>
+
 /**
  * Motor definitions and function declarations.
  */
 #include <motors.h>
 
+/**
+ * Stack usage tracking definitions and function declarations.
+ */
+#include <memtrack.h>
+
+/**
+ * Section profiler definitions and function declarations.
+ */
+#include <profiler.h>
+
+/**
+ * Control path microbenchmark definitions and function declarations.
+ */
+#include <bench.h>
+
+/**
+ * Performance telemetry definitions and function declarations.
+ */
+#include <telemetry.h>
+
+/**
+ * Black box recorder definitions and function declarations.
+ */
+#include <blackbox.h>
+
+/**
+ * Binary telemetry stream definitions and function declarations.
+ */
+#include <telestream.h>
+
 /**
  * Field positioning system definitions and function declarations.
  */
 #include <fieldpos.h>
 
+/**
+ * Ultrasonic wall-ranging localization definitions and function declarations.
+ */
+#include <wallrange.h>
+
+/**
+ * Pure pursuit path follower definitions and function declarations.
+ */
+#include <pathfollow.h>
+
 /**
  * LCD definitions and function declarations.
  */
 #include <lcdmsg.h>
 
+/**
+ * LCD framebuffer definitions and function declarations.
+ */
+#include <lcdbuffer.h>
+
+/**
+ * LCD text formatter and widget definitions and function declarations.
+ */
+#include <lcdformat.h>
+
+/**
+ * LCD button event queue definitions and function declarations.
+ */
+#include <lcdbuttons.h>
+
+/**
+ * Motor group storage definitions and function declarations.
+ */
+#include <motorgroups.h>
+
+/**
+ * Runtime parameter registry definitions and function declarations.
+ */
+#include <params.h>
+
+/**
+ * Motor characterization definitions and function declarations.
+ */
+#include <characterize.h>
+
+/**
+ * Gyroscope PID autotuner definitions and function declarations.
+ */
+#include <autotune.h>
+
 /**
  * LCD diagnostics menu definitions and function declarations.
  */
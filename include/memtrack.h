@@ -0,0 +1,121 @@
+/** @file memtrack.h
+ * @brief Header file for stack usage tracking
+ *
+ * This file contains definitions and function declarations for tracking memory usage.
+ *
+ * Tasks created with taskCreateTracked() start in a wrapper that paints the unused part of their stack with a known value.
+ * The deepest point the task has used is found later by scanning for the first overwritten word.
+ * This gives each task's stack high-water mark, so stack sizes can be chosen from measurements instead of guesses.
+ *
+ * The robot code makes no heap allocations, so only the stacks are tracked.
+ *
+ * @see memtrack.c
+ */
+
+#ifndef MEMTRACK_H_
+#define MEMTRACK_H_
+
+/**
+ * The maximum number of tasks that can be tracked.
+ */
+#define MAX_TRACKED_TASKS 10
+
+/**
+ * The value unused stack words are painted with.
+ */
+#define STACK_PAINT_VALUE 0xA5A5A5A5
+
+/**
+ * Defines the number of words below the wrapper's frame that are not painted.
+ * This leaves room for the painting loop itself.
+ */
+#define STACK_PAINT_MARGIN 16
+
+/**
+ * Defines the number of words at the bottom of the stack that are not painted.
+ * The exact top of the stack is not known to the wrapper, so this many words are left as an allowance for
+ * the part of the stack above the wrapper's frame, ensuring painting never goes past the bottom of the stack.
+ */
+#define STACK_TOP_ALLOWANCE 32
+
+/**
+ * @brief Represents a task created with taskCreateTracked().
+ */
+typedef struct TrackedTask {
+    /**
+     * The name of the task, displayed on the LCD.
+     */
+    const char *name;
+
+    /**
+     * The handle of the task.
+     */
+    TaskHandle handle;
+
+    /**
+     * The size of the task's stack, in words.
+     */
+    unsigned int stackDepth;
+
+    /**
+     * The function the task runs.
+     */
+    TaskCode code;
+
+    /**
+     * The argument passed to the task's function.
+     */
+    void *parameters;
+
+    /**
+     * The lowest painted word of the task's stack, or NULL if the task has not started.
+     */
+    volatile unsigned long *paintBottom;
+
+    /**
+     * The number of words painted.
+     */
+    unsigned int paintWords;
+} TrackedTask;
+
+/**
+ * The tracked tasks.
+ */
+extern TrackedTask trackedTasks[MAX_TRACKED_TASKS];
+
+/**
+ * The number of tracked tasks.
+ */
+extern int numTrackedTasks;
+
+/**
+ * Creates a task whose stack usage is tracked.
+ * This takes the same arguments as taskCreate(), plus a name.
+ * If a task with the same name has been tracked before, its entry is reused, so tasks that are recreated are tracked once.
+ *
+ * @param name the name of the task
+ * @param code the function the task runs
+ * @param stackDepth the size of the task's stack, in words
+ * @param parameters the argument passed to the task's function
+ * @param priority the priority of the task
+ *
+ * @return a handle to the created task, or NULL if an error occurred
+ */
+TaskHandle taskCreateTracked(const char *name, TaskCode code, unsigned int stackDepth, void *parameters, unsigned int priority);
+
+/**
+ * Finds the number of words of a tracked task's stack that have never been used.
+ * The true amount unused may be up to STACK_TOP_ALLOWANCE words more.
+ *
+ * @param task the tracked task
+ *
+ * @return the number of words never used
+ */
+unsigned int taskStackUnused(const TrackedTask *task);
+
+/**
+ * Prints the stack usage of every tracked task to the debug UART.
+ */
+void memDump();
+
+#endif
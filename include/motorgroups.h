@@ -0,0 +1,156 @@
+/** @file motorgroups.h
+ * @brief Header file for motor group storage
+ *
+ * This file contains definitions and function declarations for motor groups, which are used when testing motors.
+ * Motor groups are kept in a fixed-capacity pool and saved to the Cortex flash memory.
+ *
+ * Saved groups are stored as a versioned, CRC-checked record in one of two files.
+ * Each save writes to the file that does not hold the newest record, with a higher sequence number,
+ * so a power loss during a save leaves the previous record intact.
+ * At boot, the valid record with the highest sequence number is loaded.
+ *
+ * @see motorgroups.c
+ */
+
+#ifndef MOTORGROUPS_H_
+#define MOTORGROUPS_H_
+
+/**
+ * The maximum number of motor groups.
+ */
+#define MAX_MOTOR_GROUPS 16
+
+/**
+ * Identifies a motor group record in the flash memory ("MG").
+ */
+#define MOTOR_GROUP_MAGIC 0x4D47
+
+/**
+ * The version of the motor group record format.
+ * This must be incremented whenever the layout of MotorGroup or MotorGroupHeader changes.
+ */
+#define MOTOR_GROUP_VERSION 1
+
+/**
+ * The number of files motor group records alternate between.
+ */
+#define MOTOR_GROUP_SLOTS 2
+
+/**
+ * @brief Represents a logical motor grouping, to be used when testing motors.
+ *
+ * Has a bit for each motor port that belongs to the group, as well as a 16-character name.
+ */
+typedef struct MotorGroup {
+    /**
+     * Stores which motor ports are contained in this group.
+     * Bit n is set if motor port n is in the group. Bit 0 is ignored.
+     */
+    unsigned short ports;
+
+    /**
+     * The name of the motor group.
+     *
+     * The name can be a maximum of 16 characters.
+     * The buffer is 17 characters to hold the null terminator.
+     */
+    char name[LCD_MESSAGE_MAX_LENGTH+1];
+} MotorGroup;
+
+/**
+ * @brief The header of a motor group record in the flash memory.
+ *
+ * The header is followed by count MotorGroup structures.
+ */
+typedef struct MotorGroupHeader {
+    /**
+     * Always MOTOR_GROUP_MAGIC.
+     */
+    unsigned short magic;
+
+    /**
+     * The version of the record format (MOTOR_GROUP_VERSION).
+     */
+    unsigned char version;
+
+    /**
+     * The number of motor groups in the record.
+     */
+    unsigned char count;
+
+    /**
+     * Increases with every save, to identify the newest record.
+     */
+    unsigned long sequence;
+
+    /**
+     * The CRC-16 checksum of the header (with this field set to 0) and the motor groups.
+     */
+    unsigned short crc;
+} MotorGroupHeader;
+
+/**
+ * Array that stores the motor groups.
+ * Motor groups are added to the array via the Motor Group Management menu.
+ */
+extern MotorGroup groups[MAX_MOTOR_GROUPS];
+
+/**
+ * Stores the number of motor groups in use.
+ */
+extern int numgroups;
+
+/**
+ * Checks if a motor port belongs to a motor group.
+ *
+ * @param group the motor group
+ * @param port the motor port (1-10)
+ *
+ * @return true if the port is in the group, false otherwise
+ */
+#define motorGroupHas(group, port) bitRead((group)->ports, port)
+
+/**
+ * Loads the saved motor groups, or the standard set of groups if none have been saved.
+ * The standard set includes: Left Drive, Right Drive, Strafe Motor, Full Drive, Nautilus Shooter, Intake, Lift, and Angle Changer.
+ */
+void initGroups();
+
+/**
+ * Loads the newest valid motor group record from the flash memory.
+ * If no valid record exists, the motor groups are left unchanged.
+ *
+ * @return true if a record was loaded, false otherwise
+ */
+bool loadGroups();
+
+/**
+ * Saves the motor groups to the flash memory.
+ *
+ * @return true if the record was written completely, false otherwise
+ */
+bool saveGroups();
+
+/**
+ * Adds an empty motor group to the pool.
+ *
+ * @return a pointer to the new group, or NULL if the pool is full
+ */
+MotorGroup* addGroup();
+
+/**
+ * Removes a motor group from the pool.
+ *
+ * @param index the ID number of the group to remove
+ */
+void deleteGroup(int index);
+
+/**
+ * Runs every motor in a motor group at the same speed.
+ *
+ * @param group the motor group
+ * @param spd the speed to run the motors at
+ */
+void motorGroupSet(const MotorGroup *group, int spd);
+
+#endif
@@ -25,6 +25,20 @@
  */
 #define MOTOR_MIN -127
 
+/**
+ * Sets a motor's output, compensated for the main battery voltage.
+ * Only the closed-loop drive outputs use this, so that their gains mean the same thing as the battery sags.
+ * Driver and mechanism outputs are left as commanded.
+ *
+ * @see battery.h
+ *
+ * @param port the motor port
+ * @param spd the uncompensated motor output
+ */
+inline void motorSetCompensated(unsigned char port, int spd){
+    motorSet(port, constrain((int) (spd * batteryScale), MOTOR_MIN, MOTOR_MAX));
+}
+
 /**
  * Moves the drive straight.
  *
@@ -62,6 +76,20 @@ inline void move(int spd, int turn, int strafe){
     motorSet(STRAFE_MOTOR, strafe);
 }
 
+/**
+ * Moves the robot like move(), with the outputs compensated for the main battery voltage.
+ * Used by the closed-loop drive controllers.
+ *
+ * @param spd the forward/backward speed value
+ * @param turn the turning speed value
+ * @param strafe the strafing speed value
+ */
+inline void moveCompensated(int spd, int turn, int strafe){
+    motorSetCompensated(LEFT_MOTOR, -spd + turn);
+    motorSetCompensated(RIGHT_MOTOR, -spd - turn);
+    motorSetCompensated(STRAFE_MOTOR, strafe);
+}
+
 /** 
  * Moves the robot by setting the drive motor values by side.
  * 
@@ -73,6 +101,18 @@ inline void move_lr(int l, int r){
     motorSet(RIGHT_MOTOR, r);
 }
 
+/**
+ * Moves the robot like move_lr(), with the outputs compensated for the main battery voltage.
+ * Used by the closed-loop drive controllers.
+ *
+ * @param l the left motor speed
+ * @param r the right motor speed
+ */
+inline void move_lrCompensated(int l, int r){
+    motorSetCompensated(LEFT_MOTOR, l);
+    motorSetCompensated(RIGHT_MOTOR, r);
+}
+
 /**
  * Defines the motor configuration of the nautilus shooter.
  *
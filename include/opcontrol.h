@@ -8,6 +8,12 @@
 #ifndef OPCONTROL_H
 #define OPCONTROL_H
 
+/**
+ * Defines the default shooter speed that holds it in place once it is loaded.
+ * The value in use is the shooter_hold runtime parameter (see params.h).
+ */
+#define SHOOTER_HOLD_SPEED -25
+
 /**
  * Forward/backward speed of the drive motors.
  */
@@ -55,6 +61,7 @@ void recordJoyInfo();
 
 /**
  * Moves the robot based on the motor state variables.
+ * The drive motors are compensated for the main battery voltage.
  */
 void moveRobot();
 
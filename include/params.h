@@ -0,0 +1,342 @@
+/** @file params.h
+ * @brief Header file for the runtime parameter registry
+ *
+ * This file contains definitions and function declarations for the runtime parameter registry.
+ * Each tunable gain and threshold is a global variable, initialized to its compiled-in default,
+ * so the control loops read a parameter exactly as they would read any other global.
+ * The registry lists those globals by name and type, so that they can be changed without a rebuild:
+ *     - from the LCD diagnostic menu, one step at a time
+ *     - over the debug terminal, with one command per line (see paramCommand())
+ *
+ * Only parameters that differ from their defaults are saved to the Cortex flash memory.
+ * They are saved by name, so adding or reordering parameters does not disturb saved values,
+ * and a changed default takes effect for every parameter that has not been overridden.
+ * Records alternate between two files, as motor group records do, so a power loss during a save
+ * leaves the previous record intact.
+ *
+ * @see params.c
+ */
+
+#ifndef PARAMS_H_
+#define PARAMS_H_
+
+/**
+ * Identifies a parameter record in the flash memory ("PR").
+ */
+#define PARAM_MAGIC 0x5052
+
+/**
+ * The version of the parameter record format.
+ * This must be incremented whenever the layout of ParamEntry or ParamHeader changes.
+ */
+#define PARAM_VERSION 1
+
+/**
+ * The number of files parameter records alternate between.
+ */
+#define PARAM_SLOTS 2
+
+/**
+ * Defines the longest parameter name, in characters.
+ */
+#define PARAM_NAME_LENGTH 15
+
+/**
+ * Defines the longest command accepted over the debug terminal, in characters.
+ */
+#define PARAM_COMMAND_LENGTH 64
+
+/**
+ * Defines the period at which the debug terminal is polled for commands, in milliseconds.
+ */
+#define PARAM_CONSOLE_PERIOD 50
+
+/**
+ * Type of a parameter held in an int.
+ */
+#define PARAM_INT 0
+
+/**
+ * Type of a parameter held in a float.
+ */
+#define PARAM_FLOAT 1
+
+/**
+ * Parameter ID number of the proportional gain of the gyroscope turning loop.
+ */
+#define PARAM_GYRO_KP 0
+
+/**
+ * Parameter ID number of the integral gain of the gyroscope turning loop.
+ */
+#define PARAM_GYRO_KI 1
+
+/**
+ * Parameter ID number of the derivative gain of the gyroscope turning loop.
+ */
+#define PARAM_GYRO_KD 2
+
+/**
+ * Parameter ID number of the proportional gain of the encoder drive-straight loop.
+ */
+#define PARAM_ENCODER_KP 3
+
+/**
+ * Parameter ID number of the integral gain of the encoder drive-straight loop.
+ */
+#define PARAM_ENCODER_KI 4
+
+/**
+ * Parameter ID number of the derivative gain of the encoder drive-straight loop.
+ */
+#define PARAM_ENCODER_KD 5
+
+/**
+ * Parameter ID number of the ultrasonic range at which the skills routine reaches the other side.
+ */
+#define PARAM_DISTANCE_TO_OTHER_SIDE 6
+
+/**
+ * Parameter ID number of the angle from the vertical used to shoot into the close goal.
+ */
+#define PARAM_CLOSE_GOAL_ANGLE 7
+
+/**
+ * Parameter ID number of the angle from the vertical used to shoot into the far goal.
+ */
+#define PARAM_FAR_GOAL_ANGLE 8
+
+/**
+ * Parameter ID number of the shooter speed that holds it in place when loaded.
+ */
+#define PARAM_SHOOTER_HOLD_SPEED 9
+
+/**
+ * The number of parameters in the registry.
+ */
+#define PARAM_COUNT 10
+
+/**
+ * @brief A parameter in the registry.
+ */
+typedef struct Param {
+    /**
+     * The name of the parameter, used to save it and to refer to it over the debug terminal.
+     */
+    const char *name;
+
+    /**
+     * The type of the variable holding the parameter (PARAM_INT or PARAM_FLOAT).
+     */
+    unsigned char type;
+
+    /**
+     * The number of decimal places the parameter is displayed with on the LCD.
+     */
+    unsigned char decimals;
+
+    /**
+     * The variable holding the parameter.
+     */
+    void *value;
+
+    /**
+     * The compiled-in default value.
+     */
+    float defaultValue;
+
+    /**
+     * The smallest value the parameter can be set to.
+     */
+    float minimum;
+
+    /**
+     * The largest value the parameter can be set to.
+     */
+    float maximum;
+
+    /**
+     * The amount each press of a button changes the parameter by on the LCD.
+     */
+    float step;
+} Param;
+
+/**
+ * @brief A saved parameter in the flash memory.
+ */
+typedef struct ParamEntry {
+    /**
+     * The name of the parameter, padded with null characters.
+     */
+    char name[PARAM_NAME_LENGTH+1];
+
+    /**
+     * The value of the parameter.
+     */
+    float value;
+} ParamEntry;
+
+/**
+ * @brief The header of a parameter record in the flash memory.
+ *
+ * The header is followed by count ParamEntry structures.
+ */
+typedef struct ParamHeader {
+    /**
+     * Always PARAM_MAGIC.
+     */
+    unsigned short magic;
+
+    /**
+     * The version of the record format (PARAM_VERSION).
+     */
+    unsigned char version;
+
+    /**
+     * The number of parameters in the record.
+     */
+    unsigned char count;
+
+    /**
+     * Increases with every save, to identify the newest record.
+     */
+    unsigned long sequence;
+
+    /**
+     * The CRC-16 checksum of the header (with this field set to 0) and the parameters.
+     */
+    unsigned short crc;
+} ParamHeader;
+
+/**
+ * The parameters in the registry, indexed by parameter ID number.
+ */
+extern const Param params[PARAM_COUNT];
+
+/**
+ * The proportional gain of the gyroscope turning loop.
+ */
+extern float gyroKp;
+
+/**
+ * The integral gain of the gyroscope turning loop.
+ */
+extern float gyroKi;
+
+/**
+ * The derivative gain of the gyroscope turning loop.
+ */
+extern float gyroKd;
+
+/**
+ * The proportional gain of the encoder drive-straight loop.
+ */
+extern float encoderKp;
+
+/**
+ * The integral gain of the encoder drive-straight loop.
+ */
+extern float encoderKi;
+
+/**
+ * The derivative gain of the encoder drive-straight loop.
+ */
+extern float encoderKd;
+
+/**
+ * The ultrasonic range at which the skills routine has reached the other side of the field.
+ */
+extern int distanceToOtherSide;
+
+/**
+ * The angle from the vertical used to shoot into the close goal.
+ */
+extern int closeGoalAngle;
+
+/**
+ * The angle from the vertical used to shoot into the far goal.
+ */
+extern int farGoalAngle;
+
+/**
+ * The shooter speed that holds it in place once it is loaded.
+ */
+extern int shooterHoldSpeed;
+
+/**
+ * Loads the saved parameters. Parameters that were not saved keep their defaults.
+ */
+void initParams();
+
+/**
+ * Loads the newest valid parameter record from the flash memory.
+ * If no valid record exists, the parameters are left unchanged.
+ *
+ * @return true if a record was loaded, false otherwise
+ */
+bool loadParams();
+
+/**
+ * Saves every parameter that differs from its default to the flash memory.
+ *
+ * @return true if the record was written completely, false otherwise
+ */
+bool saveParams();
+
+/**
+ * Finds a parameter by name.
+ *
+ * @param name the name of the parameter
+ *
+ * @return the parameter ID number, or -1 if there is no parameter with that name
+ */
+int paramFind(const char *name);
+
+/**
+ * Gets the value of a parameter.
+ *
+ * @param id the parameter ID number
+ *
+ * @return the value of the parameter
+ */
+float paramGet(int id);
+
+/**
+ * Sets the value of a parameter. The value is limited to the parameter's range,
+ * and rounded to the nearest integer for an integer parameter.
+ *
+ * @param id the parameter ID number
+ * @param value the new value
+ */
+void paramSet(int id, float value);
+
+/**
+ * Sets every parameter back to its default.
+ */
+void paramsReset();
+
+/**
+ * Prints every parameter to the debug terminal, one per line.
+ */
+void paramDump();
+
+/**
+ * Runs a command from the debug terminal. The commands are:
+ *     - list: prints every parameter
+ *     - get NAME: prints a parameter
+ *     - set NAME VALUE: sets a parameter until the next power cycle
+ *     - reset NAME, or reset all: sets a parameter, or every parameter, back to its default
+ *     - save: saves the parameters to the flash memory
+ *     - stream CHANNEL PERIOD: sets the sampling period of a telemetry stream channel, in milliseconds (0 stops it)
+ * Blank lines and lines starting with # are ignored, so a file of commands can be sent as-is.
+ *
+ * @param line the command, without its line ending
+ */
+void paramCommand(const char *line);
+
+/**
+ * Starts the task that runs parameter commands typed into the debug terminal.
+ */
+void startParamConsole();
+
+#endif
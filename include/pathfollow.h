@@ -0,0 +1,160 @@
+/** @file pathfollow.h
+ * @brief Header file for the pure pursuit path follower
+ *
+ * This file contains definitions and function declarations for following paths across the field.
+ * A path is a list of field waypoints stored in flash memory.
+ * When a path is followed, extra points are injected between the waypoints and the result is smoothed.
+ * The robot then follows the smoothed path using adaptive pure pursuit, steering towards a lookahead point
+ * on the path based on its position from the field positioning system.
+ * If the drive has been characterized, the drive is driven with the feed-forward output for the velocity
+ * and acceleration its speed stands for, so it is pushed harder while speeding up and eased off while slowing down.
+ *
+ * @see pathfollow.c
+ */
+
+#ifndef PATHFOLLOW_H_
+#define PATHFOLLOW_H_
+
+/**
+ * Defines the maximum number of points in a smoothed path.
+ */
+#define PATH_MAX_POINTS 64
+
+/**
+ * Defines the spacing between points injected into a path, in inches.
+ */
+#define PATH_SPACING 6
+
+/**
+ * Defines how strongly the smoothed path is pulled towards the original waypoints (0 to 1).
+ */
+#define PATH_SMOOTH_DATA 0.25
+
+/**
+ * Defines how strongly each point of the smoothed path is pulled towards its neighbors (0 to 1).
+ */
+#define PATH_SMOOTH_WEIGHT 0.75
+
+/**
+ * Defines the maximum number of smoothing passes made over a path.
+ */
+#define PATH_SMOOTH_ITERATIONS 50
+
+/**
+ * Defines the minimum lookahead distance, in inches.
+ */
+#define PATH_LOOKAHEAD_MIN 8
+
+/**
+ * Defines the maximum lookahead distance, in inches.
+ */
+#define PATH_LOOKAHEAD_MAX 24
+
+/**
+ * Defines how much the lookahead distance grows with the drive speed, in inches per unit of motor speed.
+ * Looking further ahead at speed gives smoother paths; looking closer when slow tracks corners more tightly.
+ */
+#define PATH_LOOKAHEAD_GAIN 0.12
+
+/**
+ * Defines the highest drive speed used while following a path.
+ */
+#define PATH_MAX_SPEED 110
+
+/**
+ * Defines the lowest drive speed used while following a path (below this, the drive stalls).
+ */
+#define PATH_MIN_SPEED 30
+
+/**
+ * Defines the lowest velocity used while following a path once the drive has been characterized, in inches per second.
+ * This replaces PATH_MIN_SPEED, since the speed needed to hold it is known.
+ */
+#define PATH_MIN_VELOCITY 5
+
+/**
+ * Defines the largest change in drive speed per loop iteration, to keep the wheels from slipping.
+ */
+#define PATH_MAX_ACCEL 8
+
+/**
+ * Defines how much the drive slows down in curves.
+ * The target speed in a curve is this value divided by the path's curvature (in 1/inches).
+ */
+#define PATH_TURN_SPEED 4
+
+/**
+ * Defines how much the drive slows down when approaching the end of a path, in units of motor speed per inch remaining.
+ */
+#define PATH_SLOWDOWN 4
+
+/**
+ * Defines the proportional gain of the strafe motor, which corrects the robot's sideways distance from the path.
+ */
+#define PATH_STRAFE_KP 12
+
+/**
+ * Defines how close the robot must be to the final point of a path to stop following it, in inches.
+ */
+#define PATH_END_TOLERANCE 2
+
+/**
+ * Defines the period of the path following loop, in milliseconds.
+ */
+#define PATH_LOOP_PERIOD 20
+
+/**
+ * Defines the time allowed to follow a path on top of PATH_TIMEOUT_PER_INCH for each inch of its length, in milliseconds.
+ */
+#define PATH_TIMEOUT_BASE 2000
+
+/**
+ * Defines the time allowed to follow each inch of a path, in milliseconds. Allows for an average of 5 inches per second.
+ */
+#define PATH_TIMEOUT_PER_INCH 200
+
+/**
+ * Defines how long the robot may go without getting PATH_PROGRESS_DISTANCE closer to the end of the path
+ * before following is abandoned, in milliseconds. Catches a robot that has stalled or is circling the end.
+ */
+#define PATH_PROGRESS_TIME 1000
+
+/**
+ * Defines how much closer to the end of the path the robot must get within PATH_PROGRESS_TIME, in inches.
+ */
+#define PATH_PROGRESS_DISTANCE 1
+
+/**
+ * @brief Representation of a path waypoint, as stored in flash memory.
+ *
+ * Each coordinate is stored as a whole number of inches, which fits in a byte since the field is 144 inches wide.
+ * Paths should be declared as const arrays so that they are kept in flash rather than RAM.
+ */
+typedef struct waypoint {
+    /**
+     * X-coordinate of the waypoint, in inches.
+     */
+    unsigned char x;
+
+    /**
+     * Y-coordinate of the waypoint, in inches.
+     */
+    unsigned char y;
+} waypoint;
+
+/**
+ * Follows a path of waypoints across the field.
+ * The path is smoothed, then followed with adaptive pure pursuit until the robot reaches the final waypoint.
+ * The path starts from the robot's current position, so the first waypoint does not need to be where the robot is.
+ * Following can be cancelled by pressing 7U on the main joystick. It is abandoned if the path takes longer than
+ * its timeout (see PATH_TIMEOUT_BASE) or if the robot stops getting closer to the end (see PATH_PROGRESS_TIME),
+ * so that a robot that is blocked or cannot reach the end always returns.
+ *
+ * @param path the waypoints to follow, in order
+ * @param count the number of waypoints in the path
+ *
+ * @return true if the end of the path was reached, false if following was cancelled or abandoned
+ */
+bool followPath(const waypoint *path, int count);
+
+#endif
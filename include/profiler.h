@@ -0,0 +1,149 @@
+/** @file profiler.h
+ * @brief Header file for the section profiler
+ *
+ * This file contains definitions and function declarations for the section profiler.
+ * Code is profiled by surrounding it with profileBegin() and profileEnd() probes, which use micros().
+ * Each section records its minimum, average and maximum duration and a histogram of durations in fixed RAM.
+ * The fraction of time spent in each section since the profiler was reset gives the CPU usage of the section.
+ *
+ * A probe costs two calls to micros() and a few integer operations, so the profiler is always enabled.
+ * Each section must only be profiled from a single task.
+ *
+ * micros() is a 32-bit counter, so it wraps around every 2^32 microseconds (about 71.6 minutes).
+ * Durations are unsigned differences of micros() values, which stay correct across one wrap,
+ * so a single run of a section may last up to 71.6 minutes. The time since the profiler was reset
+ * is accumulated in 64 bits on every probe, so the CPU usage stays correct however long the robot runs.
+ *
+ * @see profiler.c
+ */
+
+#ifndef PROFILER_H_
+#define PROFILER_H_
+
+/**
+ * Section ID number of one iteration of the operator control loop, excluding its delay.
+ */
+#define PROFILE_OPCONTROL 0
+
+/**
+ * Section ID number of one iteration of the sensor task, excluding its delay.
+ */
+#define PROFILE_SENSORS 1
+
+/**
+ * Section ID number of one iteration of the LCD diagnostic menu event loop, excluding its delay.
+ */
+#define PROFILE_LCD_MENU 2
+
+/**
+ * Section ID number of one flush of the LCD framebuffer.
+ */
+#define PROFILE_LCD_FLUSH 3
+
+/**
+ * Section ID number of one sample of the battery monitor.
+ */
+#define PROFILE_BATTERY 4
+
+/**
+ * Section ID number of building the RTTTL string for one note of a song.
+ * The speaker blocks for the whole note, so playing it is not part of the section.
+ */
+#define PROFILE_SPEAKER 5
+
+/**
+ * The number of profiled sections.
+ */
+#define PROFILE_SECTION_COUNT 6
+
+/**
+ * The number of bins in each section's histogram.
+ */
+#define PROFILE_HISTOGRAM_BINS 8
+
+/**
+ * The upper limit of the first histogram bin, in microseconds.
+ * Each following bin's limit is double the previous one, and the last bin holds everything longer.
+ */
+#define PROFILE_HISTOGRAM_BASE 64
+
+/**
+ * @brief Statistics about the duration of a profiled section.
+ *
+ * All times are in microseconds.
+ */
+typedef struct ProfileSection {
+    /**
+     * The number of times the section has run.
+     */
+    unsigned long count;
+
+    /**
+     * The total time spent in the section.
+     */
+    unsigned long long total;
+
+    /**
+     * The shortest run of the section.
+     */
+    unsigned long minimum;
+
+    /**
+     * The longest run of the section.
+     */
+    unsigned long maximum;
+
+    /**
+     * The number of runs falling into each duration range.
+     */
+    unsigned long histogram[PROFILE_HISTOGRAM_BINS];
+} ProfileSection;
+
+/**
+ * The statistics of each profiled section, indexed by section ID number.
+ */
+extern ProfileSection profileSections[PROFILE_SECTION_COUNT];
+
+/**
+ * The names of each profiled section, indexed by section ID number.
+ */
+extern const char *profileNames[PROFILE_SECTION_COUNT];
+
+/**
+ * Starts a profiled section.
+ *
+ * @return the start time, to be passed to profileEnd()
+ */
+inline unsigned long profileBegin(){
+    return micros();
+}
+
+/**
+ * Ends a profiled section and records its duration.
+ *
+ * @param section the section ID number
+ * @param start the start time returned by profileBegin()
+ */
+void profileEnd(int section, unsigned long start);
+
+/**
+ * Computes the fraction of time spent in a section since the profiler was reset.
+ *
+ * @param section the section ID number
+ *
+ * @return the CPU usage, in tenths of a percent
+ */
+int profileCpuUsage(int section);
+
+/**
+ * Prints the statistics of every section to the debug UART.
+ */
+void profileDump();
+
+/**
+ * Clears the statistics of every section.
+ * The time the CPU usage is measured over only starts counting at the first reset.
+ */
+void profileReset();
+
+#endif
@@ -65,14 +65,115 @@ extern Encoder rightenc;
  */
 extern Encoder horizontalenc;
 
-/** 
- * Clears the drive encoders by resetting their value to zero.
+/**
+ * Encoder ID number of the encoder on the left side of the drivetrain.
  */
-inline void clearDriveEncoders(){
-    encoderReset(leftenc);
-    encoderReset(rightenc);
-    encoderReset(horizontalenc);
-}
+#define ENC_LEFT 0
+
+/**
+ * Encoder ID number of the encoder on the right side of the drivetrain.
+ */
+#define ENC_RIGHT 1
+
+/**
+ * Encoder ID number of the encoder on the horizontal wheel.
+ */
+#define ENC_HORIZONTAL 2
+
+/**
+ * The number of drive encoders tracked by the sensor task.
+ */
+#define NUM_DRIVE_ENCODERS 3
+
+/**
+ * Defines the period of the sensor task, in milliseconds.
+ * The drive encoders are sampled and the field position is updated once per period.
+ */
+#define SENSOR_POLL_PERIOD 10
+
+/**
+ * @brief A consumer's private view of the drive encoders.
+ *
+ * The hardware encoder counters are never reset. Instead, the sensor task accumulates them into
+ * monotonic 64-bit tick counts, and each consumer keeps a cursor marking the counts it last used.
+ * This lets several consumers (odometry, drive-straight PID, distance moves) measure the same
+ * encoders at the same time without corrupting each other's measurements.
+ */
+typedef struct EncoderCursor {
+    /**
+     * The accumulated tick count of each encoder at the time the cursor was last marked.
+     */
+    long long mark[NUM_DRIVE_ENCODERS];
+} EncoderCursor;
+
+/**
+ * Object representing the sensor task.
+ * The sensor task samples the drive encoders and LCD buttons and updates the field position at a fixed rate.
+ */
+extern TaskHandle sensorTask;
+
+/**
+ * Initializes the drive encoder accumulators.
+ * The drive encoders must be initialized before this is called.
+ */
+void initDriveEncoders();
+
+/**
+ * Starts the sensor task.
+ * The drive encoder accumulators and the field positioning system must be initialized before this is called.
+ */
+void startSensorTask();
+
+/**
+ * Samples the drive encoders once, adding the ticks counted since the last sample to the accumulated tick counts.
+ * This is called by the sensor task, and should not normally be called elsewhere.
+ */
+void sampleDriveEncoders();
+
+/**
+ * Returns the encoder object for a drive encoder ID number.
+ *
+ * @param enc the encoder ID number (ENC_LEFT, ENC_RIGHT or ENC_HORIZONTAL)
+ *
+ * @return the encoder object, or NULL if the encoder is not connected
+ */
+Encoder driveEncoder(int enc);
+
+/**
+ * Returns the accumulated tick count of a drive encoder.
+ *
+ * @param enc the encoder ID number (ENC_LEFT, ENC_RIGHT or ENC_HORIZONTAL)
+ *
+ * @return the number of ticks counted since the robot started up
+ */
+long long driveEncoderGet(int enc);
+
+/**
+ * Marks a cursor at the current accumulated tick counts, so that later readings are measured from this point.
+ *
+ * @param cursor the cursor to mark
+ */
+void cursorReset(EncoderCursor *cursor);
+
+/**
+ * Returns the number of ticks a drive encoder has counted since the cursor was marked.
+ * This does not move the cursor.
+ *
+ * @param cursor the cursor to measure from
+ * @param enc the encoder ID number (ENC_LEFT, ENC_RIGHT or ENC_HORIZONTAL)
+ *
+ * @return the number of ticks counted since the cursor was marked
+ */
+int cursorGet(const EncoderCursor *cursor, int enc);
+
+/**
+ * Reads the number of ticks every drive encoder has counted since the cursor was marked,
+ * then marks the cursor at the current tick counts.
+ *
+ * @param cursor the cursor to read and advance
+ * @param deltas an array to store the tick counts in, indexed by encoder ID number
+ */
+void cursorTake(EncoderCursor *cursor, int deltas[NUM_DRIVE_ENCODERS]);
 
 /**
  * Resets the PID control loop variables for the drivetrain.
@@ -165,32 +266,33 @@ inline unsigned int powerLevelExpander(){
 #define GYRO_NET_TARGET 0 
 
 /**
- * Defines the proportional error-correction term for the gyroscope alignment velocity control loop.
+ * Defines the default proportional error-correction term for the gyroscope alignment velocity control loop.
+ * The gains in use are the runtime parameters in params.h, which start at these defaults.
  */
 #define GYRO_KP 6
 
 /**
- * Defines the integral (accumulated) error-correction term for the gyroscope alignment velocity control loop.
+ * Defines the default integral (accumulated) error-correction term for the gyroscope alignment velocity control loop.
  */
 #define GYRO_KI 0
 
 /**
- * Defines the derivative (change) error-correction term for the gyroscope alignment velocity control loop.
+ * Defines the default derivative (change) error-correction term for the gyroscope alignment velocity control loop.
  */
 #define GYRO_KD 3825
 
 /**
- * Defines the proportional error-correction term for the encoder alignment control loop.
+ * Defines the default proportional error-correction term for the encoder alignment control loop.
  */
 #define ENCODER_KP 6
 
 /**
- * Defines the integral (accumulated) error-correction term for the encoder alignment control loop.
+ * Defines the default integral (accumulated) error-correction term for the encoder alignment control loop.
  */
 #define ENCODER_KI 0
 
 /**
- * Defines the derivative (change) error-correction term for the encoder alignment control loop.
+ * Defines the default derivative (change) error-correction term for the encoder alignment control loop.
  */
 #define ENCODER_KD 0
 
@@ -244,16 +346,6 @@ extern Ultrasonic sonar;
  */
 #define BALL_THRESHOLD -1
 
-/**
- * Defines the amount of songs in the master list.
- */
-#define SONG_COUNT 26
- 
-/** 
- * Master list of all songs.
- */
-extern char* songs[];
-
 /**
  * Object representing the speaker song task.
  * The speaker song task runs in a separate thread from the operator control code.
@@ -261,20 +353,5 @@ extern char* songs[];
  */
 TaskHandle speakerTask;
 
-/** 
- * Plays a song over the speaker.
- * This task plays a random song from the array of songs.
- *
- * @param ignore does nothing - required by task definition
- */
-void playSpeaker(void *ignore);
-
-/** 
- * Returns a random song from the master list.
- * 
- * @return a pointer to the song
- */
-char* randsong();
-
 #endif
 
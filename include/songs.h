@@ -0,0 +1,139 @@
+/** @file songs.h
+ * @brief Header file for the precompiled speaker songs
+ *
+ * This file contains definitions and function declarations for the songs played over the speaker.
+ * The songs are written in RTTTL in src/songs.rtttl, one per line, and compiled into packed note arrays in
+ * src/songdata.c by the songc host tool (see sim/songc.c), which the build runs whenever songs.rtttl changes.
+ * Each note takes two bytes of flash instead of four to six characters of text, and nothing is parsed
+ * before a song starts.
+ *
+ * A note keeps the RTTTL duration, pitch, octave and dot it was written with, so the robot code can give it to
+ * the speaker exactly as written. The PROS speaker driver only plays RTTTL and has no way to play a frequency
+ * directly, so the player task hands the speaker one note at a time, written out in a few bytes of RTTTL on its stack.
+ *
+ * This header does not depend on the PROS API, so that the song compiler can use the note layout.
+ *
+ * @see songs.c
+ * @see songdata.c
+ */
+
+#ifndef SONGS_H_
+#define SONGS_H_
+
+/**
+ * Defines the amount of songs in the master list. Must match the number of songs in songs.rtttl.
+ */
+#define SONG_COUNT 26
+
+/**
+ * Defines the pitch number of a rest. Pitches 1 to 12 are C to B.
+ */
+#define SONG_REST 0
+
+/**
+ * Defines the number of pitches in an octave.
+ */
+#define SONG_PITCHES 12
+
+/**
+ * Defines the highest octave a note can be in.
+ */
+#define SONG_MAX_OCTAVE 7
+
+/**
+ * Defines the largest RTTTL duration a note can have, where 4 is a quarter note.
+ */
+#define SONG_MAX_DURATION 255
+
+/**
+ * Defines the size of the buffer the player writes each note out to as RTTTL.
+ */
+#define SONG_RTTTL_LENGTH 32
+
+/**
+ * Packs a note: the RTTTL duration in bits 0-7, the pitch in bits 8-11, the octave in bits 12-14,
+ * and whether the note is dotted (half again as long) in bit 15.
+ */
+#define SONG_NOTE(duration, pitch, octave, dotted) \
+    ((SongNote) ((duration) | ((pitch) << 8) | ((octave) << 12) | ((dotted) ? 0x8000 : 0)))
+
+/**
+ * Returns the RTTTL duration of a packed note, where 4 is a quarter note.
+ */
+#define SONG_NOTE_DURATION(note) ((note) & 0xFF)
+
+/**
+ * Returns the pitch of a packed note, SONG_REST or 1 (C) to 12 (B).
+ */
+#define SONG_NOTE_PITCH(note) (((note) >> 8) & 0xF)
+
+/**
+ * Returns the octave of a packed note.
+ */
+#define SONG_NOTE_OCTAVE(note) (((note) >> 12) & 0x7)
+
+/**
+ * Returns whether a packed note is dotted.
+ */
+#define SONG_NOTE_DOTTED(note) (((note) & 0x8000) != 0)
+
+/**
+ * A packed note; see SONG_NOTE().
+ */
+typedef unsigned short SongNote;
+
+/**
+ * @brief A compiled song.
+ */
+typedef struct Song {
+    /**
+     * The song's notes.
+     */
+    const SongNote *notes;
+
+    /**
+     * The number of notes.
+     */
+    unsigned short count;
+
+    /**
+     * The tempo, in quarter notes per minute.
+     */
+    unsigned short tempo;
+} Song;
+
+/**
+ * Master list of all songs, in the order of songs.rtttl.
+ */
+extern const Song songs[SONG_COUNT];
+
+#ifdef SIMULATOR
+/**
+ * The RTTTL each song was compiled from, kept in the simulator only so that the compiled songs can be checked against it.
+ */
+extern const char * const songSources[SONG_COUNT];
+#endif
+
+/**
+ * Plays a song over the speaker, one note at a time. Returns when the song ends.
+ *
+ * @param song the song
+ */
+void playSong(const Song *song);
+
+/**
+ * Plays a song over the speaker.
+ * This task plays a random song from the array of songs.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void playSpeaker(void *ignore);
+
+/**
+ * Returns a random song from the master list.
+ *
+ * @return a pointer to the song
+ */
+const Song* randsong();
+
+#endif
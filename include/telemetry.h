@@ -0,0 +1,121 @@
+/** @file telemetry.h
+ * @brief Header file for the performance telemetry
+ *
+ * This file contains definitions and function declarations for the performance telemetry.
+ * The telemetry is a cheap instrumentation layer that is always compiled in.
+ * Periodic loops call loopStatsTick() once per iteration to record their period, jitter and overruns,
+ * and the sensor task samples the motor outputs.
+ * Battery sag is recorded by the battery monitor.
+ * The results are displayed on the telemetry pages of the LCD diagnostic menu.
+ *
+ * @see telemetry.c
+ */
+
+#ifndef TELEMETRY_H_
+#define TELEMETRY_H_
+
+/**
+ * Defines the weight of each new sample in the average loop period, as a power of two.
+ * A value of 4 averages over roughly the last 16 iterations.
+ */
+#define LOOP_STATS_AVERAGE_SHIFT 4
+
+/**
+ * @brief Statistics about the timing of a periodic loop.
+ *
+ * All times are in microseconds.
+ */
+typedef struct LoopStats {
+    /**
+     * The name of the loop, displayed on the LCD.
+     */
+    const char *name;
+
+    /**
+     * The period the loop is intended to run at.
+     */
+    unsigned long target;
+
+    /**
+     * The time of the last iteration, or 0 if the loop has not run since the statistics were reset.
+     */
+    unsigned long last;
+
+    /**
+     * The running average of the loop period.
+     */
+    unsigned long average;
+
+    /**
+     * The largest difference between the loop period and the target period.
+     */
+    unsigned long maxJitter;
+
+    /**
+     * The longest amount of time by which the loop period exceeded the target period.
+     */
+    unsigned long worstOverrun;
+
+    /**
+     * The number of iterations that took longer than the target period plus one millisecond.
+     */
+    unsigned long overruns;
+
+    /**
+     * The number of iterations recorded.
+     */
+    unsigned long ticks;
+
+    /**
+     * The most recent loop period.
+     */
+    unsigned long period;
+} LoopStats;
+
+/**
+ * Timing statistics of the operator control loop.
+ */
+extern LoopStats opcontrolLoop;
+
+/**
+ * Timing statistics of the sensor task loop.
+ */
+extern LoopStats sensorLoop;
+
+/**
+ * The number of motor output samples that were not zero.
+ */
+extern unsigned long motorActiveSamples;
+
+/**
+ * The number of motor output samples that were at full power.
+ */
+extern unsigned long motorSaturatedSamples;
+
+/**
+ * Clears the timing statistics of a loop.
+ *
+ * @param stats the statistics to clear
+ */
+void loopStatsReset(LoopStats *stats);
+
+/**
+ * Records one iteration of a loop.
+ * This should be called once per iteration, at the same point in the loop.
+ *
+ * @param stats the statistics of the loop
+ */
+void loopStatsTick(LoopStats *stats);
+
+/**
+ * Samples the motor outputs.
+ * This is called periodically by the sensor task.
+ */
+void sampleTelemetry();
+
+/**
+ * Clears all telemetry, so that minimums and maximums are recorded from this point on.
+ */
+void resetTelemetry();
+
+#endif
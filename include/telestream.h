@@ -0,0 +1,249 @@
+/** @file telestream.h
+ * @brief Header file for the binary telemetry stream
+ *
+ * This file contains definitions and function declarations for the binary telemetry stream.
+ * While the stream is enabled, a low-priority task samples a set of numbered channels, each at its own rate,
+ * and sends them over the spare UART as compact binary packets. The host decoder in sim/streamdecode.c
+ * turns the stream into CSV as it arrives.
+ *
+ * Each packet starts with its type and an 8-bit sequence number, so that the host can count lost packets,
+ * and ends with a CRC-16 of everything before it. Multi-byte values are little-endian.
+ * - Sample packets (STREAM_PACKET_SAMPLES) hold a 32-bit timestamp in milliseconds, followed by a channel ID
+ *   and a signed 32-bit value for each channel sampled on that tick. Values are fixed-point, scaled by ten to
+ *   the power of the channel's number of decimals.
+ * - Channel packets (STREAM_PACKET_CHANNEL) describe one channel: its ID, number of decimals, period in
+ *   milliseconds (0 if it is not being sampled) and name. Every channel is described once per
+ *   STREAM_DESCRIBE_PERIOD, so that a decoder started at any time learns the channels within a second.
+ * Packets are COBS-encoded and terminated with a zero byte.
+ *
+ * Channels either read a value when they are sampled, or hold the last value published to them
+ * with streamPublish(), for values that only exist inside a control loop.
+ * Each channel starts at its default period, which can be changed over the debug terminal with the
+ * parameter console's stream command (see paramCommand()).
+ *
+ * This header only uses standard C types, so that the host decoder can include it without the PROS API.
+ *
+ * @see telestream.c
+ */
+
+#ifndef TELESTREAM_H_
+#define TELESTREAM_H_
+
+/**
+ * Defines the UART the stream is sent over. UART 1 is used by the LCD.
+ */
+#define STREAM_PORT uart2
+
+/**
+ * Defines the baud rate of the stream.
+ * At this rate, every channel at its default rate uses a little over half of the UART's bandwidth.
+ */
+#define STREAM_BAUD 115200
+
+/**
+ * Defines the period of the stream task, in milliseconds. Channel periods are multiples of this.
+ */
+#define STREAM_PERIOD 10
+
+/**
+ * Defines the period at which every channel is described, in milliseconds.
+ */
+#define STREAM_DESCRIBE_PERIOD 1000
+
+/**
+ * Packet type of a packet of channel samples.
+ */
+#define STREAM_PACKET_SAMPLES 0
+
+/**
+ * Packet type of a packet describing a channel.
+ */
+#define STREAM_PACKET_CHANNEL 1
+
+/**
+ * Defines the longest channel name, in characters.
+ */
+#define STREAM_NAME_LENGTH 16
+
+/**
+ * Channel ID number of the gyroscope angle, in degrees.
+ */
+#define STREAM_GYRO 0
+
+/**
+ * Channel ID number of the target angle of the gyroscope PID loop, in degrees.
+ */
+#define STREAM_GYRO_TARGET 1
+
+/**
+ * Channel ID number of the error of the gyroscope PID loop, in degrees.
+ */
+#define STREAM_GYRO_ERROR 2
+
+/**
+ * Channel ID number of the integral of the gyroscope PID loop.
+ */
+#define STREAM_GYRO_INTEGRAL 3
+
+/**
+ * Channel ID number of the derivative of the gyroscope PID loop.
+ */
+#define STREAM_GYRO_DERIVATIVE 4
+
+/**
+ * Channel ID number of the turning speed of the drive motors.
+ */
+#define STREAM_TURN 5
+
+/**
+ * Channel ID number of the output of the left drive motor.
+ */
+#define STREAM_LEFT_MOTOR 6
+
+/**
+ * Channel ID number of the output of the right drive motor.
+ */
+#define STREAM_RIGHT_MOTOR 7
+
+/**
+ * Channel ID number of the accumulated tick count of the left drive encoder.
+ */
+#define STREAM_LEFT_ENC 8
+
+/**
+ * Channel ID number of the accumulated tick count of the right drive encoder.
+ */
+#define STREAM_RIGHT_ENC 9
+
+/**
+ * Channel ID number of the accumulated tick count of the horizontal encoder.
+ */
+#define STREAM_HORIZONTAL_ENC 10
+
+/**
+ * Channel ID number of the robot's X-coordinate on the field, in inches.
+ */
+#define STREAM_POSITION_X 11
+
+/**
+ * Channel ID number of the robot's Y-coordinate on the field, in inches.
+ */
+#define STREAM_POSITION_Y 12
+
+/**
+ * Channel ID number of the robot's heading on the field, in degrees.
+ */
+#define STREAM_HEADING 13
+
+/**
+ * Channel ID number of the ultrasonic sensor range, in centimeters.
+ */
+#define STREAM_SONAR 14
+
+/**
+ * Channel ID number of the main battery voltage, in millivolts.
+ */
+#define STREAM_BATTERY 15
+
+/**
+ * Channel ID number of the most recent operator control loop period, in microseconds.
+ */
+#define STREAM_OPCONTROL_PERIOD 16
+
+/**
+ * The number of telemetry stream channels.
+ */
+#define STREAM_CHANNEL_COUNT 17
+
+/**
+ * Defines the size of the largest packet before encoding: the type, sequence number, timestamp,
+ * a sample of every channel and the CRC.
+ */
+#define STREAM_MAX_PACKET (2 + 4 + STREAM_CHANNEL_COUNT * 5 + 2)
+
+/**
+ * @brief A telemetry stream channel.
+ */
+typedef struct StreamChannel {
+    /**
+     * The name of the channel, used as its column heading by the host decoder.
+     */
+    const char *name;
+
+    /**
+     * The number of decimal places the channel's values are sent with.
+     */
+    unsigned char decimals;
+
+    /**
+     * The default sampling period of the channel, in milliseconds, or 0 if it is not sampled by default.
+     */
+    unsigned short period;
+
+    /**
+     * Reads the channel's value, or NULL if the channel holds the last value passed to streamPublish().
+     */
+    double (*read)();
+} StreamChannel;
+
+/**
+ * The telemetry stream channels, indexed by channel ID number.
+ */
+extern const StreamChannel streamChannels[STREAM_CHANNEL_COUNT];
+
+/**
+ * The sampling period of each channel, in milliseconds, indexed by channel ID number.
+ * A channel with a period of 0 is not sampled.
+ */
+extern unsigned short streamPeriods[STREAM_CHANNEL_COUNT];
+
+/**
+ * Whether the telemetry stream is being sent.
+ */
+extern bool streamEnabled;
+
+/**
+ * Opens the stream's UART and starts the telemetry stream task. The stream starts disabled.
+ */
+void startTelemetryStream();
+
+/**
+ * Finds a channel by name.
+ *
+ * @param name the name of the channel
+ *
+ * @return the channel ID number, or -1 if there is no channel with that name
+ */
+int streamFind(const char *name);
+
+/**
+ * Sets the sampling period of a channel.
+ *
+ * @param channel the channel ID number
+ * @param period the sampling period in milliseconds, rounded down to a multiple of STREAM_PERIOD, or 0 to stop sampling the channel
+ */
+void streamSetPeriod(int channel, unsigned short period);
+
+/**
+ * Sets the value of a channel that does not read its own value.
+ * The value is sent the next time the channel is sampled.
+ *
+ * @param channel the channel ID number
+ * @param value the value
+ */
+void streamPublish(int channel, double value);
+
+/**
+ * Enables the telemetry stream if it is disabled, or disables it if it is enabled.
+ */
+void streamToggle();
+
+/**
+ * Appends the CRC to a packet and sends it COBS-encoded over the stream's UART, followed by a zero byte.
+ *
+ * @param packet the packet, with STREAM_MAX_PACKET bytes of space
+ * @param length the length of the packet, without the CRC
+ */
+void streamSend(unsigned char *packet, unsigned int length);
+
+#endif
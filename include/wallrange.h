@@ -0,0 +1,125 @@
+/** @file wallrange.h
+ * @brief Header file for ultrasonic wall-ranging localization
+ *
+ * This file contains definitions and function declarations for the wall-ranging localization system.
+ * The ultrasonic sensor's reading is treated as the distance to the field wall along the robot's heading.
+ * When the robot is facing (nearly) straight at a wall, that distance fixes one coordinate of its position.
+ * This lets the field positioning system re-zero itself against the walls instead of drifting over a long run.
+ *
+ * @see wallrange.c
+ */
+
+#ifndef WALLRANGE_H_
+#define WALLRANGE_H_
+
+/**
+ * Defines the number of centimeters in an inch.
+ * The ultrasonic sensor reports distances in centimeters, while the field positioning system uses inches.
+ */
+#define CM_PER_INCH 2.54
+
+/**
+ * Defines the distance from the robot's center to the face of the ultrasonic sensor, in inches.
+ * The sensor is mounted on the front of the robot, facing along the robot's heading.
+ */
+#define SONAR_OFFSET 7
+
+/**
+ * Defines the smallest ultrasonic reading that is trusted, in centimeters.
+ * A reading of zero means that no echo was received.
+ */
+#define WALLRANGE_MIN_CM 3
+
+/**
+ * Defines the largest ultrasonic reading that is trusted, in centimeters.
+ * Beyond this distance the echo from the wall is too weak to be reliable.
+ */
+#define WALLRANGE_MAX_CM 300
+
+/**
+ * Defines the largest angle, in degrees, between the robot's heading and a wall's normal for that wall to be ranged.
+ * At steeper angles the ping glances off the wall and the echo cannot be trusted.
+ */
+#define WALLRANGE_MAX_ANGLE 15
+
+/**
+ * Defines the number of consecutive readings that are median filtered before being used.
+ * This rejects single-sample spikes caused by balls or other robots crossing the beam.
+ */
+#define WALLRANGE_FILTER_SIZE 3
+
+/**
+ * Defines the largest correction, in inches, that a single wall-ranging measurement may make.
+ * Measurements that disagree with the current position estimate by more than this are rejected as outliers.
+ */
+#define WALLRANGE_GATE 12
+
+/**
+ * Defines the fraction of the measured error that is corrected per accepted measurement.
+ * Values closer to 1 trust the ultrasonic sensor more; values closer to 0 trust odometry more.
+ */
+#define WALLRANGE_GAIN 0.5
+
+/**
+ * Defines the age of an ultrasonic reading when it is read, in milliseconds.
+ * The sensor is pinged in the background, so each reading describes where the robot was this long ago.
+ * Readings are compared against the pose the robot had at that time, looked up from the pose history.
+ */
+#define WALLRANGE_LATENCY 30
+
+/**
+ * Identifies which field wall (if any) the ultrasonic sensor is currently ranging.
+ */
+typedef enum fieldWall {
+    /**
+     * The sensor is not facing a wall squarely enough to be used.
+     */
+    WALL_NONE,
+
+    /**
+     * The wall along X = 0.
+     */
+    WALL_X_LOW,
+
+    /**
+     * The wall along X = FIELD_LENGTH.
+     */
+    WALL_X_HIGH,
+
+    /**
+     * The wall along Y = 0.
+     */
+    WALL_Y_LOW,
+
+    /**
+     * The wall along Y = FIELD_LENGTH.
+     */
+    WALL_Y_HIGH
+} fieldWall;
+
+/**
+ * Number of wall-ranging measurements that have corrected the robot's position.
+ */
+extern unsigned int wallRangeAccepted;
+
+/**
+ * Number of wall-ranging measurements that have been rejected (no echo, out of range, oblique, or outlier).
+ */
+extern unsigned int wallRangeRejected;
+
+/**
+ * Discards any buffered ultrasonic readings.
+ * This should be called whenever the robot's position is reset.
+ */
+void resetWallRange();
+
+/**
+ * Corrects the robot's position using the current ultrasonic reading.
+ * The reading is taken as the range to the field wall along the robot's heading,
+ * and the X or Y coordinate of the position constrained by that wall is corrected.
+ *
+ * @return true if the position was corrected, false if the reading was rejected
+ */
+bool updateWallRange();
+
+#endif
@@ -0,0 +1,202 @@
+/** @file bbdecode.c
+ * @brief Host decoder for black box recorder dumps
+ *
+ * Reads a capture of the debug terminal containing one or more black box dumps (see blackBoxDump()),
+ * puts the valid blocks back in order by sequence number, and prints their frames as CSV.
+ * Lines that are not part of a dump are ignored, so a whole terminal session can be passed in.
+ * A block that appears in several dumps is only printed once. The CSV can be replayed through the
+ * robot code with sim/replay.
+ *
+ * Usage: bbdecode [capture...]
+ * Reads standard input if no capture files are given. Problems with the input are reported on standard error.
+ *
+ * Unlike the simulator programs, the decoder runs on the host's own C library rather than the PROS API
+ * stand-in, so it only links the robot code's CRC functions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include "crc.h"
+#include "blackbox.h"
+
+/**
+ * Defines the longest line read from a capture, which must hold a whole slot in hexadecimal.
+ */
+#define DECODE_LINE_LENGTH (sizeof(BlackBoxBlock) * 2 + 64)
+
+/**
+ * Defines the largest number of distinct blocks that can be decoded at once.
+ */
+#define DECODE_MAX_BLOCKS 1024
+
+/**
+ * The valid blocks read so far.
+ */
+BlackBoxBlock *blocks;
+
+/**
+ * The number of valid blocks read so far.
+ */
+int blockCount = 0;
+
+/**
+ * Checks whether a block read from a dump is valid.
+ * This is the same check as blackBoxValid(), which cannot be linked without the PROS API.
+ *
+ * @param block the block to check
+ * @param size the number of bytes of the block that were decoded
+ *
+ * @return true if the block has the right magic number, version and size, and its CRC matches
+ */
+bool blockValid(const BlackBoxBlock *block, size_t size) {
+    if (size < sizeof(BlackBoxHeader) || block->header.magic != BLACKBOX_MAGIC ||
+            block->header.version != BLACKBOX_VERSION || block->header.count > BLACKBOX_BLOCK_FRAMES ||
+            size < sizeof(BlackBoxHeader) + sizeof(BlackBoxFrame) * block->header.count) {
+        return false;
+    }
+    BlackBoxHeader copy = block->header;
+    copy.crc = 0;
+    unsigned short crc = crc16(CRC16_INIT, &copy, sizeof(copy));
+    return crc16(crc, block->frames, sizeof(BlackBoxFrame) * block->header.count) == block->header.crc;
+}
+
+/**
+ * Returns the value of a hexadecimal digit.
+ *
+ * @param c the digit
+ *
+ * @return the value of the digit, or -1 if it is not a hexadecimal digit
+ */
+int hexDigit(char c) {
+    if (c >= '0' && c <= '9') {
+        return c - '0';
+    } else if (c >= 'a' && c <= 'f') {
+        return c - 'a' + 10;
+    } else if (c >= 'A' && c <= 'F') {
+        return c - 'A' + 10;
+    }
+    return -1;
+}
+
+/**
+ * Decodes one line of a capture, adding the block it holds if it is a valid slot line.
+ *
+ * @param line the line, without its line ending
+ * @param source the name of the capture, for error messages
+ * @param number the line number, for error messages
+ */
+void decodeLine(const char *line, const char *source, int number) {
+    int slot;
+    int offset = 0;
+    if (sscanf(line, "blackbox slot=%d hex=%n", &slot, &offset) < 1 || offset == 0) {
+        return;
+    }
+    BlackBoxBlock block;
+    memset(&block, 0, sizeof(block));
+    unsigned char *bytes = (unsigned char *) &block;
+    size_t size = 0;
+    const char *hex = line + offset;
+    while (hexDigit(hex[0]) >= 0 && hexDigit(hex[1]) >= 0 && size < sizeof(block)) {
+        bytes[size++] = (unsigned char) (hexDigit(hex[0]) << 4 | hexDigit(hex[1]));
+        hex += 2;
+    }
+    if (size == 0) {
+        // An empty slot has never been written
+        return;
+    }
+    if (!blockValid(&block, size)) {
+        fprintf(stderr, "%s:%d: slot %d is corrupt, skipped\n", source, number, slot);
+        return;
+    }
+    for (int i = 0; i < blockCount; i++) {
+        if (blocks[i].header.sequence == block.header.sequence) {
+            return;
+        }
+    }
+    if (blockCount >= DECODE_MAX_BLOCKS) {
+        fprintf(stderr, "%s:%d: too many blocks, slot %d skipped\n", source, number, slot);
+        return;
+    }
+    blocks[blockCount++] = block;
+}
+
+/**
+ * Reads every line of a capture.
+ *
+ * @param file the capture
+ * @param source the name of the capture, for error messages
+ */
+void decodeFile(FILE *file, const char *source) {
+    char *line = malloc(DECODE_LINE_LENGTH);
+    int number = 0;
+    while (fgets(line, DECODE_LINE_LENGTH, file) != NULL) {
+        number++;
+        line[strcspn(line, "\r\n")] = '\0';
+        decodeLine(line, source, number);
+    }
+    free(line);
+}
+
+/**
+ * Orders blocks by sequence number.
+ */
+int compareBlocks(const void *a, const void *b) {
+    uint32_t x = ((const BlackBoxBlock *) a)->header.sequence;
+    uint32_t y = ((const BlackBoxBlock *) b)->header.sequence;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Prints the frames of every block as CSV, one frame per row.
+ */
+void printCsv() {
+    printf("sequence,dropped,time_ms,enabled,autonomous,online,joy1,joy2,joy3,joy4,buttons");
+    for (int port = 1; port <= 10; port++) {
+        printf(",motor%d", port);
+    }
+    printf(",enc_left,enc_right,enc_horizontal,gyro_deg,sonar_cm,battery_mv,opcontrol_us,sensor_us\n");
+    for (int i = 0; i < blockCount; i++) {
+        const BlackBoxHeader *header = &blocks[i].header;
+        for (int j = 0; j < header->count; j++) {
+            const BlackBoxFrame *frame = &blocks[i].frames[j];
+            // Frames lost before a block are only reported on its first row
+            printf("%lu,%u,%lu,%d,%d,%d", (unsigned long) header->sequence, j == 0 ? header->dropped : 0,
+                   (unsigned long) frame->time, (frame->mode & BLACKBOX_ENABLED) != 0,
+                   (frame->mode & BLACKBOX_AUTONOMOUS) != 0, (frame->mode & BLACKBOX_ONLINE) != 0);
+            for (int k = 0; k < 4; k++) {
+                printf(",%d", frame->joystick[k]);
+            }
+            printf(",0x%04x", frame->buttons);
+            for (int k = 0; k < 10; k++) {
+                printf(",%d", frame->motors[k]);
+            }
+            printf(",%ld,%ld,%ld,%d,%d,%u,%u,%u\n", (long) frame->encoders[0], (long) frame->encoders[1],
+                   (long) frame->encoders[2], frame->gyro, frame->sonar, frame->battery,
+                   frame->opcontrolPeriod, frame->sensorPeriod);
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    blocks = malloc(sizeof(BlackBoxBlock) * DECODE_MAX_BLOCKS);
+    if (argc < 2) {
+        decodeFile(stdin, "stdin");
+    }
+    for (int i = 1; i < argc; i++) {
+        FILE *file = fopen(argv[i], "r");
+        if (file == NULL) {
+            perror(argv[i]);
+            return 1;
+        }
+        decodeFile(file, argv[i]);
+        fclose(file);
+    }
+    qsort(blocks, blockCount, sizeof(BlackBoxBlock), compareBlocks);
+    printCsv();
+    fprintf(stderr, "decoded %d blocks\n", blockCount);
+    free(blocks);
+    return 0;
+}
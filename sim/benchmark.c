@@ -0,0 +1,57 @@
+/** @file benchmark.c
+ * @brief File for the host simulator's control path benchmark program
+ *
+ * Runs the control path microbenchmarks in bench.c against the API stand-in, timing each call
+ * with the host's monotonic clock. Results are printed one case per line as key=value pairs,
+ * in the same format the robot prints them in when the benchmarks are run from the LCD menu.
+ *
+ * Usage: benchmark [-n iterations]
+ *     -n iterations  number of timed calls of each case (default 10000)
+ */
+
+#include "main.h"
+#include "sim.h"
+#include "plant.h"
+
+/**
+ * Defines the default number of timed calls of each case.
+ * The host clock is much coarser than the cycle counter, so more calls are needed for a stable mean.
+ */
+#define BENCHMARK_ITERATIONS 10000
+
+/**
+ * Number of timed calls of each case.
+ */
+unsigned int benchmarkIterations = BENCHMARK_ITERATIONS;
+
+/**
+ * Runs the robot's initialization, then every benchmark case, and prints the results.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void runBenchmarks(void *ignore) {
+    BenchResult results[BENCH_CASE_COUNT];
+    char line[128];
+    initialize();
+    benchRunAll(benchmarkIterations, results);
+    simReport("bench overhead=%lu unit=%s\n", benchOverhead, BENCH_UNIT);
+    for (int i = 0; i < BENCH_CASE_COUNT; i++) {
+        benchFormat(&results[i], line, sizeof(line));
+        simReport("%s\n", line);
+    }
+}
+
+int main(int argc, char **argv) {
+    PlantConfig config;
+    plantDefaults(&config);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            // max() evaluates its arguments twice, so the argument is parsed before it is clamped
+            int iterations = atoi(argv[++i]);
+            benchmarkIterations = max(iterations, 1);
+        }
+    }
+    plantReset(&config, ROBOT_START_POSITION_X, ROBOT_START_POSITION_Y, ROBOT_START_ANGLE);
+    simRun(runBenchmarks, NULL, plantStep);
+    return 0;
+}
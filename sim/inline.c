@@ -0,0 +1,21 @@
+/** @file inline.c
+ * @brief File for the host simulator's copies of the robot code's inline functions
+ *
+ * The robot code's headers declare their inline functions without storage class, which in C99
+ * only provides an inline definition. The Cortex build inlines every call, but an unoptimized
+ * host build may not, so this file declares each one extern to emit the out-of-line copy.
+ */
+
+#include "main.h"
+
+extern inline void motorSetCompensated(unsigned char port, int spd);
+extern inline void move(int spd, int turn, int strafe);
+extern inline void moveCompensated(int spd, int turn, int strafe);
+extern inline void move_lr(int l, int r);
+extern inline void move_lrCompensated(int l, int r);
+extern inline void shoot(int spd);
+extern inline void intake(int spd);
+extern inline void adjust(int spd);
+extern inline void lift_raw(int left, int right);
+extern inline unsigned int powerLevelExpander();
+extern inline unsigned long profileBegin();
@@ -0,0 +1,424 @@
+/** @file kernel.c
+ * @brief File for the host simulator's task scheduler
+ *
+ * Simulated tasks are coroutines, so exactly one runs at a time and each runs until it waits.
+ * When a task waits, the highest priority task whose wake time has passed runs next; if no task
+ * is ready, simulated time advances one tick at a time, stepping the plant, until one is.
+ *
+ * This file includes host system headers rather than main.h, since the PROS declarations of the
+ * standard library conflict with them.
+ *
+ * @see sim.h
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <ucontext.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "sim.h"
+
+/**
+ * @brief State of a simulated task.
+ */
+typedef struct SimTask {
+    /**
+     * The saved context of the task while it is not running.
+     */
+    ucontext_t context;
+
+    /**
+     * The task's stack, or NULL if the slot is free.
+     */
+    void *stack;
+
+    /**
+     * The function the task runs.
+     */
+    SimEntry entry;
+
+    /**
+     * The parameter passed to the task's function.
+     */
+    void *param;
+
+    /**
+     * The task priority.
+     */
+    unsigned int priority;
+
+    /**
+     * The task state, one of the SIM_TASK_* states.
+     */
+    int state;
+
+    /**
+     * The simulated time the task waits for, in microseconds.
+     */
+    unsigned long long wake;
+
+    /**
+     * The scheduling sequence number of the last time the task ran, used to rotate between equal tasks.
+     */
+    unsigned long long lastRun;
+} SimTask;
+
+/**
+ * The simulated tasks.
+ */
+SimTask simTasks[SIM_MAX_TASKS];
+
+/**
+ * The context of the scheduler, which tasks switch back to when they wait.
+ */
+ucontext_t simSchedulerContext;
+
+/**
+ * The task that is currently executing, or NULL while the scheduler is running.
+ */
+SimTask *simCurrent = NULL;
+
+/**
+ * The current simulated time, in microseconds.
+ */
+unsigned long long simNow = 0;
+
+/**
+ * Number of times the scheduler has switched to a task.
+ */
+unsigned long long simSwitches = 0;
+
+/**
+ * The simulated time until which no task may run, in microseconds.
+ */
+unsigned long long simStallEnd = 0;
+
+/**
+ * Runs a task's function, then marks the task dead so the scheduler frees its stack.
+ *
+ * @param index the index of the task in simTasks
+ */
+void simTaskStart(int index) {
+    SimTask *task = &simTasks[index];
+    task->entry(task->param);
+    task->state = SIM_TASK_DEAD;
+}
+
+/**
+ * Creates a simulated task.
+ *
+ * @param entry the function to run
+ * @param param the parameter to pass to the function
+ * @param priority the task priority
+ *
+ * @return a handle to the task, or NULL if there are too many tasks
+ */
+void* simSpawn(SimEntry entry, void *param, unsigned int priority) {
+    for (int i = 0; i < SIM_MAX_TASKS; i++) {
+        SimTask *task = &simTasks[i];
+        if (task->stack != NULL) {
+            continue;
+        }
+        task->stack = malloc(SIM_STACK_SIZE);
+        if (task->stack == NULL) {
+            return NULL;
+        }
+        getcontext(&task->context);
+        task->context.uc_stack.ss_sp = task->stack;
+        task->context.uc_stack.ss_size = SIM_STACK_SIZE;
+        task->context.uc_link = &simSchedulerContext;
+        makecontext(&task->context, (void (*)()) simTaskStart, 1, i);
+        task->entry = entry;
+        task->param = param;
+        task->priority = priority;
+        task->state = SIM_TASK_RUNNABLE;
+        task->wake = simNow;
+        task->lastRun = 0;
+        return task;
+    }
+    return NULL;
+}
+
+/**
+ * Returns the handle of the task that is currently executing.
+ *
+ * @return the current task, or NULL if called from outside the simulation
+ */
+void* simSelf() {
+    return simCurrent;
+}
+
+/**
+ * Switches from the current task back to the scheduler.
+ */
+void simSwitchOut() {
+    SimTask *task = simCurrent;
+    swapcontext(&task->context, &simSchedulerContext);
+}
+
+/**
+ * Suspends the current task until simulated time reaches the wake time.
+ *
+ * @param wake the time to wake at, in microseconds
+ */
+void simSleepUntil(unsigned long long wake) {
+    if (simCurrent == NULL) {
+        return;
+    }
+    simCurrent->wake = wake;
+    simCurrent->state = SIM_TASK_SLEEPING;
+    simSwitchOut();
+}
+
+/**
+ * Stalls every task for a length of simulated time.
+ *
+ * @param us the length of the stall, in microseconds
+ */
+void simStall(unsigned long long us) {
+    if (simNow + us > simStallEnd) {
+        simStallEnd = simNow + us;
+    }
+    simSleepUntil(simStallEnd);
+}
+
+/**
+ * Returns the current simulated time.
+ *
+ * @return the simulated time since the start of the run, in microseconds
+ */
+unsigned long long simTime() {
+    return simNow;
+}
+
+/**
+ * Suspends a task until it is resumed.
+ *
+ * @param task the task to suspend
+ */
+void simSuspend(void *task) {
+    SimTask *t = (task != NULL) ? (SimTask *) task : simCurrent;
+    if (t == NULL || t->state == SIM_TASK_DEAD) {
+        return;
+    }
+    t->state = SIM_TASK_SUSPENDED;
+    if (t == simCurrent) {
+        simSwitchOut();
+    }
+}
+
+/**
+ * Resumes a suspended task.
+ *
+ * @param task the task to resume
+ */
+void simResume(void *task) {
+    SimTask *t = (SimTask *) task;
+    if (t != NULL && t->state == SIM_TASK_SUSPENDED) {
+        t->state = SIM_TASK_RUNNABLE;
+        t->wake = simNow;
+    }
+}
+
+/**
+ * Deletes a task.
+ *
+ * @param task the task to delete
+ */
+void simKill(void *task) {
+    SimTask *t = (task != NULL) ? (SimTask *) task : simCurrent;
+    if (t == NULL || t->state == SIM_TASK_DEAD) {
+        return;
+    }
+    t->state = SIM_TASK_DEAD;
+    if (t == simCurrent) {
+        // The scheduler frees the stack once it is no longer in use
+        setcontext(&simSchedulerContext);
+    }
+    free(t->stack);
+    t->stack = NULL;
+}
+
+/**
+ * Returns the state of a task.
+ *
+ * @param task the task to query
+ *
+ * @return one of the SIM_TASK_* states
+ */
+int simTaskState(void *task) {
+    SimTask *t = (task != NULL) ? (SimTask *) task : simCurrent;
+    return t != NULL ? t->state : SIM_TASK_DEAD;
+}
+
+/**
+ * Returns the priority of a task.
+ *
+ * @param task the task to query
+ *
+ * @return the task priority
+ */
+unsigned int simTaskPriority(void *task) {
+    SimTask *t = (task != NULL) ? (SimTask *) task : simCurrent;
+    return t != NULL ? t->priority : 0;
+}
+
+/**
+ * Changes the priority of a task.
+ *
+ * @param task the task to change
+ * @param priority the new priority
+ */
+void simTaskSetPriority(void *task, unsigned int priority) {
+    SimTask *t = (task != NULL) ? (SimTask *) task : simCurrent;
+    if (t != NULL) {
+        t->priority = priority;
+    }
+}
+
+/**
+ * Returns the number of tasks that have not exited.
+ *
+ * @return the number of live tasks
+ */
+unsigned int simTaskCount() {
+    unsigned int count = 0;
+    for (int i = 0; i < SIM_MAX_TASKS; i++) {
+        if (simTasks[i].stack != NULL && simTasks[i].state != SIM_TASK_DEAD) {
+            count++;
+        }
+    }
+    return count;
+}
+
+/**
+ * Picks the next task to run: the highest priority task that is ready at the current time,
+ * preferring the task that has waited longest since it last ran. No task is ready during a stall.
+ *
+ * @return the task to run, or NULL if no task is ready
+ */
+SimTask* simPickTask() {
+    SimTask *best = NULL;
+    if (simNow < simStallEnd) {
+        return NULL;
+    }
+    for (int i = 0; i < SIM_MAX_TASKS; i++) {
+        SimTask *task = &simTasks[i];
+        if (task->stack == NULL || task->wake > simNow ||
+                (task->state != SIM_TASK_RUNNABLE && task->state != SIM_TASK_SLEEPING)) {
+            continue;
+        }
+        if (best == NULL || task->priority > best->priority ||
+                (task->priority == best->priority && task->lastRun < best->lastRun)) {
+            best = task;
+        }
+    }
+    return best;
+}
+
+/**
+ * Frees the stacks of tasks that have exited.
+ */
+void simReap() {
+    for (int i = 0; i < SIM_MAX_TASKS; i++) {
+        if (simTasks[i].stack != NULL && simTasks[i].state == SIM_TASK_DEAD) {
+            free(simTasks[i].stack);
+            simTasks[i].stack = NULL;
+        }
+    }
+}
+
+/**
+ * Runs a simulation until its main task returns.
+ *
+ * @param entry the main task
+ * @param param the parameter to pass to the main task
+ * @param step the function to call once per tick as time advances, or NULL
+ */
+void simRun(SimEntry entry, void *param, SimStep step) {
+    SimTask *root = (SimTask *) simSpawn(entry, param, 0);
+    if (root == NULL) {
+        return;
+    }
+    while (root->state != SIM_TASK_DEAD) {
+        SimTask *next = simPickTask();
+        if (next == NULL) {
+            simNow += SIM_TICK_US;
+            if (step != NULL) {
+                step(SIM_TICK_US / 1000000.0);
+            }
+            continue;
+        }
+        next->state = SIM_TASK_RUNNING;
+        next->lastRun = ++simSwitches;
+        simCurrent = next;
+        swapcontext(&simSchedulerContext, &next->context);
+        simCurrent = NULL;
+        simReap();
+    }
+    // Abandon every task the main task left behind
+    for (int i = 0; i < SIM_MAX_TASKS; i++) {
+        if (simTasks[i].stack != NULL) {
+            simTasks[i].state = SIM_TASK_DEAD;
+        }
+    }
+    simReap();
+}
+
+/**
+ * Runs a function in several worker processes at once, and collects the records they write back.
+ *
+ * @param worker the function to run in each worker process
+ * @param collect the function to pass each record to
+ * @param size the size of a record, in bytes
+ * @param param the parameter to pass to both functions
+ * @param jobs the number of worker processes
+ *
+ * @return the number of valid records collected, or -1 if a worker process could not be started
+ */
+int simParallel(SimWorker worker, SimCollect collect, size_t size, void *param, int jobs) {
+    int fds[SIM_MAX_JOBS];
+    pid_t pids[SIM_MAX_JOBS];
+    int started = 0;
+    bool failed = false;
+    while (started < jobs && started < SIM_MAX_JOBS) {
+        int ends[2];
+        if (pipe(ends) != 0) {
+            failed = true;
+            break;
+        }
+        pid_t pid = fork();
+        if (pid == -1) {
+            close(ends[0]);
+            close(ends[1]);
+            failed = true;
+            break;
+        }
+        if (pid == 0) {
+            close(ends[0]);
+            for (int i = 0; i < started; i++) {
+                close(fds[i]);
+            }
+            worker(started, ends[1], param);
+            _exit(0);
+        }
+        close(ends[1]);
+        fds[started] = ends[0];
+        pids[started] = pid;
+        started++;
+    }
+    // The workers that did start are still collected and waited for, so that none is left behind
+    int received = 0;
+    void *record = malloc(size);
+    for (int i = 0; i < started; i++) {
+        while (record != NULL && read(fds[i], record, size) == (ssize_t) size) {
+            if (collect(record, param)) {
+                received++;
+            }
+        }
+        close(fds[i]);
+        waitpid(pids[i], NULL, 0);
+    }
+    free(record);
+    return failed || record == NULL ? -1 : received;
+}
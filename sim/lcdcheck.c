@@ -0,0 +1,308 @@
+/** @file lcdcheck.c
+ * @brief File for the host simulator's check of the LCD text formatter
+ *
+ * Checks every widget in lcdformat.c against the text it should write. Numbers are also checked against
+ * the same numbers formatted with snprintf(), over a range of values, widths and decimals, so that the
+ * formatter's own digit generation is compared with the C library's.
+ *
+ * Each line is written into a buffer with guard characters on either side, so that a widget that writes
+ * outside the line fails its check.
+ *
+ * Usage: lcdcheck
+ * Prints a key=value line for each failed check and for each group of checks.
+ * The exit status is the number of groups with a failed check.
+ */
+
+#include "main.h"
+#include "sim.h"
+
+/**
+ * Defines the character the line buffer's guard characters are filled with.
+ */
+#define LCDCHECK_GUARD '~'
+
+/**
+ * Defines the number of guard characters on either side of the line buffer.
+ */
+#define LCDCHECK_GUARD_LENGTH 8
+
+/**
+ * Defines the number of failed checks printed for each group.
+ */
+#define LCDCHECK_MAX_REPORTS 5
+
+/**
+ * The line buffer, with guard characters on either side.
+ */
+char lcdcheckBuffer[LCDCHECK_GUARD_LENGTH + LCD_MESSAGE_MAX_LENGTH + 1 + LCDCHECK_GUARD_LENGTH];
+
+/**
+ * The line buffer the widgets write into.
+ */
+char *lcdcheckLine = lcdcheckBuffer + LCDCHECK_GUARD_LENGTH;
+
+/**
+ * The number of checks made in the current group.
+ */
+int lcdcheckChecks = 0;
+
+/**
+ * The number of checks that failed in the current group.
+ */
+int lcdcheckFailures = 0;
+
+/**
+ * Clears the line buffer and fills the guard characters, ready for a check.
+ */
+void lcdcheckStart() {
+    memset(lcdcheckBuffer, LCDCHECK_GUARD, sizeof(lcdcheckBuffer));
+    lcdLineClear(lcdcheckLine);
+}
+
+/**
+ * Compares the line buffer, and the column a widget returned, with what they should be.
+ *
+ * @param what a description of the check
+ * @param expected the text the line buffer should hold
+ * @param col the column the widget returned
+ * @param expectedCol the column the widget should have returned
+ */
+void lcdcheckExpect(const char *what, const char *expected, int col, int expectedCol) {
+    bool guarded = true;
+    for (int i = 0; i < LCDCHECK_GUARD_LENGTH; i++) {
+        guarded &= lcdcheckBuffer[i] == LCDCHECK_GUARD;
+        guarded &= lcdcheckLine[LCD_MESSAGE_MAX_LENGTH + 1 + i] == LCDCHECK_GUARD;
+    }
+    bool pass = guarded && lcdcheckLine[LCD_MESSAGE_MAX_LENGTH] == '\0' && strcmp(lcdcheckLine, expected) == 0 &&
+            col == expectedCol;
+    lcdcheckChecks++;
+    if (!pass && lcdcheckFailures++ < LCDCHECK_MAX_REPORTS) {
+        simReport("lcdcheck check=\"%s\" line=\"%.*s\" expected=\"%s\" col=%d expected_col=%d guarded=%d\n", what,
+                  LCD_MESSAGE_MAX_LENGTH, lcdcheckLine, expected, col, expectedCol, guarded);
+    }
+}
+
+/**
+ * Pads a string with spaces to the width of a line.
+ *
+ * @param text the string, which must fit in a line
+ * @param line the buffer to store the padded string in (at least LCD_MESSAGE_MAX_LENGTH+1 characters)
+ *
+ * @return the padded string
+ */
+const char* lcdcheckPad(const char *text, char *line) {
+    snprintf(line, LCD_MESSAGE_MAX_LENGTH + 1, "%-*s", LCD_MESSAGE_MAX_LENGTH, text);
+    return line;
+}
+
+/**
+ * Checks lcdLineClear(), lcdPutText() and lcdPutChar(), including text that runs past the end of the line.
+ */
+void lcdcheckText() {
+    char expected[LCD_MESSAGE_MAX_LENGTH + 1];
+    lcdcheckStart();
+    lcdcheckExpect("clear", "                ", 0, 0);
+
+    lcdcheckStart();
+    int col = lcdPutText(lcdcheckLine, 0, "Telemetry");
+    lcdcheckExpect("text", lcdcheckPad("Telemetry", expected), col, 9);
+
+    lcdcheckStart();
+    col = lcdPutText(lcdcheckLine, 12, "Battery");
+    lcdcheckExpect("text clipped at the end", "            Batt", col, LCD_MESSAGE_MAX_LENGTH);
+
+    lcdcheckStart();
+    col = lcdPutText(lcdcheckLine, LCD_MESSAGE_MAX_LENGTH, "Battery");
+    lcdcheckExpect("text past the end", "                ", col, LCD_MESSAGE_MAX_LENGTH);
+
+    lcdcheckStart();
+    col = lcdPutChar(lcdcheckLine, lcdPutChar(lcdcheckLine, 0, '<'), '>');
+    lcdcheckExpect("characters", lcdcheckPad("<>", expected), col, 2);
+
+    lcdcheckStart();
+    col = lcdPutChar(lcdcheckLine, LCD_MESSAGE_MAX_LENGTH, '>');
+    lcdcheckExpect("character past the end", "                ", col, LCD_MESSAGE_MAX_LENGTH + 1);
+}
+
+/**
+ * Checks lcdPutInt() against snprintf() for a range of values and field widths.
+ */
+void lcdcheckInt() {
+    static const int values[] = {0, 1, -1, 9, 10, -10, 42, 99, 100, 127, -127, 7050, 65535, -32768,
+                                 1234567, 2147483647, -2147483647 - 1};
+    char expected[LCD_MESSAGE_MAX_LENGTH + 1];
+    char text[32];
+    for (unsigned int i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        for (int width = 0; width <= 12; width++) {
+            int len = snprintf(text, sizeof(text), "%*d", width, values[i]);
+            lcdcheckStart();
+            int col = lcdPutInt(lcdcheckLine, 0, width, values[i]);
+            snprintf(expected, sizeof(expected), "%-*s", LCD_MESSAGE_MAX_LENGTH, text);
+            snprintf(text, sizeof(text), "int %d width %d", values[i], width);
+            lcdcheckExpect(text, expected, col, len);
+        }
+    }
+
+    // Right-aligned at the end of the line, as the live screens use it
+    lcdcheckStart();
+    int col = lcdPutInt(lcdcheckLine, lcdPutText(lcdcheckLine, 0, "Motor"), 11, -127);
+    lcdcheckExpect("int after text", "Motor       -127", col, LCD_MESSAGE_MAX_LENGTH);
+}
+
+/**
+ * Checks lcdPutFixed() against snprintf() for a range of values, field widths and decimals.
+ */
+void lcdcheckFixed() {
+    static const int values[] = {0, 5, -5, 50, 99, 100, -100, 785, -785, 7050, 12345, -12345, 1000000};
+    char expected[LCD_MESSAGE_MAX_LENGTH + 1];
+    char text[32];
+    for (unsigned int i = 0; i < sizeof(values) / sizeof(values[0]); i++) {
+        for (int decimals = 1; decimals <= 3; decimals++) {
+            for (int width = 0; width <= 10; width++) {
+                int scale = decimals == 1 ? 10 : decimals == 2 ? 100 : 1000;
+                int magnitude = abs(values[i]);
+                snprintf(text, sizeof(text), "%s%d.%0*d", values[i] < 0 ? "-" : "", magnitude / scale, decimals,
+                         magnitude % scale);
+                char field[32];
+                int len = snprintf(field, sizeof(field), "%*s", width, text);
+                lcdcheckStart();
+                int col = lcdPutFixed(lcdcheckLine, 0, width, values[i], decimals);
+                snprintf(expected, sizeof(expected), "%-*s", LCD_MESSAGE_MAX_LENGTH, field);
+                snprintf(text, sizeof(text), "fixed %d decimals %d width %d", values[i], decimals, width);
+                lcdcheckExpect(text, expected, col, len);
+            }
+        }
+    }
+}
+
+/**
+ * Checks lcdPutVoltage(), including rounding to the nearest hundredth of a volt.
+ */
+void lcdcheckVoltage() {
+    char expected[LCD_MESSAGE_MAX_LENGTH + 1];
+    lcdcheckStart();
+    int col = lcdPutVoltage(lcdcheckLine, 0, 0, 7050);
+    lcdcheckExpect("voltage with a zero after the point", lcdcheckPad("7.05V", expected), col, 5);
+
+    lcdcheckStart();
+    col = lcdPutVoltage(lcdcheckLine, 0, 0, 7856);
+    lcdcheckExpect("voltage rounded up", lcdcheckPad("7.86V", expected), col, 5);
+
+    lcdcheckStart();
+    col = lcdPutVoltage(lcdcheckLine, 0, 0, 994);
+    lcdcheckExpect("voltage below a volt", lcdcheckPad("0.99V", expected), col, 5);
+
+    lcdcheckStart();
+    col = lcdPutVoltage(lcdcheckLine, 0, 0, 0);
+    lcdcheckExpect("no voltage", lcdcheckPad("0.00V", expected), col, 5);
+
+    lcdcheckStart();
+    col = lcdPutVoltage(lcdcheckLine, lcdPutText(lcdcheckLine, 0, "Mn Batt:"), 8, 8412);
+    lcdcheckExpect("voltage right-aligned", "Mn Batt:   8.41V", col, LCD_MESSAGE_MAX_LENGTH);
+}
+
+/**
+ * Checks lcdPutBar(), including values outside its range.
+ */
+void lcdcheckBar() {
+    char expected[LCD_MESSAGE_MAX_LENGTH + 1];
+    lcdcheckStart();
+    int col = lcdPutBar(lcdcheckLine, 0, 8, 50, 100);
+    lcdcheckExpect("half bar", lcdcheckPad("####----", expected), col, 8);
+
+    lcdcheckStart();
+    col = lcdPutBar(lcdcheckLine, 0, 8, 7, 100);
+    lcdcheckExpect("bar rounded to the nearest character", lcdcheckPad("#-------", expected), col, 8);
+
+    lcdcheckStart();
+    col = lcdPutBar(lcdcheckLine, 0, 8, 250, 100);
+    lcdcheckExpect("bar above its range", lcdcheckPad("########", expected), col, 8);
+
+    lcdcheckStart();
+    col = lcdPutBar(lcdcheckLine, 0, 8, -20, 100);
+    lcdcheckExpect("bar below its range", lcdcheckPad("--------", expected), col, 8);
+
+    lcdcheckStart();
+    col = lcdPutBar(lcdcheckLine, 0, 8, 50, 0);
+    lcdcheckExpect("bar with no range", lcdcheckPad("--------", expected), col, 8);
+
+    lcdcheckStart();
+    col = lcdPutBar(lcdcheckLine, 10, 10, 100, 100);
+    lcdcheckExpect("bar clipped at the end", "          ######", col, 20);
+}
+
+/**
+ * Checks lcdPutCenter(), lcdCenterLine() and lcdPutSplit() against the strcat centering the menus used before them.
+ */
+void lcdcheckLayout() {
+    static const char *texts[] = {"", "A", "Telemetry", "Recorder Off", "J1: Disconnected", "Longer than one line"};
+    char expected[LCD_MESSAGE_MAX_LENGTH + 1];
+    for (unsigned int i = 0; i < sizeof(texts) / sizeof(texts[0]); i++) {
+        // The old menus put half the spare spaces before the text and clipped anything past the end of the line
+        int len = min((int) strlen(texts[i]), LCD_MESSAGE_MAX_LENGTH);
+        int spaces = (LCD_MESSAGE_MAX_LENGTH - len) / 2;
+        char centered[LCD_MESSAGE_MAX_LENGTH + 1];
+        snprintf(centered, sizeof(centered), "%*s%.*s", spaces, "", len, texts[i]);
+        lcdcheckStart();
+        lcdPutCenter(lcdcheckLine, texts[i]);
+        char what[40];
+        snprintf(what, sizeof(what), "center \"%s\"", texts[i]);
+        lcdcheckExpect(what, lcdcheckPad(centered, expected), 0, 0);
+    }
+
+    lcdcheckStart();
+    lcdCenterLine(lcdcheckLine, lcdPutInt(lcdcheckLine, lcdPutText(lcdcheckLine, 0, "Slot "), 0, 3));
+    lcdcheckExpect("center composed line", "     Slot 3     ", 0, 0);
+
+    lcdcheckStart();
+    lcdPutSplit(lcdcheckLine, "Lo", "7.05V");
+    lcdcheckExpect("split", "Lo         7.05V", 0, 0);
+
+    lcdcheckStart();
+    lcdPutSplit(lcdcheckLine, "Battery Lowest", "7.05V");
+    lcdcheckExpect("split with overlapping fields", "Battery Low7.05V", 0, 0);
+
+    lcdcheckStart();
+    lcdPutSplit(lcdcheckLine, "Lo", "Longer than one line");
+    lcdcheckExpect("split with a field longer than the line", "Longer than one ", 0, 0);
+}
+
+/**
+ * @brief A group of checks.
+ */
+typedef struct LcdcheckGroup {
+    /**
+     * The name of the group, as printed in its results.
+     */
+    const char *name;
+
+    /**
+     * Runs the group's checks.
+     */
+    void (*run)();
+} LcdcheckGroup;
+
+/**
+ * The groups of checks, in the order they are run.
+ */
+const LcdcheckGroup lcdcheckGroups[] = {
+    {"text", lcdcheckText},
+    {"int", lcdcheckInt},
+    {"fixed", lcdcheckFixed},
+    {"voltage", lcdcheckVoltage},
+    {"bar", lcdcheckBar},
+    {"layout", lcdcheckLayout},
+};
+
+int main(int argc, char **argv) {
+    int failures = 0;
+    for (unsigned int i = 0; i < sizeof(lcdcheckGroups) / sizeof(lcdcheckGroups[0]); i++) {
+        lcdcheckChecks = 0;
+        lcdcheckFailures = 0;
+        lcdcheckGroups[i].run();
+        simReport("lcdcheck group=%s checks=%d failures=%d result=%s\n", lcdcheckGroups[i].name, lcdcheckChecks,
+                  lcdcheckFailures, lcdcheckFailures == 0 ? "pass" : "fail");
+        failures += lcdcheckFailures != 0;
+    }
+    return failures;
+}
@@ -0,0 +1,606 @@
+/** @file montecarlo.c
+ * @brief File for the host simulator's Monte-Carlo robustness analysis of recorded autonomous routines
+ *
+ * Plays recorded autonomous routines back through playbackAuton() many times, each time on a slightly different
+ * robot and field: the battery voltage, the strength of each drive side, the wheels' traction on the tiles,
+ * the friction resisting the robot and the pose the robot is placed at are all drawn at random around their
+ * nominal values. A recording only replays the driver's joystick, so nothing corrects for these differences,
+ * and the spread of the poses the robot ends up at shows how much a routine relies on the field it was recorded on.
+ *
+ * Run 0 of each routine is played back on the nominal robot, and its end pose is the target the other runs
+ * are compared with, unless a target is given. A run succeeds if it ends within a distance and an angle of
+ * the target. Each run draws its perturbations from a plant noise seed given by its run number, so every routine is played back on the
+ * same robots and routines can be compared on equal terms.
+ *
+ * As in tune.c, the runs are shared out between a pool of worker processes, one per core by default,
+ * each running its own simulator and sending the end poses back over a pipe. The robot code's tasks keep some
+ * state from one run to the next, so the results can differ in the last digit with the number of workers.
+ *
+ * Usage: montecarlo [-j jobs] [-n runs] [-k scale] [-t inches] [-a degrees] [-g x,y,heading] [-o file] recording...
+ *     recording       a routine saved to flash by saveAuton() and copied to the host, named as on the robot:
+ *                     a1 to a10 for an autonomous slot, or p0 for programming skills, with p1 to p3 beside it
+ *     -j jobs         the number of worker processes (default: the number of cores)
+ *     -n runs         the number of perturbed runs of each routine (default MONTE_RUNS)
+ *     -k scale        scales the spread of every perturbation (default 1)
+ *     -t inches       the largest distance from the target that counts as a success (default MONTE_POSITION_TOLERANCE)
+ *     -a degrees      the largest heading error that counts as a success (default MONTE_HEADING_TOLERANCE)
+ *     -g x,y,heading  the target pose, in inches and degrees (default: the nominal run's end pose)
+ *     -o file         writes every run's perturbations and end pose to a CSV file
+ * The distribution of each routine's end poses and its success rate are printed as key=value lines,
+ * followed by the routine with the best success rate.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "main.h"
+#include "sim.h"
+#include "plant.h"
+
+// Not declared by API.h, which replaces the standard I/O header, but provided by the host C library
+int vsnprintf(char *buffer, size_t limit, const char *formatString, va_list args);
+
+/**
+ * Defines the default number of perturbed runs of each routine.
+ */
+#define MONTE_RUNS 200
+
+/**
+ * Defines the largest number of routines analysed at once.
+ */
+#define MONTE_MAX_ROUTINES 16
+
+/**
+ * Defines the number of files in a programming skills recording.
+ */
+#define MONTE_SECTIONS (PROGSKILL_TIME / AUTON_TIME)
+
+/**
+ * Defines the length of the routine name saved at the start of an autonomous slot's file, in bytes.
+ */
+#define MONTE_NAME_LENGTH (LCD_MESSAGE_MAX_LENGTH + 1)
+
+/**
+ * Defines the length of the joystick states of one recording file, in bytes.
+ */
+#define MONTE_STATES_LENGTH (AUTON_TIME * JOY_POLL_FREQ * 8)
+
+/**
+ * Defines how long the robot is left at rest before each run, in milliseconds.
+ * Lets the robot code's battery and sensor filters settle on the new robot, so that runs do not depend on the one before.
+ */
+#define MONTE_REST_TIME 1000
+
+/**
+ * Defines the standard deviation of the charged battery voltage, in millivolts.
+ */
+#define MONTE_BATTERY_SD 250
+
+/**
+ * Defines the lowest charged battery voltage drawn, in millivolts. Teams swap out batteries below this.
+ */
+#define MONTE_BATTERY_MIN 7000
+
+/**
+ * Defines the standard deviation of the strength of each drive side.
+ */
+#define MONTE_STRENGTH_SD 0.05
+
+/**
+ * Defines the standard deviation of the wheels' traction, as a fraction of the nominal traction.
+ */
+#define MONTE_TRACTION_SD 0.1
+
+/**
+ * Defines the standard deviation of the friction resisting the robot, as a fraction of the nominal friction.
+ */
+#define MONTE_FRICTION_SD 0.25
+
+/**
+ * Defines the standard deviation of the starting position along each axis, in inches.
+ */
+#define MONTE_POSITION_SD 0.5
+
+/**
+ * Defines the standard deviation of the starting heading, in degrees.
+ */
+#define MONTE_HEADING_SD 1.5
+
+/**
+ * Defines the default largest distance from the target that counts as a success, in inches.
+ */
+#define MONTE_POSITION_TOLERANCE 6.0
+
+/**
+ * Defines the default largest heading error that counts as a success, in degrees.
+ */
+#define MONTE_HEADING_TOLERANCE 10.0
+
+/**
+ * @brief A recorded autonomous routine.
+ */
+typedef struct MonteRoutine {
+    /**
+     * The file name of the recording, which is also its name in the robot's flash.
+     */
+    char name[AUTON_FILENAME_MAX_LENGTH];
+
+    /**
+     * The autonomous slot number of the recording, or MAX_AUTON_SLOTS + 1 for programming skills.
+     */
+    int slot;
+
+    /**
+     * Whether the routine is a programming skills recording, played back from all of its sections.
+     */
+    bool skills;
+
+    /**
+     * The joystick states of each section of the recording, without the routine name. Autonomous slots have one section.
+     */
+    unsigned char states[MONTE_SECTIONS][MONTE_STATES_LENGTH];
+} MonteRoutine;
+
+/**
+ * @brief The conditions and outcome of one run, sent from a worker process.
+ */
+typedef struct MonteRun {
+    /**
+     * The index of the routine.
+     */
+    int routine;
+
+    /**
+     * The run number; 0 is the nominal run.
+     */
+    int run;
+
+    /**
+     * The properties of the robot.
+     */
+    PlantConfig config;
+
+    /**
+     * The starting pose: X and Y in inches, and heading in degrees.
+     */
+    double start[3];
+
+    /**
+     * The end pose: X and Y in inches, and heading in degrees.
+     */
+    double end[3];
+} MonteRun;
+
+/**
+ * The routines being analysed.
+ */
+MonteRoutine *monteRoutines;
+
+/**
+ * The number of routines being analysed.
+ */
+int monteRoutineCount = 0;
+
+/**
+ * The number of perturbed runs of each routine.
+ */
+int monteRuns = MONTE_RUNS;
+
+/**
+ * The number of worker processes.
+ */
+int monteJobs = 1;
+
+/**
+ * The scale of the spread of every perturbation.
+ */
+double monteScale = 1.0;
+
+/**
+ * Reads a whole host file.
+ *
+ * @param path the path of the file
+ * @param buffer the buffer to read into, which must hold one byte more than limit
+ * @param limit the size of the largest file accepted, in bytes
+ *
+ * @return the number of bytes read, or -1 if the file could not be read or is larger than the limit
+ */
+long monteReadFile(const char *path, unsigned char *buffer, size_t limit) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return -1;
+    }
+    size_t size = 0;
+    ssize_t count;
+    while (size <= limit && (count = read(fd, buffer + size, limit + 1 - size)) > 0) {
+        size += count;
+    }
+    close(fd);
+    return size > limit ? -1 : (long) size;
+}
+
+/**
+ * Reads a recording and, for programming skills, the other sections beside it.
+ *
+ * @param path the path of the recording
+ * @param routine the routine to fill
+ *
+ * @return true if every file of the recording was read
+ */
+bool monteLoad(const char *path, MonteRoutine *routine) {
+    const char *name = strrchr(path, '/');
+    name = (name == NULL) ? path : name + 1;
+    memset(routine, 0, sizeof(*routine));
+    char *end;
+    routine->skills = strcmp(name, "p0") == 0;
+    routine->slot = routine->skills ? MAX_AUTON_SLOTS + 1 : (int) strtol(name + 1, &end, 10);
+    if (!routine->skills && (name[0] != 'a' || *end != '\0' || routine->slot < 1 || routine->slot > MAX_AUTON_SLOTS)) {
+        simReport("montecarlo error=\"%s is not named a1-a%d or p0\"\n", path, MAX_AUTON_SLOTS);
+        return false;
+    }
+    strcpy(routine->name, name);
+    // An autonomous slot's file starts with the routine name; programming skills sections do not
+    unsigned char file[MONTE_NAME_LENGTH + MONTE_STATES_LENGTH + 1];
+    int sections = routine->skills ? MONTE_SECTIONS : 1;
+    size_t header = routine->skills ? 0 : MONTE_NAME_LENGTH;
+    for (int section = 0; section < sections; section++) {
+        char sectionPath[1024];
+        snprintf(sectionPath, sizeof(sectionPath), "%.*sp%d", (int) (name - path), path, section);
+        const char *filePath = routine->skills ? sectionPath : path;
+        long size = monteReadFile(filePath, file, header + MONTE_STATES_LENGTH);
+        if (size < (long) header) {
+            simReport("montecarlo error=\"cannot read %s as a recording\"\n", filePath);
+            return false;
+        }
+        // Like loadAuton(), a short file leaves the remaining states at rest
+        memcpy(routine->states[section], file + header, size - header);
+    }
+    return true;
+}
+
+/**
+ * Copies one section of a routine into the joystick states array, as loadAuton() would.
+ *
+ * @param data the section's joystick states
+ */
+void monteLoadStates(const unsigned char *data) {
+    for (int i = 0; i < AUTON_TIME * JOY_POLL_FREQ; i++) {
+        const signed char *read = (const signed char *) &data[i * 8];
+        states[i].spd = read[0];
+        states[i].turn = read[1];
+        states[i].sht = read[2];
+        states[i].intk = read[3];
+        states[i].strafe = read[4];
+        states[i].ang = read[5];
+        states[i].liftL = read[6];
+        states[i].liftR = read[7];
+    }
+}
+
+/**
+ * Writes the later sections of a programming skills routine to the simulated flash, where playbackAuton() reads them.
+ *
+ * @param routine the routine
+ */
+void monteWriteSections(const MonteRoutine *routine) {
+    for (int section = 1; section < MONTE_SECTIONS; section++) {
+        char filename[AUTON_FILENAME_MAX_LENGTH];
+        snprintf(filename, sizeof(filename), "p%d", section);
+        FILE *file = fopen(filename, "w");
+        fwrite(routine->states[section], 1, MONTE_STATES_LENGTH, file);
+        fclose(file);
+    }
+}
+
+/**
+ * Draws the robot and starting pose of a run from the plant's noise generator.
+ * Run 0 is the nominal robot at the nominal starting pose.
+ *
+ * @param run the run number, used as the noise seed
+ * @param config a pointer to store the robot's properties in
+ * @param start a pointer to store the starting pose in
+ */
+void montePerturb(int run, PlantConfig *config, double start[3]) {
+    plantDefaults(config);
+    config->seed = run + 1;
+    start[0] = ROBOT_START_POSITION_X;
+    start[1] = ROBOT_START_POSITION_Y;
+    start[2] = ROBOT_START_ANGLE;
+    if (run == 0) {
+        return;
+    }
+    // Seeding the generator through plantReset() makes the draws depend only on the run number
+    plantReset(config, start[0], start[1], start[2]);
+    double k = monteScale;
+    config->batteryMv = max(config->batteryMv + k * MONTE_BATTERY_SD * plantGaussian(), MONTE_BATTERY_MIN);
+    for (int i = 0; i < PLANT_SIDES; i++) {
+        config->strength[i] = constrain(1.0 + k * MONTE_STRENGTH_SD * plantGaussian(), 0.5, 1.5);
+    }
+    config->traction *= constrain(1.0 + k * MONTE_TRACTION_SD * plantGaussian(), 0.25, 2.0);
+    config->friction *= constrain(1.0 + k * MONTE_FRICTION_SD * plantGaussian(), 0.0, 3.0);
+    start[0] += k * MONTE_POSITION_SD * plantGaussian();
+    start[1] += k * MONTE_POSITION_SD * plantGaussian();
+    start[2] += k * MONTE_HEADING_SD * plantGaussian();
+}
+
+/**
+ * Plays a routine back once on a perturbed robot.
+ *
+ * @param index the index of the routine
+ * @param result a pointer to store the conditions and end pose in
+ */
+void monteRun(int index, MonteRun *result) {
+    const MonteRoutine *routine = &monteRoutines[index];
+    result->routine = index;
+    montePerturb(result->run, &result->config, result->start);
+    plantReset(&result->config, result->start[0], result->start[1], result->start[2]);
+    // Starting on a whole rest period keeps the playback in step with the robot code's other tasks in every worker
+    delay(2 * MONTE_REST_TIME - millis() % MONTE_REST_TIME);
+    // Programming skills playback reads the later sections into the states array as it goes
+    monteLoadStates(routine->states[0]);
+    autonLoaded = routine->slot;
+    playbackAuton();
+    result->end[0] = plant.x;
+    result->end[1] = plant.y;
+    result->end[2] = degrees(plant.heading);
+}
+
+/**
+ * Runs a worker's share of the runs and writes their results to a pipe.
+ * Worker n plays back every run whose number leaves a remainder of n when divided by the number of jobs.
+ *
+ * @param param the worker number and the pipe, as an array of two ints
+ */
+void monteWorker(void *param) {
+    int worker = ((int *) param)[0];
+    int fd = ((int *) param)[1];
+    initialize();
+    for (int index = 0; index < monteRoutineCount; index++) {
+        if (monteRoutines[index].skills) {
+            monteWriteSections(&monteRoutines[index]);
+        }
+        for (int run = worker; run <= monteRuns; run += monteJobs) {
+            MonteRun result;
+            memset(&result, 0, sizeof(result));
+            result.run = run;
+            monteRun(index, &result);
+            if (write(fd, &result, sizeof(result)) != sizeof(result)) {
+                return;
+            }
+        }
+    }
+}
+
+/**
+ * Runs a worker process, which plays back its share of the runs on a fresh simulation.
+ *
+ * @param worker the worker number
+ * @param fd the pipe to write the results to
+ * @param ignore does nothing - required by simParallel()
+ */
+void monteProcess(int worker, int fd, void *ignore) {
+    int param[2] = {worker, fd};
+    PlantConfig config;
+    plantDefaults(&config);
+    plantReset(&config, ROBOT_START_POSITION_X, ROBOT_START_POSITION_Y, ROBOT_START_ANGLE);
+    simRun(monteWorker, param, plantStep);
+}
+
+/**
+ * Stores a run's result from a worker process.
+ *
+ * @param record the MonteRun
+ * @param runs the results, indexed by routine then run number
+ *
+ * @return true if the result is for a run of a routine
+ */
+bool monteCollect(const void *record, void *runs) {
+    const MonteRun *result = (const MonteRun *) record;
+    if (result->routine < 0 || result->routine >= monteRoutineCount || result->run < 0 || result->run > monteRuns) {
+        return false;
+    }
+    ((MonteRun *) runs)[result->routine * (monteRuns + 1) + result->run] = *result;
+    return true;
+}
+
+/**
+ * Plays back every run of every routine on the worker processes.
+ *
+ * @param runs the results, indexed by routine then run number
+ *
+ * @return true if every run was played back
+ */
+bool monteRunAll(MonteRun *runs) {
+    return simParallel(monteProcess, monteCollect, sizeof(MonteRun), runs, monteJobs) == monteRoutineCount * (monteRuns + 1);
+}
+
+/**
+ * Returns the difference between two headings.
+ *
+ * @param heading the heading, in degrees
+ * @param target the heading it is compared with, in degrees
+ *
+ * @return the angle from the target to the heading, counterclockwise, in degrees, in the range (-180, 180]
+ */
+double monteHeadingError(double heading, double target) {
+    double error = fmod(heading - target, ROTATION_DEG);
+    if (error > ROTATION_DEG / 2) {
+        error -= ROTATION_DEG;
+    } else if (error <= -ROTATION_DEG / 2) {
+        error += ROTATION_DEG;
+    }
+    return error;
+}
+
+/**
+ * Orders two doubles for qsort().
+ *
+ * @param a the first double
+ * @param b the second double
+ *
+ * @return a negative number, zero or a positive number if a is less than, equal to or greater than b
+ */
+int monteCompare(const void *a, const void *b) {
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Prints the distribution of a quantity over a routine's perturbed runs.
+ *
+ * @param routine the routine's name
+ * @param stat the name of the quantity
+ * @param values the quantity in each run; sorted in place
+ * @param count the number of runs
+ */
+void monteReportStat(const char *routine, const char *stat, double *values, int count) {
+    double sum = 0;
+    for (int i = 0; i < count; i++) {
+        sum += values[i];
+    }
+    double mean = sum / count;
+    double squares = 0;
+    for (int i = 0; i < count; i++) {
+        squares += sq(values[i] - mean);
+    }
+    qsort(values, count, sizeof(double), monteCompare);
+    simReport("montecarlo routine=%s stat=%s mean=%.2f sd=%.2f min=%.2f p5=%.2f p50=%.2f p95=%.2f max=%.2f\n",
+              routine, stat, mean, sqrt(squares / count), values[0], values[(int) round(0.05 * (count - 1))],
+              values[(int) round(0.5 * (count - 1))], values[(int) round(0.95 * (count - 1))], values[count - 1]);
+}
+
+/**
+ * Writes a line to a host file.
+ *
+ * @param fd the file to write to
+ * @param format the printf format string
+ */
+void monteWriteLine(int fd, const char *format, ...) {
+    char buffer[512];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    length = min(length, (int) sizeof(buffer) - 1);
+    if (write(fd, buffer, length) != length) {
+        simReport("montecarlo error=\"cannot write run file\"\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    double positionTolerance = MONTE_POSITION_TOLERANCE;
+    double headingTolerance = MONTE_HEADING_TOLERANCE;
+    bool targeted = false;
+    double target[3] = {0, 0, 0};
+    const char *output = NULL;
+    const char *paths[MONTE_MAX_ROUTINES];
+    int pathCount = 0;
+    monteJobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    bool usage = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            monteJobs = (int) strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-n") == 0 && i + 1 < argc) {
+            monteRuns = (int) strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-k") == 0 && i + 1 < argc) {
+            monteScale = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            positionTolerance = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "-a") == 0 && i + 1 < argc) {
+            headingTolerance = strtod(argv[++i], NULL);
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            char *cell = argv[++i];
+            for (int j = 0; j < 3; j++) {
+                target[j] = strtod(cell, &cell);
+                usage |= (j < 2) ? (*cell++ != ',') : (*cell != '\0');
+            }
+            targeted = true;
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else if (argv[i][0] != '-' && pathCount < MONTE_MAX_ROUTINES) {
+            paths[pathCount++] = argv[i];
+        } else {
+            usage = true;
+        }
+    }
+    if (usage || pathCount == 0 || monteRuns < 1 || monteScale < 0) {
+        simReport("usage: montecarlo [-j jobs] [-n runs] [-k scale] [-t inches] [-a degrees] [-g x,y,heading] [-o file] recording...\n");
+        return 2;
+    }
+    monteJobs = constrain(monteJobs, 1, SIM_MAX_JOBS);
+    monteRoutines = malloc(sizeof(MonteRoutine) * pathCount);
+    for (int i = 0; i < pathCount; i++) {
+        if (!monteLoad(paths[i], &monteRoutines[monteRoutineCount++])) {
+            return 1;
+        }
+    }
+    int fd = -1;
+    if (output != NULL && (fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+        simReport("montecarlo error=\"cannot open %s\"\n", output);
+        return 1;
+    }
+
+    MonteRun *runs = malloc(sizeof(MonteRun) * monteRoutineCount * (monteRuns + 1));
+    if (!monteRunAll(runs)) {
+        simReport("montecarlo error=\"a worker failed\"\n");
+        return 1;
+    }
+    if (fd >= 0) {
+        monteWriteLine(fd, "routine,run,battery_mv,strength_left,strength_right,strength_strafe,traction,friction,"
+                           "start_x,start_y,start_heading,end_x,end_y,end_heading,success\n");
+    }
+    double *values = malloc(sizeof(double) * monteRuns);
+    int best = 0;
+    double bestRate = -1;
+    for (int index = 0; index < monteRoutineCount; index++) {
+        const char *name = monteRoutines[index].name;
+        const MonteRun *routineRuns = &runs[index * (monteRuns + 1)];
+        const double *goal = targeted ? target : routineRuns[0].end;
+        simReport("montecarlo routine=%s nominal_x=%.2f nominal_y=%.2f nominal_heading=%.2f target_x=%.2f target_y=%.2f target_heading=%.2f\n",
+                  name, routineRuns[0].end[0], routineRuns[0].end[1], routineRuns[0].end[2], goal[0], goal[1], goal[2]);
+        int successes = 0;
+        for (int run = 0; run <= monteRuns; run++) {
+            const MonteRun *r = &routineRuns[run];
+            bool success = sqrt(sq(r->end[0] - goal[0]) + sq(r->end[1] - goal[1])) <= positionTolerance &&
+                           abs(monteHeadingError(r->end[2], goal[2])) <= headingTolerance;
+            if (run > 0 && success) {
+                successes++;
+            }
+            if (fd >= 0) {
+                monteWriteLine(fd, "%s,%d,%.0f,%.3f,%.3f,%.3f,%.3f,%.3f,%.2f,%.2f,%.2f,%.2f,%.2f,%.2f,%d\n", name, run,
+                               r->config.batteryMv, r->config.strength[PLANT_LEFT], r->config.strength[PLANT_RIGHT],
+                               r->config.strength[PLANT_STRAFE], r->config.traction, r->config.friction, r->start[0],
+                               r->start[1], r->start[2], r->end[0], r->end[1], r->end[2], success);
+            }
+        }
+        // The distributions only cover the perturbed runs
+        for (int axis = 0; axis < 2; axis++) {
+            for (int run = 1; run <= monteRuns; run++) {
+                values[run - 1] = routineRuns[run].end[axis];
+            }
+            monteReportStat(name, axis == 0 ? "x_in" : "y_in", values, monteRuns);
+        }
+        for (int run = 1; run <= monteRuns; run++) {
+            values[run - 1] = monteHeadingError(routineRuns[run].end[2], goal[2]);
+        }
+        monteReportStat(name, "heading_error_deg", values, monteRuns);
+        for (int run = 1; run <= monteRuns; run++) {
+            values[run - 1] = sqrt(sq(routineRuns[run].end[0] - goal[0]) + sq(routineRuns[run].end[1] - goal[1]));
+        }
+        monteReportStat(name, "position_error_in", values, monteRuns);
+        double rate = (double) successes / monteRuns;
+        simReport("montecarlo routine=%s runs=%d successes=%d success_rate=%.3f\n", name, monteRuns, successes, rate);
+        if (rate > bestRate) {
+            best = index;
+            bestRate = rate;
+        }
+    }
+    simReport("montecarlo result=best routine=%s success_rate=%.3f\n", monteRoutines[best].name, bestRate);
+    if (fd >= 0) {
+        close(fd);
+    }
+    free(values);
+    free(runs);
+    free(monteRoutines);
+    return 0;
+}
@@ -0,0 +1,266 @@
+/** @file plant.c
+ * @brief File for the host simulator's drivetrain physics model
+ *
+ * The model is integrated with a fixed time step in SI units, while the robot's pose is kept in
+ * the field's units (inches) so that it can be compared directly with the field positioning system.
+ * The wheels are assumed not to slip relative to the robot's body, so the encoders measure the
+ * body's motion exactly up to their resolution; traction only limits the force the wheels can apply.
+ *
+ * @see plant.h
+ */
+
+#include "main.h"
+#include "sim.h"
+#include "plant.h"
+
+/**
+ * Defines the number of meters in one inch.
+ */
+#define METERS_PER_INCH 0.0254
+
+/**
+ * Defines the acceleration due to gravity, in meters per second squared.
+ */
+#define GRAVITY 9.81
+
+/**
+ * The properties of the simulated robot.
+ */
+PlantConfig plantConfig;
+
+/**
+ * The state of the simulated robot.
+ */
+PlantState plant;
+
+/**
+ * State of the plant's noise generator.
+ */
+unsigned long long plantNoiseState = 1;
+
+/**
+ * Fills a configuration with the properties of a nominal robot.
+ *
+ * @param config the configuration to fill
+ */
+void plantDefaults(PlantConfig *config) {
+    for (int i = 0; i < PLANT_SIDES; i++) {
+        config->strength[i] = 1.0;
+    }
+    config->batteryMv = PLANT_BATTERY_MV;
+    config->traction = PLANT_TRACTION;
+    config->friction = 1.0;
+    config->gyroNoise = PLANT_GYRO_NOISE;
+    config->gyroBias = PLANT_GYRO_BIAS;
+    config->sonarNoise = PLANT_SONAR_NOISE;
+    config->seed = 1;
+}
+
+/**
+ * Resets the simulated robot to rest at a pose on the field.
+ *
+ * @param config the properties of the robot, or NULL to keep the current properties
+ * @param x the X-coordinate of the robot's center, in inches
+ * @param y the Y-coordinate of the robot's center, in inches
+ * @param heading the robot's heading, in degrees
+ */
+void plantReset(const PlantConfig *config, double x, double y, double heading) {
+    if (config != NULL) {
+        plantConfig = *config;
+        // A zero state would make the generator return zero forever
+        plantNoiseState = config->seed != 0 ? config->seed : 1;
+    }
+    plant.x = x;
+    plant.y = y;
+    plant.heading = radians(heading);
+    plant.forward = 0;
+    plant.lateral = 0;
+    plant.yawRate = 0;
+    plant.batteryMv = plantConfig.batteryMv;
+    plant.current = 0;
+}
+
+/**
+ * Returns a uniformly distributed random number from the plant's noise generator (xorshift64*).
+ *
+ * @return a random number in the range (0, 1)
+ */
+double plantUniform() {
+    plantNoiseState ^= plantNoiseState >> 12;
+    plantNoiseState ^= plantNoiseState << 25;
+    plantNoiseState ^= plantNoiseState >> 27;
+    unsigned long long bits = (plantNoiseState * 2685821657736338717ULL) >> 11;
+    return (bits + 0.5) / 9007199254740992.0;
+}
+
+/**
+ * Returns the angle the simulated robot has turned counterclockwise since a starting heading.
+ *
+ * @param start the starting heading, in radians
+ *
+ * @return the angle turned, in degrees, in the range (-180, 180]
+ */
+double plantTurnedSince(double start) {
+    double turned = fmod(degrees(plant.heading - start), ROTATION_DEG);
+    if (turned > ROTATION_DEG / 2) {
+        turned -= ROTATION_DEG;
+    } else if (turned <= -ROTATION_DEG / 2) {
+        turned += ROTATION_DEG;
+    }
+    return turned;
+}
+
+/**
+ * Returns a normally distributed random number from the plant's noise generator (Box-Muller).
+ *
+ * @return a random number with a mean of 0 and a standard deviation of 1
+ */
+double plantGaussian() {
+    double u = plantUniform();
+    double v = plantUniform();
+    return sqrt(-2 * log(u)) * cos(TWO_PI * v);
+}
+
+/**
+ * Returns the torque produced by a 393 motor.
+ * The motor controller is modelled as an ideal chopper, so the motor sees the battery voltage
+ * scaled by the commanded value, and coasts inside the deadband.
+ *
+ * @param command the commanded motor value
+ * @param speed the motor's shaft speed, in radians per second
+ * @param strength the fraction of the voltage that the motor turns into work
+ *
+ * @return the shaft torque, in newton meters
+ */
+double motorTorque(int command, double speed, double strength) {
+    if (abs(command) < PLANT_MOTOR_DEADBAND) {
+        return 0;
+    }
+    double volts = strength * plant.batteryMv * constrain(command, MOTOR_MIN, MOTOR_MAX) / (double) MOTOR_MAX;
+    return PLANT_MOTOR_STALL_TORQUE * (volts / PLANT_MOTOR_RATED_MV - speed / PLANT_MOTOR_FREE_SPEED);
+}
+
+/**
+ * Applies a force to a velocity, opposed by Coulomb friction.
+ * A body at rest stays at rest until the force overcomes the friction, and friction alone never reverses a body.
+ *
+ * @param velocity the velocity before the step
+ * @param force the applied force (or torque)
+ * @param friction the magnitude of the friction force (or torque)
+ * @param mass the mass (or moment of inertia) of the body
+ * @param dt the length of the time step, in seconds
+ *
+ * @return the velocity after the step
+ */
+double applyFriction(double velocity, double force, double friction, double mass, double dt) {
+    if (velocity == 0 && abs(force) <= friction) {
+        return 0;
+    }
+    double direction = (velocity != 0) ? sign(velocity) : sign(force);
+    double next = velocity + (force - direction * friction) / mass * dt;
+    if (velocity != 0 && next * velocity < 0 && abs(force) <= friction) {
+        return 0;
+    }
+    return next;
+}
+
+/**
+ * Advances the simulated robot by one time step using the commanded motor values.
+ *
+ * @param dt the length of the time step, in seconds
+ */
+void plantStep(double dt) {
+    double radius = DRIVE_DIA / 2.0 * METERS_PER_INCH;
+    double halfTrack = DRIVE_WHEELBASE / 2.0 * METERS_PER_INCH;
+    double inertia = PLANT_MASS * (sq(PLANT_LENGTH * METERS_PER_INCH) + sq(DRIVE_WHEELBASE * METERS_PER_INCH)) / 12;
+    double u = plant.forward * METERS_PER_INCH;
+    double v = plant.lateral * METERS_PER_INCH;
+    double w = plant.yawRate;
+
+    // Ground speed of each wheel set in the direction its motor drives it
+    double wheel[PLANT_SIDES] = {u - w * halfTrack, u + w * halfTrack, -v};
+    int command[PLANT_SIDES] = {simMotors[LEFT_MOTOR], simMotors[RIGHT_MOTOR], simMotors[STRAFE_MOTOR]};
+    int motors[PLANT_SIDES] = {PLANT_MOTORS_PER_SIDE, PLANT_MOTORS_PER_SIDE, 1};
+    // The strafe wheel carries less weight than either drive side
+    double grip[PLANT_SIDES] = {plantConfig.traction * PLANT_MASS * GRAVITY / 2,
+                                plantConfig.traction * PLANT_MASS * GRAVITY / 2,
+                                plantConfig.traction * PLANT_MASS * GRAVITY / 4};
+    double force[PLANT_SIDES];
+    double current = 0;
+    for (int i = 0; i < PLANT_SIDES; i++) {
+        double torque = motorTorque(command[i], wheel[i] / radius / DRIVE_GEARRATIO, plantConfig.strength[i]);
+        current += motors[i] * PLANT_MOTOR_STALL_CURRENT * abs(torque) / PLANT_MOTOR_STALL_TORQUE;
+        force[i] = constrain(motors[i] * torque / DRIVE_GEARRATIO / radius, -grip[i], grip[i]);
+    }
+    plant.current = current;
+    plant.batteryMv = plantConfig.batteryMv - current * PLANT_BATTERY_RESISTANCE * 1000;
+
+    u = applyFriction(u, force[PLANT_LEFT] + force[PLANT_RIGHT], plantConfig.friction * PLANT_ROLLING_FRICTION, PLANT_MASS, dt);
+    v = applyFriction(v, -force[PLANT_STRAFE], plantConfig.friction * PLANT_LATERAL_FRICTION, PLANT_MASS, dt);
+    w = applyFriction(w, (force[PLANT_RIGHT] - force[PLANT_LEFT]) * halfTrack, plantConfig.friction * PLANT_TURN_FRICTION, inertia, dt);
+    plant.forward = u / METERS_PER_INCH;
+    plant.lateral = v / METERS_PER_INCH;
+    plant.yawRate = w;
+
+    // Move along the mean heading over the step
+    double dtheta = w * dt;
+    double mean = plant.heading + dtheta / 2;
+    plant.x += (plant.forward * cos(mean) - plant.lateral * sin(mean)) * dt;
+    plant.y += (plant.forward * sin(mean) + plant.lateral * cos(mean)) * dt;
+    plant.heading = fmod(plant.heading + dtheta + ROTATION_RAD, ROTATION_RAD);
+
+    plant.travel[PLANT_LEFT] += (plant.forward - w * DRIVE_WHEELBASE / 2.0) * dt;
+    plant.travel[PLANT_RIGHT] += (plant.forward + w * DRIVE_WHEELBASE / 2.0) * dt;
+    plant.travel[PLANT_STRAFE] += plant.lateral * dt;
+    plant.gyroAngle += (degrees(w) + plantConfig.gyroBias) * dt + plantConfig.gyroNoise * sqrt(dt) * plantGaussian();
+}
+
+/**
+ * Returns the count of the simulated encoder on the given port.
+ *
+ * @param port the top port the encoder was initialized on
+ *
+ * @return the encoder count, in ticks
+ */
+int plantEncoder(unsigned char port) {
+    int side;
+    if (port == (unsigned char) LEFT_ENC_TOP) {
+        side = PLANT_LEFT;
+    } else if (port == (unsigned char) RIGHT_ENC_TOP) {
+        side = PLANT_RIGHT;
+    } else if (port == (unsigned char) HORIZONTAL_ENC_TOP) {
+        side = PLANT_STRAFE;
+    } else {
+        return 0;
+    }
+    return (int) floor(plant.travel[side] / INCHES_PER_ENC_TICK);
+}
+
+/**
+ * Returns the reading of the simulated ultrasonic sensor.
+ * The sensor is SONAR_OFFSET inches ahead of the robot's center and ranges along the robot's heading.
+ *
+ * @return the range to the field wall ahead, in centimeters, or 0 if no echo was received
+ */
+int plantUltrasonic() {
+    if (plant.replay) {
+        return plant.sonar;
+    }
+    double c = cos(plant.heading);
+    double s = sin(plant.heading);
+    double sx = plant.x + SONAR_OFFSET * c;
+    double sy = plant.y + SONAR_OFFSET * s;
+    double xRange = (c > 0) ? (FIELD_LENGTH - sx) / c : (c < 0) ? -sx / c : HUGE_VAL;
+    double yRange = (s > 0) ? (FIELD_LENGTH - sy) / s : (s < 0) ? -sy / s : HUGE_VAL;
+    double range = min(xRange, yRange);
+    // The echo comes back from the wall the ray hits first, at the angle between the ray and that wall's normal
+    double incidence = degrees(acos(xRange < yRange ? abs(c) : abs(s)));
+    if (range < 0 || incidence > PLANT_SONAR_MAX_INCIDENCE) {
+        return 0;
+    }
+    double cm = range * CM_PER_INCH + plantConfig.sonarNoise * plantGaussian();
+    if (cm < WALLRANGE_MIN_CM || cm > WALLRANGE_MAX_CM) {
+        return 0;
+    }
+    return (int) round(cm);
+}
@@ -0,0 +1,315 @@
+/** @file plant.h
+ * @brief File for the host simulator's drivetrain physics model
+ *
+ * The plant models the drivetrain as a rigid body on the field, driven by 393 motors through a
+ * differential drive with a strafe wheel. Each tick, the commanded motor values are turned into
+ * voltages, the motor torque/speed curves into wheel forces, and the forces into motion.
+ * The simulated sensors are then derived from the motion: quantized encoder counts, a drifting
+ * and noisy gyroscope, and an ultrasonic sensor ranging against the field walls.
+ *
+ * Sign conventions match the robot code's control loops: a positive drive motor value moves its
+ * side of the robot forward, a positive strafe motor value moves the robot to its right, the
+ * drive encoders count up moving forward and the gyroscope counts up turning counterclockwise.
+ *
+ * @see plant.c
+ */
+
+#ifndef PLANT_H_
+#define PLANT_H_
+
+/**
+ * Defines the stall torque of a 393 motor with the standard gearing, in newton meters.
+ */
+#define PLANT_MOTOR_STALL_TORQUE 1.67
+
+/**
+ * Defines the free speed of a 393 motor with the standard gearing, in radians per second (100 RPM).
+ */
+#define PLANT_MOTOR_FREE_SPEED 10.47
+
+/**
+ * Defines the stall current of a 393 motor, in amps.
+ */
+#define PLANT_MOTOR_STALL_CURRENT 4.8
+
+/**
+ * Defines the battery voltage at which the stall torque and free speed are rated, in millivolts.
+ */
+#define PLANT_MOTOR_RATED_MV 7200
+
+/**
+ * Defines the motor value below which the motor controller produces no output.
+ */
+#define PLANT_MOTOR_DEADBAND 10
+
+/**
+ * Defines the number of motors driven by each drive side's motor port, through a Y-cable.
+ */
+#define PLANT_MOTORS_PER_SIDE 2
+
+/**
+ * Defines the mass of the robot, in kilograms.
+ */
+#define PLANT_MASS 6.5
+
+/**
+ * Defines the length of the robot's frame, used to estimate its moment of inertia, in inches.
+ */
+#define PLANT_LENGTH 16
+
+/**
+ * Defines the nominal coefficient of friction between the drive wheels and the field tiles.
+ * The force each side can apply is limited by its share of the robot's weight times this.
+ */
+#define PLANT_TRACTION 0.9
+
+/**
+ * Defines the rolling resistance resisting forward motion, in newtons.
+ */
+#define PLANT_ROLLING_FRICTION 4.0
+
+/**
+ * Defines the resistance of the drive wheels' rollers to sideways motion, in newtons.
+ */
+#define PLANT_LATERAL_FRICTION 6.0
+
+/**
+ * Defines the scrubbing resistance resisting rotation, in newton meters.
+ */
+#define PLANT_TURN_FRICTION 0.8
+
+/**
+ * Defines the internal resistance of the main battery, in ohms.
+ */
+#define PLANT_BATTERY_RESISTANCE 0.05
+
+/**
+ * Defines the charged voltage of the main battery, in millivolts.
+ */
+#define PLANT_BATTERY_MV 7800
+
+/**
+ * Defines the white noise of the gyroscope rate, in degrees per square root second.
+ */
+#define PLANT_GYRO_NOISE 0.15
+
+/**
+ * Defines the bias drift of the gyroscope after calibration, in degrees per second.
+ */
+#define PLANT_GYRO_BIAS 0.02
+
+/**
+ * Defines the standard deviation of the ultrasonic sensor's readings, in centimeters.
+ */
+#define PLANT_SONAR_NOISE 1.0
+
+/**
+ * Defines the steepest angle to a wall at which the ultrasonic sensor still receives an echo, in degrees.
+ */
+#define PLANT_SONAR_MAX_INCIDENCE 20
+
+/**
+ * Drive side ID number of the left side of the drivetrain.
+ */
+#define PLANT_LEFT 0
+
+/**
+ * Drive side ID number of the right side of the drivetrain.
+ */
+#define PLANT_RIGHT 1
+
+/**
+ * Drive side ID number of the strafe wheel.
+ */
+#define PLANT_STRAFE 2
+
+/**
+ * The number of driven wheel sets in the plant.
+ */
+#define PLANT_SIDES 3
+
+/**
+ * @brief Adjustable properties of the simulated robot.
+ *
+ * Scenarios change these to check that the control loops cope with an imperfect robot.
+ */
+typedef struct PlantConfig {
+    /**
+     * Fraction of the nominal motor voltage turned into work by each side, indexed by side ID number.
+     * Values below 1 model worn motors or a dragging gearbox, making the side both weaker and slower.
+     */
+    double strength[PLANT_SIDES];
+
+    /**
+     * Charged voltage of the main battery, in millivolts.
+     */
+    double batteryMv;
+
+    /**
+     * Coefficient of friction between the drive wheels and the field tiles.
+     */
+    double traction;
+
+    /**
+     * Multiplier of the rolling, lateral and turning friction. Values above 1 model worn or grippy tiles,
+     * or dragging wheels, that slow the robot down more than the nominal robot.
+     */
+    double friction;
+
+    /**
+     * Gyroscope rate white noise, in degrees per square root second.
+     */
+    double gyroNoise;
+
+    /**
+     * Gyroscope bias drift, in degrees per second.
+     */
+    double gyroBias;
+
+    /**
+     * Standard deviation of the ultrasonic readings, in centimeters.
+     */
+    double sonarNoise;
+
+    /**
+     * Seed of the noise generator, so that noisy runs are repeatable.
+     */
+    unsigned long long seed;
+} PlantConfig;
+
+/**
+ * @brief State of the simulated robot.
+ */
+typedef struct PlantState {
+    /**
+     * X-coordinate of the robot's center on the field, in inches.
+     */
+    double x;
+
+    /**
+     * Y-coordinate of the robot's center on the field, in inches.
+     */
+    double y;
+
+    /**
+     * Heading of the robot on the field, counterclockwise from the positive X axis, in radians.
+     */
+    double heading;
+
+    /**
+     * Forward velocity of the robot, in inches per second.
+     */
+    double forward;
+
+    /**
+     * Leftward velocity of the robot, in inches per second.
+     */
+    double lateral;
+
+    /**
+     * Counterclockwise rotation rate of the robot, in radians per second.
+     */
+    double yawRate;
+
+    /**
+     * Distance travelled by each wheel set, indexed by side ID number, in inches.
+     * The strafe wheel's distance increases moving left.
+     */
+    double travel[PLANT_SIDES];
+
+    /**
+     * Angle reported by the gyroscope, including drift and noise, in degrees.
+     */
+    double gyroAngle;
+
+    /**
+     * Voltage of the main battery under the present load, in millivolts.
+     */
+    double batteryMv;
+
+    /**
+     * Total current drawn by the drive motors, in amps.
+     */
+    double current;
+
+    /**
+     * Whether the plant is being driven by a recorded log instead of its physics.
+     * While set, plantStep() should not be called, and the sensors report the travel, gyroAngle,
+     * batteryMv and sonar set by the replay.
+     */
+    bool replay;
+
+    /**
+     * Range reported by the ultrasonic sensor during a replay, in centimeters, or 0 for no echo.
+     */
+    int sonar;
+} PlantState;
+
+/**
+ * The properties of the simulated robot.
+ */
+extern PlantConfig plantConfig;
+
+/**
+ * The state of the simulated robot.
+ */
+extern PlantState plant;
+
+/**
+ * Fills a configuration with the properties of a nominal robot.
+ *
+ * @param config the configuration to fill
+ */
+void plantDefaults(PlantConfig *config);
+
+/**
+ * Resets the simulated robot to rest at a pose on the field with the given properties.
+ * Sensor readings continue from their current values, as they would if the robot were picked up and moved.
+ *
+ * @param config the properties of the robot, or NULL to keep the current properties
+ * @param x the X-coordinate of the robot's center, in inches
+ * @param y the Y-coordinate of the robot's center, in inches
+ * @param heading the robot's heading, in degrees
+ */
+void plantReset(const PlantConfig *config, double x, double y, double heading);
+
+/**
+ * Advances the simulated robot by one time step using the commanded motor values.
+ *
+ * @param dt the length of the time step, in seconds
+ */
+void plantStep(double dt);
+
+/**
+ * Returns the count of the simulated encoder on the given port.
+ *
+ * @param port the top port the encoder was initialized on
+ *
+ * @return the encoder count, in ticks
+ */
+int plantEncoder(unsigned char port);
+
+/**
+ * Returns the reading of the simulated ultrasonic sensor.
+ *
+ * @return the range to the field wall ahead, in centimeters, or 0 if no echo was received
+ */
+int plantUltrasonic();
+
+/**
+ * Returns the angle the simulated robot has turned counterclockwise since a starting heading.
+ *
+ * @param start the starting heading, in radians
+ *
+ * @return the angle turned, in degrees, in the range (-180, 180]
+ */
+double plantTurnedSince(double start);
+
+/**
+ * Returns a normally distributed random number from the plant's noise generator.
+ *
+ * @return a random number with a mean of 0 and a standard deviation of 1
+ */
+double plantGaussian();
+
+#endif
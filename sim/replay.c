@@ -0,0 +1,439 @@
+/** @file replay.c
+ * @brief File for the host simulator's replay of recorded logs
+ *
+ * Replays a log recorded on the robot through the robot code's operator control loop, and compares
+ * the motor outputs it produces with the ones the robot commanded when the log was recorded.
+ * The log is the CSV written by bbdecode from a black box dump, or any CSV with the same column headings.
+ *
+ * The plant's physics are switched off. Instead, each frame's joystick, competition mode, battery and
+ * ultrasonic readings are held until the next frame, while the encoder and gyroscope readings are
+ * interpolated between frames so that the sensor task's field positioning sees smooth motion.
+ * As on the robot, operatorControl() is started whenever the log enters driver control, and stopped with
+ * the motors when it leaves. The recorder, field positioning and every other task run as they do on the robot.
+ *
+ * Each driver control frame is compared one operator control period after its inputs are applied, once the
+ * loop has had a chance to act on them. Joystick channels and buttons that the black box does not record,
+ * such as those of the partner joystick, read as released.
+ *
+ * Usage: replay [-v] [-t tolerance] log.csv
+ *     -v            echo the robot code's console output and LCD
+ *     -t tolerance  the largest difference between a recorded and a replayed motor value that is not
+ *                   counted as a mismatch (default REPLAY_TOLERANCE)
+ * The exit status is 1 if any frame mismatched, so that a log of a fixed bug can be kept as a regression test.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "main.h"
+#include "sim.h"
+#include "plant.h"
+
+/**
+ * Defines the default largest difference between a recorded and a replayed motor value that is not a mismatch.
+ * The robot's loop read the joystick up to one period before the black box did, so a stick that is moving
+ * quickly gives slightly different outputs; battery compensation adds a little more.
+ */
+#define REPLAY_TOLERANCE 5
+
+/**
+ * Defines the time between applying a frame's inputs and comparing the motor outputs, in milliseconds.
+ * Matches the operator control loop period.
+ */
+#define REPLAY_SETTLE 20
+
+/**
+ * Defines the largest gap between frames that is treated as continuous recording, in milliseconds.
+ * Across a longer gap, the black box discarded idle blocks, so the joystick is released.
+ */
+#define REPLAY_MAX_GAP (BLACKBOX_PERIOD * 2)
+
+/**
+ * Defines the number of individual mismatches printed before only the totals are kept.
+ */
+#define REPLAY_MAX_REPORTS 20
+
+/**
+ * Defines the number of named columns read from a log.
+ */
+#define REPLAY_COLUMNS 24
+
+/**
+ * The column headings read from a log, in the order their values are stored by replayParseFrame().
+ * A heading ending in '?' is optional.
+ */
+const char *replayHeadings[REPLAY_COLUMNS] = {
+    "time_ms", "enabled?", "autonomous?", "online?", "joy1", "joy2", "joy3", "joy4", "buttons",
+    "motor1", "motor2", "motor3", "motor4", "motor5", "motor6", "motor7", "motor8", "motor9", "motor10",
+    "enc_left", "enc_right", "enc_horizontal", "gyro_deg", "sonar_cm?"
+};
+
+/**
+ * The recorded frames.
+ */
+BlackBoxFrame *replayFrames;
+
+/**
+ * The number of recorded frames.
+ */
+int replayFrameCount = 0;
+
+/**
+ * Whether the log has a battery column. Without it, the plant's battery voltage is left as configured.
+ */
+bool replayHasBattery = false;
+
+/**
+ * The index of the frame whose inputs are being applied.
+ */
+int replayCurrent = -1;
+
+/**
+ * The simulated time at which the first frame is applied, in microseconds.
+ */
+unsigned long long replayStart = 0;
+
+/**
+ * The largest difference between a recorded and a replayed motor value that is not a mismatch.
+ */
+int replayTolerance = REPLAY_TOLERANCE;
+
+/**
+ * The number of frames that mismatched.
+ */
+int replayMismatches = 0;
+
+/**
+ * Returns the simulated time at which a frame is applied.
+ *
+ * @param frame the frame index
+ *
+ * @return the time, in microseconds
+ */
+unsigned long long replayFrameTime(int frame) {
+    return replayStart + (unsigned long long) (replayFrames[frame].time - replayFrames[0].time) * 1000;
+}
+
+/**
+ * Finds the index of a column in a log's heading line.
+ *
+ * @param headings the heading line
+ * @param name the column heading to find
+ *
+ * @return the index of the column, or -1 if it is not in the log
+ */
+int replayFindColumn(const char *headings, const char *name) {
+    size_t length = strlen(name);
+    int column = 0;
+    const char *cell = headings;
+    while (true) {
+        size_t cellLength = strcspn(cell, ",");
+        if (cellLength == length && strncmp(cell, name, length) == 0) {
+            return column;
+        }
+        if (cell[cellLength] != ',') {
+            return -1;
+        }
+        cell += cellLength + 1;
+        column++;
+    }
+}
+
+/**
+ * Parses one row of a log into a frame.
+ *
+ * @param line the row
+ * @param columns the column index of each of replayHeadings, or -1 for a missing optional column
+ * @param battery the column index of the battery voltage, or -1
+ * @param frame the frame to fill
+ *
+ * @return true if every column was present
+ */
+bool replayParseFrame(const char *line, const int columns[REPLAY_COLUMNS], int battery, BlackBoxFrame *frame) {
+    long values[64];
+    int count = 0;
+    const char *cell = line;
+    while (count < 64) {
+        values[count++] = strtol(cell, NULL, 0);
+        cell += strcspn(cell, ",");
+        if (*cell != ',') {
+            break;
+        }
+        cell++;
+    }
+    for (int i = 0; i < REPLAY_COLUMNS; i++) {
+        if (columns[i] >= count) {
+            return false;
+        }
+    }
+    if (battery >= count) {
+        return false;
+    }
+    // Optional columns default to a robot in driver control with no ultrasonic echo
+    long v[REPLAY_COLUMNS];
+    for (int i = 0; i < REPLAY_COLUMNS; i++) {
+        v[i] = columns[i] >= 0 ? values[columns[i]] : (i == 1 ? 1 : 0);
+    }
+    memset(frame, 0, sizeof(*frame));
+    frame->time = v[0];
+    frame->mode = (v[1] ? BLACKBOX_ENABLED : 0) | (v[2] ? BLACKBOX_AUTONOMOUS : 0) | (v[3] ? BLACKBOX_ONLINE : 0);
+    for (int i = 0; i < 4; i++) {
+        frame->joystick[i] = v[4 + i];
+    }
+    frame->buttons = v[8];
+    for (int i = 0; i < 10; i++) {
+        frame->motors[i] = v[9 + i];
+    }
+    for (int i = 0; i < 3; i++) {
+        frame->encoders[i] = v[19 + i];
+    }
+    frame->gyro = v[22];
+    frame->sonar = v[23];
+    frame->battery = battery >= 0 ? values[battery] : 0;
+    return true;
+}
+
+/**
+ * Reads a log from a host file.
+ *
+ * @param path the path of the log
+ *
+ * @return true if the log was read and holds at least one frame
+ */
+bool replayLoad(const char *path) {
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        simReport("replay error=\"cannot open %s\"\n", path);
+        return false;
+    }
+    size_t size = 0;
+    size_t capacity = 65536;
+    char *text = (char *) malloc(capacity + 1);
+    ssize_t count;
+    while ((count = read(fd, text + size, capacity - size)) > 0) {
+        size += count;
+        if (size == capacity) {
+            capacity *= 2;
+            text = (char *) realloc(text, capacity + 1);
+        }
+    }
+    close(fd);
+    text[size] = '\0';
+
+    int columns[REPLAY_COLUMNS];
+    int battery = -1;
+    int capacityFrames = 1024;
+    replayFrames = (BlackBoxFrame *) malloc(sizeof(BlackBoxFrame) * capacityFrames);
+    bool headed = false;
+    char *line = text;
+    while (*line != '\0') {
+        char *next = line + strcspn(line, "\r\n");
+        bool last = (*next == '\0');
+        *next = '\0';
+        if (!headed) {
+            headed = true;
+            for (int i = 0; i < REPLAY_COLUMNS; i++) {
+                char name[32];
+                strncpy(name, replayHeadings[i], sizeof(name) - 1);
+                name[sizeof(name) - 1] = '\0';
+                bool optional = name[strlen(name) - 1] == '?';
+                if (optional) {
+                    name[strlen(name) - 1] = '\0';
+                }
+                columns[i] = replayFindColumn(line, name);
+                if (columns[i] < 0 && !optional) {
+                    simReport("replay error=\"%s has no %s column\"\n", path, name);
+                    free(text);
+                    return false;
+                }
+            }
+            battery = replayFindColumn(line, "battery_mv");
+            replayHasBattery = battery >= 0;
+        } else if (*line != '\0') {
+            if (replayFrameCount == capacityFrames) {
+                capacityFrames *= 2;
+                replayFrames = (BlackBoxFrame *) realloc(replayFrames, sizeof(BlackBoxFrame) * capacityFrames);
+            }
+            if (replayParseFrame(line, columns, battery, &replayFrames[replayFrameCount])) {
+                replayFrameCount++;
+            }
+        }
+        if (last) {
+            break;
+        }
+        line = next + 1;
+        line += strspn(line, "\r\n");
+    }
+    free(text);
+    if (replayFrameCount == 0) {
+        simReport("replay error=\"%s has no frames\"\n", path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Sets the plant's encoder and gyroscope readings between the current frame and the next.
+ * Called once per tick as simulated time advances.
+ *
+ * @param dt the length of the time step, in seconds
+ */
+void replayStep(double dt) {
+    if (replayCurrent < 0) {
+        return;
+    }
+    const BlackBoxFrame *from = &replayFrames[replayCurrent];
+    const BlackBoxFrame *to = from;
+    double fraction = 0;
+    if (replayCurrent + 1 < replayFrameCount && to->time + REPLAY_MAX_GAP >= replayFrames[replayCurrent + 1].time) {
+        to = &replayFrames[replayCurrent + 1];
+        unsigned long long start = replayFrameTime(replayCurrent);
+        fraction = (double) (simTime() - start) / (replayFrameTime(replayCurrent + 1) - start);
+        fraction = constrain(fraction, 0.0, 1.0);
+    }
+    for (int i = 0; i < PLANT_SIDES; i++) {
+        double ticks = from->encoders[i] + (to->encoders[i] - from->encoders[i]) * fraction;
+        // Half a tick keeps the plant's rounding down from losing a count
+        plant.travel[i] = (floor(ticks) + 0.5) * INCHES_PER_ENC_TICK;
+    }
+    plant.gyroAngle = simGyroZero + round(from->gyro + (to->gyro - from->gyro) * fraction);
+}
+
+/**
+ * Applies a frame's joystick, competition mode, battery and ultrasonic readings.
+ *
+ * @param frame the frame
+ */
+void replayApplyInputs(const BlackBoxFrame *frame) {
+    for (int i = 0; i < 4; i++) {
+        simJoyAnalog[0][i + 1] = frame->joystick[i];
+    }
+    for (int group = 5; group <= 8; group++) {
+        simJoyDigital[0][group] = (frame->buttons >> ((group - 5) * 4)) & 0xF;
+    }
+    simEnabled = (frame->mode & BLACKBOX_ENABLED) != 0;
+    simAutonomous = (frame->mode & BLACKBOX_AUTONOMOUS) != 0;
+    simOnline = (frame->mode & BLACKBOX_ONLINE) != 0;
+    if (replayHasBattery) {
+        plant.batteryMv = frame->battery;
+    }
+    plant.sonar = frame->sonar;
+}
+
+/**
+ * Releases every joystick axis and button.
+ */
+void replayReleaseJoystick() {
+    memset(simJoyAnalog, 0, sizeof(simJoyAnalog));
+    memset(simJoyDigital, 0, sizeof(simJoyDigital));
+}
+
+/**
+ * Runs the operator control loop, as the PROS kernel does when the robot enters driver control.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void replayOperatorControl(void *ignore) {
+    operatorControl();
+}
+
+/**
+ * Compares the motor outputs with a frame's recorded outputs, printing any mismatch.
+ *
+ * @param frame the frame
+ * @param maxError the largest difference seen so far, updated by this call
+ */
+void replayCompare(const BlackBoxFrame *frame, int *maxError) {
+    bool mismatched = false;
+    for (int port = 1; port <= 10; port++) {
+        int replayed = motorGet(port);
+        int error = abs(replayed - frame->motors[port - 1]);
+        *maxError = max(*maxError, error);
+        if (error > replayTolerance) {
+            if (replayMismatches < REPLAY_MAX_REPORTS) {
+                simReport("mismatch time_ms=%lu port=%d recorded=%d replayed=%d\n",
+                          (unsigned long) frame->time, port, frame->motors[port - 1], replayed);
+            }
+            mismatched = true;
+        }
+    }
+    if (mismatched) {
+        replayMismatches++;
+    }
+}
+
+/**
+ * Runs the robot's initialization, then replays every frame of the log.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void runReplay(void *ignore) {
+    // Start the encoders at the first frame's counts, so that the robot code's accumulators start from there
+    for (int i = 0; i < PLANT_SIDES; i++) {
+        plant.travel[i] = (replayFrames[0].encoders[i] + 0.5) * INCHES_PER_ENC_TICK;
+    }
+    initialize();
+    TaskHandle driver = NULL;
+    int compared = 0;
+    int maxError = 0;
+    replayStart = simTime();
+    for (int i = 0; i < replayFrameCount; i++) {
+        const BlackBoxFrame *frame = &replayFrames[i];
+        simSleepUntil(replayFrameTime(i));
+        replayCurrent = i;
+        replayApplyInputs(frame);
+        bool driving = (frame->mode & BLACKBOX_ENABLED) && !(frame->mode & BLACKBOX_AUTONOMOUS);
+        if (driving && driver == NULL) {
+            driver = taskCreate(replayOperatorControl, TASK_DEFAULT_STACK_SIZE, NULL, TASK_PRIORITY_DEFAULT);
+        } else if (!driving && driver != NULL) {
+            taskDelete(driver);
+            driver = NULL;
+            motorStopAll();
+        }
+        if (!driving) {
+            continue;
+        }
+        unsigned long long compare = simTime() + REPLAY_SETTLE * 1000ULL;
+        if (i + 1 < replayFrameCount) {
+            compare = min(compare, replayFrameTime(i + 1));
+        }
+        simSleepUntil(compare);
+        replayCompare(frame, &maxError);
+        compared++;
+        if (i + 1 < replayFrameCount && frame->time + REPLAY_MAX_GAP < replayFrames[i + 1].time) {
+            // The robot was idle across the gap, so nothing was held on the joystick
+            replayReleaseJoystick();
+        }
+    }
+    if (driver != NULL) {
+        taskDelete(driver);
+    }
+    simReport("replay frames=%d compared=%d mismatched=%d max_error=%d x_in=%.2f y_in=%.2f heading_deg=%.0f result=%s\n",
+              replayFrameCount, compared, replayMismatches, maxError, position.x, position.y,
+              degrees(fieldHeading()), replayMismatches == 0 ? "pass" : "fail");
+}
+
+int main(int argc, char **argv) {
+    const char *path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            simEcho = true;
+        } else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            replayTolerance = atoi(argv[++i]);
+        } else {
+            path = argv[i];
+        }
+    }
+    if (path == NULL) {
+        simReport("usage: replay [-v] [-t tolerance] log.csv\n");
+        return 2;
+    }
+    if (!replayLoad(path)) {
+        return 2;
+    }
+    PlantConfig config;
+    plantDefaults(&config);
+    plantReset(&config, ROBOT_START_POSITION_X, ROBOT_START_POSITION_Y, ROBOT_START_ANGLE);
+    plant.replay = true;
+    simRun(runReplay, NULL, replayStep);
+    return replayMismatches != 0;
+}
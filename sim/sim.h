@@ -0,0 +1,312 @@
+/** @file sim.h
+ * @brief File for the host simulator's kernel and API stand-in controls
+ *
+ * The host simulator builds the robot code in src/ for the development machine instead of the Cortex.
+ * The PROS API is replaced by a stand-in (simapi.c) whose motors and sensors are connected to a
+ * physics model of the drivetrain (plant.c), and whose tasks are run as coroutines by a small
+ * deterministic scheduler (kernel.c) on simulated time.
+ *
+ * Simulated time only advances when every task is waiting, so a run is repeatable and is not
+ * affected by the speed of the host. The plant is stepped once per SIM_TICK_US as time advances.
+ *
+ * This header does not include API.h, since kernel.c must include host system headers that
+ * conflict with the PROS declarations of the standard library.
+ *
+ * @see kernel.c
+ * @see simapi.c
+ */
+
+#ifndef SIM_H_
+#define SIM_H_
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/**
+ * Defines the simulation time step, in microseconds.
+ * The plant is stepped once per tick, and tasks wake on tick boundaries.
+ */
+#define SIM_TICK_US 1000
+
+/**
+ * Defines the maximum number of simulated tasks that can exist at once.
+ */
+#define SIM_MAX_TASKS 24
+
+/**
+ * Defines the largest number of worker processes simParallel() runs.
+ */
+#define SIM_MAX_JOBS 64
+
+/**
+ * Defines the stack size given to each simulated task, in bytes.
+ * Host code uses far more stack than the Cortex, so the requested stack depth is not used.
+ */
+#define SIM_STACK_SIZE (256 * 1024)
+
+/**
+ * Task state of a task that has exited or been deleted. Matches TASK_DEAD.
+ */
+#define SIM_TASK_DEAD 0
+
+/**
+ * Task state of the task that is currently executing. Matches TASK_RUNNING.
+ */
+#define SIM_TASK_RUNNING 1
+
+/**
+ * Task state of a task that is ready to run. Matches TASK_RUNNABLE.
+ */
+#define SIM_TASK_RUNNABLE 2
+
+/**
+ * Task state of a task that is waiting for a wake time. Matches TASK_SLEEPING.
+ */
+#define SIM_TASK_SLEEPING 3
+
+/**
+ * Task state of a task that has been suspended. Matches TASK_SUSPENDED.
+ */
+#define SIM_TASK_SUSPENDED 4
+
+/**
+ * Defines the number of motor ports on the Cortex.
+ */
+#define SIM_MOTOR_PORTS 10
+
+/**
+ * Defines the number of joysticks the stand-in reports.
+ */
+#define SIM_JOYSTICKS 2
+
+/**
+ * Entry point of a simulated task.
+ */
+typedef void (*SimEntry)(void *param);
+
+/**
+ * Function called once per tick as simulated time advances.
+ *
+ * @param dt the length of the tick, in seconds
+ */
+typedef void (*SimStep)(double dt);
+
+/**
+ * Function run in each worker process of simParallel(), which writes its results to a pipe as fixed-size records.
+ *
+ * @param worker the worker number, from 0 to one less than the number of workers
+ * @param fd the write end of the pipe to the parent process
+ * @param param the parameter passed to simParallel()
+ */
+typedef void (*SimWorker)(int worker, int fd, void *param);
+
+/**
+ * Function called in the parent process of simParallel() with each record a worker wrote.
+ *
+ * @param record the record
+ * @param param the parameter passed to simParallel()
+ *
+ * @return true if the record was valid
+ */
+typedef bool (*SimCollect)(const void *record, void *param);
+
+/**
+ * Creates a simulated task, which will first run when the current task next waits.
+ *
+ * @param entry the function to run
+ * @param param the parameter to pass to the function
+ * @param priority the task priority; higher priority tasks run first when several are ready
+ *
+ * @return a handle to the task, or NULL if there are too many tasks
+ */
+void* simSpawn(SimEntry entry, void *param, unsigned int priority);
+
+/**
+ * Returns the handle of the task that is currently executing.
+ *
+ * @return the current task, or NULL if called from outside the simulation
+ */
+void* simSelf();
+
+/**
+ * Suspends the current task until simulated time reaches the wake time.
+ * A wake time in the past lets other ready tasks run before the current task continues.
+ *
+ * @param wake the time to wake at, in microseconds
+ */
+void simSleepUntil(unsigned long long wake);
+
+/**
+ * Stalls every task, as the Cortex does while it programs flash.
+ * Simulated time keeps advancing and the plant keeps moving, but no task runs until the stall ends.
+ *
+ * @param us the length of the stall, in microseconds
+ */
+void simStall(unsigned long long us);
+
+/**
+ * Returns the current simulated time.
+ *
+ * @return the simulated time since the start of the run, in microseconds
+ */
+unsigned long long simTime();
+
+/**
+ * Suspends a task until it is resumed. Suspending the current task switches to another task immediately.
+ *
+ * @param task the task to suspend
+ */
+void simSuspend(void *task);
+
+/**
+ * Resumes a suspended task.
+ *
+ * @param task the task to resume
+ */
+void simResume(void *task);
+
+/**
+ * Deletes a task. Deleting the current task does not return.
+ *
+ * @param task the task to delete
+ */
+void simKill(void *task);
+
+/**
+ * Returns the state of a task.
+ *
+ * @param task the task to query
+ *
+ * @return one of the SIM_TASK_* states
+ */
+int simTaskState(void *task);
+
+/**
+ * Returns the priority of a task.
+ *
+ * @param task the task to query
+ *
+ * @return the task priority
+ */
+unsigned int simTaskPriority(void *task);
+
+/**
+ * Changes the priority of a task.
+ *
+ * @param task the task to change
+ * @param priority the new priority
+ */
+void simTaskSetPriority(void *task, unsigned int priority);
+
+/**
+ * Returns the number of tasks that have not exited.
+ *
+ * @return the number of live tasks
+ */
+unsigned int simTaskCount();
+
+/**
+ * Runs a simulation until its main task returns.
+ * Tasks created by the main task are abandoned when it returns.
+ *
+ * @param entry the main task
+ * @param param the parameter to pass to the main task
+ * @param step the function to call once per tick as time advances, or NULL
+ */
+void simRun(SimEntry entry, void *param, SimStep step);
+
+/**
+ * Runs a function in several worker processes at once, and collects the records they write back.
+ * Each worker is a fork of the calling process, so it starts with a copy of the caller's globals.
+ *
+ * @param worker the function to run in each worker process
+ * @param collect the function to pass each record to
+ * @param size the size of a record, in bytes; at most PIPE_BUF, so that each record is written in one piece
+ * @param param the parameter to pass to both functions
+ * @param jobs the number of worker processes, at most SIM_MAX_JOBS
+ *
+ * @return the number of valid records collected, or -1 if a worker process could not be started
+ */
+int simParallel(SimWorker worker, SimCollect collect, size_t size, void *param, int jobs);
+
+/**
+ * The commanded value of each motor port, indexed by port number. Read by the plant.
+ */
+extern int simMotors[SIM_MOTOR_PORTS + 1];
+
+/**
+ * The value reported for each joystick axis, indexed by joystick (0 or 1) then axis number.
+ */
+extern int simJoyAnalog[SIM_JOYSTICKS][7];
+
+/**
+ * The buttons reported as pressed in each joystick button group, indexed by joystick (0 or 1)
+ * then group number, as a mask of JOY_DOWN, JOY_LEFT, JOY_UP and JOY_RIGHT.
+ */
+extern unsigned char simJoyDigital[SIM_JOYSTICKS][9];
+
+/**
+ * The value reported for each analog port, indexed by port number.
+ * The power expander status port instead reports the plant's battery voltage.
+ */
+extern int simAnalog[9];
+
+/**
+ * Mask of the digital ports that read LOW, bit n being port n. Every other port reads HIGH, like an open switch.
+ */
+extern unsigned long simDigitalLow;
+
+/**
+ * The LCD buttons reported as pressed, as a mask of LCD_BTN_LEFT, LCD_BTN_CENTER and LCD_BTN_RIGHT.
+ */
+extern unsigned int simLcdButtons;
+
+/**
+ * The text shown on each line of the simulated LCD.
+ */
+extern char simLcdText[2][17];
+
+/**
+ * The plant's gyroscope angle when the simulated gyroscope was last reset, in degrees.
+ */
+extern double simGyroZero;
+
+/**
+ * Whether the stand-in reports a field or competition switch connection.
+ */
+extern bool simOnline;
+
+/**
+ * Whether the stand-in reports the robot as enabled.
+ */
+extern bool simEnabled;
+
+/**
+ * Whether the stand-in reports the robot as being in autonomous mode.
+ */
+extern bool simAutonomous;
+
+/**
+ * Whether the robot code's console output and LCD updates are echoed to the host's standard output.
+ */
+extern bool simEcho;
+
+/**
+ * Host file descriptors that the output of UART 1 and UART 2 is written to, or -1 to discard it.
+ */
+extern int simUartFd[2];
+
+/**
+ * Called with every RTTTL song the robot code plays, or NULL to ignore them.
+ * The speaker itself is silent and takes no simulated time.
+ */
+extern void (*simSpeakerHook)(const char *song);
+
+/**
+ * Writes a line of simulator output to the host's standard output, regardless of simEcho.
+ *
+ * @param format the printf format string
+ */
+void simReport(const char *format, ...);
+
+#endif
@@ -0,0 +1,945 @@
+/** @file simapi.c
+ * @brief File for the host simulator's stand-in for the PROS API
+ *
+ * This file defines the PROS functions used by the robot code, in terms of the simulator's
+ * kernel and plant. Motor values are handed to the plant, sensors read from it, tasks and
+ * delays are run on simulated time, and flash files are kept in memory for the length of a run.
+ * As on the Cortex, closing a written flash file stalls every task while it is programmed, and the
+ * space taken by overwritten and deleted files is only reclaimed when the robot restarts, here the next run.
+ *
+ * The robot code's console output is only echoed to the host when simEcho is set, so that
+ * simulator reports are not buried under debugging output. UART output is discarded unless
+ * a host file has been given for it in simUartFd.
+ *
+ * @see sim.h
+ */
+
+#include <time.h>
+#include <unistd.h>
+#include "main.h"
+#include "sim.h"
+#include "plant.h"
+
+/**
+ * Defines the maximum number of files in the simulated flash file system.
+ */
+#define SIM_FLASH_FILES 16
+
+/**
+ * Defines the number of bytes that can be written to the simulated flash in one run.
+ */
+#define SIM_FLASH_SPACE (64 * 1024)
+
+/**
+ * Defines the size of a simulated flash page, which is erased before it is programmed, in bytes.
+ */
+#define SIM_FLASH_PAGE 1024
+
+/**
+ * Defines how long erasing a simulated flash page stalls the robot, in microseconds.
+ */
+#define SIM_FLASH_ERASE_US 20000
+
+/**
+ * Defines how long programming one byte of simulated flash stalls the robot, in microseconds.
+ */
+#define SIM_FLASH_PROGRAM_US 26
+
+/**
+ * Defines the maximum length of a simulated flash file name.
+ */
+#define SIM_FLASH_NAME 16
+
+/**
+ * Defines the maximum number of simulated flash files that can be open at once.
+ */
+#define SIM_OPEN_FILES 8
+
+/**
+ * Defines the FILE handle value of the first simulated flash file stream.
+ * Values below this are the PROS console and UART streams.
+ */
+#define SIM_FILE_HANDLE_BASE 8
+
+/**
+ * Defines the maximum number of encoders that can be initialized at once.
+ */
+#define SIM_ENCODERS 6
+
+/**
+ * Defines the size of the buffer formatted output is written to before being sent, in bytes.
+ */
+#define SIM_PRINT_BUFFER 512
+
+/**
+ * Defines the blocking time meaning "wait forever", as passed to mutexTake().
+ */
+#define SIM_WAIT_FOREVER ((unsigned long) -1)
+
+// Not declared by API.h, which replaces the standard I/O header, but provided by the host C library
+int vsnprintf(char *buffer, size_t limit, const char *formatString, va_list args);
+
+/**
+ * @brief A file in the simulated flash file system.
+ */
+typedef struct SimFlashFile {
+    /**
+     * The file name, or an empty string if the slot is free.
+     */
+    char name[SIM_FLASH_NAME];
+
+    /**
+     * The file contents.
+     */
+    unsigned char *data;
+
+    /**
+     * The length of the file contents, in bytes.
+     */
+    size_t size;
+} SimFlashFile;
+
+/**
+ * @brief An open stream on a simulated flash file.
+ */
+typedef struct SimStream {
+    /**
+     * The file the stream reads or writes, or NULL if the stream is closed.
+     */
+    SimFlashFile *file;
+
+    /**
+     * The offset of the next byte to read or write.
+     */
+    size_t position;
+
+    /**
+     * Whether the stream was opened for writing.
+     */
+    bool writing;
+
+    /**
+     * The number of bytes written through the stream, which are programmed when it is closed.
+     */
+    size_t written;
+} SimStream;
+
+/**
+ * @brief A simulated encoder.
+ */
+typedef struct SimEncoder {
+    /**
+     * The top port of the encoder, or 0 if the slot is free.
+     */
+    unsigned char port;
+
+    /**
+     * The plant's count for the encoder when it was last reset.
+     */
+    int zero;
+} SimEncoder;
+
+/**
+ * @brief A simulated mutex.
+ */
+typedef struct SimMutex {
+    /**
+     * The task holding the mutex, or NULL if it is free.
+     */
+    void *owner;
+
+    /**
+     * The number of times the owner has taken the mutex without giving it back.
+     */
+    unsigned int depth;
+} SimMutex;
+
+/**
+ * The commanded value of each motor port, indexed by port number.
+ */
+int simMotors[SIM_MOTOR_PORTS + 1];
+
+/**
+ * The value reported for each joystick axis, indexed by joystick (0 or 1) then axis number.
+ */
+int simJoyAnalog[SIM_JOYSTICKS][7];
+
+/**
+ * The buttons reported as pressed in each joystick button group, indexed by joystick (0 or 1) then group number.
+ */
+unsigned char simJoyDigital[SIM_JOYSTICKS][9];
+
+/**
+ * The value reported for each analog port, indexed by port number.
+ */
+int simAnalog[9];
+
+/**
+ * Mask of the digital ports that read LOW, bit n being port n.
+ */
+unsigned long simDigitalLow = 0;
+
+/**
+ * The LCD buttons reported as pressed.
+ */
+unsigned int simLcdButtons = 0;
+
+/**
+ * The text shown on each line of the simulated LCD.
+ */
+char simLcdText[2][17];
+
+/**
+ * Whether the stand-in reports a field or competition switch connection.
+ */
+bool simOnline = false;
+
+/**
+ * Whether the stand-in reports the robot as enabled.
+ */
+bool simEnabled = true;
+
+/**
+ * Whether the stand-in reports the robot as being in autonomous mode.
+ */
+bool simAutonomous = false;
+
+/**
+ * Whether the robot code's console output and LCD updates are echoed to the host's standard output.
+ */
+bool simEcho = false;
+
+/**
+ * Host file descriptors that the output of UART 1 and UART 2 is written to, or -1 to discard it.
+ */
+int simUartFd[2] = {-1, -1};
+
+/**
+ * Called with every RTTTL song the robot code plays, or NULL to ignore them.
+ */
+void (*simSpeakerHook)(const char *song) = NULL;
+
+/**
+ * The files in the simulated flash file system.
+ */
+SimFlashFile simFlash[SIM_FLASH_FILES];
+
+/**
+ * The open simulated flash file streams.
+ */
+SimStream simStreams[SIM_OPEN_FILES];
+
+/**
+ * The number of bytes written to the simulated flash in this run, including overwritten and deleted files.
+ */
+size_t simFlashUsed = 0;
+
+/**
+ * The simulated encoders.
+ */
+SimEncoder simEncoders[SIM_ENCODERS];
+
+/**
+ * The plant's gyroscope angle when the simulated gyroscope was last reset, in degrees.
+ */
+double simGyroZero = 0;
+
+/**
+ * Whether the simulated gyroscope has been initialized.
+ */
+bool simGyroReady = false;
+
+/**
+ * Whether the simulated ultrasonic sensor has been initialized.
+ */
+bool simUltrasonicReady = false;
+
+/**
+ * Writes bytes to a host file.
+ *
+ * @param fd the host file descriptor
+ * @param data the bytes to write
+ * @param length the number of bytes
+ */
+void simWriteFd(int fd, const void *data, size_t length) {
+    const char *bytes = (const char *) data;
+    while (length > 0) {
+        ssize_t written = write(fd, bytes, length);
+        if (written <= 0) {
+            return;
+        }
+        bytes += written;
+        length -= written;
+    }
+}
+
+/**
+ * Writes bytes to the host's standard output.
+ *
+ * @param data the bytes to write
+ * @param length the number of bytes
+ */
+void simWriteHost(const void *data, size_t length) {
+    simWriteFd(1, data, length);
+}
+
+/**
+ * Writes a line of simulator output to the host's standard output, regardless of simEcho.
+ *
+ * @param format the printf format string
+ */
+void simReport(const char *format, ...) {
+    char buffer[SIM_PRINT_BUFFER];
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+    simWriteHost(buffer, min((size_t) max(length, 0), sizeof(buffer) - 1));
+}
+
+/**
+ * Enables the benchmark counter. The host's monotonic clock needs no setup.
+ */
+void benchCounterInit() {
+}
+
+/**
+ * Reads the benchmark counter, which stands in for the Cortex's DWT cycle counter on the host.
+ *
+ * @return the host's monotonic clock, in nanoseconds
+ */
+unsigned long benchCounter() {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (unsigned long) now.tv_sec * 1000000000UL + now.tv_nsec;
+}
+
+// -------------------- Competition and joystick functions --------------------
+
+bool isAutonomous() {
+    return simAutonomous;
+}
+
+bool isEnabled() {
+    return simEnabled;
+}
+
+bool isJoystickConnected(unsigned char joystick) {
+    return simOnline && joystick >= 1 && joystick <= SIM_JOYSTICKS;
+}
+
+bool isOnline() {
+    return simOnline;
+}
+
+int joystickGetAnalog(unsigned char joystick, unsigned char axis) {
+    if (joystick < 1 || joystick > SIM_JOYSTICKS || axis < 1 || axis > 6) {
+        return 0;
+    }
+    return simJoyAnalog[joystick - 1][axis];
+}
+
+bool joystickGetDigital(unsigned char joystick, unsigned char buttonGroup, unsigned char button) {
+    if (joystick < 1 || joystick > SIM_JOYSTICKS || buttonGroup < 5 || buttonGroup > 8) {
+        return false;
+    }
+    return (simJoyDigital[joystick - 1][buttonGroup] & button) != 0;
+}
+
+unsigned int powerLevelBackup() {
+    return 9000;
+}
+
+unsigned int powerLevelMain() {
+    return (unsigned int) plant.batteryMv;
+}
+
+void setTeamName(const char *name) {
+}
+
+// -------------------- Analog and digital I/O --------------------
+
+int analogRead(unsigned char channel) {
+    if (channel == POWER_EXPANDER_STATUS) {
+        // The power expander shares the main battery in the simulation
+        return (int) (plant.batteryMv * POWER_EXPANDER_VOLTAGE_DIVISOR / 1000);
+    }
+    return (channel >= 1 && channel <= 8) ? simAnalog[channel] : 0;
+}
+
+int analogCalibrate(unsigned char channel) {
+    return analogRead(channel);
+}
+
+int analogReadCalibrated(unsigned char channel) {
+    return 0;
+}
+
+bool digitalRead(unsigned char pin) {
+    return (pin < 32 && bitRead(simDigitalLow, pin)) ? LOW : HIGH;
+}
+
+void digitalWrite(unsigned char pin, bool value) {
+}
+
+void pinMode(unsigned char pin, unsigned char mode) {
+}
+
+// -------------------- Motors and speaker --------------------
+
+int motorGet(unsigned char channel) {
+    return (channel >= 1 && channel <= SIM_MOTOR_PORTS) ? simMotors[channel] : 0;
+}
+
+void motorSet(unsigned char channel, int speed) {
+    if (channel >= 1 && channel <= SIM_MOTOR_PORTS) {
+        simMotors[channel] = constrain(speed, MOTOR_MIN, MOTOR_MAX);
+    }
+}
+
+void motorStop(unsigned char channel) {
+    motorSet(channel, 0);
+}
+
+void motorStopAll() {
+    for (int i = 1; i <= SIM_MOTOR_PORTS; i++) {
+        simMotors[i] = 0;
+    }
+}
+
+void speakerInit() {
+}
+
+void speakerPlayArray(const char * * songs) {
+}
+
+void speakerPlayRtttl(const char *song) {
+    if (simSpeakerHook != NULL) {
+        simSpeakerHook(song);
+    }
+}
+
+void speakerShutdown() {
+}
+
+// -------------------- Sensors --------------------
+
+int gyroGet(Gyro gyro) {
+    return gyro != NULL ? (int) round(plant.gyroAngle - simGyroZero) : 0;
+}
+
+Gyro gyroInit(unsigned char port, unsigned short multiplier) {
+    if (port < 1 || port > 8 || simGyroReady) {
+        return NULL;
+    }
+    simGyroReady = true;
+    simGyroZero = plant.gyroAngle;
+    return &simGyroZero;
+}
+
+void gyroReset(Gyro gyro) {
+    if (gyro != NULL) {
+        simGyroZero = plant.gyroAngle;
+    }
+}
+
+void gyroShutdown(Gyro gyro) {
+    simGyroReady = false;
+}
+
+int encoderGet(Encoder enc) {
+    SimEncoder *encoder = (SimEncoder *) enc;
+    return encoder != NULL ? plantEncoder(encoder->port) - encoder->zero : 0;
+}
+
+Encoder encoderInit(unsigned char portTop, unsigned char portBottom, bool reverse) {
+    // The plant reports counts in the robot's direction of travel, as if each encoder were wired the right way round
+    if (portTop < 1 || portTop > 12 || portBottom < 1 || portBottom > 12) {
+        return NULL;
+    }
+    for (int i = 0; i < SIM_ENCODERS; i++) {
+        if (simEncoders[i].port == 0) {
+            simEncoders[i].port = portTop;
+            simEncoders[i].zero = plantEncoder(portTop);
+            return &simEncoders[i];
+        }
+    }
+    return NULL;
+}
+
+void encoderReset(Encoder enc) {
+    SimEncoder *encoder = (SimEncoder *) enc;
+    if (encoder != NULL) {
+        encoder->zero = plantEncoder(encoder->port);
+    }
+}
+
+void encoderShutdown(Encoder enc) {
+    SimEncoder *encoder = (SimEncoder *) enc;
+    if (encoder != NULL) {
+        encoder->port = 0;
+    }
+}
+
+int ultrasonicGet(Ultrasonic ult) {
+    return ult != NULL ? plantUltrasonic() : 0;
+}
+
+Ultrasonic ultrasonicInit(unsigned char portEcho, unsigned char portPing) {
+    if (portEcho < 1 || portEcho > 12 || portPing < 1 || portPing > 12 || simUltrasonicReady) {
+        return NULL;
+    }
+    simUltrasonicReady = true;
+    return &simUltrasonicReady;
+}
+
+void ultrasonicShutdown(Ultrasonic ult) {
+    simUltrasonicReady = false;
+}
+
+// -------------------- Streams and flash files --------------------
+
+/**
+ * Returns the simulated flash file stream for a FILE handle.
+ *
+ * @param stream the FILE handle
+ *
+ * @return the open stream, or NULL if the handle is not an open flash file stream
+ */
+SimStream* simStream(FILE *stream) {
+    long index = (long) stream - SIM_FILE_HANDLE_BASE;
+    if (index < 0 || index >= SIM_OPEN_FILES || simStreams[index].file == NULL) {
+        return NULL;
+    }
+    return &simStreams[index];
+}
+
+/**
+ * Finds a file in the simulated flash file system.
+ *
+ * @param name the file name
+ *
+ * @return the file, or NULL if it does not exist
+ */
+SimFlashFile* simFlashFind(const char *name) {
+    for (int i = 0; i < SIM_FLASH_FILES; i++) {
+        if (simFlash[i].name[0] != '\0' && strcmp(simFlash[i].name, name) == 0) {
+            return &simFlash[i];
+        }
+    }
+    return NULL;
+}
+
+/**
+ * Writes bytes to a stream.
+ *
+ * @param data the bytes to write
+ * @param length the number of bytes
+ * @param stream the stream to write to
+ *
+ * @return the number of bytes written
+ */
+size_t simStreamWrite(const void *data, size_t length, FILE *stream) {
+    if (stream == stdout) {
+        if (simEcho) {
+            simWriteHost(data, length);
+        }
+        return length;
+    }
+    if (stream == uart1 || stream == uart2) {
+        int fd = simUartFd[(long) stream - 1];
+        if (fd >= 0) {
+            simWriteFd(fd, data, length);
+        }
+        return length;
+    }
+    SimStream *s = simStream(stream);
+    if (s == NULL) {
+        return 0;
+    }
+    if (!s->writing) {
+        return 0;
+    }
+    if (simFlashUsed + length > SIM_FLASH_SPACE) {
+        return 0;
+    }
+    SimFlashFile *file = s->file;
+    if (s->position + length > file->size) {
+        unsigned char *data = (unsigned char *) realloc(file->data, s->position + length);
+        if (data == NULL) {
+            return 0;
+        }
+        file->data = data;
+        file->size = s->position + length;
+    }
+    memcpy(file->data + s->position, data, length);
+    s->position += length;
+    s->written += length;
+    simFlashUsed += length;
+    return length;
+}
+
+/**
+ * Formats a string and writes it to a stream.
+ *
+ * @param stream the stream to write to
+ * @param formatString the printf format string
+ * @param args the values to format
+ *
+ * @return the number of characters formatted
+ */
+int simStreamFormat(FILE *stream, const char *formatString, va_list args) {
+    char buffer[SIM_PRINT_BUFFER];
+    int length = vsnprintf(buffer, sizeof(buffer), formatString, args);
+    simStreamWrite(buffer, min((size_t) max(length, 0), sizeof(buffer) - 1), stream);
+    return length;
+}
+
+FILE * fopen(const char *file, const char *mode) {
+    bool writing = (mode[0] == 'w' || mode[0] == 'a');
+    SimFlashFile *f = simFlashFind(file);
+    if (f == NULL) {
+        if (!writing || strlen(file) >= SIM_FLASH_NAME) {
+            return NULL;
+        }
+        for (int i = 0; i < SIM_FLASH_FILES && f == NULL; i++) {
+            if (simFlash[i].name[0] == '\0') {
+                f = &simFlash[i];
+                strncpy(f->name, file, SIM_FLASH_NAME);
+                f->data = NULL;
+                f->size = 0;
+            }
+        }
+        if (f == NULL) {
+            return NULL;
+        }
+    }
+    if (mode[0] == 'w') {
+        f->size = 0;
+    }
+    for (int i = 0; i < SIM_OPEN_FILES; i++) {
+        if (simStreams[i].file == NULL) {
+            simStreams[i].file = f;
+            simStreams[i].writing = writing;
+            simStreams[i].written = 0;
+            simStreams[i].position = (mode[0] == 'a') ? f->size : 0;
+            return (FILE *) (long) (SIM_FILE_HANDLE_BASE + i);
+        }
+    }
+    return NULL;
+}
+
+void fclose(FILE *stream) {
+    SimStream *s = simStream(stream);
+    if (s != NULL) {
+        s->file = NULL;
+        if (s->written > 0) {
+            size_t pages = (s->written + SIM_FLASH_PAGE - 1) / SIM_FLASH_PAGE;
+            simStall(pages * SIM_FLASH_ERASE_US + s->written * SIM_FLASH_PROGRAM_US);
+        }
+    }
+}
+
+int fcount(FILE *stream) {
+    SimStream *s = simStream(stream);
+    return (s != NULL && !s->writing) ? (int) (s->file->size - s->position) : 0;
+}
+
+int fdelete(const char *file) {
+    SimFlashFile *f = simFlashFind(file);
+    if (f == NULL) {
+        return -1;
+    }
+    free(f->data);
+    f->data = NULL;
+    f->size = 0;
+    f->name[0] = '\0';
+    return 0;
+}
+
+int feof(FILE *stream) {
+    SimStream *s = simStream(stream);
+    return s == NULL || s->position >= s->file->size;
+}
+
+int fflush(FILE *stream) {
+    return 0;
+}
+
+int fgetc(FILE *stream) {
+    unsigned char value;
+    return fread(&value, 1, 1, stream) == 1 ? value : EOF;
+}
+
+char* fgets(char *str, int num, FILE *stream) {
+    int i = 0;
+    while (i < num - 1) {
+        int value = fgetc(stream);
+        if (value == EOF) {
+            break;
+        }
+        str[i++] = (char) value;
+        if (value == '\n') {
+            break;
+        }
+    }
+    str[i] = '\0';
+    return i > 0 ? str : NULL;
+}
+
+void fprint(const char *string, FILE *stream) {
+    fputs(string, stream);
+}
+
+int fputc(int value, FILE *stream) {
+    unsigned char byte = (unsigned char) value;
+    return simStreamWrite(&byte, 1, stream) == 1 ? byte : EOF;
+}
+
+int fputs(const char *string, FILE *stream) {
+    size_t length = strlen(string);
+    return simStreamWrite(string, length, stream) == length ? (int) length : EOF;
+}
+
+size_t fread(void *ptr, size_t size, size_t count, FILE *stream) {
+    SimStream *s = simStream(stream);
+    if (s == NULL || s->writing || size == 0) {
+        return 0;
+    }
+    size_t available = (s->file->size - min(s->position, s->file->size)) / size;
+    count = min(count, available);
+    memcpy(ptr, s->file->data + s->position, count * size);
+    s->position += count * size;
+    return count;
+}
+
+int fseek(FILE *stream, long int offset, int origin) {
+    SimStream *s = simStream(stream);
+    if (s == NULL) {
+        return -1;
+    }
+    long base = (origin == SEEK_CUR) ? (long) s->position : (origin == SEEK_END) ? (long) s->file->size : 0;
+    if (base + offset < 0) {
+        return -1;
+    }
+    s->position = base + offset;
+    return 0;
+}
+
+long int ftell(FILE *stream) {
+    SimStream *s = simStream(stream);
+    return s != NULL ? (long) s->position : -1;
+}
+
+size_t fwrite(const void *ptr, size_t size, size_t count, FILE *stream) {
+    return size != 0 ? simStreamWrite(ptr, size * count, stream) / size : 0;
+}
+
+int getchar() {
+    return EOF;
+}
+
+void print(const char *string) {
+    fputs(string, stdout);
+}
+
+int putchar(int value) {
+    return fputc(value, stdout);
+}
+
+int puts(const char *string) {
+    fputs(string, stdout);
+    return fputc('\n', stdout);
+}
+
+int fprintf(FILE *stream, const char *formatString, ...) {
+    va_list args;
+    va_start(args, formatString);
+    int length = simStreamFormat(stream, formatString, args);
+    va_end(args);
+    return length;
+}
+
+int printf(const char *formatString, ...) {
+    va_list args;
+    va_start(args, formatString);
+    int length = simStreamFormat(stdout, formatString, args);
+    va_end(args);
+    return length;
+}
+
+int snprintf(char *buffer, size_t limit, const char *formatString, ...) {
+    va_list args;
+    va_start(args, formatString);
+    int length = vsnprintf(buffer, limit, formatString, args);
+    va_end(args);
+    return length;
+}
+
+int sprintf(char *buffer, const char *formatString, ...) {
+    va_list args;
+    va_start(args, formatString);
+    int length = vsnprintf(buffer, SIM_PRINT_BUFFER, formatString, args);
+    va_end(args);
+    return length;
+}
+
+void usartInit(FILE *usart, unsigned int baud, unsigned int flags) {
+}
+
+void usartShutdown(FILE *usart) {
+}
+
+// -------------------- LCD --------------------
+
+void lcdClear(FILE *lcdPort) {
+    lcdSetText(lcdPort, 1, "");
+    lcdSetText(lcdPort, 2, "");
+}
+
+void lcdInit(FILE *lcdPort) {
+}
+
+void lcdPrint(FILE *lcdPort, unsigned char line, const char *formatString, ...) {
+    char buffer[17];
+    va_list args;
+    va_start(args, formatString);
+    vsnprintf(buffer, sizeof(buffer), formatString, args);
+    va_end(args);
+    lcdSetText(lcdPort, line, buffer);
+}
+
+unsigned int lcdReadButtons(FILE *lcdPort) {
+    return simLcdButtons;
+}
+
+void lcdSetBacklight(FILE *lcdPort, bool backlight) {
+}
+
+void lcdSetText(FILE *lcdPort, unsigned char line, const char *buffer) {
+    if (line < 1 || line > 2) {
+        return;
+    }
+    char *text = simLcdText[line - 1];
+    if (strncmp(text, buffer, 16) == 0) {
+        return;
+    }
+    strncpy(text, buffer, 16);
+    text[16] = '\0';
+    if (simEcho) {
+        simReport("[%8lu] LCD %d: %s\n", millis(), line, text);
+    }
+}
+
+void lcdShutdown(FILE *lcdPort) {
+}
+
+// -------------------- Tasks, mutexes and timing --------------------
+
+TaskHandle taskCreate(TaskCode taskCode, const unsigned int stackDepth, void *parameters, const unsigned int priority) {
+    return simSpawn(taskCode, parameters, priority);
+}
+
+void taskDelay(const unsigned long msToDelay) {
+    simSleepUntil(simTime() + msToDelay * 1000ULL);
+}
+
+void taskDelayUntil(unsigned long *previousWakeTime, const unsigned long cycleTime) {
+    *previousWakeTime += cycleTime;
+    // A late task does not wait, but still lets the other ready tasks run
+    simSleepUntil(max(*previousWakeTime * 1000ULL, simTime()));
+}
+
+void taskDelete(TaskHandle taskToDelete) {
+    simKill(taskToDelete);
+}
+
+unsigned int taskGetCount() {
+    return simTaskCount();
+}
+
+unsigned int taskGetState(TaskHandle task) {
+    return simTaskState(task);
+}
+
+unsigned int taskPriorityGet(const TaskHandle task) {
+    return simTaskPriority(task);
+}
+
+void taskPrioritySet(TaskHandle task, const unsigned int newPriority) {
+    simTaskSetPriority(task, newPriority);
+}
+
+void taskResume(TaskHandle taskToResume) {
+    simResume(taskToResume);
+}
+
+void taskSuspend(TaskHandle taskToSuspend) {
+    simSuspend(taskToSuspend);
+}
+
+Mutex mutexCreate() {
+    SimMutex *mutex = (SimMutex *) malloc(sizeof(SimMutex));
+    if (mutex != NULL) {
+        mutex->owner = NULL;
+        mutex->depth = 0;
+    }
+    return mutex;
+}
+
+bool mutexGive(Mutex mutex) {
+    SimMutex *m = (SimMutex *) mutex;
+    if (m == NULL || m->owner != simSelf()) {
+        return false;
+    }
+    if (--m->depth == 0) {
+        m->owner = NULL;
+    }
+    return true;
+}
+
+bool mutexTake(Mutex mutex, const unsigned long blockTime) {
+    SimMutex *m = (SimMutex *) mutex;
+    if (m == NULL) {
+        return false;
+    }
+    unsigned long long deadline = simTime() + blockTime * 1000ULL;
+    // The holder can only be another task that is waiting, so wait a tick at a time for it to finish
+    while (m->owner != NULL && m->owner != simSelf()) {
+        if (blockTime != SIM_WAIT_FOREVER && simTime() >= deadline) {
+            return false;
+        }
+        simSleepUntil(simTime() + SIM_TICK_US);
+    }
+    m->owner = simSelf();
+    m->depth++;
+    return true;
+}
+
+void mutexDelete(Mutex mutex) {
+    free(mutex);
+}
+
+void delay(const unsigned long time) {
+    taskDelay(time);
+}
+
+void delayMicroseconds(const unsigned long us) {
+    simSleepUntil(simTime() + us);
+}
+
+unsigned long micros() {
+    return (unsigned long) simTime();
+}
+
+unsigned long millis() {
+    return (unsigned long) (simTime() / 1000);
+}
+
+void wait(const unsigned long time) {
+    taskDelay(time);
+}
+
+void waitUntil(unsigned long *previousWakeTime, const unsigned long time) {
+    taskDelayUntil(previousWakeTime, time);
+}
@@ -0,0 +1,756 @@
+/** @file simulate.c
+ * @brief File for the host simulator's closed-loop controller scenarios
+ *
+ * Each scenario runs one of the robot code's control loops against the plant, measures how the
+ * simulated robot actually moved, and checks the measurements against limits so that a change
+ * which makes a controller worse fails the run. Results are printed one scenario per line as
+ * key=value pairs so that they can be compared between runs.
+ *
+ * Usage: simulate [-v] [-s seed] [-u file] [scenario...]
+ *     -v       echo the robot code's console output and LCD
+ *     -s seed  seed the plant's sensor noise (default 1)
+ *     -u file  enable the binary telemetry stream and write it to a file, for sim/streamdecode
+ * With no scenario names, every scenario is run. The exit status is the number of failed scenarios.
+ */
+
+#include <fcntl.h>
+#include "main.h"
+#include "sim.h"
+#include "plant.h"
+
+/**
+ * Defines the period of the scenario control loops, in milliseconds. Matches the operator control loop.
+ */
+#define SCENARIO_PERIOD 20
+
+/**
+ * Defines how long the robot is left at rest before each scenario, in milliseconds.
+ */
+#define SCENARIO_REST_TIME 500
+
+/**
+ * Defines the maximum number of control loop iterations recorded by a scenario.
+ */
+#define SCENARIO_MAX_SAMPLES 256
+
+/**
+ * Defines the speed the drive-straight scenario drives at.
+ */
+#define STRAIGHT_SPEED 80
+
+/**
+ * Defines how long the drive-straight scenario drives for, in milliseconds.
+ */
+#define STRAIGHT_TIME 2000
+
+/**
+ * Defines the strength of the right side of the drive in the drive-straight scenario,
+ * so that the drive-straight correction has something to correct.
+ */
+#define STRAIGHT_RIGHT_STRENGTH 0.85
+
+/**
+ * Defines the largest acceptable change in heading while driving straight, in degrees.
+ */
+#define STRAIGHT_MAX_HEADING 3.0
+
+/**
+ * Defines the largest acceptable sideways drift while driving straight, in inches.
+ */
+#define STRAIGHT_MAX_DRIFT 2.0
+
+/**
+ * Defines the largest acceptable difference between the field positioning system's estimate and the
+ * robot's true position at the end of the drive-straight scenario, in inches.
+ */
+#define STRAIGHT_MAX_ODOMETRY_ERROR 2.0
+
+/**
+ * Defines the left side motor value of the arc scenario.
+ */
+#define ARC_LEFT_SPEED 40
+
+/**
+ * Defines the right side motor value of the arc scenario. Faster than the left side, so the robot curves counterclockwise.
+ */
+#define ARC_RIGHT_SPEED 100
+
+/**
+ * Defines how long the arc scenario drives for, in milliseconds.
+ */
+#define ARC_TIME 4000
+
+/**
+ * Defines the least the robot must turn in the arc scenario for it to test odometry on a curve, in degrees.
+ */
+#define ARC_MIN_HEADING 90.0
+
+/**
+ * Defines the largest acceptable difference between the distance the field positioning system estimates the robot
+ * moved and the distance it truly moved in the arc scenario, in inches.
+ */
+#define ARC_MAX_ODOMETRY_ERROR 0.5
+
+/**
+ * Defines where the path scenarios start, on both axes, in inches. The middle of the field leaves room for the path in any direction.
+ */
+#define PATH_START 72
+
+/**
+ * Defines how far the path scenario's path goes ahead before it turns, in inches.
+ */
+#define PATH_AHEAD 36
+
+/**
+ * Defines how far the path scenario's path goes to the left after it turns, in inches.
+ */
+#define PATH_LEFT 24
+
+/**
+ * Defines the longest acceptable time for the path scenario to reach the end of its path, in milliseconds.
+ */
+#define PATH_MAX_TIME 8000
+
+/**
+ * Defines the largest acceptable distance between the robot's true position and the end of the path
+ * at the end of the path scenario, in inches.
+ */
+#define PATH_MAX_END_ERROR 4.0
+
+/**
+ * Defines the longest acceptable time for followPath() to give up on a path the robot cannot move along, in milliseconds.
+ */
+#define PATH_MAX_STALL_TIME 2000
+
+/**
+ * Defines the X-coordinate the characterization scenarios start at, facing along the X axis, in inches.
+ * The field is 144 inches wide, so the robot has room for both stages at their distance limit.
+ */
+#define CHARACTERIZE_START_X 12
+
+/**
+ * Defines how far past CHARACTERIZE_MAX_DISTANCE a characterization stage may drive, in inches.
+ * The stages only check their distance once per period, and the robot coasts after the motors stop.
+ */
+#define CHARACTERIZE_MAX_OVERRUN 3.0
+
+/**
+ * Defines the strength of the drive in the characterization limit scenario (see PlantConfig).
+ * The nominal drive covers about 35 inches during the ramp; this one would cover well over CHARACTERIZE_MAX_DISTANCE.
+ */
+#define CHARACTERIZE_FAST_STRENGTH 1.8
+
+/**
+ * Defines the distance the forward scenario drives with goForward(), in inches.
+ */
+#define FORWARD_DISTANCE 24
+
+/**
+ * Defines the largest acceptable difference between FORWARD_DISTANCE and the distance driven when goForward() returns, in inches.
+ */
+#define FORWARD_MAX_ERROR 1.0
+
+/**
+ * Defines the farthest the robot may coast after goForward() returns, in inches.
+ * goForward() stops the motors at the target without braking, so the robot coasts on from full speed.
+ */
+#define FORWARD_MAX_COAST 10.0
+
+/**
+ * Defines the largest acceptable heading change while driving with goForward(), in degrees.
+ */
+#define FORWARD_MAX_HEADING 3.0
+
+/**
+ * Defines the angle the rturn scenario turns with rturn(), in degrees.
+ */
+#define RTURN_ANGLE 90
+
+/**
+ * Defines the largest acceptable difference between RTURN_ANGLE and the angle turned when rturn() returns, in degrees.
+ */
+#define RTURN_MAX_ERROR 3.0
+
+/**
+ * Defines the farthest the robot may coast after rturn() returns, in degrees.
+ * rturn() stops the motors at the target without braking, so the robot coasts on from full speed.
+ */
+#define RTURN_MAX_COAST 55.0
+
+/**
+ * Defines the gyroscope angle the turn scenario turns to, in degrees.
+ */
+#define TURN_TARGET 45
+
+/**
+ * Defines how long the turn scenario runs for, in milliseconds.
+ */
+#define TURN_TIME 3000
+
+/**
+ * Defines how close to the target the robot must stay to count as settled, in degrees.
+ */
+#define TURN_TOLERANCE 2.0
+
+/**
+ * Defines the longest acceptable time for the turn scenario to settle, in milliseconds.
+ */
+#define TURN_MAX_SETTLE 2000
+
+/**
+ * @brief A closed-loop scenario.
+ */
+typedef struct Scenario {
+    /**
+     * The name used to select the scenario on the command line and in its results.
+     */
+    const char *name;
+
+    /**
+     * Runs the scenario and prints its results.
+     *
+     * @return true if the scenario's measurements were within their limits
+     */
+    bool (*run)();
+} Scenario;
+
+/**
+ * Number of scenarios that have failed.
+ */
+int scenarioFailures = 0;
+
+/**
+ * The scenario names selected on the command line.
+ */
+char **scenarioSelected;
+
+/**
+ * Number of scenario names selected on the command line, or 0 to run every scenario.
+ */
+int scenarioSelectedCount = 0;
+
+/**
+ * Stops the drive, gives the robot a new configuration and leaves it at rest, so that each scenario starts from a standstill.
+ *
+ * @param config the configuration of the robot for the scenario
+ */
+void scenarioRest(const PlantConfig *config) {
+    move(0, 0, 0);
+    plantReset(config, plant.x, plant.y, degrees(plant.heading));
+    delay(SCENARIO_REST_TIME);
+}
+
+/**
+ * Drives straight with moveStraight(), with one side of the drive weaker than the other.
+ * Measures the heading change, sideways drift, time to reach speed and the odometry error.
+ *
+ * @return true if the robot drove straight enough and odometry kept up
+ */
+bool scenarioStraight() {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = plantConfig.seed;
+    config.strength[PLANT_RIGHT] = STRAIGHT_RIGHT_STRENGTH;
+    scenarioRest(&config);
+
+    double startX = plant.x;
+    double startY = plant.y;
+    double startHeading = plant.heading;
+    double speeds[SCENARIO_MAX_SAMPLES];
+    int samples = 0;
+    resetEncoderVariables();
+    unsigned long start = millis();
+    unsigned long wakeTime = start;
+    while (millis() - start < STRAIGHT_TIME) {
+        moveStraight(STRAIGHT_SPEED);
+        taskDelayUntil(&wakeTime, SCENARIO_PERIOD);
+        if (samples < SCENARIO_MAX_SAMPLES) {
+            speeds[samples++] = plant.forward;
+        }
+    }
+    move(0, 0, 0);
+
+    double dx = plant.x - startX;
+    double dy = plant.y - startY;
+    double distance = dx * cos(startHeading) + dy * sin(startHeading);
+    double drift = -dx * sin(startHeading) + dy * cos(startHeading);
+    double heading = plantTurnedSince(startHeading);
+    double odometry = sqrt(sq(position.x - plant.x) + sq(position.y - plant.y));
+    int rise = samples;
+    for (int i = 0; i < samples; i++) {
+        if (speeds[i] >= 0.9 * speeds[samples - 1]) {
+            rise = i + 1;
+            break;
+        }
+    }
+
+    bool pass = abs(heading) <= STRAIGHT_MAX_HEADING && abs(drift) <= STRAIGHT_MAX_DRIFT &&
+            odometry <= STRAIGHT_MAX_ODOMETRY_ERROR && distance > 0;
+    simReport("scenario=straight result=%s distance_in=%.2f speed_ips=%.2f rise_ms=%d heading_deg=%.2f drift_in=%.2f odometry_in=%.2f\n",
+              pass ? "pass" : "fail", distance, speeds[samples - 1], rise * SCENARIO_PERIOD, heading, drift, odometry);
+    return pass;
+}
+
+/**
+ * Drives along a curve with the two sides of the drive at different speeds.
+ * Measures how far the field positioning system's estimate of the move strays from the robot's true move.
+ *
+ * @return true if the robot turned far enough and odometry kept up along the curve
+ */
+bool scenarioArc() {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = plantConfig.seed;
+    scenarioRest(&config);
+
+    double startX = plant.x;
+    double startY = plant.y;
+    double startHeading = plant.heading;
+    point startPosition = position;
+    unsigned long start = millis();
+    unsigned long wakeTime = start;
+    while (millis() - start < ARC_TIME) {
+        move_lr(ARC_LEFT_SPEED, ARC_RIGHT_SPEED);
+        taskDelayUntil(&wakeTime, SCENARIO_PERIOD);
+    }
+    move(0, 0, 0);
+    // Let the robot coast to a stop so the last odometry update covers the whole move
+    delay(SCENARIO_REST_TIME);
+
+    double distance = sqrt(sq(plant.x - startX) + sq(plant.y - startY));
+    double heading = plantTurnedSince(startHeading);
+    double odometry = sqrt(sq((position.x - startPosition.x) - (plant.x - startX)) +
+                           sq((position.y - startPosition.y) - (plant.y - startY)));
+
+    bool pass = heading >= ARC_MIN_HEADING && odometry <= ARC_MAX_ODOMETRY_ERROR;
+    simReport("scenario=arc result=%s distance_in=%.2f heading_deg=%.2f odometry_in=%.2f\n",
+              pass ? "pass" : "fail", distance, heading, odometry);
+    return pass;
+}
+
+/**
+ * Moves the robot to the middle of the field without changing its heading, and builds a path from there
+ * that goes PATH_AHEAD ahead of the robot, then PATH_LEFT to its left.
+ *
+ * @param config the configuration of the robot for the scenario
+ * @param path the array of two waypoints to store the path in
+ */
+void pathScenarioStart(const PlantConfig *config, waypoint path[2]) {
+    scenarioRest(config);
+    double heading = fieldHeading();
+    plantReset(NULL, PATH_START, PATH_START, degrees(heading));
+    resetPosition(PATH_START, PATH_START);
+    delay(SCENARIO_PERIOD);
+    double aheadX = PATH_START + PATH_AHEAD * cos(heading);
+    double aheadY = PATH_START + PATH_AHEAD * sin(heading);
+    path[0].x = (unsigned char) round(aheadX);
+    path[0].y = (unsigned char) round(aheadY);
+    path[1].x = (unsigned char) round(aheadX - PATH_LEFT * sin(heading));
+    path[1].y = (unsigned char) round(aheadY + PATH_LEFT * cos(heading));
+}
+
+/**
+ * Follows a path that turns left with followPath().
+ * Measures the time taken and how far from the end of the path the robot truly stopped.
+ *
+ * @return true if the robot reached the end of the path in time
+ */
+bool scenarioPath() {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = plantConfig.seed;
+    waypoint path[2];
+    pathScenarioStart(&config, path);
+
+    unsigned long start = millis();
+    bool reached = followPath(path, 2);
+    unsigned long time = millis() - start;
+    double error = sqrt(sq(plant.x - path[1].x) + sq(plant.y - path[1].y));
+
+    bool pass = reached && time <= PATH_MAX_TIME && error <= PATH_MAX_END_ERROR;
+    simReport("scenario=path result=%s reached=%d time_ms=%lu end_error_in=%.2f\n",
+              pass ? "pass" : "fail", reached, time, error);
+    return pass;
+}
+
+/**
+ * Follows a path with followPath() while the drive cannot move the robot, as if it were blocked.
+ * Measures how long followPath() takes to give up.
+ *
+ * @return true if followPath() gave up on the path in time
+ */
+bool scenarioPathStall() {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = plantConfig.seed;
+    config.strength[PLANT_LEFT] = 0;
+    config.strength[PLANT_RIGHT] = 0;
+    waypoint path[2];
+    pathScenarioStart(&config, path);
+
+    unsigned long start = millis();
+    bool reached = followPath(path, 2);
+    unsigned long time = millis() - start;
+
+    bool pass = !reached && time <= PATH_MAX_STALL_TIME;
+    simReport("scenario=pathstall result=%s reached=%d time_ms=%lu\n", pass ? "pass" : "fail", reached, time);
+    return pass;
+}
+
+/**
+ * The farthest the robot has truly driven during a single characterization stage, in inches.
+ */
+double characterizeStageDistance;
+
+/**
+ * Whether characterizeMonitor() should keep running.
+ */
+volatile bool characterizeMonitoring;
+
+/**
+ * Measures how far the robot truly drives during each characterization stage into characterizeStageDistance.
+ * A stage starts when characterize() shows its name on the first line of the LCD.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void characterizeMonitor(void *ignore) {
+    char stage[sizeof(simLcdText[0])] = "";
+    double startX = plant.x;
+    characterizeStageDistance = 0;
+    unsigned long wakeTime = millis();
+    while (characterizeMonitoring) {
+        if (strcmp(stage, simLcdText[0]) != 0) {
+            strcpy(stage, simLcdText[0]);
+            startX = plant.x;
+        }
+        characterizeStageDistance = max(characterizeStageDistance, abs(plant.x - startX));
+        taskDelayUntil(&wakeTime, SCENARIO_PERIOD / 2);
+    }
+}
+
+/**
+ * Characterizes the drive with characterize(), starting near the left wall of the field and facing the right wall.
+ *
+ * @param strength the strength of both sides of the drive (see PlantConfig)
+ * @param result a pointer to store the feed-forward constants in
+ *
+ * @return true if characterization completed
+ */
+bool characterizeDrive(double strength, Feedforward *result) {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = plantConfig.seed;
+    config.strength[PLANT_LEFT] = strength;
+    config.strength[PLANT_RIGHT] = strength;
+    scenarioRest(&config);
+    plantReset(NULL, CHARACTERIZE_START_X, PATH_START, 0);
+    resetPosition(CHARACTERIZE_START_X, PATH_START);
+    delay(SCENARIO_PERIOD);
+
+    MotorGroup drive;
+    memset(&drive, 0, sizeof(drive));
+    // The same motors as the default Full Drive group, whose strafe wheel has no encoder
+    strcpy(drive.name, "Full Drive");
+    bitSet(drive.ports, LEFT_MOTOR);
+    bitSet(drive.ports, RIGHT_MOTOR);
+    bitSet(drive.ports, STRAFE_MOTOR);
+    memset(result, 0, sizeof(*result));
+
+    characterizeMonitoring = true;
+    taskCreate(characterizeMonitor, TASK_DEFAULT_STACK_SIZE, NULL, TASK_PRIORITY_DEFAULT);
+    bool done = characterize(&drive, result);
+    characterizeMonitoring = false;
+    delay(SCENARIO_PERIOD);
+    return done;
+}
+
+/**
+ * Characterizes the drive, whose true feed-forward constants follow from the plant's motor model.
+ * Checks that the constants are plausible and that neither stage drove past its distance limit.
+ *
+ * @return true if characterization completed with plausible constants within the distance limit
+ */
+bool scenarioCharacterize() {
+    Feedforward result;
+    bool done = characterizeDrive(1, &result);
+
+    bool pass = done && result.kS > 0 && result.kV > 0 && result.kA >= 0 &&
+            characterizeStageDistance <= CHARACTERIZE_MAX_DISTANCE + CHARACTERIZE_MAX_OVERRUN;
+    simReport("scenario=characterize result=%s ks=%.2f kv=%.3f ka=%.3f stage_distance_in=%.2f\n",
+              pass ? "pass" : "fail", result.kS, result.kV, result.kA, characterizeStageDistance);
+    return pass;
+}
+
+/**
+ * Characterizes a drive that is fast enough to reach the distance limit during the ramp stage.
+ * Checks that the ramp stopped at the limit and was still fit to the samples taken before it.
+ *
+ * @return true if characterization completed with plausible constants and stopped at the distance limit
+ */
+bool scenarioCharacterizeLimit() {
+    Feedforward result;
+    bool done = characterizeDrive(CHARACTERIZE_FAST_STRENGTH, &result);
+
+    bool pass = done && result.kS > 0 && result.kV > 0 &&
+            characterizeStageDistance >= CHARACTERIZE_MAX_DISTANCE &&
+            characterizeStageDistance <= CHARACTERIZE_MAX_DISTANCE + CHARACTERIZE_MAX_OVERRUN;
+    simReport("scenario=characterizelimit result=%s ks=%.2f kv=%.3f ka=%.3f stage_distance_in=%.2f\n",
+              pass ? "pass" : "fail", result.kS, result.kV, result.kA, characterizeStageDistance);
+    return pass;
+}
+
+/**
+ * Characterizes the drive, then follows the same path as the path scenario with the measured feed-forward constants.
+ * The drive constants in use before the scenario are restored afterwards.
+ *
+ * @return true if the robot reached the end of the path in time
+ */
+bool scenarioPathFeedforward() {
+    Feedforward result;
+    bool characterized = characterizeDrive(1, &result);
+
+    Feedforward saved = driveFeedforward;
+    bool savedValid = driveFeedforwardValid;
+    driveFeedforward = result;
+    driveFeedforwardValid = characterized;
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = plantConfig.seed;
+    waypoint path[2];
+    pathScenarioStart(&config, path);
+
+    unsigned long start = millis();
+    bool reached = characterized && followPath(path, 2);
+    unsigned long time = millis() - start;
+    double error = sqrt(sq(plant.x - path[1].x) + sq(plant.y - path[1].y));
+    driveFeedforward = saved;
+    driveFeedforwardValid = savedValid;
+
+    bool pass = reached && time <= PATH_MAX_TIME && error <= PATH_MAX_END_ERROR;
+    simReport("scenario=pathff result=%s reached=%d time_ms=%lu end_error_in=%.2f\n",
+              pass ? "pass" : "fail", reached, time, error);
+    return pass;
+}
+
+/**
+ * Drives FORWARD_DISTANCE with goForward(), which runs the drive at full power until the right encoder reaches the distance.
+ * Measures the distance truly driven when goForward() returns and once the robot has coasted to a stop, and the heading change.
+ * goForward() drives with move(), which takes the opposite sign to the plant for the forward speed,
+ * so distances are measured along the robot's heading in whichever direction it went.
+ *
+ * @return true if goForward() stopped at the distance, the robot did not coast too far and it drove straight enough
+ */
+bool scenarioForward() {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = plantConfig.seed;
+    scenarioRest(&config);
+
+    double startX = plant.x;
+    double startY = plant.y;
+    double startHeading = plant.heading;
+    unsigned long start = millis();
+    goForward(FORWARD_DISTANCE);
+    unsigned long time = millis() - start;
+    double stopped = abs((plant.x - startX) * cos(startHeading) + (plant.y - startY) * sin(startHeading));
+    delay(SCENARIO_REST_TIME);
+
+    double distance = abs((plant.x - startX) * cos(startHeading) + (plant.y - startY) * sin(startHeading));
+    double heading = plantTurnedSince(startHeading);
+    double error = stopped - FORWARD_DISTANCE;
+
+    bool pass = abs(error) <= FORWARD_MAX_ERROR && distance - stopped <= FORWARD_MAX_COAST &&
+            abs(heading) <= FORWARD_MAX_HEADING;
+    simReport("scenario=forward result=%s target_in=%d stop_error_in=%.2f coast_in=%.2f distance_in=%.2f time_ms=%lu heading_deg=%.2f\n",
+              pass ? "pass" : "fail", FORWARD_DISTANCE, error, distance - stopped, distance, time, heading);
+    return pass;
+}
+
+/**
+ * Turns RTURN_ANGLE to the right with rturn(), which runs the drive at full power until the right encoder
+ * has travelled the turn's arc.
+ * Measures the angle truly turned when rturn() returns and once the robot has coasted to a stop.
+ *
+ * @return true if rturn() stopped at the angle and the robot did not coast too far
+ */
+bool scenarioRturn() {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = plantConfig.seed;
+    scenarioRest(&config);
+
+    double startHeading = plant.heading;
+    unsigned long start = millis();
+    rturn(RTURN_ANGLE);
+    unsigned long time = millis() - start;
+    // The plant's heading is counterclockwise, so a right turn is negative
+    double stopped = -plantTurnedSince(startHeading);
+    delay(SCENARIO_REST_TIME);
+
+    double turned = -plantTurnedSince(startHeading);
+    double error = stopped - RTURN_ANGLE;
+
+    bool pass = abs(error) <= RTURN_MAX_ERROR && turned - stopped <= RTURN_MAX_COAST;
+    simReport("scenario=rturn result=%s target_deg=%d stop_error_deg=%.2f coast_deg=%.2f turned_deg=%.2f time_ms=%lu\n",
+              pass ? "pass" : "fail", RTURN_ANGLE, error, turned - stopped, turned, time);
+    return pass;
+}
+
+/**
+ * Turns to TURN_TARGET with targetNet() from rest, using the current gyroscope gains.
+ *
+ * @param settled a pointer to store the time the robot last left the tolerance band in, in milliseconds
+ * @param overshoot a pointer to store the largest overshoot in, in degrees
+ * @param error a pointer to store the final error against the robot's true heading in, in degrees
+ *
+ * @return true if the turn settled on the target in time
+ */
+bool measureTurn(unsigned long *settled, double *overshoot, double *error) {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = plantConfig.seed;
+    scenarioRest(&config);
+
+    double startHeading = plant.heading;
+    *overshoot = 0;
+    *settled = 0;
+    resetGyroVariables();
+    unsigned long start = millis();
+    unsigned long wakeTime = start;
+    while (millis() - start < TURN_TIME) {
+        moveCompensated(0, targetNet(TURN_TARGET), 0);
+        taskDelayUntil(&wakeTime, SCENARIO_PERIOD);
+        double turned = plantTurnedSince(startHeading);
+        *overshoot = max(*overshoot, turned - TURN_TARGET);
+        if (abs(turned - TURN_TARGET) > TURN_TOLERANCE) {
+            *settled = millis() - start;
+        }
+    }
+    move(0, 0, 0);
+
+    *error = plantTurnedSince(startHeading) - TURN_TARGET;
+    return abs(*error) <= TURN_TOLERANCE && *settled <= TURN_MAX_SETTLE;
+}
+
+/**
+ * Turns to a gyroscope angle with targetNet().
+ * Measures the settle time, overshoot and final error against the robot's true heading.
+ *
+ * @return true if the turn settled on the target in time
+ */
+bool scenarioTurn() {
+    unsigned long settled;
+    double overshoot, error;
+    bool pass = measureTurn(&settled, &overshoot, &error);
+    simReport("scenario=turn result=%s target_deg=%d settle_ms=%lu overshoot_deg=%.2f error_deg=%.2f gyro_deg=%d\n",
+              pass ? "pass" : "fail", TURN_TARGET, settled, overshoot, error, gyroGet(gyro));
+    return pass;
+}
+
+/**
+ * Tunes the gyroscope turning loop with the relay autotuner, then turns with the tuned gains.
+ * The gains in use before the scenario are restored afterwards.
+ *
+ * @return true if the experiment completed and the turn with the tuned gains settled on the target in time
+ */
+bool scenarioAutotune() {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = plantConfig.seed;
+    scenarioRest(&config);
+
+    float kP = gyroKp, kI = gyroKi, kD = gyroKd;
+    AutotuneResult result;
+    memset(&result, 0, sizeof(result));
+    bool tuned = autotuneGyro(&result);
+    unsigned long settled = 0;
+    double overshoot = 0, error = 0;
+    bool pass = false;
+    if (tuned) {
+        autotuneApply(&result);
+        pass = measureTurn(&settled, &overshoot, &error);
+    }
+    gyroKp = kP;
+    gyroKi = kI;
+    gyroKd = kD;
+    simReport("scenario=autotune result=%s ku=%.2f pu_ms=%d kp=%.2f ki=%.5f kd=%.0f settle_ms=%lu overshoot_deg=%.2f error_deg=%.2f\n",
+              pass ? "pass" : "fail", result.ultimateGain, (int) round(result.ultimatePeriod * 1000),
+              result.kP, result.kI, result.kD, settled, overshoot, error);
+    return pass;
+}
+
+/**
+ * The scenarios, in the order they are run.
+ */
+const Scenario scenarios[] = {
+    {"straight", scenarioStraight},
+    {"arc", scenarioArc},
+    {"path", scenarioPath},
+    {"pathstall", scenarioPathStall},
+    {"characterize", scenarioCharacterize},
+    {"characterizelimit", scenarioCharacterizeLimit},
+    {"pathff", scenarioPathFeedforward},
+    {"forward", scenarioForward},
+    {"rturn", scenarioRturn},
+    {"turn", scenarioTurn},
+    {"autotune", scenarioAutotune},
+};
+
+/**
+ * Returns whether a scenario was selected on the command line.
+ *
+ * @param name the scenario name
+ *
+ * @return true if the scenario should be run
+ */
+bool scenarioIsSelected(const char *name) {
+    if (scenarioSelectedCount == 0) {
+        return true;
+    }
+    for (int i = 0; i < scenarioSelectedCount; i++) {
+        if (strcmp(scenarioSelected[i], name) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+/**
+ * Runs the robot's initialization, then each selected scenario in turn.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void runScenarios(void *ignore) {
+    initialize();
+    streamEnabled = simUartFd[1] >= 0;
+    for (unsigned int i = 0; i < sizeof(scenarios) / sizeof(scenarios[0]); i++) {
+        if (scenarioIsSelected(scenarios[i].name) && !scenarios[i].run()) {
+            scenarioFailures++;
+        }
+    }
+}
+
+int main(int argc, char **argv) {
+    PlantConfig config;
+    plantDefaults(&config);
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-v") == 0) {
+            simEcho = true;
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            config.seed = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-u") == 0 && i + 1 < argc) {
+            simUartFd[1] = open(argv[++i], O_WRONLY | O_CREAT | O_TRUNC, 0644);
+            if (simUartFd[1] < 0) {
+                simReport("cannot open %s\n", argv[i]);
+                return 1;
+            }
+        } else {
+            // Gather the scenario names at the front of argv
+            argv[1 + scenarioSelectedCount++] = argv[i];
+        }
+    }
+    scenarioSelected = &argv[1];
+    plantReset(&config, ROBOT_START_POSITION_X, ROBOT_START_POSITION_Y, ROBOT_START_ANGLE);
+    simRun(runScenarios, NULL, plantStep);
+    return scenarioFailures;
+}
@@ -0,0 +1,340 @@
+/** @file songc.c
+ * @brief File for the host song compiler
+ *
+ * Compiles the RTTTL songs in src/songs.rtttl into the packed note arrays in src/songdata.c (see songs.h),
+ * so that the robot neither stores nor parses the RTTTL text. The build runs this whenever songs.rtttl changes.
+ *
+ * Each line of the input is a song, "name:defaults:notes". Lines starting with # and blank lines are ignored.
+ * The defaults are d (duration), o (octave) and b (tempo, in quarter notes per minute), which default to
+ * 4, 6 and 63 as in the RTTTL specification. Each note is an optional duration, a pitch (a to g, h for b, or p for
+ * a rest), an optional sharp (#), an optional dot, an optional octave and an optional dot, in that order.
+ * Spaces are ignored. An entry without a pitch, which some of the songs have, is skipped with a warning.
+ *
+ * Usage: songc songs.rtttl songdata.c
+ * Errors and warnings are printed to standard error as key=value lines; the exit status is 1 on an error.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <ctype.h>
+#include "songs.h"
+
+/**
+ * Defines the longest line of the input, in characters.
+ */
+#define SONGC_LINE_LENGTH 4096
+
+/**
+ * Defines the most notes a song can have.
+ */
+#define SONGC_MAX_NOTES 1024
+
+/**
+ * Defines the number of notes written on each line of the output.
+ */
+#define SONGC_NOTES_PER_LINE 10
+
+/**
+ * @brief A song being compiled.
+ */
+typedef struct SongcSong {
+    /**
+     * The RTTTL the song was compiled from.
+     */
+    char *source;
+
+    /**
+     * The tempo, in quarter notes per minute.
+     */
+    int tempo;
+
+    /**
+     * The number of notes.
+     */
+    int count;
+
+    /**
+     * The packed notes.
+     */
+    SongNote notes[SONGC_MAX_NOTES];
+} SongcSong;
+
+/**
+ * The songs compiled so far.
+ */
+SongcSong songcSongs[SONG_COUNT];
+
+/**
+ * The number of songs compiled so far.
+ */
+int songcCount = 0;
+
+/**
+ * The input line being compiled, for messages.
+ */
+int songcLine = 0;
+
+/**
+ * Removes every space from a string.
+ *
+ * @param text the string
+ */
+void songcStrip(char *text) {
+    char *out = text;
+    for (; *text != '\0'; text++) {
+        if (!isspace((unsigned char) *text)) {
+            *out++ = *text;
+        }
+    }
+    *out = '\0';
+}
+
+/**
+ * Reads a decimal number.
+ *
+ * @param text a pointer to the text, moved past the number
+ * @param fallback the value if there is no number
+ *
+ * @return the number
+ */
+int songcNumber(const char **text, int fallback) {
+    if (!isdigit((unsigned char) **text)) {
+        return fallback;
+    }
+    int value = 0;
+    while (isdigit((unsigned char) **text)) {
+        value = value * 10 + (*(*text)++ - '0');
+        if (value > 100000) {
+            value = 100000;
+        }
+    }
+    return value;
+}
+
+/**
+ * Compiles one note.
+ *
+ * @param token the note, without spaces
+ * @param duration the default duration
+ * @param octave the default octave
+ * @param note a pointer to store the packed note in
+ *
+ * @return 1 if the note was compiled, 0 if it has no pitch and was skipped, or -1 if it is invalid
+ */
+int songcNote(const char *token, int duration, int octave, SongNote *note) {
+    static const int pitches[7] = {10, 12, 1, 3, 5, 6, 8};
+    const char *text = token;
+    duration = songcNumber(&text, duration);
+    char letter = (char) tolower((unsigned char) *text);
+    int pitch;
+    if (letter >= 'a' && letter <= 'g') {
+        pitch = pitches[letter - 'a'];
+    } else if (letter == 'h') {
+        pitch = 12;
+    } else if (letter == 'p') {
+        pitch = SONG_REST;
+    } else if (letter == '\0') {
+        fprintf(stderr, "songc warning=\"skipped entry without a pitch\" line=%d entry=\"%s\"\n", songcLine, token);
+        return 0;
+    } else {
+        fprintf(stderr, "songc error=\"unknown pitch\" line=%d entry=\"%s\"\n", songcLine, token);
+        return -1;
+    }
+    text++;
+    bool sharp = false;
+    if (*text == '#') {
+        sharp = true;
+        text++;
+    }
+    bool dotted = false;
+    if (*text == '.') {
+        dotted = true;
+        text++;
+    }
+    octave = songcNumber(&text, octave);
+    if (*text == '.') {
+        dotted = true;
+        text++;
+    }
+    if (sharp && pitch != SONG_REST && ++pitch > SONG_PITCHES) {
+        // B sharp is the next octave's C
+        pitch = 1;
+        octave++;
+    }
+    if (*text != '\0' || duration < 1 || duration > SONG_MAX_DURATION || octave > SONG_MAX_OCTAVE) {
+        fprintf(stderr, "songc error=\"invalid note\" line=%d entry=\"%s\"\n", songcLine, token);
+        return -1;
+    }
+    *note = SONG_NOTE(duration, pitch, octave, dotted);
+    return 1;
+}
+
+/**
+ * Compiles one song.
+ *
+ * @param line the song's RTTTL
+ * @param song the song to fill
+ *
+ * @return true if the song was compiled
+ */
+bool songcSong(const char *line, SongcSong *song) {
+    song->source = strdup(line);
+    char *text = strdup(line);
+    char *defaults = strchr(text, ':');
+    char *notes = defaults != NULL ? strchr(defaults + 1, ':') : NULL;
+    if (notes == NULL) {
+        fprintf(stderr, "songc error=\"expected name:defaults:notes\" line=%d\n", songcLine);
+        free(text);
+        return false;
+    }
+    *notes++ = '\0';
+    songcStrip(++defaults);
+    songcStrip(notes);
+    int duration = 4, octave = 6, tempo = 63;
+    for (char *entry = strtok(defaults, ","); entry != NULL; entry = strtok(NULL, ",")) {
+        const char *value = entry + 2;
+        if (strlen(entry) < 3 || entry[1] != '=' || !isdigit((unsigned char) *value)) {
+            fprintf(stderr, "songc error=\"invalid default\" line=%d entry=\"%s\"\n", songcLine, entry);
+            free(text);
+            return false;
+        }
+        switch (tolower((unsigned char) entry[0])) {
+            case 'd': duration = songcNumber(&value, duration); break;
+            case 'o': octave = songcNumber(&value, octave); break;
+            case 'b': tempo = songcNumber(&value, tempo); break;
+        }
+    }
+    if (tempo < 1 || tempo > 0xFFFF) {
+        fprintf(stderr, "songc error=\"invalid tempo\" line=%d\n", songcLine);
+        free(text);
+        return false;
+    }
+    song->tempo = tempo;
+    song->count = 0;
+    char *entry = notes;
+    while (entry != NULL) {
+        char *next = strchr(entry, ',');
+        if (next != NULL) {
+            *next++ = '\0';
+        }
+        if (*entry != '\0') {
+            if (song->count == SONGC_MAX_NOTES) {
+                fprintf(stderr, "songc error=\"too many notes\" line=%d\n", songcLine);
+                free(text);
+                return false;
+            }
+            int result = songcNote(entry, duration, octave, &song->notes[song->count]);
+            if (result < 0) {
+                free(text);
+                return false;
+            }
+            song->count += result;
+        }
+        entry = next;
+    }
+    free(text);
+    return true;
+}
+
+/**
+ * Writes a string as a C string literal.
+ *
+ * @param out the file to write to
+ * @param text the string
+ */
+void songcWriteString(FILE *out, const char *text) {
+    fputc('"', out);
+    for (; *text != '\0'; text++) {
+        if (*text == '"' || *text == '\\') {
+            fputc('\\', out);
+        }
+        fputc(*text, out);
+    }
+    fputc('"', out);
+}
+
+/**
+ * Writes the compiled songs as C source.
+ *
+ * @param out the file to write to
+ */
+void songcWrite(FILE *out) {
+    fprintf(out, "/** @file songdata.c\n"
+                 " * @brief File for the precompiled speaker songs\n"
+                 " *\n"
+                 " * Generated from songs.rtttl by sim/songc.c; edit songs.rtttl instead of this file.\n"
+                 " *\n"
+                 " * @see songs.h\n"
+                 " */\n\n"
+                 "#include \"main.h\"\n\n"
+                 "#if SONG_COUNT != %d\n"
+                 "#error \"SONG_COUNT does not match the number of songs in songs.rtttl\"\n"
+                 "#endif\n", songcCount);
+    for (int i = 0; i < songcCount; i++) {
+        const SongcSong *song = &songcSongs[i];
+        fprintf(out, "\n/**\n * Notes of %.*s.\n */\nconst SongNote songNotes%d[%d] = {", (int) strcspn(song->source, ":"),
+                song->source, i, song->count);
+        for (int n = 0; n < song->count; n++) {
+            fprintf(out, "%s0x%04X%s", n % SONGC_NOTES_PER_LINE == 0 ? "\n    " : " ", song->notes[n],
+                    n + 1 < song->count ? "," : "\n");
+        }
+        fprintf(out, "};\n");
+    }
+    fprintf(out, "\n/**\n * Master list of all songs, in the order of songs.rtttl.\n */\nconst Song songs[SONG_COUNT] = {\n");
+    for (int i = 0; i < songcCount; i++) {
+        fprintf(out, "    {songNotes%d, %d, %d},\n", i, songcSongs[i].count, songcSongs[i].tempo);
+    }
+    fprintf(out, "};\n\n#ifdef SIMULATOR\n/**\n * The RTTTL each song was compiled from.\n */\n"
+                 "const char * const songSources[SONG_COUNT] = {\n");
+    for (int i = 0; i < songcCount; i++) {
+        fprintf(out, "    ");
+        songcWriteString(out, songcSongs[i].source);
+        fprintf(out, ",\n");
+    }
+    fprintf(out, "};\n#endif\n");
+}
+
+int main(int argc, char **argv) {
+    if (argc != 3) {
+        fprintf(stderr, "usage: songc songs.rtttl songdata.c\n");
+        return 2;
+    }
+    FILE *in = fopen(argv[1], "r");
+    if (in == NULL) {
+        fprintf(stderr, "songc error=\"cannot open %s\"\n", argv[1]);
+        return 1;
+    }
+    char line[SONGC_LINE_LENGTH];
+    while (fgets(line, sizeof(line), in) != NULL) {
+        songcLine++;
+        line[strcspn(line, "\r\n")] = '\0';
+        const char *start = line + strspn(line, " \t");
+        if (*start == '\0' || *start == '#') {
+            continue;
+        }
+        if (songcCount == SONG_COUNT) {
+            fprintf(stderr, "songc error=\"more than SONG_COUNT (%d) songs\" line=%d\n", SONG_COUNT, songcLine);
+            fclose(in);
+            return 1;
+        }
+        if (!songcSong(start, &songcSongs[songcCount++])) {
+            fclose(in);
+            return 1;
+        }
+    }
+    fclose(in);
+    if (songcCount != SONG_COUNT) {
+        fprintf(stderr, "songc error=\"%d songs but SONG_COUNT is %d\"\n", songcCount, SONG_COUNT);
+        return 1;
+    }
+    FILE *out = fopen(argv[2], "w");
+    if (out == NULL) {
+        fprintf(stderr, "songc error=\"cannot write %s\"\n", argv[2]);
+        return 1;
+    }
+    songcWrite(out);
+    fclose(out);
+    return 0;
+}
@@ -0,0 +1,264 @@
+/** @file songcheck.c
+ * @brief File for the host simulator's check of the precompiled speaker songs
+ *
+ * Checks that every song in songdata.c plays the same notes as the RTTTL it was compiled from.
+ * Each song's RTTTL is read here with a parser of its own, independent of the song compiler, into the
+ * frequency and length of every note. These are compared with the one-note RTTTL that playSong() hands to the speaker
+ * for each compiled note, read with the same parser, so the check covers both the compiler and the player.
+ *
+ * Frequencies may differ by 1 Hz and lengths by 1 ms, to allow for rounding.
+ *
+ * Usage: songcheck
+ * Prints a key=value line for each song and a summary with the flash used by the songs and by their RTTTL text.
+ * The exit status is the number of songs that did not match.
+ */
+
+#include <ctype.h>
+#include "main.h"
+#include "sim.h"
+
+/**
+ * Defines the largest difference between a played and a parsed frequency that is not a mismatch, in hertz.
+ */
+#define SONGCHECK_FREQUENCY_TOLERANCE 1
+
+/**
+ * Defines the largest difference between a played and a parsed length that is not a mismatch, in milliseconds.
+ */
+#define SONGCHECK_DURATION_TOLERANCE 1
+
+/**
+ * Defines the most notes a song can have.
+ */
+#define SONGCHECK_MAX_NOTES 1024
+
+/**
+ * Defines the number of mismatches printed for each song.
+ */
+#define SONGCHECK_MAX_REPORTS 5
+
+/**
+ * @brief A note as it sounds.
+ */
+typedef struct SongcheckNote {
+    /**
+     * The frequency, in hertz, or 0 for a rest.
+     */
+    double frequency;
+
+    /**
+     * The length, in milliseconds.
+     */
+    double duration;
+} SongcheckNote;
+
+/**
+ * The notes of the song being checked, parsed from its RTTTL.
+ */
+SongcheckNote songcheckExpected[SONGCHECK_MAX_NOTES];
+
+/**
+ * The notes playSong() handed to the speaker for the song being checked, parsed from their RTTTL.
+ */
+SongcheckNote songcheckPlayed[SONGCHECK_MAX_NOTES];
+
+/**
+ * The number of notes playSong() handed to the speaker.
+ */
+int songcheckPlayedCount = 0;
+
+/**
+ * Skips spaces.
+ *
+ * @param text the text
+ *
+ * @return the first character of the text that is not a space
+ */
+const char* songcheckSkip(const char *text) {
+    while (*text == ' ' || *text == '\t') {
+        text++;
+    }
+    return text;
+}
+
+/**
+ * Reads a number that may have spaces between its digits.
+ *
+ * @param text a pointer to the text, moved past the number
+ *
+ * @return the number, or -1 if there is none
+ */
+int songcheckNumber(const char **text) {
+    int value = -1;
+    const char *c = songcheckSkip(*text);
+    while (*c >= '0' && *c <= '9') {
+        value = (value < 0 ? 0 : value * 10) + (*c - '0');
+        c = songcheckSkip(c + 1);
+    }
+    *text = c;
+    return value;
+}
+
+/**
+ * Parses RTTTL into the frequency and length of each note.
+ * Octave 4's A is 440 Hz, and a beat is a quarter note.
+ *
+ * @param rtttl the RTTTL
+ * @param notes the array to store the notes in
+ * @param limit the size of the array
+ *
+ * @return the number of notes, or -1 if the RTTTL is malformed
+ */
+int songcheckParse(const char *rtttl, SongcheckNote *notes, int limit) {
+    const char *c = strchr(rtttl, ':');
+    if (c == NULL) {
+        return -1;
+    }
+    int defaultDuration = 4, defaultOctave = 6, tempo = 63;
+    c++;
+    while (*(c = songcheckSkip(c)) != ':') {
+        if (*c == '\0') {
+            return -1;
+        }
+        char key = (char) tolower(*c);
+        c = songcheckSkip(c + 1);
+        if (*c != '=') {
+            return -1;
+        }
+        c++;
+        int value = songcheckNumber(&c);
+        if (key == 'd') {
+            defaultDuration = value;
+        } else if (key == 'o') {
+            defaultOctave = value;
+        } else if (key == 'b') {
+            tempo = value;
+        }
+        c = songcheckSkip(c);
+        if (*c == ',') {
+            c++;
+        }
+    }
+    c++;
+    int count = 0;
+    while (*(c = songcheckSkip(c)) != '\0') {
+        int duration = songcheckNumber(&c);
+        char letter = (char) tolower(*c);
+        // Semitones above octave 0's C
+        static const char names[] = "c d ef g a bh";
+        const char *name = (letter != '\0' && letter != ' ') ? strchr(names, letter) : NULL;
+        if (name == NULL && letter != 'p') {
+            // An entry without a pitch plays nothing
+            if (*c != ',' && *c != '\0') {
+                return -1;
+            }
+            if (*c == ',') {
+                c++;
+            }
+            continue;
+        }
+        int semitone = (letter == 'h') ? 11 : (name != NULL ? (int) (name - names) : -1);
+        c = songcheckSkip(c + 1);
+        if (*c == '#') {
+            semitone++;
+            c = songcheckSkip(c + 1);
+        }
+        double length = 1.0;
+        if (*c == '.') {
+            length = 1.5;
+            c = songcheckSkip(c + 1);
+        }
+        int octave = songcheckNumber(&c);
+        if (*c == '.') {
+            length = 1.5;
+            c = songcheckSkip(c + 1);
+        }
+        if (*c == ',') {
+            c++;
+        } else if (*c != '\0') {
+            return -1;
+        }
+        if (count == limit) {
+            return -1;
+        }
+        duration = duration > 0 ? duration : defaultDuration;
+        octave = octave >= 0 ? octave : defaultOctave;
+        notes[count].duration = 60000.0 / tempo * 4 / duration * length;
+        notes[count].frequency = (letter == 'p') ? 0 : 440 * pow(2, (octave * 12 + semitone - (4 * 12 + 9)) / 12.0);
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Parses each note playSong() hands to the speaker.
+ *
+ * @param rtttl the note's RTTTL
+ */
+void songcheckSpeaker(const char *rtttl) {
+    SongcheckNote note[2];
+    if (songcheckParse(rtttl, note, 2) != 1) {
+        simReport("songcheck error=\"played malformed RTTTL\" rtttl=\"%s\"\n", rtttl);
+        note[0].frequency = -1;
+        note[0].duration = -1;
+    }
+    if (songcheckPlayedCount < SONGCHECK_MAX_NOTES) {
+        songcheckPlayed[songcheckPlayedCount] = note[0];
+    }
+    songcheckPlayedCount++;
+}
+
+/**
+ * Compares one note with the note it should be.
+ *
+ * @param index the song number
+ * @param what the kind of note being compared
+ * @param n the note number
+ * @param frequency the note's frequency, in hertz
+ * @param duration the note's length, in milliseconds
+ * @param reports a pointer to the number of mismatches printed so far
+ *
+ * @return true if the note matches
+ */
+bool songcheckNote(int index, const char *what, int n, double frequency, double duration, int *reports) {
+    const SongcheckNote *expected = &songcheckExpected[n];
+    if (abs(frequency - expected->frequency) <= SONGCHECK_FREQUENCY_TOLERANCE &&
+            abs(duration - expected->duration) <= SONGCHECK_DURATION_TOLERANCE) {
+        return true;
+    }
+    if ((*reports)++ < SONGCHECK_MAX_REPORTS) {
+        simReport("songcheck song=%d note=%d %s_hz=%.1f expected_hz=%.1f %s_ms=%.1f expected_ms=%.1f\n", index, n,
+                  what, frequency, expected->frequency, what, duration, expected->duration);
+    }
+    return false;
+}
+
+int main(int argc, char **argv) {
+    int failures = 0;
+    size_t compiledBytes = sizeof(songs);
+    size_t textBytes = sizeof(char *) * SONG_COUNT;
+    simSpeakerHook = songcheckSpeaker;
+    for (int i = 0; i < SONG_COUNT; i++) {
+        const Song *song = &songs[i];
+        compiledBytes += sizeof(SongNote) * song->count;
+        textBytes += strlen(songSources[i]) + 1;
+        int expected = songcheckParse(songSources[i], songcheckExpected, SONGCHECK_MAX_NOTES);
+        bool pass = expected == song->count;
+        int reports = 0;
+        if (pass) {
+            songcheckPlayedCount = 0;
+            playSong(song);
+            pass &= songcheckPlayedCount == song->count;
+            for (int n = 0; n < min(songcheckPlayedCount, song->count); n++) {
+                pass &= songcheckNote(i, "played", n, songcheckPlayed[n].frequency, songcheckPlayed[n].duration, &reports);
+            }
+        }
+        simReport("songcheck song=%d name=\"%.*s\" notes=%d expected_notes=%d played_notes=%d result=%s\n", i,
+                  (int) strcspn(songSources[i], ":"), songSources[i], song->count, expected, songcheckPlayedCount,
+                  pass ? "pass" : "fail");
+        failures += !pass;
+    }
+    simReport("songcheck songs=%d failures=%d compiled_bytes=%u rtttl_bytes=%u\n", SONG_COUNT, failures,
+              (unsigned int) compiledBytes, (unsigned int) textBytes);
+    return failures;
+}
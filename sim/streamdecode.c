@@ -0,0 +1,315 @@
+/** @file streamdecode.c
+ * @brief Host decoder for the binary telemetry stream
+ *
+ * Reads the telemetry stream (see telestream.h) from a serial port or a capture file and prints it as CSV
+ * as it arrives, one row per sample packet. Each column is a channel that is being sampled; a cell is empty
+ * if its channel was not sampled in that packet. The column headings are printed again whenever the robot
+ * describes a different set of channels. Rows are only printed once the channels have been described,
+ * which the robot does every STREAM_DESCRIBE_PERIOD.
+ *
+ * Usage: streamdecode [-b baud] [device|capture]
+ *     -b baud  the baud rate to set on a serial port (default STREAM_BAUD)
+ * Reads standard input if no device or capture is given. Packets that fail their CRC, and packets lost
+ * according to their sequence numbers, are counted and reported on standard error at the end.
+ *
+ * Like bbdecode, the decoder runs on the host's own C library and only links the robot code's
+ * CRC and COBS functions.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <termios.h>
+#include "crc.h"
+#include "cobs.h"
+#include "telestream.h"
+
+/**
+ * Defines the largest number of channel ID numbers the decoder can track.
+ */
+#define DECODE_MAX_CHANNELS 256
+
+/**
+ * Defines the longest encoded packet accepted. Anything longer is line noise and is discarded.
+ */
+#define DECODE_MAX_ENCODED 1024
+
+/**
+ * @brief What the decoder knows about a channel.
+ */
+typedef struct DecodeChannel {
+    /**
+     * Whether the channel has been described.
+     */
+    bool known;
+
+    /**
+     * The name of the channel.
+     */
+    char name[STREAM_NAME_LENGTH + 1];
+
+    /**
+     * The number of decimal places the channel's values are sent with.
+     */
+    int decimals;
+
+    /**
+     * The sampling period of the channel, in milliseconds, or 0 if it is not being sampled.
+     */
+    int period;
+
+    /**
+     * Whether the channel was sampled in the current packet.
+     */
+    bool sampled;
+
+    /**
+     * The channel's value in the current packet, in fixed point.
+     */
+    long value;
+} DecodeChannel;
+
+/**
+ * What the decoder knows about each channel, indexed by channel ID number.
+ */
+DecodeChannel channels[DECODE_MAX_CHANNELS];
+
+/**
+ * Whether the channel descriptions have changed since the column headings were last printed.
+ */
+bool headingsChanged = false;
+
+/**
+ * Whether any column headings have been printed.
+ */
+bool headingsPrinted = false;
+
+/**
+ * The number of valid packets received.
+ */
+unsigned long packets = 0;
+
+/**
+ * The number of packets lost, according to the gaps in their sequence numbers.
+ */
+unsigned long lost = 0;
+
+/**
+ * The number of packets that were malformed or failed their CRC.
+ */
+unsigned long corrupt = 0;
+
+/**
+ * The sequence number of the last valid packet, or -1 if none has been received.
+ */
+int lastSequence = -1;
+
+/**
+ * Reads a 16-bit little-endian value from a packet.
+ */
+unsigned int get16(const unsigned char *packet) {
+    return packet[0] | (unsigned int) packet[1] << 8;
+}
+
+/**
+ * Reads a 32-bit little-endian value from a packet.
+ */
+unsigned long get32(const unsigned char *packet) {
+    return get16(packet) | (unsigned long) get16(packet + 2) << 16;
+}
+
+/**
+ * Prints the column headings: the timestamp, then every channel that is being sampled.
+ */
+void printHeadings() {
+    printf("time_ms");
+    for (int i = 0; i < DECODE_MAX_CHANNELS; i++) {
+        if (channels[i].known && channels[i].period != 0) {
+            printf(",%s", channels[i].name);
+        }
+    }
+    printf("\n");
+    headingsChanged = false;
+    headingsPrinted = true;
+}
+
+/**
+ * Handles a packet describing a channel.
+ *
+ * @param packet the packet, without its CRC
+ * @param length the length of the packet
+ */
+void handleChannel(const unsigned char *packet, unsigned int length) {
+    if (length < 6) {
+        corrupt++;
+        return;
+    }
+    DecodeChannel *channel = &channels[packet[2]];
+    char name[STREAM_NAME_LENGTH + 1];
+    unsigned int nameLength = length - 6 < STREAM_NAME_LENGTH ? length - 6 : STREAM_NAME_LENGTH;
+    memcpy(name, &packet[6], nameLength);
+    name[nameLength] = '\0';
+    int period = get16(&packet[4]);
+    // Only a change in the set of sampled channels changes the columns, not a change of rate
+    bool wasColumn = channel->known && channel->period != 0;
+    if (wasColumn != (period != 0) || (wasColumn && strcmp(channel->name, name) != 0)) {
+        headingsChanged = true;
+    }
+    channel->known = true;
+    channel->period = period;
+    channel->decimals = packet[3];
+    strcpy(channel->name, name);
+}
+
+/**
+ * Handles a packet of channel samples, printing it as a row.
+ *
+ * @param packet the packet, without its CRC
+ * @param length the length of the packet
+ */
+void handleSamples(const unsigned char *packet, unsigned int length) {
+    if (length < 6 || (length - 6) % 5 != 0) {
+        corrupt++;
+        return;
+    }
+    for (int i = 0; i < DECODE_MAX_CHANNELS; i++) {
+        channels[i].sampled = false;
+    }
+    for (unsigned int i = 6; i < length; i += 5) {
+        DecodeChannel *channel = &channels[packet[i]];
+        channel->sampled = true;
+        channel->value = (long) (int32_t) get32(&packet[i + 1]);
+    }
+    if (!headingsPrinted && !headingsChanged) {
+        // Nothing has been described yet, so the columns are unknown
+        return;
+    }
+    if (headingsChanged) {
+        printHeadings();
+    }
+    printf("%lu", get32(&packet[2]));
+    for (int i = 0; i < DECODE_MAX_CHANNELS; i++) {
+        const DecodeChannel *channel = &channels[i];
+        if (!channel->known || channel->period == 0) {
+            continue;
+        }
+        if (!channel->sampled) {
+            printf(",");
+        } else if (channel->decimals == 0) {
+            printf(",%ld", channel->value);
+        } else {
+            double scale = 1;
+            for (int d = 0; d < channel->decimals; d++) {
+                scale *= 10;
+            }
+            printf(",%.*f", channel->decimals, channel->value / scale);
+        }
+    }
+    printf("\n");
+}
+
+/**
+ * Decodes and handles one COBS-encoded packet.
+ *
+ * @param encoded the encoded packet, without its zero delimiter
+ * @param length the length of the encoded packet
+ */
+void handlePacket(const unsigned char *encoded, unsigned int length) {
+    unsigned char packet[DECODE_MAX_ENCODED];
+    unsigned int size = cobsDecode(encoded, length, packet);
+    if (size < 4 || crc16(CRC16_INIT, packet, size - 2) != get16(&packet[size - 2])) {
+        corrupt++;
+        return;
+    }
+    size -= 2;
+    if (lastSequence >= 0) {
+        lost += (packet[1] - lastSequence - 1) & 0xFF;
+    }
+    lastSequence = packet[1];
+    packets++;
+    if (packet[0] == STREAM_PACKET_CHANNEL) {
+        handleChannel(packet, size);
+    } else if (packet[0] == STREAM_PACKET_SAMPLES) {
+        handleSamples(packet, size);
+    }
+}
+
+/**
+ * Puts a serial port into raw mode at a baud rate.
+ *
+ * @param fd the serial port
+ * @param baud the baud rate
+ *
+ * @return true if the port was configured
+ */
+bool configurePort(int fd, long baud) {
+    static const long rates[] = {9600, 19200, 38400, 57600, 115200, 230400};
+    static const speed_t speeds[] = {B9600, B19200, B38400, B57600, B115200, B230400};
+    struct termios tty;
+    if (tcgetattr(fd, &tty) != 0) {
+        return false;
+    }
+    for (unsigned int i = 0; i < sizeof(rates) / sizeof(rates[0]); i++) {
+        if (rates[i] == baud) {
+            cfmakeraw(&tty);
+            cfsetispeed(&tty, speeds[i]);
+            cfsetospeed(&tty, speeds[i]);
+            return tcsetattr(fd, TCSANOW, &tty) == 0;
+        }
+    }
+    return false;
+}
+
+int main(int argc, char **argv) {
+    long baud = STREAM_BAUD;
+    const char *path = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-b") == 0 && i + 1 < argc) {
+            baud = strtol(argv[++i], NULL, 10);
+        } else {
+            path = argv[i];
+        }
+    }
+    int fd = 0;
+    if (path != NULL && (fd = open(path, O_RDONLY | O_NOCTTY)) < 0) {
+        perror(path);
+        return 1;
+    }
+    if (isatty(fd) && !configurePort(fd, baud)) {
+        fprintf(stderr, "%s: cannot set baud rate %ld\n", path != NULL ? path : "stdin", baud);
+        return 1;
+    }
+    // Rows are flushed as they arrive, so that the output can be watched or piped live
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    unsigned char encoded[DECODE_MAX_ENCODED];
+    unsigned int length = 0;
+    bool overflow = false;
+    unsigned char buffer[512];
+    ssize_t count;
+    while ((count = read(fd, buffer, sizeof(buffer))) > 0) {
+        for (ssize_t i = 0; i < count; i++) {
+            if (buffer[i] != 0) {
+                if (length < sizeof(encoded)) {
+                    encoded[length++] = buffer[i];
+                } else {
+                    overflow = true;
+                }
+            } else {
+                if (overflow) {
+                    corrupt++;
+                } else if (length > 0) {
+                    handlePacket(encoded, length);
+                }
+                length = 0;
+                overflow = false;
+            }
+        }
+    }
+    fprintf(stderr, "packets=%lu lost=%lu corrupt=%lu\n", packets, lost, corrupt);
+    return 0;
+}
@@ -0,0 +1,580 @@
+/** @file tune.c
+ * @brief File for the host simulator's parallel PID gain search
+ *
+ * Searches for the gains of one of the robot code's control loops by running the loop against the plant with
+ * many candidate sets of gains. Every candidate runs the same episodes: the same moves with the same plant
+ * noise seeds, so that candidates are compared on equal terms. Each episode is scored on how long the loop
+ * takes to settle, how far it overshoots and its final error, and a candidate's score is its mean episode score.
+ * Lower scores are better.
+ *
+ * The search is a grid over each gain's range, refined over several rounds. Each round's grid is centered on
+ * the best candidate so far and spans one grid step of the previous round on each side. The first round also
+ * scores the gains currently compiled in, as a baseline.
+ *
+ * The robot code and the simulator keep all of their state in globals, so two episodes cannot run in one
+ * process at the same time. Each round's candidates are instead shared out between a pool of worker
+ * processes, one per core by default, each running its own simulator and sending its scores back over a pipe.
+ *
+ * The best gains are written as debug terminal commands for the parameter registry (see paramCommand()),
+ * ending with a save, so that sending the file to the robot's debug terminal loads and saves them.
+ *
+ * Usage: tune [-j jobs] [-g points] [-r rounds] [-s seeds] [-o file] loop
+ *     loop       turn, for targetNet() and the gyro_k* parameters,
+ *                or straight, for moveStraight() and the encoder_k* parameters
+ *     -j jobs    the number of worker processes (default: the number of cores)
+ *     -g points  the number of grid points per gain in each round (default TUNE_POINTS)
+ *     -r rounds  the number of rounds (default TUNE_ROUNDS)
+ *     -s seeds   the number of plant noise seeds each episode is run with (default TUNE_SEEDS)
+ *     -o file    the parameter file to write (default: standard output)
+ * The results of each round are printed as key=value lines.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+#include "main.h"
+#include "sim.h"
+#include "plant.h"
+
+/**
+ * Defines the number of gains searched, which are always a proportional, integral and derivative gain.
+ */
+#define TUNE_GAINS 3
+
+/**
+ * Defines the default number of grid points per gain in each round.
+ */
+#define TUNE_POINTS 5
+
+/**
+ * Defines the default number of rounds.
+ */
+#define TUNE_ROUNDS 4
+
+/**
+ * Defines the default number of plant noise seeds each episode is run with.
+ */
+#define TUNE_SEEDS 2
+
+/**
+ * Defines the period of the episode control loops, in milliseconds. Matches the operator control loop.
+ */
+#define TUNE_PERIOD 20
+
+/**
+ * Defines how long the robot is left at rest before each episode, in milliseconds.
+ */
+#define TUNE_REST_TIME 200
+
+/**
+ * Defines how long each turn episode runs for, in milliseconds.
+ */
+#define TUNE_TURN_TIME 3000
+
+/**
+ * Defines how close to the target a turn must stay to count as settled, in degrees.
+ */
+#define TUNE_TURN_TOLERANCE 2.0
+
+/**
+ * Defines how long each drive-straight episode runs for, in milliseconds.
+ */
+#define TUNE_STRAIGHT_TIME 2000
+
+/**
+ * Defines how close to its starting heading the robot must stay while driving straight to count as settled, in degrees.
+ */
+#define TUNE_STRAIGHT_TOLERANCE 1.0
+
+/**
+ * Defines the score of each degree of overshoot, relative to each second of settle time.
+ */
+#define TUNE_OVERSHOOT_WEIGHT 0.05
+
+/**
+ * Defines the score of each degree of final error, relative to each second of settle time.
+ */
+#define TUNE_ERROR_WEIGHT 0.2
+
+/**
+ * @brief The measurements of an episode, or the mean measurements of a candidate's episodes.
+ */
+typedef struct TuneMetrics {
+    /**
+     * The time the loop last left its tolerance band, in milliseconds.
+     */
+    double settle;
+
+    /**
+     * The largest overshoot past the target, in degrees.
+     */
+    double overshoot;
+
+    /**
+     * The size of the final error, in degrees.
+     */
+    double error;
+} TuneMetrics;
+
+/**
+ * @brief A candidate set of gains and its results.
+ */
+typedef struct TuneCandidate {
+    /**
+     * The gains, in the order of the loop's parameters.
+     */
+    float gains[TUNE_GAINS];
+
+    /**
+     * The mean episode score.
+     */
+    double score;
+
+    /**
+     * The mean episode measurements.
+     */
+    TuneMetrics metrics;
+} TuneCandidate;
+
+/**
+ * @brief A result sent from a worker process.
+ */
+typedef struct TuneResult {
+    /**
+     * The index of the candidate in the round.
+     */
+    int index;
+
+    /**
+     * The mean episode score.
+     */
+    double score;
+
+    /**
+     * The mean episode measurements.
+     */
+    TuneMetrics metrics;
+} TuneResult;
+
+/**
+ * @brief A control loop that can be tuned.
+ */
+typedef struct TuneLoop {
+    /**
+     * The name used to select the loop on the command line.
+     */
+    const char *name;
+
+    /**
+     * The parameter ID numbers of the loop's proportional, integral and derivative gains.
+     */
+    int params[TUNE_GAINS];
+
+    /**
+     * The lower end of each gain's range in the first round.
+     */
+    float low[TUNE_GAINS];
+
+    /**
+     * The upper end of each gain's range in the first round.
+     */
+    float high[TUNE_GAINS];
+
+    /**
+     * The number of episodes run with each seed.
+     */
+    int episodes;
+
+    /**
+     * Runs one episode from rest with the current gains.
+     *
+     * @param episode the episode number (0 to episodes-1)
+     * @param metrics a pointer to store the measurements in
+     */
+    void (*run)(int episode, TuneMetrics *metrics);
+} TuneLoop;
+
+/**
+ * The target angles of the turn episodes, in degrees.
+ */
+const int tuneTurnTargets[] = {30, 45, 90, -60};
+
+/**
+ * The strength of the right side of the drive in the drive-straight episodes.
+ */
+const double tuneStraightStrengths[] = {0.85, 1.15};
+
+/**
+ * The speeds the drive-straight episodes drive at.
+ */
+const int tuneStraightSpeeds[] = {60, 100};
+
+/**
+ * The loop being tuned.
+ */
+const TuneLoop *tuneLoop;
+
+/**
+ * The candidates of the current round.
+ */
+TuneCandidate *tuneCandidates;
+
+/**
+ * The number of candidates in the current round.
+ */
+int tuneCandidateCount = 0;
+
+/**
+ * The number of worker processes.
+ */
+int tuneJobs = 1;
+
+/**
+ * The number of plant noise seeds each episode is run with.
+ */
+int tuneSeeds = TUNE_SEEDS;
+
+/**
+ * The plant noise seed of the episode being run.
+ */
+unsigned long long tuneSeed = 1;
+
+/**
+ * Stops the drive and gives the robot a new configuration at rest, so that each episode starts from a standstill.
+ *
+ * @param config the configuration of the robot for the episode
+ */
+void tuneRest(const PlantConfig *config) {
+    move(0, 0, 0);
+    plantReset(config, plant.x, plant.y, degrees(plant.heading));
+    delay(TUNE_REST_TIME);
+}
+
+/**
+ * Turns to one of the turn targets with targetNet().
+ *
+ * @param episode the index of the target
+ * @param metrics a pointer to store the measurements in
+ */
+void tuneTurn(int episode, TuneMetrics *metrics) {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = tuneSeed;
+    tuneRest(&config);
+
+    int target = tuneTurnTargets[episode];
+    double startHeading = plant.heading;
+    metrics->settle = 0;
+    metrics->overshoot = 0;
+    resetGyroVariables();
+    unsigned long start = millis();
+    unsigned long wakeTime = start;
+    while (millis() - start < TUNE_TURN_TIME) {
+        moveCompensated(0, targetNet(target), 0);
+        taskDelayUntil(&wakeTime, TUNE_PERIOD);
+        double turned = plantTurnedSince(startHeading);
+        // Overshoot is past the target in the direction of the turn
+        metrics->overshoot = max(metrics->overshoot, (target > 0) ? turned - target : target - turned);
+        if (abs(turned - target) > TUNE_TURN_TOLERANCE) {
+            metrics->settle = millis() - start;
+        }
+    }
+    move(0, 0, 0);
+    metrics->error = abs(plantTurnedSince(startHeading) - target);
+}
+
+/**
+ * Drives straight with moveStraight(), with one side of the drive weaker or stronger than the other.
+ * The error is the change in heading.
+ *
+ * @param episode the index of the strength and speed
+ * @param metrics a pointer to store the measurements in
+ */
+void tuneStraight(int episode, TuneMetrics *metrics) {
+    PlantConfig config;
+    plantDefaults(&config);
+    config.seed = tuneSeed;
+    config.strength[PLANT_RIGHT] = tuneStraightStrengths[episode % 2];
+    tuneRest(&config);
+
+    int speed = tuneStraightSpeeds[episode / 2];
+    double startHeading = plant.heading;
+    metrics->settle = 0;
+    metrics->overshoot = 0;
+    resetEncoderVariables();
+    unsigned long start = millis();
+    unsigned long wakeTime = start;
+    while (millis() - start < TUNE_STRAIGHT_TIME) {
+        moveStraight(speed);
+        taskDelayUntil(&wakeTime, TUNE_PERIOD);
+        double heading = plantTurnedSince(startHeading);
+        metrics->overshoot = max(metrics->overshoot, abs(heading));
+        if (abs(heading) > TUNE_STRAIGHT_TOLERANCE) {
+            metrics->settle = millis() - start;
+        }
+    }
+    move(0, 0, 0);
+    metrics->error = abs(plantTurnedSince(startHeading));
+}
+
+/**
+ * The loops that can be tuned.
+ */
+const TuneLoop tuneLoops[] = {
+    {"turn", {PARAM_GYRO_KP, PARAM_GYRO_KI, PARAM_GYRO_KD}, {0, 0, 0}, {20, 0.001, 8000},
+     sizeof(tuneTurnTargets) / sizeof(tuneTurnTargets[0]), tuneTurn},
+    {"straight", {PARAM_ENCODER_KP, PARAM_ENCODER_KI, PARAM_ENCODER_KD}, {0, 0, 0}, {20, 0.01, 100},
+     4, tuneStraight},
+};
+
+/**
+ * Scores an episode's measurements.
+ *
+ * @param metrics the measurements
+ *
+ * @return the score; lower is better
+ */
+double tuneScore(const TuneMetrics *metrics) {
+    return metrics->settle / 1000.0 + TUNE_OVERSHOOT_WEIGHT * metrics->overshoot + TUNE_ERROR_WEIGHT * metrics->error;
+}
+
+/**
+ * Runs every episode of the loop with a candidate's gains.
+ *
+ * @param candidate the candidate
+ * @param result a pointer to store the mean score and measurements in
+ */
+void tuneEvaluate(const TuneCandidate *candidate, TuneResult *result) {
+    for (int i = 0; i < TUNE_GAINS; i++) {
+        paramSet(tuneLoop->params[i], candidate->gains[i]);
+    }
+    memset(result, 0, sizeof(*result));
+    int runs = 0;
+    for (int seed = 1; seed <= tuneSeeds; seed++) {
+        tuneSeed = seed;
+        for (int episode = 0; episode < tuneLoop->episodes; episode++) {
+            TuneMetrics metrics;
+            tuneLoop->run(episode, &metrics);
+            result->score += tuneScore(&metrics);
+            result->metrics.settle += metrics.settle;
+            result->metrics.overshoot += metrics.overshoot;
+            result->metrics.error += metrics.error;
+            runs++;
+        }
+    }
+    result->score /= runs;
+    result->metrics.settle /= runs;
+    result->metrics.overshoot /= runs;
+    result->metrics.error /= runs;
+}
+
+/**
+ * Runs a worker's share of the round's candidates and writes their results to a pipe.
+ * Worker n evaluates every candidate whose index leaves a remainder of n when divided by the number of jobs.
+ *
+ * @param param the worker number and the pipe, as an array of two ints
+ */
+void tuneWorker(void *param) {
+    int worker = ((int *) param)[0];
+    int fd = ((int *) param)[1];
+    initialize();
+    for (int i = worker; i < tuneCandidateCount; i += tuneJobs) {
+        TuneResult result;
+        tuneEvaluate(&tuneCandidates[i], &result);
+        result.index = i;
+        if (write(fd, &result, sizeof(result)) != sizeof(result)) {
+            break;
+        }
+    }
+}
+
+/**
+ * Runs a worker process, which evaluates its share of the round's candidates on a fresh simulation.
+ *
+ * @param worker the worker number
+ * @param fd the pipe to write the results to
+ * @param ignore does nothing - required by simParallel()
+ */
+void tuneProcess(int worker, int fd, void *ignore) {
+    int param[2] = {worker, fd};
+    PlantConfig config;
+    plantDefaults(&config);
+    plantReset(&config, ROBOT_START_POSITION_X, ROBOT_START_POSITION_Y, ROBOT_START_ANGLE);
+    simRun(tuneWorker, param, plantStep);
+}
+
+/**
+ * Stores a candidate's result from a worker process.
+ *
+ * @param record the TuneResult
+ * @param ignore does nothing - required by simParallel()
+ *
+ * @return true if the result is for a candidate of the round
+ */
+bool tuneCollect(const void *record, void *ignore) {
+    const TuneResult *result = (const TuneResult *) record;
+    if (result->index < 0 || result->index >= tuneCandidateCount) {
+        return false;
+    }
+    tuneCandidates[result->index].score = result->score;
+    tuneCandidates[result->index].metrics = result->metrics;
+    return true;
+}
+
+/**
+ * Evaluates every candidate of the round on the worker processes.
+ *
+ * @return true if every candidate was evaluated
+ */
+bool tuneRound() {
+    return simParallel(tuneProcess, tuneCollect, sizeof(TuneResult), NULL, tuneJobs) == tuneCandidateCount;
+}
+
+/**
+ * Fills the round's candidates with a grid over a range of each gain.
+ *
+ * @param low the lower end of each gain's range
+ * @param high the upper end of each gain's range
+ * @param points the number of grid points per gain
+ */
+void tuneGrid(const float *low, const float *high, int points) {
+    tuneCandidateCount = 0;
+    int total = 1;
+    for (int i = 0; i < TUNE_GAINS; i++) {
+        total *= points;
+    }
+    for (int n = 0; n < total; n++) {
+        TuneCandidate *candidate = &tuneCandidates[tuneCandidateCount++];
+        memset(candidate, 0, sizeof(*candidate));
+        int digits = n;
+        for (int i = 0; i < TUNE_GAINS; i++) {
+            candidate->gains[i] = low[i] + (high[i] - low[i]) * (digits % points) / (points - 1);
+            digits /= points;
+        }
+    }
+}
+
+/**
+ * Prints a candidate's gains and results.
+ *
+ * @param label the first field of the line
+ * @param candidate the candidate
+ */
+void tuneReport(const char *label, const TuneCandidate *candidate) {
+    simReport("%s score=%.4f", label, candidate->score);
+    for (int i = 0; i < TUNE_GAINS; i++) {
+        simReport(" %s=%g", params[tuneLoop->params[i]].name, candidate->gains[i]);
+    }
+    simReport(" settle_ms=%.0f overshoot_deg=%.2f error_deg=%.2f\n", candidate->metrics.settle,
+              candidate->metrics.overshoot, candidate->metrics.error);
+}
+
+/**
+ * Writes the best gains as parameter registry commands.
+ *
+ * @param fd the file to write to
+ * @param best the best candidate
+ */
+void tuneWriteParams(int fd, const TuneCandidate *best) {
+    char buffer[256];
+    int length = snprintf(buffer, sizeof(buffer), "# tune loop=%s score=%.4f settle_ms=%.0f overshoot_deg=%.2f error_deg=%.2f\n",
+                          tuneLoop->name, best->score, best->metrics.settle, best->metrics.overshoot, best->metrics.error);
+    for (int i = 0; i < TUNE_GAINS; i++) {
+        length += snprintf(buffer + length, sizeof(buffer) - length, "set %s %.8f\n",
+                           params[tuneLoop->params[i]].name, best->gains[i]);
+    }
+    length += snprintf(buffer + length, sizeof(buffer) - length, "save\n");
+    if (write(fd, buffer, length) != length) {
+        simReport("cannot write parameter file\n");
+    }
+}
+
+int main(int argc, char **argv) {
+    int points = TUNE_POINTS;
+    int rounds = TUNE_ROUNDS;
+    const char *output = NULL;
+    tuneJobs = (int) sysconf(_SC_NPROCESSORS_ONLN);
+    tuneLoop = NULL;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-j") == 0 && i + 1 < argc) {
+            tuneJobs = (int) strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-g") == 0 && i + 1 < argc) {
+            points = (int) strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-r") == 0 && i + 1 < argc) {
+            rounds = (int) strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            tuneSeeds = (int) strtol(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc) {
+            output = argv[++i];
+        } else {
+            for (unsigned int j = 0; j < sizeof(tuneLoops) / sizeof(tuneLoops[0]); j++) {
+                if (strcmp(argv[i], tuneLoops[j].name) == 0) {
+                    tuneLoop = &tuneLoops[j];
+                }
+            }
+        }
+    }
+    if (tuneLoop == NULL || points < 2 || rounds < 1 || tuneSeeds < 1) {
+        simReport("usage: tune [-j jobs] [-g points] [-r rounds] [-s seeds] [-o file] turn|straight\n");
+        return 2;
+    }
+    tuneJobs = constrain(tuneJobs, 1, SIM_MAX_JOBS);
+    int fd = 1;
+    if (output != NULL && (fd = open(output, O_WRONLY | O_CREAT | O_TRUNC, 0644)) < 0) {
+        simReport("cannot open %s\n", output);
+        return 1;
+    }
+
+    int gridSize = 1;
+    for (int i = 0; i < TUNE_GAINS; i++) {
+        gridSize *= points;
+    }
+    tuneCandidates = malloc(sizeof(TuneCandidate) * (gridSize + 1));
+    float low[TUNE_GAINS], high[TUNE_GAINS];
+    memcpy(low, tuneLoop->low, sizeof(low));
+    memcpy(high, tuneLoop->high, sizeof(high));
+    TuneCandidate best;
+    TuneCandidate baseline;
+    for (int round = 1; round <= rounds; round++) {
+        tuneGrid(low, high, points);
+        if (round == 1) {
+            // The gains compiled in are scored alongside the first grid
+            TuneCandidate *current = &tuneCandidates[tuneCandidateCount++];
+            memset(current, 0, sizeof(*current));
+            for (int i = 0; i < TUNE_GAINS; i++) {
+                current->gains[i] = params[tuneLoop->params[i]].defaultValue;
+            }
+        }
+        if (!tuneRound()) {
+            simReport("round %d failed\n", round);
+            return 1;
+        }
+        if (round == 1) {
+            baseline = tuneCandidates[--tuneCandidateCount];
+            best = baseline;
+            tuneReport("tune baseline", &baseline);
+        }
+        for (int n = 0; n < tuneCandidateCount; n++) {
+            if (tuneCandidates[n].score < best.score) {
+                best = tuneCandidates[n];
+            }
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "tune round=%d candidates=%d episodes=%d", round, tuneCandidateCount,
+                 tuneCandidateCount * tuneLoop->episodes * tuneSeeds);
+        tuneReport(label, &best);
+        // Zoom in on the best candidate, one grid step either side, within the parameter's limits
+        for (int i = 0; i < TUNE_GAINS; i++) {
+            const Param *param = &params[tuneLoop->params[i]];
+            float step = (high[i] - low[i]) / (points - 1);
+            low[i] = max(best.gains[i] - step, param->minimum);
+            high[i] = min(best.gains[i] + step, param->maximum);
+        }
+    }
+    tuneReport("tune result=best", &best);
+    tuneWriteParams(fd, &best);
+    if (fd != 1) {
+        close(fd);
+    }
+    free(tuneCandidates);
+    return 0;
+}
@@ -42,22 +42,22 @@ int selectAuton() {
             val = MAX_AUTON_SLOTS+2;
         }
         if(val == 0) {
-            lcdSetText(LCD_PORT, 2, "NONE");
+            lcdBufferSetText(LCD_PORT, 2, "NONE");
         } else if(val == MAX_AUTON_SLOTS+1) {
-            lcdSetText(LCD_PORT, 2, "Prog. Skills");
+            lcdBufferSetText(LCD_PORT, 2, "Prog. Skills");
         } else if (val == MAX_AUTON_SLOTS+2) {
-            lcdSetText(LCD_PORT, 2, "Hardcoded Skills");
+            lcdBufferSetText(LCD_PORT, 2, "Hardcoded Skills");
         } else {
             char filename[AUTON_FILENAME_MAX_LENGTH];
             snprintf(filename, sizeof(filename)/sizeof(char), "a%d", val);
             FILE* autonFile = fopen(filename, "r");
             if(autonFile == NULL){
-                lcdPrint(LCD_PORT, 2, "Slot: %d (EMPTY)", val);
+                lcdBufferPrint(LCD_PORT, 2, "Slot: %d (EMPTY)", val);
             } else {
                 char name[LCD_MESSAGE_MAX_LENGTH+1];
                 memset(name, 0, sizeof(name));
                 fread(name, sizeof(char), sizeof(name) / sizeof(char), autonFile);
-                lcdSetText(LCD_PORT, 2, name);
+                lcdBufferSetText(LCD_PORT, 2, name);
                 fclose(autonFile);
             }
         }
@@ -73,13 +73,13 @@ int selectAuton() {
  */
 void initAutonRecorder() {
     printf("Beginning initialization of autonomous recorder...\n");
-    lcdClear(LCD_PORT);
-    lcdSetText(LCD_PORT, 1, "Init recorder...");
-    lcdSetText(LCD_PORT, 2, "");
+    lcdBufferClear(LCD_PORT);
+    lcdBufferSetText(LCD_PORT, 1, "Init recorder...");
+    lcdBufferSetText(LCD_PORT, 2, "");
     memset(states, 0, sizeof(*states));
     printf("Completed initialization of autonomous recorder.\n");
-    lcdSetText(LCD_PORT, 1, "Init-ed recorder!");
-    lcdSetText(LCD_PORT, 2, "");
+    lcdBufferSetText(LCD_PORT, 1, "Init-ed recorder!");
+    lcdBufferSetText(LCD_PORT, 2, "");
     autonLoaded = -1;
     progSkills = 0;
 }
@@ -88,17 +88,17 @@ void initAutonRecorder() {
  * Records driver joystick values into states array.
  */
 void recordAuton() {
-    lcdClear(LCD_PORT);
+    lcdBufferClear(LCD_PORT);
     for(int i = 3; i > 0; i--){
         lcdSetBacklight(LCD_PORT, true);
         printf("Beginning autonomous recording in %d...\n", i);
-        lcdSetText(LCD_PORT, 1, "Recording auton");
-        lcdPrint(LCD_PORT, 2, "in %d...", i);
+        lcdBufferSetText(LCD_PORT, 1, "Recording auton");
+        lcdBufferPrint(LCD_PORT, 2, "in %d...", i);
         delay(1000);
     }
     printf("Ready to begin autonomous recording.\n");
-    lcdSetText(LCD_PORT, 1, "Recording auton...");
-    lcdSetText(LCD_PORT, 2, "");
+    lcdBufferSetText(LCD_PORT, 1, "Recording auton...");
+    lcdBufferSetText(LCD_PORT, 2, "");
     bool lightState = false;
     for (int i = 0; i < AUTON_TIME * JOY_POLL_FREQ; i++) {
         printf("Recording state %d...\n", i);
@@ -115,8 +115,8 @@ void recordAuton() {
         states[i].liftR = liftR;
         if (joystickGetDigital(1, 7, JOY_UP)) {
             printf("Autonomous recording manually cancelled.\n");
-            lcdSetText(LCD_PORT, 1, "Cancelled record.");
-            lcdSetText(LCD_PORT, 2, "");
+            lcdBufferSetText(LCD_PORT, 1, "Cancelled record.");
+            lcdBufferSetText(LCD_PORT, 2, "");
             memset(states + i + 1, 0, sizeof(joyState) * (AUTON_TIME * JOY_POLL_FREQ - i - 1));
             i = AUTON_TIME * JOY_POLL_FREQ;
         }
@@ -124,8 +124,8 @@ void recordAuton() {
         delay(1000 / JOY_POLL_FREQ);
     }
     printf("Completed autonomous recording.\n");
-    lcdSetText(LCD_PORT, 1, "Recorded auton!");
-    lcdSetText(LCD_PORT, 2, "");
+    lcdBufferSetText(LCD_PORT, 1, "Recorded auton!");
+    lcdBufferSetText(LCD_PORT, 2, "");
     motorStopAll();
     delay(1000);
     autonLoaded = 0;
@@ -136,9 +136,9 @@ void recordAuton() {
  */
 void saveAuton() {
     printf("Waiting for file selection...\n");
-    lcdClear(LCD_PORT);
-    lcdSetText(LCD_PORT, 1, "Save to?");
-    lcdSetText(LCD_PORT, 2, "");
+    lcdBufferClear(LCD_PORT);
+    lcdBufferSetText(LCD_PORT, 1, "Save to?");
+    lcdBufferSetText(LCD_PORT, 2, "");
     int autonSlot;
     if(progSkills == 0) {
         autonSlot = selectAuton();
@@ -154,31 +154,31 @@ void saveAuton() {
     } else if(autonSlot != MAX_AUTON_SLOTS+1) {
         typeString(name);
     }
-    lcdSetText(LCD_PORT, 1, "Saving auton...");
+    lcdBufferSetText(LCD_PORT, 1, "Saving auton...");
     char filename[AUTON_FILENAME_MAX_LENGTH];
     if(autonSlot != MAX_AUTON_SLOTS + 1) {
         printf("Not doing programming skills, recording to slot %d.\n",autonSlot);
         snprintf(filename, sizeof(filename)/sizeof(char), "a%d", autonSlot);
-        //lcdPrint(LCD_PORT, 2, "Slot: %d", autonSlot);
-        lcdPrint(LCD_PORT, 2, "%s", name);
+        //lcdBufferPrint(LCD_PORT, 2, "Slot: %d", autonSlot);
+        lcdBufferPrint(LCD_PORT, 2, "%s", name);
     } else {
         printf("Doing programming skills, recording to section %d.\n", progSkills);
         snprintf(filename, sizeof(filename)/sizeof(char), "p%d", progSkills);
-        lcdPrint(LCD_PORT, 2, "Skills Part: %d", progSkills+1);
+        lcdBufferPrint(LCD_PORT, 2, "Skills Part: %d", progSkills+1);
     }
     printf("Saving to file %s...\n",filename);
     FILE *autonFile = fopen(filename, "w");
     if (autonFile == NULL) {
         printf("Error saving autonomous in file %s!\n", filename);
-        lcdSetText(LCD_PORT, 1, "Error saving!");
+        lcdBufferSetText(LCD_PORT, 1, "Error saving!");
         if(autonSlot != MAX_AUTON_SLOTS + 1){
             printf("Not doing programming skills, error saving auton in slot %d!\n", autonSlot);
-            lcdSetText(LCD_PORT, 1, "Error saving!");
-            lcdPrint(LCD_PORT, 2,   "Slot: %d", autonSlot);
+            lcdBufferSetText(LCD_PORT, 1, "Error saving!");
+            lcdBufferPrint(LCD_PORT, 2,   "Slot: %d", autonSlot);
         } else {
             printf("Doing programming skills, error saving auton in section 0!\n");
-            lcdSetText(LCD_PORT, 1, "Error saving!");
-            lcdSetText(LCD_PORT, 2, "Prog. Skills");
+            lcdBufferSetText(LCD_PORT, 1, "Error saving!");
+            lcdBufferSetText(LCD_PORT, 2, "Prog. Skills");
         }
         delay(1000);
         return;
@@ -195,13 +195,13 @@ void saveAuton() {
     }
     fclose(autonFile);
     printf("Completed saving autonomous to file %s.\n", filename);
-    lcdSetText(LCD_PORT, 1, "Saved auton!");
+    lcdBufferSetText(LCD_PORT, 1, "Saved auton!");
     if(autonSlot != MAX_AUTON_SLOTS + 1) {
         printf("Not doing programming skills, recorded to slot %d.\n",autonSlot);
-        lcdPrint(LCD_PORT, 2, "Slot: %d", autonSlot);
+        lcdBufferPrint(LCD_PORT, 2, "Slot: %d", autonSlot);
     } else {
         printf("Doing programming skills, recorded to section %d.\n", progSkills);
-        lcdPrint(LCD_PORT, 2, "Skills Part: %d", progSkills+1);
+        lcdBufferPrint(LCD_PORT, 2, "Skills Part: %d", progSkills+1);
     }
     delay(1000);
     if(autonSlot == MAX_AUTON_SLOTS + 1) {
@@ -218,43 +218,43 @@ void saveAuton() {
  * Loads autonomous file contents into states array.
  */
 void loadAuton() {
-    lcdClear(LCD_PORT);
+    lcdBufferClear(LCD_PORT);
     bool done = false;
     int autonSlot;
     FILE* autonFile;
     char filename[AUTON_FILENAME_MAX_LENGTH];
     do {
         printf("Waiting for file selection...\n");
-        lcdSetText(LCD_PORT, 1, "Load from?");
-        lcdSetText(LCD_PORT, 2, "");
+        lcdBufferSetText(LCD_PORT, 1, "Load from?");
+        lcdBufferSetText(LCD_PORT, 2, "");
         autonSlot = selectAuton();
         if(autonSlot == 0) {
             printf("Not loading an autonomous!\n");
-            lcdSetText(LCD_PORT, 1, "Not loading!");
-            lcdSetText(LCD_PORT,   2, "");
+            lcdBufferSetText(LCD_PORT, 1, "Not loading!");
+            lcdBufferSetText(LCD_PORT,   2, "");
             autonLoaded = 0;
             return;
         } else if(autonSlot == MAX_AUTON_SLOTS + 1){
             printf("Performing programming skills.\n");
-            lcdSetText(LCD_PORT, 1, "Loading skills...");
-            lcdPrint(LCD_PORT,   2, "Skills Part: 1");
+            lcdBufferSetText(LCD_PORT, 1, "Loading skills...");
+            lcdBufferPrint(LCD_PORT,   2, "Skills Part: 1");
             autonLoaded = MAX_AUTON_SLOTS + 1;
         } else if (autonSlot == MAX_AUTON_SLOTS + 2) {
             printf("Performing hard-coded programming skills.\n");
-            lcdSetText(LCD_PORT, 1, "Loaded skills!");
-            lcdPrint(LCD_PORT,   2, "Hardcoded Skills");
+            lcdBufferSetText(LCD_PORT, 1, "Loaded skills!");
+            lcdBufferPrint(LCD_PORT,   2, "Hardcoded Skills");
             autonLoaded = MAX_AUTON_SLOTS + 2;
             return;
         } else if(autonSlot == autonLoaded) {
             printf("Autonomous %d is already loaded.\n", autonSlot);
-            lcdSetText(LCD_PORT, 1, "Loaded auton!");
-            lcdPrint(LCD_PORT,   2, "Slot: %d", autonSlot);
+            lcdBufferSetText(LCD_PORT, 1, "Loaded auton!");
+            lcdBufferPrint(LCD_PORT,   2, "Slot: %d", autonSlot);
             return;
         }
         printf("Loading autonomous from slot %d...\n", autonSlot);
-        lcdSetText(LCD_PORT, 1, "Loading auton...");
+        lcdBufferSetText(LCD_PORT, 1, "Loading auton...");
         if(autonSlot != MAX_AUTON_SLOTS + 1){
-            lcdPrint(LCD_PORT, 2,   "Slot: %d", autonSlot);
+            lcdBufferPrint(LCD_PORT, 2,   "Slot: %d", autonSlot);
         }
         if(autonSlot != MAX_AUTON_SLOTS + 1){
             printf("Not doing programming skills, loading slot %d\n", autonSlot);
@@ -267,14 +267,14 @@ void loadAuton() {
         autonFile = fopen(filename, "r");
         if (autonFile == NULL) {
             printf("No autonomous was saved in file %s!\n", filename);
-            lcdSetText(LCD_PORT, 1, "No auton saved!");
+            lcdBufferSetText(LCD_PORT, 1, "No auton saved!");
             if(autonSlot != MAX_AUTON_SLOTS + 1){
                 printf("Not doing programming skills, no auton in slot %d!\n", autonSlot);
-                lcdSetText(LCD_PORT, 1, "No auton saved!");
-                lcdPrint(LCD_PORT, 2,   "Slot: %d", autonSlot);
+                lcdBufferSetText(LCD_PORT, 1, "No auton saved!");
+                lcdBufferPrint(LCD_PORT, 2,   "Slot: %d", autonSlot);
             } else {
                 printf("Doing programming skills, no auton in section 0!\n");
-                lcdSetText(LCD_PORT, 1, "No skills saved!");
+                lcdBufferSetText(LCD_PORT, 1, "No skills saved!");
             }
             delay(1000);
         } else {
@@ -303,14 +303,14 @@ void loadAuton() {
     }
     fclose(autonFile);
     printf("Completed loading autonomous from file %s.\n", filename);
-    lcdSetText(LCD_PORT, 1, "Loaded auton!");
+    lcdBufferSetText(LCD_PORT, 1, "Loaded auton!");
     if(autonSlot != MAX_AUTON_SLOTS + 1){
         printf("Not doing programming skills, loaded from slot %d.\n", autonSlot);
-        //lcdPrint(LCD_PORT,   2, "Slot: %d", autonSlot);
-        lcdPrint(LCD_PORT, 2, "%s", name);
+        //lcdBufferPrint(LCD_PORT,   2, "Slot: %d", autonSlot);
+        lcdBufferPrint(LCD_PORT, 2, "%s", name);
     } else {
         printf("Doing programming skills, loaded from section %d.\n", progSkills);
-        lcdSetText(LCD_PORT, 2, "Skills Section: 1");
+        lcdBufferSetText(LCD_PORT, 2, "Skills Section: 1");
     }
     autonLoaded = autonSlot;
 }
@@ -331,13 +331,13 @@ void playbackAuton() { //must load autonomous first!
         return;
     }
     printf("Beginning playback...\n");
-    lcdSetText(LCD_PORT, 1, "Playing back...");
-    lcdSetText(LCD_PORT, 2, "");
+    lcdBufferSetText(LCD_PORT, 1, "Playing back...");
+    lcdBufferSetText(LCD_PORT, 2, "");
     lcdSetBacklight(LCD_PORT, true);
     int file=0;
     do{
         FILE* nextFile = NULL;
-        lcdPrint(LCD_PORT, 2, "File: %d", file+1);
+        lcdBufferPrint(LCD_PORT, 2, "File: %d", file+1);
         char filename[AUTON_FILENAME_MAX_LENGTH];
         if(autonLoaded == MAX_AUTON_SLOTS + 1 && file < PROGSKILL_TIME/AUTON_TIME - 1){
             printf("Next section: %d\n", file+1);
@@ -356,8 +356,8 @@ void playbackAuton() { //must load autonomous first!
             liftR = states[i].liftR;
             if (joystickGetDigital(1, 7, JOY_UP) && !isOnline()) {
                 printf("Playback manually cancelled.\n");
-                lcdSetText(LCD_PORT, 1, "Cancelled playback.");
-                lcdSetText(LCD_PORT, 2, "");
+                lcdBufferSetText(LCD_PORT, 1, "Cancelled playback.");
+                lcdBufferSetText(LCD_PORT, 2, "");
                 i = AUTON_TIME * JOY_POLL_FREQ;
                 file = PROGSKILL_TIME/AUTON_TIME;
             }
@@ -385,8 +385,8 @@ void playbackAuton() { //must load autonomous first!
     } while(autonLoaded == MAX_AUTON_SLOTS + 1 && file < PROGSKILL_TIME/AUTON_TIME);
     motorStopAll();
     printf("Completed playback.\n");
-    lcdSetText(LCD_PORT, 1, "Played back!");
-    lcdSetText(LCD_PORT, 2, "");
+    lcdBufferSetText(LCD_PORT, 1, "Played back!");
+    lcdBufferSetText(LCD_PORT, 2, "");
     delay(1000);
 }
 
@@ -13,7 +13,7 @@
  * It turns to the face the other net to shoot the final set of match loads.
  */
 void runHardCodedProgrammingSkills() {
-    lcdSetText(LCD_PORT, 1, "Hardcoded Skills");
+    lcdBufferSetText(LCD_PORT, 1, "Hardcoded Skills");
     int numShots = 0;
     bool shooterLimitPressed = UNPRESSED;
     shoot(-127);
@@ -22,11 +22,11 @@ void runHardCodedProgrammingSkills() {
             numShots++;
         }
         shooterLimitPressed = digitalRead(SHOOTER_LIMIT);
-        lcdPrint(LCD_PORT, 2, "Shot: %d", numShots);
+        lcdBufferPrint(LCD_PORT, 2, "Shot: %d", numShots);
         if (joystickGetDigital(1, 7, JOY_UP)) {
             printf("Skills manually cancelled.\n");
-            lcdSetText(LCD_PORT, 1, "Cancelled skills.");
-            lcdSetText(LCD_PORT, 2, "");
+            lcdBufferSetText(LCD_PORT, 1, "Cancelled skills.");
+            lcdBufferSetText(LCD_PORT, 2, "");
             motorStopAll();
             return;
         }
@@ -38,19 +38,16 @@ void runHardCodedProgrammingSkills() {
     bool done = false;
     int timeout = 0;
     while (!done) { //turn right
-        printf("Curr: %d\tPrev: %d\tTarg: %d\n", (gyroGet(gyro) % ROTATION_DEG), prev_ang, (-90-CLOSE_GOAL_ANGLE));
-        move(0, targetNet(-90-CLOSE_GOAL_ANGLE), 0);
-        printf("Turn: %d\n", constrain(turn, -127, 127));
-        printf("----------------------------------\n");
-        lcdPrint(LCD_PORT, 2, "Angle: %d", (gyroGet(gyro) % ROTATION_DEG));
+        moveCompensated(0, targetNet(-90-closeGoalAngle), 0);
+        lcdBufferPrint(LCD_PORT, 2, "Angle: %d", (gyroGet(gyro) % ROTATION_DEG));
         if (joystickGetDigital(1, 7, JOY_UP)) {
             printf("Skills manually cancelled.\n");
-            lcdSetText(LCD_PORT, 1, "Cancelled skills.");
-            lcdSetText(LCD_PORT, 2, "");
+            lcdBufferSetText(LCD_PORT, 1, "Cancelled skills.");
+            lcdBufferSetText(LCD_PORT, 2, "");
             motorStopAll();
             return;
         }
-        if(abs((gyroGet(gyro) % ROTATION_DEG) - (-90-CLOSE_GOAL_ANGLE))<=1 && prev_ang == gyroGet(gyro)) {
+        if(abs((gyroGet(gyro) % ROTATION_DEG) - (-90-closeGoalAngle))<=1 && prev_ang == gyroGet(gyro)) {
             done = true;
         } else if(prev_ang == gyroGet(gyro)) {
             timeout += 20;
@@ -68,26 +65,28 @@ void runHardCodedProgrammingSkills() {
     resetGyroVariables();
     int forwspd = 0;
     resetEncoderVariables();
-    while (ultrasonicGet(sonar) > (DISTANCE_TO_OTHER_SIDE + 50) || ultrasonicGet(sonar) == 0) {
+    while (ultrasonicGet(sonar) > (distanceToOtherSide + 50) || ultrasonicGet(sonar) == 0) {
         moveStraight(constrain(forwspd, -127, 127));
         printf("Fast Dist: %d\n", ultrasonicGet(sonar));
+        updateWallRange();
         if (joystickGetDigital(1, 7, JOY_UP)) {
             printf("Skills manually cancelled.\n");
-            lcdSetText(LCD_PORT, 1, "Cancelled skills.");
-            lcdSetText(LCD_PORT, 2, "");
+            lcdBufferSetText(LCD_PORT, 1, "Cancelled skills.");
+            lcdBufferSetText(LCD_PORT, 2, "");
             motorStopAll();
             return;
         }
         forwspd += 5;
         delay(20);
     }
-    while (ultrasonicGet(sonar) > DISTANCE_TO_OTHER_SIDE || ultrasonicGet(sonar) == 0) {
+    while (ultrasonicGet(sonar) > distanceToOtherSide || ultrasonicGet(sonar) == 0) {
         moveStraight(constrain(forwspd, 64, 127));
         printf("Slow Dist: %d\n", ultrasonicGet(sonar));
+        updateWallRange();
         if (joystickGetDigital(1, 7, JOY_UP)) {
             printf("Skills manually cancelled.\n");
-            lcdSetText(LCD_PORT, 1, "Cancelled skills.");
-            lcdSetText(LCD_PORT, 2, "");
+            lcdBufferSetText(LCD_PORT, 1, "Cancelled skills.");
+            lcdBufferSetText(LCD_PORT, 2, "");
             motorStopAll();
             return;
         }
@@ -101,19 +100,16 @@ void runHardCodedProgrammingSkills() {
     done = false;
     timeout = 0;
     while (!done) { //turn left
-        printf("Curr: %d\tPrev: %d\tTarg: %d\n", (gyroGet(gyro) % ROTATION_DEG), prev_ang, 90+FAR_GOAL_ANGLE);
-        move(0, targetNet(90+FAR_GOAL_ANGLE), 0);
-        printf("Turn: %d\n", constrain(turn, -127, 127));
-        printf("----------------------------------\n");
-        lcdPrint(LCD_PORT, 2, "Angle: %d", (gyroGet(gyro) % ROTATION_DEG));
+        moveCompensated(0, targetNet(90+farGoalAngle), 0);
+        lcdBufferPrint(LCD_PORT, 2, "Angle: %d", (gyroGet(gyro) % ROTATION_DEG));
         if (joystickGetDigital(1, 7, JOY_UP)) {
             printf("Skills manually cancelled.\n");
-            lcdSetText(LCD_PORT, 1, "Cancelled skills.");
-            lcdSetText(LCD_PORT, 2, "");
+            lcdBufferSetText(LCD_PORT, 1, "Cancelled skills.");
+            lcdBufferSetText(LCD_PORT, 2, "");
             motorStopAll();
             return;
         }
-        if(abs((gyroGet(gyro) % ROTATION_DEG) - (90+FAR_GOAL_ANGLE))<=1 && prev_ang == gyroGet(gyro)) {
+        if(abs((gyroGet(gyro) % ROTATION_DEG) - (90+farGoalAngle))<=1 && prev_ang == gyroGet(gyro)) {
             done = true;
         } else if(prev_ang == gyroGet(gyro)) {
             timeout += 20;
@@ -131,15 +127,15 @@ void runHardCodedProgrammingSkills() {
     shoot(127);
     delay(20);
     shoot(0);
-    taskCreate(playSpeaker, TASK_DEFAULT_STACK_SIZE, NULL, TASK_PRIORITY_DEFAULT);
+    taskCreateTracked("Speaker", playSpeaker, TASK_DEFAULT_STACK_SIZE, NULL, TASK_PRIORITY_DEFAULT);
     delay(200);
     shoot(-127);
-    lcdSetText(LCD_PORT, 2, "Final Shots");
+    lcdBufferSetText(LCD_PORT, 2, "Final Shots");
     while (true) {
         if (joystickGetDigital(1, 7, JOY_UP)) {
             printf("Skills manually cancelled.\n");
-            lcdSetText(LCD_PORT, 1, "Cancelled skills.");
-            lcdSetText(LCD_PORT, 2, "");
+            lcdBufferSetText(LCD_PORT, 1, "Cancelled skills.");
+            lcdBufferSetText(LCD_PORT, 2, "");
             motorStopAll();
             return;
         }
@@ -0,0 +1,93 @@
+/** @file autotune.c
+ * @brief File for the gyroscope PID autotuner
+ *
+ * This file contains the code for the relay feedback experiment and the conversion of its results
+ * into gains for targetNet().
+ *
+ * @see autotune.h
+ */
+
+#include "main.h"
+
+/**
+ * Runs a relay feedback experiment on the drive and computes gains for the gyroscope turning loop.
+ *
+ * @param result a pointer to store the results in
+ *
+ * @return true if the experiment completed, false if it was cancelled or the robot did not oscillate in time
+ */
+bool autotuneGyro(AutotuneResult *result) {
+    bool cancelled = false;
+    lcdFlushEvents();
+    lcdBufferSetText(LCD_PORT, 1, "Autotuning...");
+
+    // targetNet() turns with a positive speed when the angle is above the target, and so does the relay
+    int setpoint = gyroGet(gyro);
+    int output = AUTOTUNE_RELAY;
+    int high = 0, low = 0;
+    int cycles = 0;
+    int measured = 0;
+    double periodSum = 0, amplitudeSum = 0;
+    unsigned long start = millis();
+    unsigned long lastSwitch = start;
+    unsigned long wakeTime = start;
+    while (measured < AUTOTUNE_CYCLES && millis() - start < AUTOTUNE_TIMEOUT && !cancelled) {
+        moveCompensated(0, output, 0);
+        taskDelayUntil(&wakeTime, AUTOTUNE_PERIOD);
+        int error = gyroGet(gyro) - setpoint;
+        high = max(high, error);
+        low = min(low, error);
+        if (output < 0 && error > AUTOTUNE_HYSTERESIS) {
+            // Each switch back to a positive speed ends a cycle
+            output = AUTOTUNE_RELAY;
+            unsigned long now = millis();
+            cycles++;
+            if (cycles > AUTOTUNE_SKIP_CYCLES) {
+                periodSum += now - lastSwitch;
+                amplitudeSum += (high - low) / 2.0;
+                measured++;
+            }
+            lastSwitch = now;
+            high = error;
+            low = error;
+        } else if (output > 0 && error < -AUTOTUNE_HYSTERESIS) {
+            output = -AUTOTUNE_RELAY;
+        }
+        char line[LCD_MESSAGE_MAX_LENGTH+1];
+        lcdLineClear(line);
+        lcdPutBar(line, 0, LCD_MESSAGE_MAX_LENGTH, min(cycles, AUTOTUNE_SKIP_CYCLES + AUTOTUNE_CYCLES), AUTOTUNE_SKIP_CYCLES + AUTOTUNE_CYCLES);
+        lcdBufferSetText(LCD_PORT, 2, line);
+        cancelled = lcdPressedButtons() != 0;
+    }
+    move(0, 0, 0);
+    double amplitude = measured == 0 ? 0 : amplitudeSum / measured;
+    if (cancelled || measured < AUTOTUNE_CYCLES || amplitude <= AUTOTUNE_HYSTERESIS) {
+        return false;
+    }
+
+    // The describing function of a relay with hysteresis gives the gain at which the loop oscillates
+    result->ultimateGain = 4 * AUTOTUNE_RELAY / (MATH_PI * sqrt(sq(amplitude) - sq(AUTOTUNE_HYSTERESIS)));
+    result->ultimatePeriod = periodSum / measured / 1000.0;
+    double kP = AUTOTUNE_KP_FACTOR * result->ultimateGain;
+    double integralTime = AUTOTUNE_TI_FACTOR * result->ultimatePeriod;
+    double derivativeTime = AUTOTUNE_TD_FACTOR * result->ultimatePeriod;
+    // targetNet() adds error * 20 to its integral on each 20 millisecond call, so the integral is in degree-milliseconds,
+    // and its derivative is the change in error per call divided by 100
+    result->kP = kP;
+    result->kI = kP / (integralTime * 1000);
+    result->kD = kP * derivativeTime * 100000 / AUTOTUNE_PERIOD;
+    printf("autotune ku=%f pu_ms=%d amplitude_deg=%f kp=%f ki=%f kd=%f\n", result->ultimateGain,
+           (int) round(result->ultimatePeriod * 1000), amplitude, result->kP, result->kI, result->kD);
+    return true;
+}
+
+/**
+ * Makes the results of an experiment the gyroscope turning loop's gains.
+ *
+ * @param result the results of the experiment
+ */
+void autotuneApply(const AutotuneResult *result) {
+    paramSet(PARAM_GYRO_KP, result->kP);
+    paramSet(PARAM_GYRO_KI, result->kI);
+    paramSet(PARAM_GYRO_KD, result->kD);
+}
@@ -0,0 +1,204 @@
+/** @file battery.c
+ * @brief File for the battery monitor
+ *
+ * This file contains the code for the battery monitor task.
+ * The statistics are only written by the monitor task. The single-word fields are read by other tasks without locking,
+ * but the 64-bit sums take two loads on the Cortex, so they are read and written under batteryMutex.
+ *
+ * @see battery.h
+ */
+
+#include "main.h"
+
+/**
+ * The statistics of each battery, indexed by battery ID number.
+ */
+BatteryStats batteryStats[NUM_BATTS];
+
+/**
+ * The factor motor outputs are scaled by to compensate for the main battery voltage.
+ */
+float batteryScale = 1;
+
+/**
+ * Stores whether motor outputs are compensated for the main battery voltage.
+ */
+bool batteryCompensation = true;
+
+/**
+ * Object representing the battery monitor task.
+ */
+TaskHandle batteryTask = NULL;
+
+/**
+ * The main battery sag history, as a ring buffer.
+ */
+BatterySag batteryHistory[BATTERY_HISTORY_SIZE];
+
+/**
+ * The index at which the next history entry is written.
+ */
+int batteryHistoryHead = 0;
+
+/**
+ * The number of entries in the history.
+ */
+int batteryHistoryCount = 0;
+
+/**
+ * Mutex protecting the average voltage sums and sample counts.
+ */
+Mutex batteryMutex = NULL;
+
+/**
+ * Set to clear the statistics on the monitor task's next sample, so the reset does not race with it.
+ */
+volatile bool batteryResetRequested = false;
+
+/**
+ * Reads the current voltage of a battery.
+ *
+ * @param batt the battery ID number (BATT_MAIN, BATT_BKUP or BATT_PEXP)
+ *
+ * @return the voltage of the battery, in millivolts
+ */
+unsigned int batteryRead(int batt) {
+    switch (batt) {
+        case BATT_MAIN: return powerLevelMain();
+        case BATT_BKUP: return powerLevelBackup();
+        case BATT_PEXP: return powerLevelExpander();
+    }
+    return 0;
+}
+
+/**
+ * Gets the average voltage of a battery since the statistics were reset.
+ *
+ * @param batt the battery ID number (BATT_MAIN, BATT_BKUP or BATT_PEXP)
+ *
+ * @return the average voltage, in millivolts, or 0 if the battery has not been connected
+ */
+unsigned int batteryAverage(int batt) {
+    if (batt < 0 || batt >= NUM_BATTS || batteryMutex == NULL) {
+        return 0;
+    }
+    mutexTake(batteryMutex, -1);
+    unsigned long long sum = batteryStats[batt].sum;
+    unsigned long samples = batteryStats[batt].samples;
+    mutexGive(batteryMutex);
+    return samples == 0 ? 0 : (unsigned int) (sum / samples);
+}
+
+/**
+ * Gets the sag of the main battery over a previous history period.
+ *
+ * @param age how many periods ago to get the sag from (0 is the last completed period)
+ * @param sag a pointer to store the sag in
+ *
+ * @return true if the history goes back that far, false otherwise
+ */
+bool batterySagAt(int age, BatterySag *sag) {
+    if (age < 0 || age >= batteryHistoryCount) {
+        return false;
+    }
+    *sag = batteryHistory[(batteryHistoryHead - 1 - age + BATTERY_HISTORY_SIZE) % BATTERY_HISTORY_SIZE];
+    return true;
+}
+
+/**
+ * Clears the minimum and average voltages and the sag history.
+ */
+void resetBatteryStats() {
+    batteryResetRequested = true;
+}
+
+/**
+ * Records a sample of a battery's voltage.
+ *
+ * @param stats the statistics of the battery
+ * @param voltage the voltage sample, in millivolts
+ */
+void recordBattery(BatteryStats *stats, unsigned int voltage) {
+    if (voltage < BATTERY_MIN_VALID) {
+        stats->filtered = 0;
+        return;
+    }
+    if (stats->filtered == 0) {
+        stats->filtered = voltage;
+    } else {
+        stats->filtered += (int) (BATTERY_FILTER * ((int) voltage - (int) stats->filtered));
+    }
+    if (stats->minimum == 0 || voltage < stats->minimum) {
+        stats->minimum = voltage;
+    }
+    mutexTake(batteryMutex, -1);
+    stats->sum += voltage;
+    stats->samples++;
+    mutexGive(batteryMutex);
+}
+
+/**
+ * Runs the battery monitor task.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void runBatteryMonitor(void *ignore) {
+    unsigned int periodMinimum = 0;
+    unsigned long periodSum = 0;
+    int periodSamples = 0;
+    unsigned long wakeTime = millis();
+    while (true) {
+        unsigned long profile = profileBegin();
+        if (batteryResetRequested) {
+            mutexTake(batteryMutex, -1);
+            memset(batteryStats, 0, sizeof(batteryStats));
+            mutexGive(batteryMutex);
+            batteryHistoryHead = 0;
+            batteryHistoryCount = 0;
+            periodMinimum = 0;
+            periodSum = 0;
+            periodSamples = 0;
+            batteryResetRequested = false;
+        }
+        for (int batt = 0; batt < NUM_BATTS; batt++) {
+            recordBattery(&batteryStats[batt], batteryRead(batt));
+        }
+
+        unsigned int main = batteryStats[BATT_MAIN].filtered;
+        if (main != 0) {
+            if (periodMinimum == 0 || main < periodMinimum) {
+                periodMinimum = main;
+            }
+            periodSum += main;
+            periodSamples++;
+        }
+        if (periodSamples == BATTERY_HISTORY_PERIOD / BATTERY_SAMPLE_PERIOD) {
+            batteryHistory[batteryHistoryHead].minimum = periodMinimum;
+            batteryHistory[batteryHistoryHead].average = periodSum / periodSamples;
+            batteryHistoryHead = (batteryHistoryHead + 1) % BATTERY_HISTORY_SIZE;
+            if (batteryHistoryCount < BATTERY_HISTORY_SIZE) {
+                batteryHistoryCount++;
+            }
+            periodMinimum = 0;
+            periodSum = 0;
+            periodSamples = 0;
+        }
+
+        if (batteryCompensation && main != 0) {
+            batteryScale = constrain((float) BATTERY_NOMINAL / main, BATTERY_SCALE_MIN, BATTERY_SCALE_MAX);
+        } else {
+            batteryScale = 1;
+        }
+        profileEnd(PROFILE_BATTERY, profile);
+        taskDelayUntil(&wakeTime, BATTERY_SAMPLE_PERIOD);
+    }
+}
+
+/**
+ * Starts the battery monitor task.
+ */
+void startBatteryMonitor() {
+    memset(batteryStats, 0, sizeof(batteryStats));
+    batteryMutex = mutexCreate();
+    batteryTask = taskCreateTracked("Battery", runBatteryMonitor, TASK_MINIMAL_STACK_SIZE * 2, NULL, TASK_PRIORITY_LOWEST + 1);
+}
@@ -0,0 +1,261 @@
+/** @file bench.c
+ * @brief File for the control path microbenchmarks
+ *
+ * The cases call their functions with arguments that leave the motors stopped, so the benchmarks
+ * can be run on a robot that is sitting on the bench.
+ *
+ * @see bench.h
+ */
+
+#include "main.h"
+
+#ifndef SIMULATOR
+/**
+ * Debug Exception and Monitor Control Register of the Cortex-M3.
+ */
+#define DEMCR (*(volatile unsigned long *) 0xE000EDFC)
+
+/**
+ * Bit of DEMCR that enables the DWT and ITM units.
+ */
+#define DEMCR_TRCENA 0x01000000
+
+/**
+ * Control register of the Cortex-M3 Data Watchpoint and Trace unit.
+ */
+#define DWT_CTRL (*(volatile unsigned long *) 0xE0001000)
+
+/**
+ * Bit of DWT_CTRL that enables the cycle counter.
+ */
+#define DWT_CTRL_CYCCNTENA 0x00000001
+
+/**
+ * Cycle counter of the Cortex-M3 Data Watchpoint and Trace unit.
+ */
+#define DWT_CYCCNT (*(volatile unsigned long *) 0xE0001004)
+
+/**
+ * Enables the DWT cycle counter.
+ */
+void benchCounterInit() {
+    DEMCR |= DEMCR_TRCENA;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= DWT_CTRL_CYCCNTENA;
+}
+
+/**
+ * Reads the DWT cycle counter.
+ *
+ * @return the number of CPU cycles since the counter was enabled, modulo 2^32
+ */
+unsigned long benchCounter() {
+    return DWT_CYCCNT;
+}
+#endif
+
+/**
+ * The cost of reading the counter around an empty call, in BENCH_UNIT.
+ */
+unsigned long benchOverhead = 0;
+
+/**
+ * Does nothing. Timed by benchCalibrate() to measure the harness's own cost.
+ */
+void benchEmpty() {
+}
+
+/**
+ * Makes one call of targetNet(), which only calculates a turning speed.
+ */
+void benchTargetNet() {
+    targetNet(GYRO_NET_TARGET);
+}
+
+/**
+ * Makes one call of moveStraight() at zero speed, which runs the whole correction but leaves the drive stopped.
+ */
+void benchMoveStraight() {
+    moveStraight(0);
+}
+
+/**
+ * The line buffer the LCD formatting cases write into.
+ */
+char benchLine[LCD_MESSAGE_MAX_LENGTH+1];
+
+/**
+ * The voltage the battery line cases write, in millivolts. Not a constant, so the compiler cannot format it in advance.
+ */
+int benchMillivolts = 7853;
+
+/**
+ * Centers a menu name with the LCD formatter.
+ */
+void benchLcdCenter() {
+    lcdPutCenter(benchLine, "Telemetry");
+}
+
+/**
+ * Centers a menu name the way the menus did before the LCD formatter, as a baseline for benchLcdCenter().
+ */
+void benchStrcatCenter() {
+    const char *text = "Telemetry";
+    int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(text))/2;
+    benchLine[0] = '\0';
+    for(int i = 0; i < spaces; i++){
+        strcat(benchLine, " ");
+    }
+    strcat(benchLine, text);
+    for(int i = 0; i < spaces; i++){
+        strcat(benchLine, " ");
+    }
+}
+
+/**
+ * Writes a battery voltage line with the LCD formatter, as the battery screen does.
+ */
+void benchLcdVoltage() {
+    lcdLineClear(benchLine);
+    lcdPutText(benchLine, 0, "Mn Batt:");
+    lcdPutVoltage(benchLine, 9, LCD_MESSAGE_MAX_LENGTH - 9, benchMillivolts);
+}
+
+/**
+ * Writes and centers a battery voltage line the way the battery screen did before the LCD formatter,
+ * as a baseline for benchLcdVoltage().
+ */
+void benchSprintfVoltage() {
+    char battdisp[LCD_MESSAGE_MAX_LENGTH+1];
+    char temp[LCD_MESSAGE_MAX_LENGTH+1];
+    memset(battdisp, 0, sizeof(battdisp));
+    memset(temp, 0, sizeof(temp));
+    strcat(battdisp, "Mn Batt: ");
+    sprintf(temp, "%d.%d V", benchMillivolts/1000, benchMillivolts%1000);
+    strcat(battdisp, temp);
+    int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(battdisp))/2;
+    benchLine[0] = '\0';
+    for(int i = 0; i < spaces; i++){
+        strcat(benchLine, " ");
+    }
+    strcat(benchLine, battdisp);
+    for(int i = 0; i < spaces; i++){
+        strcat(benchLine, " ");
+    }
+}
+
+/**
+ * The benchmark cases, in the order they are run.
+ * The strcat and sprintf cases are the LCD text code from before lcdformat.c, kept so the two can be compared.
+ */
+const BenchCase benchCases[BENCH_CASE_COUNT] = {
+    {"updatePosition", updatePosition},
+    {"targetNet", benchTargetNet},
+    {"moveStraight", benchMoveStraight},
+    {"recordJoyInfo", recordJoyInfo},
+    {"moveRobot", moveRobot},
+    {"lcdPutCenter", benchLcdCenter},
+    {"strcatCenter", benchStrcatCenter},
+    {"lcdPutVoltage", benchLcdVoltage},
+    {"sprintfVoltage", benchSprintfVoltage}
+};
+
+/**
+ * Measures the cost of reading the counter around an empty call.
+ */
+void benchCalibrate() {
+    BenchCase empty = {"empty", benchEmpty};
+    BenchResult result;
+    benchOverhead = 0;
+    benchFunction(&empty, BENCH_ITERATIONS, &result);
+    benchOverhead = result.minimum;
+}
+
+/**
+ * Times a benchmark case.
+ *
+ * @param bench the case to time
+ * @param iterations the number of timed calls
+ * @param result the statistics to fill
+ */
+void benchFunction(const BenchCase *bench, unsigned int iterations, BenchResult *result) {
+    for (int i = 0; i < BENCH_WARMUP; i++) {
+        bench->run();
+    }
+    result->name = bench->name;
+    result->calls = 0;
+    result->mean = 0;
+    result->variance = 0;
+    result->minimum = 0;
+    result->maximum = 0;
+    // Welford's method keeps the variance accurate without storing every sample
+    double squares = 0;
+    for (unsigned int i = 0; i < iterations; i++) {
+        unsigned long start = benchCounter();
+        bench->run();
+        unsigned long elapsed = benchCounter() - start;
+        elapsed = elapsed > benchOverhead ? elapsed - benchOverhead : 0;
+
+        result->calls++;
+        double delta = elapsed - result->mean;
+        result->mean += delta / result->calls;
+        squares += delta * (elapsed - result->mean);
+        if (result->calls == 1 || elapsed < result->minimum) {
+            result->minimum = elapsed;
+        }
+        result->maximum = max(result->maximum, elapsed);
+    }
+    result->variance = result->calls > 1 ? squares / (result->calls - 1) : 0;
+}
+
+/**
+ * Times every benchmark case.
+ *
+ * @param iterations the number of timed calls of each case
+ * @param results the statistics to fill, indexed in the same order as benchCases
+ */
+void benchRunAll(unsigned int iterations, BenchResult results[BENCH_CASE_COUNT]) {
+    if (sensorTask != NULL) {
+        taskSuspend(sensorTask);
+    }
+    benchCounterInit();
+    benchCalibrate();
+    for (int i = 0; i < BENCH_CASE_COUNT; i++) {
+        benchFunction(&benchCases[i], iterations, &results[i]);
+    }
+    resetGyroVariables();
+    resetEncoderVariables();
+    motorStopAll();
+    if (sensorTask != NULL) {
+        taskResume(sensorTask);
+    }
+}
+
+/**
+ * Formats the statistics of a benchmark case as a line of key=value pairs.
+ *
+ * @param result the statistics to format
+ * @param buffer the buffer to write the line to
+ * @param size the size of the buffer
+ *
+ * @return the length of the formatted line
+ */
+int benchFormat(const BenchResult *result, char *buffer, size_t size) {
+    return snprintf(buffer, size, "bench name=%s unit=%s calls=%lu mean=%.1f stddev=%.1f min=%lu max=%lu",
+                    result->name, BENCH_UNIT, result->calls, result->mean, sqrt(result->variance),
+                    result->minimum, result->maximum);
+}
+
+/**
+ * Runs every benchmark case BENCH_ITERATIONS times and prints the results.
+ */
+void benchDump() {
+    BenchResult results[BENCH_CASE_COUNT];
+    char line[128];
+    benchRunAll(BENCH_ITERATIONS, results);
+    printf("bench overhead=%lu unit=%s\n", benchOverhead, BENCH_UNIT);
+    for (int i = 0; i < BENCH_CASE_COUNT; i++) {
+        benchFormat(&results[i], line, sizeof(line));
+        printf("%s\n", line);
+    }
+}
@@ -0,0 +1,340 @@
+/** @file blackbox.c
+ * @brief File for the black box recorder
+ *
+ * Only the sensor task starts a save, between frames, so the writer task never sees a frame half recorded.
+ * The sensor task never waits for the writer: frames that fall due while the ring is being saved are dropped
+ * and counted in the header of the next block.
+ *
+ * @see blackbox.h
+ */
+
+#include "main.h"
+
+/**
+ * The ring of blocks frames are recorded into. Each block is saved to the flash file of the slot with its index.
+ */
+BlackBoxBlock blackBoxBlocks[BLACKBOX_SLOTS];
+
+/**
+ * Whether each block has recorded frames since it was last saved.
+ */
+bool blackBoxDirty[BLACKBOX_SLOTS];
+
+/**
+ * The index of the block frames are being recorded into.
+ */
+int blackBoxFilling = 0;
+
+/**
+ * Whether any motor was running in a frame of the block being filled.
+ */
+bool blackBoxMoving = false;
+
+/**
+ * Whether the robot was enabled at the last sensor task tick.
+ */
+bool blackBoxWasEnabled = false;
+
+/**
+ * Set to ask the sensor task to save the ring, even though the robot has not been disabled.
+ */
+volatile bool blackBoxSaveRequest = false;
+
+/**
+ * Set by the sensor task while the writer task saves the ring. No frames are recorded meanwhile.
+ */
+volatile bool blackBoxSaving = false;
+
+/**
+ * The number of sensor task ticks since the last frame was recorded.
+ */
+int blackBoxTicks = 0;
+
+/**
+ * The number of frames dropped while the ring was saved, since the block being filled was started.
+ */
+unsigned long blackBoxDropped = 0;
+
+/**
+ * The sequence number of the block being filled.
+ */
+unsigned long blackBoxSequence = 0;
+
+/**
+ * Whether startBlackBox() has been called, so that the sensor task may record frames.
+ */
+bool blackBoxStarted = false;
+
+/**
+ * Mutex preventing the writer task from rewriting a slot while it is being dumped.
+ */
+Mutex blackBoxMutex = NULL;
+
+/**
+ * Object representing the black box writer task.
+ */
+TaskHandle blackBoxTask = NULL;
+
+/**
+ * Returns the name of the flash file of a black box slot.
+ *
+ * @param slot the slot number
+ * @param name a buffer of at least 5 characters to store the name in
+ */
+void blackBoxFileName(int slot, char *name) {
+    snprintf(name, 5, "bb%d", slot);
+}
+
+/**
+ * Returns the CRC of a black box block.
+ *
+ * @param block the block to check; its header.count must not exceed BLACKBOX_BLOCK_FRAMES
+ *
+ * @return the CRC-16 of the header with its crc field set to 0, followed by the valid frames
+ */
+unsigned short blackBoxCrc(const BlackBoxBlock *block) {
+    BlackBoxHeader copy = block->header;
+    copy.crc = 0;
+    unsigned short crc = crc16(CRC16_INIT, &copy, sizeof(copy));
+    return crc16(crc, block->frames, sizeof(BlackBoxFrame) * block->header.count);
+}
+
+/**
+ * Checks whether a black box block is valid.
+ *
+ * @param block the block to check
+ * @param size the number of bytes of the block that were read
+ *
+ * @return true if the block has the right magic number, version and size, and its CRC matches
+ */
+bool blackBoxValid(const BlackBoxBlock *block, size_t size) {
+    return size >= sizeof(BlackBoxHeader) &&
+            block->header.magic == BLACKBOX_MAGIC &&
+            block->header.version == BLACKBOX_VERSION &&
+            block->header.count <= BLACKBOX_BLOCK_FRAMES &&
+            size >= sizeof(BlackBoxHeader) + sizeof(BlackBoxFrame) * block->header.count &&
+            blackBoxCrc(block) == block->header.crc;
+}
+
+/**
+ * Reads a black box block from flash.
+ *
+ * @param slot the slot to read
+ * @param block the block to read into
+ *
+ * @return true if the slot holds a valid block
+ */
+bool blackBoxRead(int slot, BlackBoxBlock *block) {
+    char name[5];
+    blackBoxFileName(slot, name);
+    FILE *file = fopen(name, "r");
+    if (file == NULL) {
+        return false;
+    }
+    size_t size = fread(block, 1, sizeof(*block), file);
+    fclose(file);
+    return blackBoxValid(block, size);
+}
+
+/**
+ * Writes a block of the ring to the flash file of its slot.
+ *
+ * @param slot the slot of the block, whose header.count, header.sequence and header.dropped have been filled
+ */
+void blackBoxWrite(int slot) {
+    BlackBoxBlock *block = &blackBoxBlocks[slot];
+    block->header.magic = BLACKBOX_MAGIC;
+    block->header.version = BLACKBOX_VERSION;
+    block->header.period = BLACKBOX_PERIOD;
+    block->header.reserved = 0;
+    block->header.crc = blackBoxCrc(block);
+
+    char name[5];
+    blackBoxFileName(slot, name);
+    mutexTake(blackBoxMutex, -1);
+    FILE *file = fopen(name, "w");
+    if (file != NULL) {
+        fwrite(block, 1, sizeof(BlackBoxHeader) + sizeof(BlackBoxFrame) * block->header.count, file);
+        fclose(file);
+    }
+    mutexGive(blackBoxMutex);
+}
+
+/**
+ * Runs the black box writer task.
+ * Saves every block changed since the last save when the sensor task asks for it.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void runBlackBox(void *ignore) {
+    while (true) {
+        if (blackBoxSaving) {
+            for (int slot = 0; slot < BLACKBOX_SLOTS; slot++) {
+                // A block reused before any frame was recorded in it leaves its slot's file as it was
+                if (blackBoxDirty[slot] && blackBoxBlocks[slot].header.count > 0) {
+                    blackBoxWrite(slot);
+                }
+                blackBoxDirty[slot] = false;
+            }
+            blackBoxSaving = false;
+        }
+        delay(BLACKBOX_WRITE_POLL);
+    }
+}
+
+/**
+ * Starts recording into the block after the one being filled, overwriting the oldest block of the ring.
+ * If no motor ran in the block being filled, it is reused instead.
+ */
+void blackBoxNextBlock() {
+    if (blackBoxMoving) {
+        blackBoxFilling = (blackBoxFilling + 1) % BLACKBOX_SLOTS;
+    }
+    BlackBoxBlock *block = &blackBoxBlocks[blackBoxFilling];
+    block->header.count = 0;
+    block->header.sequence = ++blackBoxSequence;
+    block->header.dropped = min(blackBoxDropped, 0xFFFF);
+    blackBoxDropped = 0;
+    blackBoxMoving = false;
+}
+
+/**
+ * Finds where the last recording left off, and starts the black box writer task.
+ */
+void startBlackBox() {
+    int last = BLACKBOX_SLOTS - 1;
+    // Nothing is being recorded yet, so the first block doubles as a buffer for the scan
+    for (int slot = 0; slot < BLACKBOX_SLOTS; slot++) {
+        if (blackBoxRead(slot, &blackBoxBlocks[0]) &&
+                (blackBoxSequence == 0 || (long) (blackBoxBlocks[0].header.sequence - blackBoxSequence) > 0)) {
+            last = slot;
+            blackBoxSequence = blackBoxBlocks[0].header.sequence;
+        }
+    }
+    memset(blackBoxBlocks, 0, sizeof(blackBoxBlocks));
+    // Start after the newest block of the last recording, so that it is the last to be overwritten
+    blackBoxFilling = last;
+    blackBoxMoving = true;
+    blackBoxNextBlock();
+    blackBoxMutex = mutexCreate();
+    blackBoxTask = taskCreateTracked("Black Box", runBlackBox, TASK_MINIMAL_STACK_SIZE * 2, NULL, TASK_PRIORITY_LOWEST + 1);
+    blackBoxStarted = true;
+}
+
+/**
+ * Fills a frame with the current state of the robot.
+ *
+ * @param frame the frame to fill
+ */
+void blackBoxRecord(BlackBoxFrame *frame) {
+    frame->time = millis();
+    for (int i = 0; i < NUM_DRIVE_ENCODERS; i++) {
+        frame->encoders[i] = (int32_t) driveEncoderGet(i);
+    }
+    frame->gyro = gyro != NULL ? gyroGet(gyro) : 0;
+    frame->sonar = sonar != NULL ? ultrasonicGet(sonar) : -1;
+    frame->battery = powerLevelMain();
+    frame->opcontrolPeriod = min(opcontrolLoop.period, 0xFFFF);
+    frame->sensorPeriod = min(sensorLoop.period, 0xFFFF);
+    frame->buttons = 0;
+    for (int group = 5; group <= 8; group++) {
+        for (unsigned char button = JOY_DOWN; button <= JOY_RIGHT; button <<= 1) {
+            // Groups 5 and 6 only have up and down buttons
+            if ((group >= 7 || button == JOY_DOWN || button == JOY_UP) && joystickGetDigital(1, group, button)) {
+                frame->buttons |= button << ((group - 5) * 4);
+            }
+        }
+    }
+    for (int i = 0; i < 4; i++) {
+        frame->joystick[i] = joystickGetAnalog(1, i + 1);
+    }
+    for (int port = 1; port <= 10; port++) {
+        frame->motors[port - 1] = motorGet(port);
+        if (frame->motors[port - 1] != 0) {
+            blackBoxMoving = true;
+        }
+    }
+    frame->mode = (isEnabled() ? BLACKBOX_ENABLED : 0) | (isAutonomous() ? BLACKBOX_AUTONOMOUS : 0) |
+            (isOnline() ? BLACKBOX_ONLINE : 0);
+    frame->reserved = 0;
+}
+
+/**
+ * Records a frame if BLACKBOX_PERIOD has elapsed since the last one.
+ */
+void blackBoxSample() {
+    if (!blackBoxStarted) {
+        return;
+    }
+    bool enabled = isEnabled();
+    if (enabled && ++blackBoxTicks >= BLACKBOX_PERIOD / SENSOR_POLL_PERIOD) {
+        blackBoxTicks = 0;
+        BlackBoxBlock *block = &blackBoxBlocks[blackBoxFilling];
+        if (blackBoxSaving) {
+            // The writer task is reading the ring, so the frame is lost
+            blackBoxDropped++;
+        } else {
+            // A block is also ended after a save that dropped frames, so that the gap falls between blocks
+            if (block->header.count >= BLACKBOX_BLOCK_FRAMES || (blackBoxDropped > 0 && block->header.count > 0)) {
+                blackBoxNextBlock();
+                block = &blackBoxBlocks[blackBoxFilling];
+            }
+            blackBoxRecord(&block->frames[block->header.count]);
+            block->header.count++;
+            blackBoxDirty[blackBoxFilling] = true;
+        }
+    }
+    // The ring is only saved once the robot stops driving, since writing flash stalls every task
+    if (!blackBoxSaving && (blackBoxSaveRequest || (blackBoxWasEnabled && !enabled))) {
+        blackBoxSaving = true;
+    }
+    blackBoxSaveRequest = false;
+    blackBoxWasEnabled = enabled;
+}
+
+/**
+ * Prints the contents of a black box slot's flash file over the debug terminal as a line of hexadecimal.
+ *
+ * @param slot the slot to print
+ */
+void blackBoxDumpSlot(int slot) {
+    char name[5];
+    blackBoxFileName(slot, name);
+    mutexTake(blackBoxMutex, -1);
+    FILE *file = fopen(name, "r");
+    if (file != NULL) {
+        unsigned char data[BLACKBOX_DUMP_CHUNK];
+        char hex[BLACKBOX_DUMP_CHUNK * 2 + 1];
+        size_t size;
+        printf("blackbox slot=%d hex=", slot);
+        while ((size = fread(data, 1, sizeof(data), file)) > 0) {
+            for (size_t i = 0; i < size; i++) {
+                snprintf(&hex[i * 2], 3, "%02x", data[i]);
+            }
+            fputs(hex, stdout);
+        }
+        printf("\n");
+        fclose(file);
+    }
+    mutexGive(blackBoxMutex);
+}
+
+/**
+ * Prints every block of the recording over the debug terminal, after saving the ring to flash.
+ */
+void blackBoxDump() {
+    if (!blackBoxStarted) {
+        return;
+    }
+    blackBoxSaveRequest = true;
+    // Wait for the sensor task to start the save and for the writer task to finish it
+    unsigned long start = millis();
+    while ((blackBoxSaveRequest || blackBoxSaving) && millis() - start < BLACKBOX_WRITE_POLL * 10) {
+        delay(SENSOR_POLL_PERIOD);
+    }
+    printf("blackbox begin slots=%d period=%d sequence=%lu\n", BLACKBOX_SLOTS, BLACKBOX_PERIOD, blackBoxSequence);
+    for (int slot = 0; slot < BLACKBOX_SLOTS; slot++) {
+        blackBoxDumpSlot(slot);
+    }
+    printf("blackbox end\n");
+}
@@ -0,0 +1,279 @@
+/** @file characterize.c
+ * @brief File for motor characterization
+ *
+ * This file contains the code for characterizing a motor group and storing the drive feed-forward constants.
+ * The least-squares fits are accumulated as running sums, so no samples are stored.
+ *
+ * @see characterize.h
+ */
+
+#include "main.h"
+
+/**
+ * The feed-forward constants of the drive, measured by characterization.
+ */
+Feedforward driveFeedforward = {0, 0, 0};
+
+/**
+ * Stores whether the drive feed-forward constants have been measured.
+ */
+bool driveFeedforwardValid = false;
+
+/**
+ * @brief The record the drive feed-forward constants are saved as.
+ */
+typedef struct FeedforwardRecord {
+    /**
+     * Always FEEDFORWARD_MAGIC.
+     */
+    unsigned short magic;
+
+    /**
+     * The version of the record format (FEEDFORWARD_VERSION).
+     */
+    unsigned short version;
+
+    /**
+     * The feed-forward constants.
+     */
+    Feedforward gains;
+
+    /**
+     * The CRC-16 checksum of the record, with this field set to 0.
+     */
+    unsigned short crc;
+} FeedforwardRecord;
+
+/**
+ * Returns the distance travelled by the drive encoders of a motor group.
+ * The connected encoders of the left, right and strafe motors in the group are averaged.
+ *
+ * @param group the motor group
+ * @param count a pointer to store the number of encoders averaged in
+ *
+ * @return the average distance, in inches
+ */
+double groupDistance(const MotorGroup *group, int *count) {
+    static const int encoderMotor[NUM_DRIVE_ENCODERS] = {LEFT_MOTOR, RIGHT_MOTOR, STRAFE_MOTOR};
+    long long ticks = 0;
+    *count = 0;
+    for (int enc = 0; enc < NUM_DRIVE_ENCODERS; enc++) {
+        // An encoder that is not connected always reads 0, which would drag the average down
+        if (motorGroupHas(group, encoderMotor[enc]) && driveEncoder(enc) != NULL) {
+            ticks += driveEncoderGet(enc);
+            (*count)++;
+        }
+    }
+    return *count == 0 ? 0 : (double) ticks / *count * INCHES_PER_ENC_TICK;
+}
+
+/**
+ * Runs the motors of a motor group for characterization.
+ * If the group drives the robot forward, the strafe motor is left stopped,
+ * since it would move the robot sideways where the left and right encoders cannot see it.
+ *
+ * @param group the motor group
+ * @param spd the speed to run the motors at
+ */
+void characterizeSet(const MotorGroup *group, int spd) {
+    bool forward = motorGroupHas(group, LEFT_MOTOR) || motorGroupHas(group, RIGHT_MOTOR);
+    for (int port = 1; port <= 10; port++) {
+        if (motorGroupHas(group, port) && !(forward && port == STRAFE_MOTOR)) {
+            motorSet(port, spd);
+        }
+    }
+}
+
+/**
+ * Measures the velocity of a motor group from a window of distance samples.
+ *
+ * @param window the last CHARACTERIZE_WINDOW+1 distances, as a ring buffer
+ * @param index the index of the newest distance in the window
+ *
+ * @return the velocity, in inches per second
+ */
+double windowVelocity(const double *window, int index) {
+    double oldest = window[(index + 1) % (CHARACTERIZE_WINDOW + 1)];
+    return fabs(window[index] - oldest) * 1000.0 / (CHARACTERIZE_WINDOW * CHARACTERIZE_PERIOD);
+}
+
+/**
+ * Characterizes a motor group.
+ *
+ * @param group the motor group to characterize
+ * @param result a pointer to store the feed-forward constants in
+ *
+ * @return true if characterization completed, false if it was cancelled, the group has no drive encoders,
+ *         or the ramp reached CHARACTERIZE_MAX_DISTANCE before the motors started moving
+ */
+bool characterize(const MotorGroup *group, Feedforward *result) {
+    int encoders;
+    groupDistance(group, &encoders);
+    if (encoders == 0) {
+        return false;
+    }
+    double window[CHARACTERIZE_WINDOW + 1];
+    int index = 0;
+    bool cancelled = false;
+    lcdFlushEvents();
+
+    // Ramp stage: fit output = kS + kV * velocity
+    double n = 0, sumV = 0, sumU = 0, sumVV = 0, sumVU = 0;
+    double output = 0;
+    for (int i = 0; i <= CHARACTERIZE_WINDOW; i++) {
+        window[i] = groupDistance(group, &encoders);
+    }
+    double startDistance = window[0];
+    lcdBufferSetText(LCD_PORT, 1, "Ramping...");
+    unsigned long wakeTime = millis();
+    while (output < CHARACTERIZE_RAMP_MAX && !cancelled) {
+        characterizeSet(group, (int) output);
+        taskDelayUntil(&wakeTime, CHARACTERIZE_PERIOD);
+        index = (index + 1) % (CHARACTERIZE_WINDOW + 1);
+        window[index] = groupDistance(group, &encoders);
+        if (fabs(window[index] - startDistance) >= CHARACTERIZE_MAX_DISTANCE) {
+            printf("Characterization ramp reached the distance limit at output %d.\n", (int) output);
+            break;
+        }
+        double velocity = windowVelocity(window, index);
+        // The velocity lags the output by half the window
+        double applied = output - CHARACTERIZE_RAMP_RATE * CHARACTERIZE_WINDOW / 2;
+        if (velocity > CHARACTERIZE_MIN_VELOCITY) {
+            n++;
+            sumV += velocity;
+            sumU += applied;
+            sumVV += velocity * velocity;
+            sumVU += velocity * applied;
+        }
+        output += CHARACTERIZE_RAMP_RATE;
+        char line[LCD_MESSAGE_MAX_LENGTH+1];
+        lcdLineClear(line);
+        lcdPutBar(line, 0, LCD_MESSAGE_MAX_LENGTH, (int) output, CHARACTERIZE_RAMP_MAX);
+        lcdBufferSetText(LCD_PORT, 2, line);
+        cancelled = lcdPressedButtons() != 0;
+    }
+    characterizeSet(group, 0);
+    double denominator = n * sumVV - sumV * sumV;
+    if (cancelled || n < 2 || denominator <= 0) {
+        return false;
+    }
+    result->kV = (n * sumVU - sumV * sumU) / denominator;
+    result->kS = (sumU - result->kV * sumV) / n;
+
+    lcdBufferSetText(LCD_PORT, 1, "Resting...");
+    lcdBufferSetText(LCD_PORT, 2, "");
+    delay(CHARACTERIZE_REST_TIME);
+
+    // Step stage: fit output - kS - kV * velocity = kA * acceleration
+    double sumAA = 0, sumAR = 0;
+    for (int i = 0; i <= CHARACTERIZE_WINDOW; i++) {
+        window[i] = groupDistance(group, &encoders);
+    }
+    startDistance = window[0];
+    double lastVelocity = 0;
+    lcdBufferSetText(LCD_PORT, 1, "Stepping...");
+    unsigned long start = millis();
+    wakeTime = start;
+    while (millis() - start < CHARACTERIZE_STEP_TIME && !cancelled) {
+        characterizeSet(group, CHARACTERIZE_STEP_SPEED);
+        taskDelayUntil(&wakeTime, CHARACTERIZE_PERIOD);
+        index = (index + 1) % (CHARACTERIZE_WINDOW + 1);
+        window[index] = groupDistance(group, &encoders);
+        if (fabs(window[index] - startDistance) >= CHARACTERIZE_MAX_DISTANCE) {
+            printf("Characterization step reached the distance limit.\n");
+            break;
+        }
+        double velocity = windowVelocity(window, index);
+        double acceleration = (velocity - lastVelocity) * 1000.0 / CHARACTERIZE_PERIOD;
+        lastVelocity = velocity;
+        if (acceleration > CHARACTERIZE_MIN_ACCEL) {
+            double remaining = CHARACTERIZE_STEP_SPEED - result->kS - result->kV * velocity;
+            sumAA += acceleration * acceleration;
+            sumAR += acceleration * remaining;
+        }
+        cancelled = lcdPressedButtons() != 0;
+    }
+    characterizeSet(group, 0);
+    if (cancelled) {
+        return false;
+    }
+    result->kA = sumAA > 0 ? max(sumAR / sumAA, 0) : 0;
+    printf("Characterized: kS %f, kV %f, kA %f\n", result->kS, result->kV, result->kA);
+    return true;
+}
+
+/**
+ * Computes the output needed to move with a given velocity and acceleration.
+ *
+ * @param ff the feed-forward constants
+ * @param velocity the velocity, in inches per second
+ * @param acceleration the acceleration, in inches per second squared
+ *
+ * @return the output, limited to the motor range
+ */
+int feedforwardOutput(const Feedforward *ff, double velocity, double acceleration) {
+    double output = ff->kV * velocity + ff->kA * acceleration;
+    if (velocity > 0) {
+        output += ff->kS;
+    } else if (velocity < 0) {
+        output -= ff->kS;
+    }
+    return constrain((int) round(output), MOTOR_MIN, MOTOR_MAX);
+}
+
+/**
+ * Computes the checksum of a feed-forward record.
+ *
+ * @param record the record
+ *
+ * @return the checksum
+ */
+unsigned short feedforwardCrc(const FeedforwardRecord *record) {
+    FeedforwardRecord copy = *record;
+    copy.crc = 0;
+    return crc16(CRC16_INIT, &copy, sizeof(copy));
+}
+
+/**
+ * Loads the drive feed-forward constants from the flash memory.
+ *
+ * @return true if a valid record was loaded, false otherwise
+ */
+bool loadFeedforward() {
+    FILE *file = fopen(FEEDFORWARD_FILE, "r");
+    if (file == NULL) {
+        return false;
+    }
+    FeedforwardRecord record;
+    bool valid = fread(&record, sizeof(record), 1, file) == 1 &&
+            record.magic == FEEDFORWARD_MAGIC &&
+            record.version == FEEDFORWARD_VERSION &&
+            feedforwardCrc(&record) == record.crc;
+    fclose(file);
+    if (valid) {
+        driveFeedforward = record.gains;
+        driveFeedforwardValid = true;
+    }
+    return valid;
+}
+
+/**
+ * Saves the drive feed-forward constants to the flash memory.
+ *
+ * @return true if the record was written completely, false otherwise
+ */
+bool saveFeedforward() {
+    FeedforwardRecord record;
+    memset(&record, 0, sizeof(record));
+    record.magic = FEEDFORWARD_MAGIC;
+    record.version = FEEDFORWARD_VERSION;
+    record.gains = driveFeedforward;
+    record.crc = feedforwardCrc(&record);
+    FILE *file = fopen(FEEDFORWARD_FILE, "w");
+    if (file == NULL) {
+        return false;
+    }
+    bool written = fwrite(&record, sizeof(record), 1, file) == 1;
+    fclose(file);
+    return written;
+}
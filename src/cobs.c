@@ -0,0 +1,72 @@
+/** @file cobs.c
+ * @brief File for Consistent Overhead Byte Stuffing
+ *
+ * Each run of up to 254 non-zero bytes is preceded by a code byte holding the run's length plus one.
+ * A code below 0xFF means that the run was followed by a zero in the original packet,
+ * except for the last run, after which the packet ends.
+ *
+ * @see cobs.h
+ */
+
+#include "main.h"
+
+/**
+ * Encodes a packet with COBS.
+ *
+ * @param data the packet
+ * @param length the length of the packet, in bytes
+ * @param out the buffer to write the encoded packet to, of at least COBS_MAX_ENCODED(length) bytes
+ *
+ * @return the length of the encoded packet
+ */
+unsigned int cobsEncode(const void *data, unsigned int length, unsigned char *out) {
+    const unsigned char *bytes = (const unsigned char *) data;
+    unsigned int code = 0;
+    unsigned int size = 1;
+    unsigned char run = 1;
+    for (unsigned int i = 0; i < length; i++) {
+        if (bytes[i] != 0) {
+            out[size++] = bytes[i];
+            run++;
+        }
+        // A zero, or a full run, ends the current run and starts the next one
+        if (bytes[i] == 0 || run == 0xFF) {
+            out[code] = run;
+            code = size++;
+            run = 1;
+        }
+    }
+    out[code] = run;
+    return size;
+}
+
+/**
+ * Decodes a COBS-encoded packet.
+ *
+ * @param data the encoded packet, without its zero delimiter
+ * @param length the length of the encoded packet, in bytes
+ * @param out the buffer to write the packet to, of at least length bytes
+ *
+ * @return the length of the decoded packet, or 0 if the encoded packet is malformed
+ */
+unsigned int cobsDecode(const unsigned char *data, unsigned int length, void *out) {
+    unsigned char *bytes = (unsigned char *) out;
+    unsigned int size = 0;
+    unsigned int i = 0;
+    while (i < length) {
+        unsigned char run = data[i++];
+        if (run == 0 || i + run - 1 > length) {
+            return 0;
+        }
+        for (unsigned char j = 1; j < run; j++) {
+            if (data[i] == 0) {
+                return 0;
+            }
+            bytes[size++] = data[i++];
+        }
+        if (run != 0xFF && i < length) {
+            bytes[size++] = 0;
+        }
+    }
+    return size;
+}
@@ -0,0 +1,31 @@
+/** @file crc.c
+ * @brief File for cyclic redundancy checks
+ *
+ * This file contains the code for computing CRC-16/CCITT checksums (polynomial 0x1021).
+ * The checksum is computed one bit at a time rather than with a lookup table,
+ * since it is only used on small records and flash space is limited.
+ *
+ * @see crc.h
+ */
+
+#include "main.h"
+
+/**
+ * Updates a CRC-16/CCITT checksum with a block of data.
+ *
+ * @param crc the checksum of the data so far (CRC16_INIT for the first block)
+ * @param data the block of data
+ * @param length the length of the block, in bytes
+ *
+ * @return the checksum including the block
+ */
+unsigned short crc16(unsigned short crc, const void *data, unsigned int length) {
+    const unsigned char *bytes = (const unsigned char *) data;
+    for (unsigned int i = 0; i < length; i++) {
+        crc ^= (unsigned short) bytes[i] << 8;
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
@@ -11,6 +11,42 @@
  */
 point position;
 
+/**
+ * Gyroscope angle accumulated before the last call to resetGyroHeading(), in degrees.
+ */
+int gyroHeadingOffset = 0;
+
+/**
+ * Encoder cursor for odometry, marking the encoder counts used by the last position update.
+ */
+EncoderCursor odometryCursor;
+
+/**
+ * The robot's heading at the last position update, in radians.
+ */
+double odometryHeading = 0;
+
+/**
+ * Ring buffer of the most recently recorded poses.
+ */
+poseSample poseHistory[POSE_HISTORY_SIZE];
+
+/**
+ * Index in the pose history that the next pose will be written to.
+ */
+int poseHistoryHead = 0;
+
+/**
+ * Number of poses stored in the pose history.
+ */
+int poseHistoryCount = 0;
+
+/**
+ * Mutex protecting the robot's position and the pose history.
+ * The sensor task updates them while other tasks apply corrections and look up past poses.
+ */
+Mutex poseMutex = NULL;
+
 /**
  * Coordinates of each of the white lines on the field.
  */
@@ -25,18 +61,34 @@ const lineSegment LINE_COORDS[8] = {{.p1 = {.x = 0, .y = 48}, .p2 = {.x = 48, .y
 
 /**
  * Updates the robot's estimate of its position based on sensor input.
+ * Each update integrates the encoder travel since the last update along an arc,
+ * using the change in heading over the step rather than only the current heading.
  */
 void updatePosition() {
-	double gyroValue = (double)((gyroGet(gyro) % ROTATION_DEG) * MATH_PI / 180.0);
-	double gyroVectorX = cos(gyroValue);
-	double gyroVectorY = sin(gyroValue);
-	double dr = (double) (0.5 * (INCHES_PER_ENC_TICK * (double) encoderGet(leftenc) + INCHES_PER_ENC_TICK * (double) encoderGet(rightenc)));
-	double dh = (double) (INCHES_PER_ENC_TICK * (double) encoderGet(horizontalenc));
-	
-	position.x += dr * gyroVectorX + dh * cos(gyroValue + MATH_PI / 2);
-	position.y += dr * gyroVectorY + dh * sin(gyroValue + MATH_PI / 2);
-
-	if (analogRead(LINE_TRACKER_PORT) < LINE_THRESHOLD) {
+	mutexTake(poseMutex, -1);
+	double gyroValue = fieldHeading();
+	int ticks[NUM_DRIVE_ENCODERS];
+	cursorTake(&odometryCursor, ticks);
+	double dr = (double) (0.5 * (INCHES_PER_ENC_TICK * (double) ticks[ENC_LEFT] + INCHES_PER_ENC_TICK * (double) ticks[ENC_RIGHT]));
+	double dh = (double) (INCHES_PER_ENC_TICK * (double) ticks[ENC_HORIZONTAL]);
+
+	// Treat the step as an arc of constant curvature: the chord points along the mean heading,
+	// and is shorter than the distance travelled by a factor of sin(dtheta/2)/(dtheta/2)
+	double dtheta = gyroValue - odometryHeading;
+	if (dtheta > MATH_PI) {
+		dtheta -= ROTATION_RAD;
+	} else if (dtheta < -MATH_PI) {
+		dtheta += ROTATION_RAD;
+	}
+	double halfTheta = dtheta / 2;
+	double chord = (abs(halfTheta) < 1e-6) ? 1.0 : sin(halfTheta) / halfTheta;
+	double meanHeading = odometryHeading + halfTheta;
+	odometryHeading = gyroValue;
+
+	position.x += chord * (dr * cos(meanHeading) - dh * sin(meanHeading));
+	position.y += chord * (dr * sin(meanHeading) + dh * cos(meanHeading));
+
+	if (LINE_TRACKER_PORT != UNDEFINED_PORT && analogRead(LINE_TRACKER_PORT) < LINE_THRESHOLD) {
 		double lowestDist = 100000.0;
 		double lowestX = -1;
 		double lowestY = -1; // the coordinate of the closest distance
@@ -69,7 +121,15 @@ void updatePosition() {
 		position.x = lowestX;
 		position.y = lowestY;
 	}
-    clearDriveEncoders();
+
+	poseHistory[poseHistoryHead].time = millis();
+	poseHistory[poseHistoryHead].position = position;
+	poseHistory[poseHistoryHead].heading = gyroValue;
+	poseHistoryHead = (poseHistoryHead + 1) % POSE_HISTORY_SIZE;
+	if (poseHistoryCount < POSE_HISTORY_SIZE) {
+		poseHistoryCount++;
+	}
+	mutexGive(poseMutex);
 }
 
 /**
@@ -79,7 +139,109 @@ void updatePosition() {
  * @param y The Y-coordinate to reset the robot's position to. 
  */
 void resetPosition(double x, double y) {
+	mutexTake(poseMutex, -1);
 	position.x = x;
 	position.y = y;
+	poseHistoryHead = 0;
+	poseHistoryCount = 0;
+	cursorReset(&odometryCursor);
+	odometryHeading = fieldHeading();
+	mutexGive(poseMutex);
+	resetWallRange();
+}
+
+/**
+ * Initializes the field positioning system and places the robot at its starting position.
+ */
+void initFieldPosition() {
+	poseMutex = mutexCreate();
+	resetPosition(ROBOT_START_POSITION_X, ROBOT_START_POSITION_Y);
 }
 
+/**
+ * Looks up the robot's pose at a given time, interpolating between recorded poses.
+ * Times newer than the latest recorded pose return the latest pose.
+ *
+ * @param time the time to look up, in milliseconds since startup
+ * @param pose a pointer to store the pose in
+ *
+ * @return true if the pose was found, false if the time is older than the pose history
+ */
+bool poseAt(unsigned long time, poseSample *pose) {
+	bool found = false;
+	mutexTake(poseMutex, -1);
+	int newer = (poseHistoryHead + POSE_HISTORY_SIZE - 1) % POSE_HISTORY_SIZE;
+	if (poseHistoryCount > 0 && (long) (time - poseHistory[newer].time) >= 0) {
+		*pose = poseHistory[newer];
+		found = true;
+	}
+	for (int i = 1; i < poseHistoryCount && !found; i++) {
+		int older = (newer + POSE_HISTORY_SIZE - 1) % POSE_HISTORY_SIZE;
+		if ((long) (time - poseHistory[older].time) >= 0) {
+			const poseSample *a = &poseHistory[older];
+			const poseSample *b = &poseHistory[newer];
+			double f = (b->time == a->time) ? 0 : (double) (time - a->time) / (double) (b->time - a->time);
+			double dh = b->heading - a->heading;
+			if (dh > MATH_PI) {
+				dh -= ROTATION_RAD;
+			} else if (dh < -MATH_PI) {
+				dh += ROTATION_RAD;
+			}
+			pose->time = time;
+			pose->position.x = a->position.x + f * (b->position.x - a->position.x);
+			pose->position.y = a->position.y + f * (b->position.y - a->position.y);
+			pose->heading = fmod(a->heading + f * dh + ROTATION_RAD, ROTATION_RAD);
+			found = true;
+		}
+		newer = older;
+	}
+	mutexGive(poseMutex);
+	return found;
+}
+
+/**
+ * Corrects the robot's position based on a measurement taken at a given time.
+ * The correction is applied to the current position and to every recorded pose from that time onward.
+ *
+ * @param time the time the measurement was taken, in milliseconds since startup
+ * @param dx the correction to the X-coordinate, in inches
+ * @param dy the correction to the Y-coordinate, in inches
+ */
+void correctPosition(unsigned long time, double dx, double dy) {
+	mutexTake(poseMutex, -1);
+	position.x += dx;
+	position.y += dy;
+	for (int i = 0; i < poseHistoryCount; i++) {
+		if ((long) (poseHistory[i].time - time) >= 0) {
+			poseHistory[i].position.x += dx;
+			poseHistory[i].position.y += dy;
+		}
+	}
+	mutexGive(poseMutex);
+}
+
+
+/**
+ * Returns the robot's heading on the field.
+ * A heading of zero points along the positive X axis, and the heading increases counterclockwise.
+ *
+ * @return the robot's heading in radians, in the range [0, 2*pi)
+ */
+double fieldHeading() {
+	int deg = (ROBOT_START_ANGLE + gyroHeadingOffset + gyroGet(gyro)) % ROTATION_DEG;
+	if (deg < 0) {
+		deg += ROTATION_DEG;
+	}
+	return deg * DEG_TO_RAD;
+}
+
+/**
+ * Resets the gyroscope to zero while preserving the robot's heading on the field.
+ */
+void resetGyroHeading() {
+	// Hold the pose lock so that odometry never sees the offset and the gyroscope out of step
+	mutexTake(poseMutex, -1);
+	gyroHeadingOffset += gyroGet(gyro);
+	gyroReset(gyro);
+	mutexGive(poseMutex);
+}
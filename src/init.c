@@ -64,22 +64,32 @@ void initialize() {
         seed += analogRead(i);
     }
     srand(seed);
+    initParams();
     leftenc = encoderInit(LEFT_ENC_TOP, LEFT_ENC_BOT, true);
     rightenc = encoderInit(RIGHT_ENC_TOP, RIGHT_ENC_BOT, true);
     horizontalenc = encoderInit(HORIZONTAL_ENC_TOP, HORIZONTAL_ENC_BOT, true);
     lcdInit(LCD_PORT);
-    lcdClear(LCD_PORT);
+    startLcdFlushTask();
+    lcdBufferClear(LCD_PORT);
     lcdSetBacklight(LCD_PORT, true);
-    lcdSetText(LCD_PORT, 1, "Init-ing gyro...");
+    lcdBufferSetText(LCD_PORT, 1, "Init-ing gyro...");
     gyro = gyroInit(GYRO_PORT, GYRO_SENSITIVITY);
     sonar = ultrasonicInit(ULTRASONIC_ECHO_PORT, ULTRASONIC_PING_PORT);
     speakerInit();
     delay(1100);
     gyroReset(gyro);
-    resetPosition(ROBOT_START_POSITION_X, ROBOT_START_POSITION_Y);
-    lcdSetText(LCD_PORT, 1, "Init-ed gyro!");
+    profileReset();
+    initDriveEncoders();
+    initFieldPosition();
+    startBlackBox();
+    startSensorTask();
+    startBatteryMonitor();
+    startTelemetryStream();
+    startParamConsole();
+    lcdBufferSetText(LCD_PORT, 1, "Init-ed gyro!");
     initAutonRecorder();
     initGroups();
+    loadFeedforward();
     if(isOnline()){
         loadAuton();
     }
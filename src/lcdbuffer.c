@@ -0,0 +1,121 @@
+/** @file lcdbuffer.c
+ * @brief File for the LCD framebuffer
+ *
+ * This file contains the code for the LCD framebuffer and its flusher task.
+ * Lines are stored padded with spaces to the full width of the LCD, so comparing a line
+ * with what was last transmitted is a simple string comparison.
+ *
+ * @see lcdbuffer.h
+ */
+
+#include "main.h"
+
+/**
+ * Object representing the LCD flusher task.
+ */
+TaskHandle lcdFlushTask = NULL;
+
+/**
+ * The text that should be on the LCD.
+ */
+char lcdShadow[LCD_LINES][LCD_MESSAGE_MAX_LENGTH+1];
+
+/**
+ * The text that was last transmitted to the LCD.
+ */
+char lcdShown[LCD_LINES][LCD_MESSAGE_MAX_LENGTH+1];
+
+/**
+ * Mutex protecting the framebuffer.
+ */
+Mutex lcdBufferMutex = NULL;
+
+/**
+ * Sets the text of a line of the LCD.
+ *
+ * @param lcdport the LCD screen's port (if this is not LCD_PORT, the text is sent directly)
+ * @param line the line to set (1 or 2)
+ * @param text the text to display
+ */
+void lcdBufferSetText(FILE *lcdport, unsigned char line, const char *text) {
+    if (lcdport != LCD_PORT || lcdBufferMutex == NULL) {
+        lcdSetText(lcdport, line, text);
+        return;
+    }
+    if (line < 1 || line > LCD_LINES) {
+        return;
+    }
+    char padded[LCD_MESSAGE_MAX_LENGTH+1];
+    int i = 0;
+    for (; i < LCD_MESSAGE_MAX_LENGTH && text[i] != '\0'; i++) {
+        padded[i] = text[i];
+    }
+    for (; i < LCD_MESSAGE_MAX_LENGTH; i++) {
+        padded[i] = ' ';
+    }
+    padded[LCD_MESSAGE_MAX_LENGTH] = '\0';
+    mutexTake(lcdBufferMutex, -1);
+    memcpy(lcdShadow[line-1], padded, sizeof(padded));
+    mutexGive(lcdBufferMutex);
+}
+
+/**
+ * Clears the LCD.
+ *
+ * @param lcdport the LCD screen's port
+ */
+void lcdBufferClear(FILE *lcdport) {
+    lcdBufferSetText(lcdport, 1, "");
+    lcdBufferSetText(lcdport, 2, "");
+}
+
+/**
+ * Transmits any lines of the framebuffer that have changed since they were last transmitted.
+ */
+void flushLcdBuffer() {
+    for (int line = 0; line < LCD_LINES; line++) {
+        char text[LCD_MESSAGE_MAX_LENGTH+1];
+        bool dirty = false;
+        mutexTake(lcdBufferMutex, -1);
+        if (strcmp(lcdShadow[line], lcdShown[line]) != 0) {
+            memcpy(text, lcdShadow[line], sizeof(text));
+            memcpy(lcdShown[line], lcdShadow[line], sizeof(text));
+            dirty = true;
+        }
+        mutexGive(lcdBufferMutex);
+        // Transmit outside of the lock so that drawing never waits on the UART
+        if (dirty) {
+            lcdSetText(LCD_PORT, line + 1, text);
+        }
+    }
+}
+
+/**
+ * Runs the LCD flusher task.
+ * Transmits the changed lines of the framebuffer every LCD_REFRESH_PERIOD milliseconds.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void runLcdFlush(void *ignore) {
+    unsigned long wakeTime = millis();
+    while (true) {
+        unsigned long profile = profileBegin();
+        flushLcdBuffer();
+        profileEnd(PROFILE_LCD_FLUSH, profile);
+        taskDelayUntil(&wakeTime, LCD_REFRESH_PERIOD);
+    }
+}
+
+/**
+ * Starts the LCD flusher task.
+ */
+void startLcdFlushTask() {
+    for (int line = 0; line < LCD_LINES; line++) {
+        memset(lcdShadow[line], ' ', LCD_MESSAGE_MAX_LENGTH);
+        lcdShadow[line][LCD_MESSAGE_MAX_LENGTH] = '\0';
+        // Force the first flush to transmit every line
+        memset(lcdShown[line], 0, sizeof(lcdShown[line]));
+    }
+    lcdBufferMutex = mutexCreate();
+    lcdFlushTask = taskCreateTracked("LCD Flush", runLcdFlush, TASK_MINIMAL_STACK_SIZE * 2, NULL, TASK_PRIORITY_LOWEST + 1);
+}
@@ -0,0 +1,129 @@
+/** @file lcdbuttons.c
+ * @brief File for the LCD button event queue
+ *
+ * This file contains the code for sampling and debouncing the LCD buttons.
+ * Debounced state changes are placed in a queue as events, which the LCD diagnostic menu reads without blocking.
+ * The queue has a single producer (the sensor task) and a single consumer (the LCD diagnostic menu task),
+ * so it needs no locking: only the producer writes the tail, and only the consumer writes the head.
+ *
+ * @see lcdbuttons.h
+ */
+
+#include "main.h"
+
+/**
+ * The button event queue.
+ */
+lcdEvent lcdEventQueue[LCD_EVENT_QUEUE_SIZE];
+
+/**
+ * Index of the oldest event in the queue. Only written by the consumer.
+ */
+volatile unsigned int lcdEventHead = 0;
+
+/**
+ * Index that the next event will be written to. Only written by the producer.
+ */
+volatile unsigned int lcdEventTail = 0;
+
+/**
+ * The LCD buttons, in the order they are sampled.
+ */
+const unsigned char lcdButtons[LCD_BUTTON_COUNT] = {LCD_BTN_LEFT, LCD_BTN_CENTER, LCD_BTN_RIGHT};
+
+/**
+ * The debounced state of each button.
+ */
+bool lcdButtonDown[LCD_BUTTON_COUNT];
+
+/**
+ * The number of consecutive samples for which each button's raw state has differed from its debounced state.
+ */
+unsigned char lcdButtonChanging[LCD_BUTTON_COUNT];
+
+/**
+ * The number of samples for which each button has been held down.
+ */
+unsigned int lcdButtonHeld[LCD_BUTTON_COUNT];
+
+/**
+ * Adds an event to the queue, dropping it if the queue is full.
+ *
+ * @param button the button that generated the event
+ * @param type the type of event
+ */
+void pushLcdEvent(unsigned char button, unsigned char type) {
+    unsigned int next = (lcdEventTail + 1) % LCD_EVENT_QUEUE_SIZE;
+    if (next == lcdEventHead) {
+        return;
+    }
+    lcdEventQueue[lcdEventTail].button = button;
+    lcdEventQueue[lcdEventTail].type = type;
+    lcdEventTail = next;
+}
+
+/**
+ * Samples the LCD buttons once, debouncing them and queueing any resulting events.
+ */
+void sampleLcdButtons() {
+    unsigned int raw = lcdReadButtons(LCD_PORT);
+    for (int i = 0; i < LCD_BUTTON_COUNT; i++) {
+        bool down = (raw & lcdButtons[i]) != 0;
+        if (down != lcdButtonDown[i]) {
+            lcdButtonChanging[i]++;
+            if (lcdButtonChanging[i] >= LCD_DEBOUNCE_SAMPLES) {
+                lcdButtonDown[i] = down;
+                lcdButtonChanging[i] = 0;
+                lcdButtonHeld[i] = 0;
+                pushLcdEvent(lcdButtons[i], down ? LCD_EVENT_PRESS : LCD_EVENT_RELEASE);
+            }
+        } else {
+            lcdButtonChanging[i] = 0;
+        }
+        if (lcdButtonDown[i]) {
+            lcdButtonHeld[i]++;
+            if (lcdButtonHeld[i] == LCD_LONG_PRESS_TIME / SENSOR_POLL_PERIOD) {
+                pushLcdEvent(lcdButtons[i], LCD_EVENT_LONG_PRESS);
+            }
+        }
+    }
+}
+
+/**
+ * Removes the oldest event from the button event queue.
+ *
+ * @param event a pointer to store the event in
+ *
+ * @return true if an event was removed, false if the queue was empty
+ */
+bool lcdNextEvent(lcdEvent *event) {
+    if (lcdEventHead == lcdEventTail) {
+        return false;
+    }
+    *event = lcdEventQueue[lcdEventHead];
+    lcdEventHead = (lcdEventHead + 1) % LCD_EVENT_QUEUE_SIZE;
+    return true;
+}
+
+/**
+ * Removes all events from the button event queue, returning the buttons that were pressed.
+ *
+ * @return a bitmask of the buttons that were pressed since the last call
+ */
+unsigned int lcdPressedButtons() {
+    unsigned int pressed = 0;
+    lcdEvent event;
+    while (lcdNextEvent(&event)) {
+        if (event.type == LCD_EVENT_PRESS) {
+            pressed |= event.button;
+        }
+    }
+    return pressed;
+}
+
+/**
+ * Discards all events in the button event queue.
+ */
+void lcdFlushEvents() {
+    lcdEventHead = lcdEventTail;
+}
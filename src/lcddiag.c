@@ -5,10 +5,14 @@
  * The menu provides live debugging and testing functionality.
  * It provides the following functions:
  *     - Motor testing functionality (individual and group)
+ *     - Motor characterization
+ *     - Gyroscope PID autotuning
  *     - Motor group management
+ *     - Runtime parameter editing
  *     - Battery voltage information
  *     - Joystick connection status
  *     - Robot sensory data
+ *     - Performance telemetry
  *     - Autonomous recorder status
  *     - LCD backlight toggle
  *     - Screensaver that displays during operator control
@@ -42,32 +46,53 @@ bool backlight = true;
 bool disableOpControl = false;
 
 /**
- * Array that stores the motor groups.
- * As this is a dynamic array, creating and editing new motor groups is possible.
- * These motor groups are added to the array via the Motor Group Management menu.
+ * Displays text centered on a line of the LCD.
+ *
+ * @param line the line on the LCD to display the text on
+ * @param text the text to display
  */
-MotorGroup *groups;
+void setTextCenter(unsigned char line, const char *text){
+    char str[LCD_MESSAGE_MAX_LENGTH+1];
+    lcdPutCenter(str, text);
+    lcdBufferSetText(LCD_PORT, line, str);
+}
 
 /**
- * Stores the number of motor groups.
- * This is functionally identical to the size of the motor group array.
+ * Displays a label followed by an integer centered on a line of the LCD.
+ *
+ * @param line the line on the LCD to display the text on
+ * @param label the text to display before the integer
+ * @param value the integer to display
  */
-int numgroups;
+void setTextIntCenter(unsigned char line, const char *label, int value){
+    char str[LCD_MESSAGE_MAX_LENGTH+1];
+    lcdLineClear(str);
+    lcdCenterLine(str, lcdPutInt(str, lcdPutText(str, 0, label), 0, value));
+    lcdBufferSetText(LCD_PORT, line, str);
+}
 
 /**
- * Stores the top-level menu names.
+ * Displays the navigation line used when selecting a motor number.
+ * Motor 0 represents the cancel or confirm option.
+ *
+ * @param val the motor number currently selected
  */
-char menuChoices[LCD_MENU_COUNT][LCD_MESSAGE_MAX_LENGTH+1] = {
-    "Motor Test",
-    "Motor Group Mgmt",
-    "Battery Info",
-    "Connection Info",
-    "Robot Info",
-    "Autonomous Info",
-    "Toggle Backlight",
-    "Screensaver",
-    "Credits"
-};
+void setMotorNavText(int val){
+    char str[LCD_MESSAGE_MAX_LENGTH+1];
+    lcdLineClear(str);
+    if(val == 1){
+        lcdPutText(str, 0, "ESC");
+    } else {
+        lcdPutInt(str, 0, 0, val == 0 ? 10 : val - 1);
+    }
+    lcdPutText(str, 7, "SEL");
+    if(val == 10){
+        lcdPutText(str, 13, "ESC");
+    } else {
+        lcdPutInt(str, 13, 3, val + 1);
+    }
+    lcdBufferSetText(LCD_PORT, 2, str);
+}
 
 /**
  * Uses the LCD and the autonomous potentiometer to type a string.
@@ -91,9 +116,10 @@ char* typeString(char *dest){
     int spacecode = 26;
     int endcode = 27;
     do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);
-        bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);
+        unsigned int pressed = lcdPressedButtons();
+        bool centerPressed = pressed & LCD_BTN_CENTER;
+        bool leftPressed = pressed & LCD_BTN_LEFT;
+        bool rightPressed = pressed & LCD_BTN_RIGHT;
 
         switch(c){
             case UPPER:
@@ -116,33 +142,23 @@ char* typeString(char *dest){
             }
         }
 
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(dest))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, dest);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(LCD_PORT, 1, str);
+        setTextCenter(1, dest);
 
         if(i > 0){
             if(c == UPPER){
-                lcdSetText(LCD_PORT, 2, "DEL    SEL   abc");
+                lcdBufferSetText(LCD_PORT, 2, "DEL    SEL   abc");
             } else if(c == LOWER) {
-                lcdSetText(LCD_PORT, 2, "DEL    SEL   123");
+                lcdBufferSetText(LCD_PORT, 2, "DEL    SEL   123");
             } else { //NUMBER
-                lcdSetText(LCD_PORT, 2, "DEL    SEL   ABC");
+                lcdBufferSetText(LCD_PORT, 2, "DEL    SEL   ABC");
             }
         } else {
             if(c == UPPER){
-                lcdSetText(LCD_PORT, 2, "|      SEL   abc");
+                lcdBufferSetText(LCD_PORT, 2, "|      SEL   abc");
             } else if(c == LOWER) {
-                lcdSetText(LCD_PORT, 2, "|      SEL   123");
+                lcdBufferSetText(LCD_PORT, 2, "|      SEL   123");
             } else { //NUMBER
-                lcdSetText(LCD_PORT, 2, "|      SEL   ABC");
+                lcdBufferSetText(LCD_PORT, 2, "|      SEL   ABC");
             }
         }
 
@@ -167,176 +183,11 @@ char* typeString(char *dest){
 }
 
 /**
- * Saves motor groups out to a file.
- * This file can be loaded to add custom motor groups into memory.
- */
-void saveGroups(){
-    FILE* group = fopen("grp", "w");
-    taskPrioritySet(NULL, TASK_PRIORITY_HIGHEST-1);
-    lcdSetText(LCD_PORT, 1, "Saving groups...");
-    lcdSetText(LCD_PORT, 2, "");
-    for(int i = 0; i < numgroups; i++){
-        fwrite(groups[i].motor, sizeof(bool), sizeof(groups[i].motor) / sizeof(bool), group);
-        fwrite("\n", sizeof(char), sizeof("\n") / sizeof(char), group);
-        fwrite(groups[i].name, sizeof(char), sizeof(groups[i].name) / sizeof(char), group);
-        if(i == numgroups-1){
-            fwrite("\t", sizeof(char), sizeof("\t") / sizeof(char), group);
-        } else {
-            fwrite("\n", sizeof(char), sizeof("\n") / sizeof(char), group);
-        }
-    }
-    taskPrioritySet(NULL, TASK_PRIORITY_DEFAULT);
-    lcdSetText(LCD_PORT, 1, "Saved groups!");
-    lcdSetText(LCD_PORT, 2, "");
-    delay(1000);
-}
-
-/**
- * Loads motor groups from a file on the Cortex flash memory.
- * This is used to add custom motor groups for testing purposes.
- */
-void loadGroups(){
-    FILE* group = fopen("grp", "r");
-    taskPrioritySet(NULL, TASK_PRIORITY_HIGHEST-1);
-    lcdSetText(LCD_PORT, 1, "Loading groups...");
-    lcdSetText(LCD_PORT, 2, "");
-    if(groups != NULL){
-        free(groups);
-    }
-    groups = NULL;
-    int i = 0;
-    bool done = false;
-    while(!done){
-        groups = (MotorGroup *) realloc(groups, sizeof(MotorGroup)*(i+1));
-        fread(groups[i].motor, sizeof(bool), sizeof(groups[i].motor) / sizeof(bool), group);
-        fgetc(group);
-        fread(groups[i].name, sizeof(char), sizeof(groups[i].name) / sizeof(char), group);
-        if(fgetc(group) == '\t'){
-            done = true;
-        }
-        i++;
-    }
-    numgroups = i;
-    taskPrioritySet(NULL, TASK_PRIORITY_DEFAULT);
-    lcdSetText(LCD_PORT, 1, "Loaded groups!");
-    lcdSetText(LCD_PORT, 2, "");
-    delay(1000);
-}
-
-/**
- * Initializes the motor groups array to contain the standard set of groups.
- * This includes: Left Drive, Right Drive, Full Drive, Nautilus Shooter, Intake, and Strafe Motor.
- */
-void initGroups(){
-    FILE* group = fopen("grp", "r");
-    if(group == NULL){
-        numgroups = 8; //LDRIVE, RDRIVE, STRAFE, DRIVE, SHOOT, INTK, LIFT, ANGLE
-        groups = (MotorGroup*) malloc(sizeof(MotorGroup) * numgroups);
-        if(groups == NULL){
-            return;
-        }
-        memset(groups, 0, sizeof(*groups));
-        for(int i = 0; i<numgroups; i++){
-            for(int j = 0; j<=10; j++){
-                groups[i].motor[j] = false;
-            }
-        }
-        groups[0].motor[LEFT_MOTOR] = true;
-        strcpy(groups[0].name, "Left Drive");
-
-        groups[1].motor[RIGHT_MOTOR] = true;
-        strcpy(groups[1].name, "Right Drive");
-
-        groups[2].motor[STRAFE_MOTOR] = true;
-        strcpy(groups[2].name, "Strafe Motor");
-
-        groups[3].motor[LEFT_MOTOR] = true;
-        groups[3].motor[RIGHT_MOTOR] = true;
-        groups[3].motor[STRAFE_MOTOR] = true;
-        strcpy(groups[3].name, "Full Drive");
-
-        groups[4].motor[NAUTILUS_SHOOTER_MOTOR_LEFT] = true;
-        groups[4].motor[NAUTILUS_SHOOTER_MOTOR_RIGHT] = true;
-        groups[4].motor[NAUTILUS_SHOOTER_MOTOR_CENTER] = true;
-        strcpy(groups[4].name, "Nautilus Shooter");
-
-        groups[5].motor[INTAKE_ROLLER_MOTOR] = true;
-        strcpy(groups[5].name, "Intake");
-
-        groups[6].motor[LIFT_MOTOR_LEFT] = true;
-        groups[6].motor[LIFT_MOTOR_RIGHT] = true;
-        strcpy(groups[6].name, "Lift");
-
-        groups[7].motor[SHOOTER_ANGLE_MOTOR] = true;
-        strcpy(groups[7].name, "Angle Changer");
-
-        //saveGroups();
-    } else {
-        //loadGroups();
-    }
-}
-
-/** 
- * Formats the LCD diagnostic menu name in the center of the screen.
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
- * @param line the line on the LCD to print the name
- * @param index the ID number of the menu
- */
-void formatMenuNameCenter(FILE* lcdport, int line, int index){
-    int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(menuChoices[index]))/2;
-    char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-    for(int i = 0; i < spaces; i++){
-        strcat(str, " ");
-    }
-    strcat(str, menuChoices[index]);
-    for(int i = 0; i < spaces; i++){
-        strcat(str, " ");
-    }
-    lcdSetText(lcdport, line, str);
-}
-
-/** 
- * Displays the list of menus and waits for the user to select one.
- * 
- * @return the ID number of the menu selected
- */
-int selectMenu() {
-    bool done = false;
-    int val = 0;
-    do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);
-        bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);
-
-        if(rightPressed && val != LCD_MENU_COUNT-1) val++;
-        else if(rightPressed && val == LCD_MENU_COUNT-1) val = 0;
-        else if(leftPressed && val != 0) val--;
-        else if(leftPressed && val == 0) val = LCD_MENU_COUNT - 1;
-
-        formatMenuNameCenter(LCD_PORT, 1, val);
-        if(val == 0){
-            lcdSetText(LCD_PORT, 2, "<      SEL     >");
-        } else if(val == LCD_MENU_COUNT-1) {
-            lcdSetText(LCD_PORT, 2, "<      SEL     >");
-        } else {
-            lcdSetText(LCD_PORT, 2, "<      SEL     >");
-        }
-        delay(20);
-        done = centerPressed;
-    } while(!done);
-    printf("Selected menu choice: %d\n", val);
-    return val;
-}
-
-/** 
- * Runs the screensaver that displays LCD messages.
+ * Runs the screensaver that displays LCD messages until any button is pressed.
  *
  * @see lcdmsg.c
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
  */
-void runScreensaver(FILE *lcdport){
+void runScreensaver(){
     int cycle = 0;
     do {
         if(cycle == 0){
@@ -347,198 +198,60 @@ void runScreensaver(FILE *lcdport){
         if(cycle==150){
             cycle=0;
         }
-    } while(!lcdAnyButtonPressed());
+    } while(lcdPressedButtons() == 0);
 }
 
-/** 
- * Displays the battery voltages, allowing for switching between batteries.
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
- */
-void runBattery(FILE *lcdport){
-    bool done = false;
-    int val = BATT_MAIN;
-    do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);
-        bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);
-
-        if(rightPressed && val != BATT_PEXP) val++;
-        else if(rightPressed && val == BATT_PEXP) val = BATT_MAIN;
-        else if(leftPressed && val != BATT_MAIN) val--;
-        else if(leftPressed && val == BATT_MAIN) val = BATT_PEXP;
-
-        int beforepoint = 0;
-        int afterpoint = 0;
-        char battdisp[LCD_MESSAGE_MAX_LENGTH+1];
-        char temp[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(battdisp, 0, sizeof(battdisp));
-        memset(temp, 0, sizeof(temp));
-
-        switch(val){
-            case BATT_MAIN: beforepoint = powerLevelMain()/1000;
-                            afterpoint = powerLevelMain()%1000;
-                            strcat(battdisp, "Mn Batt: ");
-                            break;
-            case BATT_BKUP: beforepoint = powerLevelBackup()/1000;
-                            afterpoint = powerLevelBackup()%1000;
-                            strcat(battdisp, "Bk Batt: ");
-                            break;
-            case BATT_PEXP: beforepoint = powerLevelExpander()/1000;
-                            afterpoint = powerLevelExpander()%1000;
-                            strcat(battdisp, "Ex Batt: ");
-                            break;
-        }
-        sprintf(temp, "%d.%d V", beforepoint, afterpoint);
-        strcat(battdisp, temp);
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(battdisp))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(str, 0, sizeof(str));
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, battdisp);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        lcdSetText(LCD_PORT, 1, str);
-
-        if(val == BATT_MAIN){
-            lcdSetText(LCD_PORT, 2, "EX     ESC    BK");
-        } else if(val == BATT_PEXP) {
-            lcdSetText(LCD_PORT, 2, "BK     ESC    MN");
-        } else { //BATT_BKUP
-            lcdSetText(LCD_PORT, 2, "MN     ESC    EX");
-        }
-        delay(20);
-        done = centerPressed;
-    } while(!done);
-}
-
-/** 
+/**
  * Prompts the user to select an individual motor to test.
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
- * 
- * @return the motor number selected
+ *
+ * @return the motor number selected, or 0 to cancel
  */
-int selectMotor(FILE *lcdport){
+int selectMotor(){
     bool done = false;
     int val = 1;
     do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);
-        bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);
+        unsigned int pressed = lcdPressedButtons();
+        bool centerPressed = pressed & LCD_BTN_CENTER;
+        bool leftPressed = pressed & LCD_BTN_LEFT;
+        bool rightPressed = pressed & LCD_BTN_RIGHT;
 
         if(rightPressed && val != 10) val++;
         else if(rightPressed && val == 10) val = 0;
         else if(leftPressed && val != 0) val--;
         else if(leftPressed && val == 0) val = 10;
 
-        char motorstr[LCD_MESSAGE_MAX_LENGTH+1];
         if(val != 0){
-            char temp[LCD_MESSAGE_MAX_LENGTH+1];
-            memset(motorstr, 0, sizeof(motorstr));
-            memset(temp, 0, sizeof(temp));
-            strcpy(motorstr, "Motor: ");
-            sprintf(temp, "%d", val);
-            strcat(motorstr, temp);
+            setTextIntCenter(1, "Motor: ", val);
         } else {
-            strcpy(motorstr, "Cancel");
+            setTextCenter(1, "Cancel");
         }
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(motorstr))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, motorstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(LCD_PORT, 1, str);
+        setMotorNavText(val);
 
         done = centerPressed;
-        if(val == 0){
-            lcdSetText(LCD_PORT, 2, "10     SEL     1");
-        } else if(val == 1) {
-            lcdSetText(LCD_PORT, 2, "ESC    SEL     2");
-        } else if(val == 10) {
-            lcdSetText(LCD_PORT, 2, "9      SEL   ESC");
-        } else if (val == 9) {
-            lcdSetText(LCD_PORT, 2, "8      SEL    10");
-        } else {
-            char navstr[LCD_MESSAGE_MAX_LENGTH+1];
-            memset(navstr, 0, sizeof(navstr));
-            sprintf(navstr, "%c      SEL     %c",(val-1) + '0', (val+1) + '0');
-            /*navstr[0] = (val-1) + '0';*/
-            /*strcat(navstr, "      SEL     ");*/
-            /*navstr[LCD_MESSAGE_MAX_LENGTH] = (val+1) + '0';*/
-            lcdSetText(LCD_PORT, 2, navstr);
-        }
         delay(20);
     } while(!done);
     printf("Testing motor %d.\n", val);
     return val;
 }
 
-/** 
- * Selects the speed of the motor to test.
- * 
- * @param mtr the motor number that is being tested
- * 
+/**
+ * Selects the speed to test a motor or motor group at, using the autonomous potentiometer.
+ *
+ * @param name the name of the motor or motor group being tested
+ *
  * @return the speed selected
  */
-int selectSpd(int mtr) {
+int selectSpd(const char *name) {
     bool done = false;
-    int val=0;
+    int val;
     do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        /*bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);*/
-        /*bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);*/
+        bool centerPressed = lcdPressedButtons() & LCD_BTN_CENTER;
 
         val = (float) ((float) analogRead(AUTON_POT)/(float) AUTON_POT_HIGH) * 254;
         val -= 127;
-        char motorstr[LCD_MESSAGE_MAX_LENGTH+1];
-        char temp[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(motorstr, 0, sizeof(motorstr));
-        memset(temp, 0, sizeof(temp));
-        strcpy(motorstr, "Motor: ");
-        sprintf(temp, "%d", mtr);
-        strcat(motorstr, temp);
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(motorstr))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, motorstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
 
-        lcdSetText(LCD_PORT, 1, str);
-
-        char speedstr[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(speedstr, 0, sizeof(speedstr));
-        memset(temp, 0, sizeof(temp));
-        strcpy(speedstr, "Speed: ");
-        sprintf(temp, "%d", val);
-        strcat(speedstr, temp);
-
-        spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(speedstr))/2;
-        strcpy(str, "");
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, speedstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(LCD_PORT, 2, str);
+        setTextCenter(1, name);
+        setTextIntCenter(2, "Speed: ", val);
 
         done = (digitalRead(AUTON_BUTTON) == PRESSED || centerPressed);
         delay(20);
@@ -547,764 +260,778 @@ int selectSpd(int mtr) {
     return val;
 }
 
-/** 
- * Runs the individual motor test.
- * Selection of the motor and speed is handled by other functions
+/**
+ * Runs a set of motors at a fixed speed until any button is pressed.
+ * Operator control of the motors is disabled while the test runs.
  *
- * @see selectMotor()
- * @see selectSpd()
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
+ * @param name the name of the motor or motor group being tested
+ * @param group the motors in the test
+ * @param spd the speed to run the motors at
  */
-void runIndivMotor(FILE *lcdport){
+void runMotorTest(const char *name, const MotorGroup *group, int spd){
     bool done = false;
-    int mtr = selectMotor(lcdport);
-    if(mtr == 0) return;
-    int spd = selectSpd(mtr);
-    int val = spd;
     disableOpControl = true;
     motorStopAll();
     do {
-        char motorstr[LCD_MESSAGE_MAX_LENGTH+1];
-        char temp[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(motorstr, 0, sizeof(motorstr));
-        memset(temp, 0, sizeof(temp));
-        strcpy(motorstr, "Motor: ");
-        sprintf(temp, "%d", mtr);
-        strcat(motorstr, temp);
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(motorstr))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, motorstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(LCD_PORT, 1, str);
-
-        char speedstr[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(speedstr, 0, sizeof(speedstr));
-        memset(temp, 0, sizeof(temp));
-        strcpy(speedstr, "Run Speed: ");
-        sprintf(temp, "%d", val);
-        strcat(speedstr, temp);
-
-        spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(speedstr))/2;
-        strcpy(str, "");
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, speedstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
+        setTextCenter(1, name);
+        setTextIntCenter(2, "Run Speed: ", spd);
 
-        lcdSetText(LCD_PORT, 2, str);
-
-        done = lcdAnyButtonPressed();
-        motorSet(mtr, val);
+        motorGroupSet(group, spd);
 
+        done = lcdPressedButtons() != 0;
         delay(20);
     } while(!done);
     disableOpControl = false;
 }
 
-/** 
- * Selects the motor group to test.
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
- * 
- * @return the ID number of the group to test
+/**
+ * Runs the individual motor test.
+ * Selection of the motor and speed is handled by other functions
+ *
+ * @see selectMotor()
+ * @see selectSpd()
  */
-int selectMotorGroup(FILE *lcdport){
+void runIndivMotor(){
+    int mtr = selectMotor();
+    if(mtr == 0) return;
+    char name[LCD_MESSAGE_MAX_LENGTH+1];
+    lcdLineClear(name);
+    name[lcdPutInt(name, lcdPutText(name, 0, "Motor: "), 0, mtr)] = '\0';
+    int spd = selectSpd(name);
+    MotorGroup group = {1 << mtr, ""};
+    runMotorTest(name, &group, spd);
+}
+
+/**
+ * Selects a motor group.
+ *
+ * @return the ID number of the group selected, or -1 to cancel
+ */
+int selectMotorGroup(){
     bool done = false;
     int val = 0;
     do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);
-        bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);
+        unsigned int pressed = lcdPressedButtons();
+        bool centerPressed = pressed & LCD_BTN_CENTER;
+        bool leftPressed = pressed & LCD_BTN_LEFT;
+        bool rightPressed = pressed & LCD_BTN_RIGHT;
 
         if(rightPressed && val != numgroups-1) val++;
         else if(rightPressed && val == numgroups-1) val = -1;
         else if(leftPressed && val != -1) val--;
         else if(leftPressed && val == -1) val = numgroups-1;
 
-        char motorstr[LCD_MESSAGE_MAX_LENGTH+1];
-        if(val != -1){
-            memset(motorstr, 0, sizeof(motorstr));
-            strcpy(motorstr, groups[val].name);
-        } else {
-            strcpy(motorstr, "Cancel");
-        }
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(motorstr))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, motorstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(LCD_PORT, 1, str);
+        setTextCenter(1, val != -1 ? groups[val].name : "Cancel");
+        lcdBufferSetText(LCD_PORT, 2, "<      SEL     >");
 
         done = centerPressed;
-        lcdSetText(LCD_PORT, 2, "<      SEL     >");
-        delay(20);
-    } while(!done);
-    return val;
-}
-
-/** 
- * Selects the speed of the motor group to be tested.
- * 
- * @param mtr the ID number of the motor group to be tested
- * 
- * @return the speed selected
- */
-int selectSpdGroup(int mtr) {
-    bool done = false;
-    int val;
-    do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        /*bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);*/
-        /*bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);*/
-
-        val = (float) ((float) analogRead(AUTON_POT)/(float) AUTON_POT_HIGH) * 254;
-        val -= 127;
-        char motorstr[LCD_MESSAGE_MAX_LENGTH+1];
-        char temp[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(motorstr, 0, sizeof(motorstr));
-        memset(temp, 0, sizeof(temp));
-        strcpy(motorstr, groups[mtr].name);
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(motorstr))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, motorstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(LCD_PORT, 1, str);
-
-        char speedstr[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(speedstr, 0, sizeof(speedstr));
-        memset(temp, 0, sizeof(temp));
-        strcpy(speedstr, "Speed: ");
-        sprintf(temp, "%d", val);
-        strcat(speedstr, temp);
-
-        spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(speedstr))/2;
-        strcpy(str, "");
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, speedstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(LCD_PORT, 2, str);
-
-        done = (digitalRead(AUTON_BUTTON) == PRESSED || centerPressed);
         delay(20);
     } while(!done);
     return val;
 }
 
-/** 
+/**
  * Runs the motor group test.
  * Selection of the motor group and speed is handled by other functions.
  *
  * @see selectMotorGroup()
- * @see selectSpdGroup()
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
+ * @see selectSpd()
  */
-void runGroupMotor(FILE *lcdport){
-    bool done = false;
-    int mtr = selectMotorGroup(lcdport);
+void runGroupMotor(){
+    int mtr = selectMotorGroup();
     if(mtr == -1) return;
-    int spd = selectSpdGroup(mtr);
-    int val = spd;
-    disableOpControl = true;
-    motorStopAll();
-    do {
-        char motorstr[LCD_MESSAGE_MAX_LENGTH+1];
-        char temp[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(motorstr, 0, sizeof(motorstr));
-        memset(temp, 0, sizeof(temp));
-        strcpy(motorstr, groups[mtr].name);
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(motorstr))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, motorstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(LCD_PORT, 1, str);
-
-        char speedstr[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(speedstr, 0, sizeof(speedstr));
-        memset(temp, 0, sizeof(temp));
-        strcat(speedstr, "Run Speed: ");
-        sprintf(temp, "%d", val);
-        strcat(speedstr, temp);
-
-        spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(speedstr))/2;
-        strcpy(str, "");
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, speedstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(LCD_PORT, 2, str);
-
-        for(int i = 1; i <= 10; i++){
-            if(groups[mtr].motor[i]){
-                motorSet(i, val);
-            }
-        }
-
-        done = lcdAnyButtonPressed();
-        delay(20);
-    } while(!done);
-    disableOpControl = false;
+    int spd = selectSpd(groups[mtr].name);
+    runMotorTest(groups[mtr].name, &groups[mtr], spd);
 }
 
-/** 
- * Runs the top-level motor testing menu.
- * Prompts the user to select between individual and group motor testing.
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
- */
-void runMotor(FILE *lcdport){
-    bool done = false;
-    int val = 0;
-    do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);
-        bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);
-
-        if(rightPressed && val != 1) val++;
-        else if(leftPressed && val != 0) val--;
-
-        if(val){
-            lcdSetText(lcdport, 1, "Indiv Motor Test");
-        } else {
-            lcdSetText(lcdport, 1, "Group Motor Test");
-        }
-        done = centerPressed;
-        if(val == 0){
-            lcdSetText(LCD_PORT, 2, "|      SEL     >");
-        } else if(val == 1) {
-            lcdSetText(LCD_PORT, 2, "<      SEL     |");
-        }
-        delay(20);
-    } while(!done);
-    if(val){
-        runIndivMotor(lcdport);
-    } else {
-        runGroupMotor(lcdport);
-    }
-}
-
-/** 
+/**
  * Selects the motors that constitute the specified motor group.
- * 
- * @param motor a boolean array that stores the states of each motor in the group
- * 
- * @return a pointer to the array passed
+ *
+ * @param group the motor group to edit
  */
-bool* selectMotorGroupMembers(bool *motor){
+void selectMotorGroupMembers(MotorGroup *group){
     bool done = false;
     int val = 1;
     do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);
-        bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);
+        unsigned int pressed = lcdPressedButtons();
+        bool centerPressed = pressed & LCD_BTN_CENTER;
+        bool leftPressed = pressed & LCD_BTN_LEFT;
+        bool rightPressed = pressed & LCD_BTN_RIGHT;
 
         if(rightPressed && val != 10) val++;
         else if(rightPressed && val == 10) val = 0;
         else if(leftPressed && val != 0) val--;
         else if(leftPressed && val == 0) val = 10;
 
-        char motorstr[LCD_MESSAGE_MAX_LENGTH+1];
         if(val != 0){
-            char temp[LCD_MESSAGE_MAX_LENGTH+1];
-            memset(motorstr, 0, sizeof(motorstr));
-            memset(temp, 0, sizeof(temp));
-            strcpy(motorstr, "Motor ");
-            sprintf(temp, "%d:", val);
-            strcat(motorstr, temp);
-            if(motor[val]){
-                strcat(motorstr, " On");
-            } else {
-                strcat(motorstr, " Off");
-            }
+            char str[LCD_MESSAGE_MAX_LENGTH+1];
+            lcdLineClear(str);
+            int col = lcdPutInt(str, lcdPutText(str, 0, "Motor "), 0, val);
+            lcdCenterLine(str, lcdPutText(str, col, motorGroupHas(group, val) ? ": On" : ": Off"));
+            lcdBufferSetText(LCD_PORT, 1, str);
         } else {
-            strcpy(motorstr, "Confirm");
-        }
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(motorstr))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, motorstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
+            setTextCenter(1, "Confirm");
         }
 
-        lcdSetText(LCD_PORT, 1, str);
-
         done = (centerPressed && val == 0);
         if(centerPressed && val != 0){
-            motor[val] = !motor[val];
-        }
-        if(val == 0){
-            lcdSetText(LCD_PORT, 2, "10     SEL     1");
-        } else if(val == 1) {
-            lcdSetText(LCD_PORT, 2, "ESC    SEL     2");
-        } else if(val == 10) {
-            lcdSetText(LCD_PORT, 2, "9      SEL   ESC");
-        } else if (val == 9) {
-            lcdSetText(LCD_PORT, 2, "8      SEL    10");
-        } else {
-            char navstr[LCD_MESSAGE_MAX_LENGTH+1];
-            memset(navstr, 0, sizeof(navstr));
-            sprintf(navstr, "%c      SEL     %c",(val-1) + '0', (val+1) + '0');
-            /*navstr[0] = (val-1) + '0';*/
-            /*strcat(navstr, "      SEL     ");*/
-            /*navstr[LCD_MESSAGE_MAX_LENGTH] = (val+1) + '0';*/
-            lcdSetText(LCD_PORT, 2, navstr);
+            group->ports ^= 1 << val;
         }
+        setMotorNavText(val);
         delay(20);
     } while(!done);
-    return motor;
 }
 
-/** 
- * Adds a new motor group to the dynamic array.
- */
-void addMotorGroup(){
-    MotorGroup *temp = (MotorGroup*) realloc(groups, sizeof(MotorGroup)*(numgroups+1));
-    if(temp == NULL) return;
-    groups = temp;
-    numgroups++;
-    memset(&groups[numgroups-1], 0, sizeof(groups[numgroups-1]));
-    typeString(groups[numgroups-1].name);
-    selectMotorGroupMembers(groups[numgroups-1].motor);
-}
-
-/** 
- * Edits a motor group.
- * Prompts the user to either edit the name or the motors in a motor group.
- * 
- * @param mtr the ID number of the motor group to edit
+/**
+ * Prompts the user to choose between two options.
+ *
+ * @param first the option selected when the left side is highlighted
+ * @param second the option selected when the right side is highlighted
+ *
+ * @return false if the first option was selected, true if the second option was selected
  */
-void editMotorGroup(int mtr){
-    if(mtr == -1) return;
+bool selectOption(const char *first, const char *second){
     bool done = false;
-    int val = 0;
-    FILE *lcdport = LCD_PORT;
+    bool val = false;
     do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);
-        bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);
+        unsigned int pressed = lcdPressedButtons();
+        if(pressed & LCD_BTN_RIGHT) val = true;
+        else if(pressed & LCD_BTN_LEFT) val = false;
 
-        if(rightPressed && val != 1) val++;
-        else if(leftPressed && val != 0) val--;
+        setTextCenter(1, val ? second : first);
+        lcdBufferSetText(LCD_PORT, 2, val ? "<      SEL     |" : "|      SEL     >");
 
-        char motorstr[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(motorstr, 0, sizeof(motorstr));
+        done = pressed & LCD_BTN_CENTER;
+        delay(20);
+    } while(!done);
+    return val;
+}
 
-        if(val){
-            strcpy(motorstr, "Edit Name");
-        } else {
-            strcpy(motorstr, "Edit Motors");
-        }
+/**
+ * Runs motor characterization on a motor group.
+ * Displays the measured feed-forward constants, and prompts the user whether to save them as the drive constants.
+ *
+ * @see characterize()
+ */
+void runCharacterize(){
+    int mtr = selectMotorGroup();
+    if(mtr == -1) return;
+    Feedforward result;
+    disableOpControl = true;
+    motorStopAll();
+    bool done = characterize(&groups[mtr], &result);
+    motorStopAll();
+    disableOpControl = false;
+    if(!done){
+        lcdBufferSetText(LCD_PORT, 1, "Char. Cancelled");
+        lcdBufferSetText(LCD_PORT, 2, "");
+        delay(1000);
+        return;
+    }
+    char line1[LCD_MESSAGE_MAX_LENGTH+1];
+    char line2[LCD_MESSAGE_MAX_LENGTH+1];
+    lcdLineClear(line1);
+    lcdLineClear(line2);
+    lcdPutText(line1, 0, "kS");
+    lcdPutInt(line1, 2, 4, (int) round(result.kS));
+    lcdPutText(line1, 7, "kV");
+    lcdPutFixed(line1, 9, 7, (int) round(result.kV * 1000), 3);
+    lcdPutText(line2, 0, "kA");
+    lcdPutFixed(line2, 2, 7, (int) round(result.kA * 1000), 3);
+    lcdBufferSetText(LCD_PORT, 1, line1);
+    lcdBufferSetText(LCD_PORT, 2, line2);
+    lcdFlushEvents();
+    while(lcdPressedButtons() == 0){
+        delay(20);
+    }
+    if(selectOption("Discard", "Save as Drive")){
+        driveFeedforward = result;
+        driveFeedforwardValid = true;
+        lcdBufferSetText(LCD_PORT, 1, saveFeedforward() ? "Saved!" : "Save failed!");
+        lcdBufferSetText(LCD_PORT, 2, "");
+        delay(1000);
+    }
+}
 
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(motorstr))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, motorstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
+/**
+ * Runs the gyroscope PID autotuner.
+ * Displays the ultimate gain and period and the gains computed from them,
+ * and prompts the user whether to use the gains for turning and save them.
+ *
+ * @see autotuneGyro()
+ */
+void runAutotune(){
+    AutotuneResult result;
+    disableOpControl = true;
+    motorStopAll();
+    bool done = autotuneGyro(&result);
+    motorStopAll();
+    disableOpControl = false;
+    if(!done){
+        lcdBufferSetText(LCD_PORT, 1, "Tune Cancelled");
+        lcdBufferSetText(LCD_PORT, 2, "");
+        delay(1000);
+        return;
+    }
+    char line1[LCD_MESSAGE_MAX_LENGTH+1];
+    char line2[LCD_MESSAGE_MAX_LENGTH+1];
+    lcdLineClear(line1);
+    lcdLineClear(line2);
+    lcdPutText(line1, 0, "Ku");
+    lcdPutFixed(line1, 2, 6, (int) round(result.ultimateGain * 100), 2);
+    lcdPutText(line1, 9, "Pu");
+    lcdPutInt(line1, 11, 5, (int) round(result.ultimatePeriod * 1000));
+    lcdPutText(line2, 0, "P");
+    lcdPutFixed(line2, 1, 4, (int) round(result.kP * 10), 1);
+    lcdPutText(line2, 6, "D");
+    lcdPutInt(line2, 7, 6, (int) round(result.kD));
+    lcdBufferSetText(LCD_PORT, 1, line1);
+    lcdBufferSetText(LCD_PORT, 2, line2);
+    lcdFlushEvents();
+    while(lcdPressedButtons() == 0){
+        delay(20);
+    }
+    if(selectOption("Discard", "Save as Gyro")){
+        autotuneApply(&result);
+        lcdBufferSetText(LCD_PORT, 1, saveParams() ? "Saved!" : "Save failed!");
+        lcdBufferSetText(LCD_PORT, 2, "");
+        delay(1000);
+    }
+}
+
+/**
+ * Saves the motor groups, displaying the result on the LCD.
+ */
+void saveGroupsWithStatus(){
+    lcdBufferSetText(LCD_PORT, 1, "Saving groups...");
+    lcdBufferSetText(LCD_PORT, 2, "");
+    if(saveGroups()){
+        lcdBufferSetText(LCD_PORT, 1, "Saved groups!");
+    } else {
+        lcdBufferSetText(LCD_PORT, 1, "Save failed!");
+    }
+    delay(1000);
+}
 
-        lcdSetText(lcdport, 1, str);
+/**
+ * Adds a new motor group to the pool.
+ */
+void addMotorGroup(){
+    MotorGroup *group = addGroup();
+    if(group == NULL){
+        lcdBufferSetText(LCD_PORT, 1, "Too many groups!");
+        lcdBufferSetText(LCD_PORT, 2, "");
+        delay(1000);
+        return;
+    }
+    typeString(group->name);
+    selectMotorGroupMembers(group);
+    saveGroupsWithStatus();
+}
 
-        done = centerPressed;
-        if(val == 0){
-            lcdSetText(LCD_PORT, 2, "|      SEL     >");
-        } else if(val == 1) {
-            lcdSetText(LCD_PORT, 2, "<      SEL     |");
-        }
-        delay(20);
-    } while(!done);
-    if(val){
+/**
+ * Edits a motor group.
+ * Prompts the user to select a group, then to either edit the name or the motors in the group.
+ */
+void editMotorGroup(){
+    int mtr = selectMotorGroup();
+    if(mtr == -1) return;
+    if(selectOption("Edit Motors", "Edit Name")){
         typeString(groups[mtr].name);
     } else {
-        selectMotorGroupMembers(groups[mtr].motor);
+        selectMotorGroupMembers(&groups[mtr]);
     }
+    saveGroupsWithStatus();
 }
 
-/** 
+/**
  * Deletes a motor group.
- * Prompts the user whether to cancel or to proceed with deletion.
- * 
- * @param mtr the ID number to delete
+ * Prompts the user to select a group, then whether to cancel or to proceed with deletion.
  */
-void delMotorGroup(int mtr){
+void delMotorGroup(){
+    int mtr = selectMotorGroup();
     if(mtr == -1) return;
-    int val = 0;
-    FILE *lcdport = LCD_PORT;
-    bool done = false;
-    do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);
-        bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);
-
-        if(rightPressed && val != 1) val++;
-        else if(leftPressed && val != 0) val--;
-
-        char motorstr[LCD_MESSAGE_MAX_LENGTH+1];
-        memset(motorstr, 0, sizeof(motorstr));
-
-        if(val){
-            strcpy(motorstr, "Delete Forever");
-        } else {
-            strcpy(motorstr, "Cancel Delete");
-        }
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(motorstr))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, motorstr);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(lcdport, 1, str);
+    if(selectOption("Cancel Delete", "Delete Forever")){
+        deleteGroup(mtr);
+        saveGroupsWithStatus();
+    }
+}
 
-        done = centerPressed;
-        if(val == 0){
-            lcdSetText(LCD_PORT, 2, "|      SEL     >");
-        } else if(val == 1) {
-            lcdSetText(LCD_PORT, 2, "<      SEL     |");
-        }
-        delay(20);
-    } while(!done);
-    if(val){
-        memset(&groups[mtr], 0, sizeof(groups[mtr]));
-        for(int i = mtr; i < numgroups - 1; i++){
-            memcpy(&groups[i], &groups[i+1], sizeof(groups[i]));
-        }
-        numgroups--;
+/**
+ * Renders the value of a parameter, centered on a line, with the given characters at each end.
+ *
+ * @param line the line buffer to render into
+ * @param id the parameter ID number
+ * @param left the character at the left end of the line
+ * @param right the character at the right end of the line
+ */
+void renderParamValue(char *line, int id, char left, char right){
+    const Param *param = &params[id];
+    char value[LCD_MESSAGE_MAX_LENGTH+1];
+    lcdLineClear(value);
+    int scale = 1;
+    for(int i = 0; i < param->decimals; i++){
+        scale *= 10;
     }
+    value[lcdPutFixed(value, 0, 0, (int) round(paramGet(id) * scale), param->decimals)] = '\0';
+    lcdLineClear(line);
+    lcdPutCenter(line, value);
+    lcdPutChar(line, 0, left);
+    lcdPutChar(line, LCD_MESSAGE_MAX_LENGTH - 1, right);
 }
 
-/** 
- * Runs the top-level motor group management menu.
- * Prompts the user whether to add, edit, or delete motor groups.
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
+/**
+ * Selects a parameter. The name of the highlighted parameter is displayed with its current value.
+ *
+ * @return the parameter ID number selected, or -1 when done
  */
-void runMotorGroupMgmt(FILE *lcdport){
+int selectParam(){
     bool done = false;
     int val = 0;
     do {
-        bool centerPressed = lcdButtonPressed(LCD_BTN_CENTER);
-        bool leftPressed = lcdButtonPressed(LCD_BTN_LEFT);
-        bool rightPressed = lcdButtonPressed(LCD_BTN_RIGHT);
+        unsigned int pressed = lcdPressedButtons();
+        bool centerPressed = pressed & LCD_BTN_CENTER;
+        bool leftPressed = pressed & LCD_BTN_LEFT;
+        bool rightPressed = pressed & LCD_BTN_RIGHT;
 
-        if(rightPressed && val != 3) val++;
-        else if(rightPressed && val == 3) val = 0;
-        else if(leftPressed && val != 0) val--;
-        else if(leftPressed && val == 0) val = 3;
+        if(rightPressed && val != PARAM_COUNT-1) val++;
+        else if(rightPressed && val == PARAM_COUNT-1) val = -1;
+        else if(leftPressed && val != -1) val--;
+        else if(leftPressed && val == -1) val = PARAM_COUNT-1;
 
-        switch(val){
-            case 0: lcdSetText(lcdport, 1, "Add Motor Group"); break;
-            case 1: lcdSetText(lcdport, 1, "Edit Motor Group"); break;
-            case 2: lcdSetText(lcdport, 1, "Del Motor Group"); break;
-            case 3: lcdSetText(lcdport, 1, "Cancel Grp. Mgmt"); break;
-        }
-        done = centerPressed;
-        if(val == 0){
-            lcdSetText(LCD_PORT, 2, "<      SEL     >");
+        if(val != -1){
+            char str[LCD_MESSAGE_MAX_LENGTH+1];
+            setTextCenter(1, params[val].name);
+            renderParamValue(str, val, '<', '>');
+            lcdBufferSetText(LCD_PORT, 2, str);
         } else {
-            lcdSetText(LCD_PORT, 2, "<      SEL     >");
+            setTextCenter(1, "Done");
+            lcdBufferSetText(LCD_PORT, 2, "<      SEL     >");
         }
+
+        done = centerPressed;
         delay(20);
     } while(!done);
-    switch(val){
-        case 0: addMotorGroup(); break;
-        case 1: editMotorGroup(selectMotorGroup(lcdport)); break;
-        case 2: delMotorGroup(selectMotorGroup(lcdport)); break;
-        case 3: break;
-    }
+    return val;
 }
 
-/** 
- * Runs the joystick connection debugging menu.
- * Prints whether the main and partner joysticks are connected.
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
+/**
+ * Changes a parameter one step at a time until the center button is pressed.
+ * The new value takes effect immediately, so that the change can be tried out while driving.
+ *
+ * @param id the parameter ID number
  */
-void runConnection(FILE *lcdport){
+void editParamValue(int id){
+    bool done = false;
     do {
-        char strjoy1[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        char strjoy2[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        if(isJoystickConnected(1)){
-            strcat(strjoy1, "J1: Connected");
-        } else {
-            strcat(strjoy1, "J1: Disconnected");
-        }
-        if(isJoystickConnected(2)){
-            strcat(strjoy2, "J2: Connected");
-        } else {
-            strcat(strjoy2, "J2: Disconnected");
+        unsigned int pressed = lcdPressedButtons();
+        if(pressed & LCD_BTN_RIGHT){
+            paramSet(id, paramGet(id) + params[id].step);
+        } else if(pressed & LCD_BTN_LEFT){
+            paramSet(id, paramGet(id) - params[id].step);
         }
 
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(strjoy1))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, strjoy1);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(lcdport, 1, str);
-
-        spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(strjoy2))/2;
-        strcpy(str, "");
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, strjoy2);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(lcdport, 2, str);
+        char str[LCD_MESSAGE_MAX_LENGTH+1];
+        setTextCenter(1, params[id].name);
+        renderParamValue(str, id, '-', '+');
+        lcdBufferSetText(LCD_PORT, 2, str);
 
+        done = pressed & LCD_BTN_CENTER;
         delay(20);
-    } while(!lcdAnyButtonPressed());
+    } while(!done);
 }
 
-/** 
- * Runs the robot sensory information menu.
- * Displays information regarding competition switch status and gyroscope angle.
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
+/**
+ * Edits the runtime parameters.
+ * Prompts the user to select and change parameters until Done is selected,
+ * then whether to save the changes or keep them only until the next power cycle.
  */
-void runRobot(FILE *lcdport){
-    do {
-        char strjoy1[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        char strjoy2[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        /*if(isOnline()){
-            strcat(strjoy1, "Competition Mode");
-        } else {
-            strcat(strjoy1, "Practice Mode");
-        }*/
-        /*if(isEnabled()){
-            strcat(strjoy2, "Robot Enabled");
-        } else {
-            strcat(strjoy2, "Robot Disabled");
-        }*/
-        snprintf(strjoy1, LCD_MESSAGE_MAX_LENGTH+1, "L: %d, R: %d", encoderGet(leftenc), encoderGet(rightenc));
-        sprintf(strjoy2, "Angle: %d", gyroGet(gyro));
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(strjoy1))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, strjoy1);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
+void editParams(){
+    bool changed = false;
+    int id;
+    while((id = selectParam()) != -1){
+        float before = paramGet(id);
+        editParamValue(id);
+        changed = changed || paramGet(id) != before;
+    }
+    if(changed && selectOption("Keep Unsaved", "Save to Flash")){
+        lcdBufferSetText(LCD_PORT, 1, saveParams() ? "Saved params!" : "Save failed!");
+        lcdBufferSetText(LCD_PORT, 2, "");
+        delay(1000);
+    }
+}
 
-        lcdSetText(lcdport, 1, str);
+/**
+ * Toggles the LCD backlight.
+ */
+void toggleBacklight(){
+    backlight = !backlight;
+    lcdSetBacklight(LCD_PORT, backlight);
+}
 
-        spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(strjoy2))/2;
-        strcpy(str, "");
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
+/**
+ * Toggles compensation of motor outputs for the main battery voltage.
+ */
+void toggleCompensation(){
+    batteryCompensation = !batteryCompensation;
+    lcdBufferSetText(LCD_PORT, 1, batteryCompensation ? "Volt Comp On" : "Volt Comp Off");
+    lcdBufferSetText(LCD_PORT, 2, "");
+    delay(1000);
+}
+
+/**
+ * Renders the battery voltage screen.
+ * Each of the first three pages displays the filtered, lowest and average voltage of one of the batteries.
+ * The last page displays the lowest and average main battery voltage over the sag history.
+ *
+ * @param page the battery to display (BATT_MAIN, BATT_BKUP or BATT_PEXP), or NUM_BATTS for the sag history
+ * @param line1 the first line buffer to render into
+ * @param line2 the second line buffer to render into
+ */
+void screenBattery(int page, char *line1, char *line2){
+    if(page == NUM_BATTS){
+        unsigned int minimum = 0;
+        unsigned long sum = 0;
+        int count = 0;
+        BatterySag sag;
+        while(batterySagAt(count, &sag)){
+            if(minimum == 0 || sag.minimum < minimum){
+                minimum = sag.minimum;
+            }
+            sum += sag.average;
+            count++;
         }
-        strcat(str, strjoy2);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
+        lcdPutText(line1, 0, "Sag");
+        lcdPutText(line1, lcdPutInt(line1, 3, 3, count), "s Lo");
+        lcdPutText(line2, 0, "Sag Avg");
+        if(count > 0){
+            lcdPutVoltage(line1, 10, LCD_MESSAGE_MAX_LENGTH - 10, minimum);
+            lcdPutVoltage(line2, 10, LCD_MESSAGE_MAX_LENGTH - 10, sum / count);
         }
+        return;
+    }
+    const BatteryStats *stats = &batteryStats[page];
+    switch(page){
+        case BATT_MAIN: lcdPutText(line1, 0, "Mn Batt:"); break;
+        case BATT_BKUP: lcdPutText(line1, 0, "Bk Batt:"); break;
+        case BATT_PEXP: lcdPutText(line1, 0, "Ex Batt:"); break;
+    }
+    lcdPutVoltage(line1, 9, LCD_MESSAGE_MAX_LENGTH - 9, stats->filtered);
+    lcdPutText(line2, 0, "Lo");
+    lcdPutVoltage(line2, 2, 6, stats->minimum);
+    lcdPutText(line2, 9, "Av");
+    lcdPutVoltage(line2, 11, 5, batteryAverage(page));
+}
 
-        lcdSetText(lcdport, 2, str);
+/**
+ * Fills in the joystick connection screen.
+ * Displays whether the main and partner joysticks are connected.
+ *
+ * @param page ignored - this screen has one page
+ * @param line1 the first line buffer to render into
+ * @param line2 the second line buffer to render into
+ */
+void screenConnection(int page, char *line1, char *line2){
+    lcdPutCenter(line1, isJoystickConnected(1) ? "J1: Connected" : "J1: Disconnected");
+    lcdPutCenter(line2, isJoystickConnected(2) ? "J2: Connected" : "J2: Disconnected");
+}
 
-        delay(20);
-    } while(!lcdAnyButtonPressed());
+/**
+ * Fills in the robot sensory information screen.
+ * Displays the drive encoder counts and gyroscope angle.
+ *
+ * @param page ignored - this screen has one page
+ * @param line1 the first line buffer to render into
+ * @param line2 the second line buffer to render into
+ */
+void screenRobot(int page, char *line1, char *line2){
+    lcdPutText(line1, 0, "L:");
+    lcdPutInt(line1, 2, 6, (int) driveEncoderGet(ENC_LEFT));
+    lcdPutText(line1, 9, "R:");
+    lcdPutInt(line1, 11, 5, (int) driveEncoderGet(ENC_RIGHT));
+    lcdPutText(line2, 0, "Angle:");
+    lcdPutInt(line2, 6, LCD_MESSAGE_MAX_LENGTH - 6, gyroGet(gyro));
 }
 
-/** 
- * Runs the autonomous recorder status menu.
+/**
+ * Fills in the autonomous recorder status screen.
  * Displays the autonomous that is currently loaded, and if controller playback is enabled.
  * Controller playback is automatically disabled when plugged into the competition switch.
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
+ *
+ * @param page ignored - this screen has one page
+ * @param line1 the first line buffer to render into
+ * @param line2 the second line buffer to render into
  */
-void runAuton(FILE *lcdport){
-    do {
-        char strjoy1[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        char strjoy2[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        if(autonLoaded == -1){
-            strcat(strjoy1, "No Auton Loaded");
-        } else if(autonLoaded == 0){
-            strcat(strjoy1, "Empty Auton");
-        } else if(autonLoaded == MAX_AUTON_SLOTS + 1){
-            strcat(strjoy1, "Prog. Skills");
-        } else {
-            FILE* autonFile;
-            char filename[AUTON_FILENAME_MAX_LENGTH];
-            snprintf(filename, sizeof(filename)/sizeof(char), "a%d", autonLoaded);
-            autonFile = fopen(filename, "r");
+void screenAuton(int page, char *line1, char *line2){
+    if(autonLoaded == -1){
+        lcdPutCenter(line1, "No Auton Loaded");
+    } else if(autonLoaded == 0){
+        lcdPutCenter(line1, "Empty Auton");
+    } else if(autonLoaded == MAX_AUTON_SLOTS + 1){
+        lcdPutCenter(line1, "Prog. Skills");
+    } else {
+        char filename[AUTON_FILENAME_MAX_LENGTH];
+        snprintf(filename, sizeof(filename)/sizeof(char), "a%d", autonLoaded);
+        FILE* autonFile = fopen(filename, "r");
+        if(autonFile != NULL){
             char name[LCD_MESSAGE_MAX_LENGTH+1];
             memset(name, 0, sizeof(name));
-            fread(name, sizeof(char), sizeof(name) / sizeof(char), autonFile);
-            strcpy(strjoy1, name);
+            fread(name, sizeof(char), LCD_MESSAGE_MAX_LENGTH, autonFile);
+            lcdPutCenter(line1, name);
             fclose(autonFile);
         }
-        if(isOnline()){
-            strcat(strjoy2, "Recorder Off");
-        } else {
-            strcat(strjoy2, "Recorder On");
-        }
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(strjoy1))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, strjoy1);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(lcdport, 1, str);
-
-        spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(strjoy2))/2;
-        strcpy(str, "");
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, strjoy2);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(lcdport, 2, str);
-
-        delay(20);
-    } while(!lcdAnyButtonPressed());
+    }
+    lcdPutCenter(line2, isOnline() ? "Recorder Off" : "Recorder On");
 }
 
-/** 
- * Runs the credits menu.
+/**
+ * Fills in the credits screen.
  * The LCD diagnostic menu was inspired by Team 750W and Akram Sandhu.
  * This would not be possible without their generosity and permissiveness to use their idea.
  *
  * Note: the implementation of this feature is completely different between the two teams.
  * No code was reused from their implementation of the LCD diagnostic menu.
- * 
- * @param lcdport the LCD screen's port (either UART1 or UART2)
+ *
+ * @param page ignored - this screen has one page
+ * @param line1 the first line buffer to render into
+ * @param line2 the second line buffer to render into
  */
-void runCredits(FILE *lcdport){
-    do {
-        char strjoy1[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        char strjoy2[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        strcat(strjoy1, "Thanks Team 750W");
-        strcat(strjoy2, "Akram Sandhu");
-
-        int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(strjoy1))/2;
-        char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, strjoy1);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-
-        lcdSetText(lcdport, 1, str);
+void screenCredits(int page, char *line1, char *line2){
+    lcdPutCenter(line1, "Thanks Team 750W");
+    lcdPutCenter(line2, "Akram Sandhu");
+}
 
-        spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(strjoy2))/2;
-        strcpy(str, "");
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
-        strcat(str, strjoy2);
-        for(int i = 0; i < spaces; i++){
-            strcat(str, " ");
-        }
+/**
+ * Renders the timing statistics of a loop.
+ * The first line shows the average period, and the second line shows the worst jitter,
+ * the worst overrun (both in milliseconds) and the number of overruns.
+ *
+ * @param stats the statistics of the loop
+ * @param line1 the first line buffer to render into
+ * @param line2 the second line buffer to render into
+ */
+void renderLoopStats(const LoopStats *stats, char *line1, char *line2){
+    lcdPutText(line1, 0, stats->name);
+    lcdPutText(line1, lcdPutFixed(line1, 9, 5, stats->average / 100, 1), "ms");
+    lcdPutText(line2, 0, "J");
+    lcdPutFixed(line2, 1, 4, stats->maxJitter / 100, 1);
+    lcdPutText(line2, 6, "W");
+    lcdPutFixed(line2, 7, 4, stats->worstOverrun / 100, 1);
+    lcdPutText(line2, 12, "O");
+    lcdPutInt(line2, 13, 3, min(stats->overruns, 999));
+}
 
-        lcdSetText(lcdport, 2, str);
+/**
+ * Renders the live telemetry screen.
+ * The pages show the operator control loop timing, the sensor task timing,
+ * the task count and battery sag, and the motor output saturation.
+ *
+ * @param page the page of telemetry to display
+ * @param line1 the first line buffer to render into
+ * @param line2 the second line buffer to render into
+ */
+void screenTelemetry(int page, char *line1, char *line2){
+    switch(page){
+        case 0: renderLoopStats(&opcontrolLoop, line1, line2); break;
+        case 1: renderLoopStats(&sensorLoop, line1, line2); break;
+        case 2: lcdPutText(line1, 0, "Tasks:");
+                lcdPutInt(line1, 6, LCD_MESSAGE_MAX_LENGTH - 6, taskGetCount());
+                lcdPutText(line2, 0, "Batt Min:");
+                if(batteryStats[BATT_MAIN].minimum != 0){
+                    lcdPutVoltage(line2, 9, LCD_MESSAGE_MAX_LENGTH - 9, batteryStats[BATT_MAIN].minimum);
+                }
+                break;
+        case 3: {
+                int saturation = motorActiveSamples == 0 ? 0 : (int) (motorSaturatedSamples * 100 / motorActiveSamples);
+                lcdPutText(line1, 0, "Motor Sat:");
+                lcdPutChar(line1, lcdPutInt(line1, 10, 5, saturation), '%');
+                lcdPutBar(line2, 0, LCD_MESSAGE_MAX_LENGTH, saturation, 100);
+                break;
+            }
+    }
+}
 
-        delay(20);
-    } while(!lcdAnyButtonPressed());
+/**
+ * Renders the profiler screen.
+ * Each page shows one profiled section's CPU usage and its average and maximum duration in microseconds.
+ *
+ * @param page the section ID number to display
+ * @param line1 the first line buffer to render into
+ * @param line2 the second line buffer to render into
+ */
+void screenProfiler(int page, char *line1, char *line2){
+    const ProfileSection *stats = &profileSections[page];
+    lcdPutText(line1, 0, profileNames[page]);
+    lcdPutChar(line1, lcdPutFixed(line1, 10, 5, profileCpuUsage(page), 1), '%');
+    lcdPutText(line2, 0, "A");
+    lcdPutInt(line2, 1, 6, stats->count == 0 ? 0 : (int) (stats->total / stats->count));
+    lcdPutText(line2, 8, "M");
+    lcdPutInt(line2, 9, 7, stats->maximum);
 }
 
-/** 
- * Dispatcher function that executes the selected LCD diagnostic menu function.
- * This function is called with the result of selectMenu().
- * 
- * @see selectMenu()
- * 
- * @param choice the selected menu to run
+/**
+ * Renders the memory usage screen.
+ * Each page shows the stack usage of one tracked task in words.
+ *
+ * @param page the page to display
+ * @param line1 the first line buffer to render into
+ * @param line2 the second line buffer to render into
  */
-void doMenuChoice(int choice){
-    switch(choice){
-        case MENU_SCREENSAVER: runScreensaver(LCD_PORT); break;
-        case MENU_BATTERY: runBattery(LCD_PORT); break;
-        case MENU_MOTOR: runMotor(LCD_PORT); break;
-        case MENU_MOTOR_MGMT: runMotorGroupMgmt(LCD_PORT); break;
-        case MENU_CONNECTION: runConnection(LCD_PORT); break;
-        case MENU_ROBOT: runRobot(LCD_PORT); break;
-        case MENU_AUTON: runAuton(LCD_PORT); break;
-        case MENU_BACKLIGHT: lcdSetBacklight(LCD_PORT, !backlight); backlight = !backlight; break;
-        case MENU_CREDITS: runCredits(LCD_PORT); break;
+void screenMemory(int page, char *line1, char *line2){
+    if(page >= numTrackedTasks){
+        lcdPutCenter(line1, "No Task");
+        return;
     }
+    const TrackedTask *task = &trackedTasks[page];
+    int used = task->stackDepth - taskStackUnused(task);
+    lcdPutText(line1, 0, task->name);
+    lcdPutText(line2, lcdPutInt(line2, 0, 4, used), "/");
+    lcdPutInt(line2, 5, 4, task->stackDepth);
+    lcdPutBar(line2, 10, 6, used, task->stackDepth);
 }
 
+/**
+ * Items of the telemetry menu.
+ */
+const MenuNode telemetryMenu[] = {
+    {"Live Telemetry", NULL, 0, screenTelemetry, 4, NULL},
+    {"Profiler", NULL, 0, screenProfiler, PROFILE_SECTION_COUNT, NULL},
+    {"Dump Profile", NULL, 0, NULL, 0, profileDump},
+    {"Memory", NULL, 0, screenMemory, MAX_TRACKED_TASKS, NULL},
+    {"Dump Memory", NULL, 0, NULL, 0, memDump},
+    {"Benchmark", NULL, 0, NULL, 0, benchDump},
+    {"Dump Black Box", NULL, 0, NULL, 0, blackBoxDump},
+    {"Toggle Stream", NULL, 0, NULL, 0, streamToggle},
+    {"Reset Telemetry", NULL, 0, NULL, 0, resetTelemetry},
+    {"Back", NULL, 0, NULL, 0, NULL}
+};
+
+/**
+ * Items of the motor testing menu.
+ */
+const MenuNode motorMenu[] = {
+    {"Group Motor Test", NULL, 0, NULL, 0, runGroupMotor},
+    {"Indiv Motor Test", NULL, 0, NULL, 0, runIndivMotor},
+    {"Characterize", NULL, 0, NULL, 0, runCharacterize},
+    {"Autotune Gyro", NULL, 0, NULL, 0, runAutotune},
+    {"Back", NULL, 0, NULL, 0, NULL}
+};
+
+/**
+ * Items of the motor group management menu.
+ */
+const MenuNode motorGroupMenu[] = {
+    {"Add Motor Group", NULL, 0, NULL, 0, addMotorGroup},
+    {"Edit Motor Group", NULL, 0, NULL, 0, editMotorGroup},
+    {"Del Motor Group", NULL, 0, NULL, 0, delMotorGroup},
+    {"Cancel Grp. Mgmt", NULL, 0, NULL, 0, NULL}
+};
+
+/**
+ * Items of the top-level menu.
+ */
+const MenuNode topMenu[] = {
+    {"Motor Test", motorMenu, sizeof(motorMenu)/sizeof(MenuNode), NULL, 0, NULL},
+    {"Motor Group Mgmt", motorGroupMenu, sizeof(motorGroupMenu)/sizeof(MenuNode), NULL, 0, NULL},
+    {"Parameters", NULL, 0, NULL, 0, editParams},
+    {"Battery Info", NULL, 0, screenBattery, NUM_BATTS+1, NULL},
+    {"Connection Info", NULL, 0, screenConnection, 1, NULL},
+    {"Robot Info", NULL, 0, screenRobot, 1, NULL},
+    {"Telemetry", telemetryMenu, sizeof(telemetryMenu)/sizeof(MenuNode), NULL, 0, NULL},
+    {"Autonomous Info", NULL, 0, screenAuton, 1, NULL},
+    {"Toggle Volt Comp", NULL, 0, NULL, 0, toggleCompensation},
+    {"Toggle Backlight", NULL, 0, NULL, 0, toggleBacklight},
+    {"Screensaver", NULL, 0, NULL, 0, runScreensaver},
+    {"Credits", NULL, 0, screenCredits, 1, NULL}
+};
+
+/**
+ * The root of the LCD diagnostic menu tree.
+ */
+const MenuNode menuRoot = {"Main Menu", topMenu, sizeof(topMenu)/sizeof(MenuNode), NULL, 0, NULL};
+
 /**
  * Runs the LCD diagnostic menu task.
  * This thread executes concurrently with the operator control task.
  * The LCD diagnostic menu starts in screensaver mode.
  * Pressing any button cancels screensaver mode and enters the selection menu.
  *
+ * The whole menu tree is driven by this single event loop.
+ * The left and right buttons move through the items of the current menu, and the center button selects one.
+ *
  * @param ignore does nothing - required by task definition
  */
 void formatLCDDisplay(void *ignore){
+    const MenuNode *menus[LCD_MENU_MAX_DEPTH];
+    int selected[LCD_MENU_MAX_DEPTH];
+    int depth = 0;
+    const MenuNode *screen = NULL;
+    int page = 0;
+
     lcdSetBacklight(LCD_PORT, backlight);
-    doMenuChoice(MENU_SCREENSAVER);
+    runScreensaver();
+    menus[0] = &menuRoot;
+    selected[0] = 0;
+    unsigned long wakeTime = millis();
     while(true){
-        doMenuChoice(selectMenu());
+        unsigned long profile = profileBegin();
+        lcdEvent event;
+        while(lcdNextEvent(&event)){
+            if(event.type != LCD_EVENT_PRESS){
+                continue;
+            }
+            if(screen != NULL){
+                if(screen->pageCount > 1 && event.button == LCD_BTN_LEFT){
+                    page = (page + screen->pageCount - 1) % screen->pageCount;
+                } else if(screen->pageCount > 1 && event.button == LCD_BTN_RIGHT){
+                    page = (page + 1) % screen->pageCount;
+                } else {
+                    screen = NULL;
+                }
+                continue;
+            }
+            const MenuNode *menu = menus[depth];
+            if(event.button == LCD_BTN_LEFT){
+                selected[depth] = (selected[depth] + menu->childCount - 1) % menu->childCount;
+            } else if(event.button == LCD_BTN_RIGHT){
+                selected[depth] = (selected[depth] + 1) % menu->childCount;
+            } else if(event.button == LCD_BTN_CENTER){
+                const MenuNode *item = &menu->children[selected[depth]];
+                printf("Selected menu choice: %s\n", item->name);
+                if(item->children != NULL && depth < LCD_MENU_MAX_DEPTH - 1){
+                    depth++;
+                    menus[depth] = item;
+                    selected[depth] = 0;
+                } else if(item->screen != NULL){
+                    screen = item;
+                    page = 0;
+                } else if(item->action != NULL){
+                    item->action();
+                    depth = 0;
+                    lcdFlushEvents();
+                    wakeTime = millis();
+                    // Time spent in the action is not part of the menu loop
+                    profile = profileBegin();
+                    break;
+                } else if(depth > 0){
+                    depth--;
+                }
+            }
+        }
+
+        char line1[LCD_MESSAGE_MAX_LENGTH+1];
+        char line2[LCD_MESSAGE_MAX_LENGTH+1];
+        lcdLineClear(line1);
+        lcdLineClear(line2);
+        if(screen != NULL){
+            screen->screen(page, line1, line2);
+        } else {
+            lcdPutCenter(line1, menus[depth]->children[selected[depth]].name);
+            lcdPutText(line2, 0, "<      SEL     >");
+        }
+        lcdBufferSetText(LCD_PORT, 1, line1);
+        lcdBufferSetText(LCD_PORT, 2, line2);
+        profileEnd(PROFILE_LCD_MENU, profile);
+        taskDelayUntil(&wakeTime, LCD_MENU_PERIOD);
     }
 }
-
@@ -0,0 +1,207 @@
+/** @file lcdformat.c
+ * @brief File for the LCD text formatter and widgets
+ *
+ * This file contains the code for formatting text on the LCD.
+ * All widgets write in place into a line buffer, with each character written once,
+ * instead of building strings with strcat and sprintf.
+ *
+ * @see lcdformat.h
+ */
+
+#include "main.h"
+
+/**
+ * Fills a line buffer with spaces and terminates it.
+ *
+ * @param line the line buffer (must be at least LCD_MESSAGE_MAX_LENGTH+1 characters)
+ */
+void lcdLineClear(char *line){
+    memset(line, ' ', LCD_MESSAGE_MAX_LENGTH);
+    line[LCD_MESSAGE_MAX_LENGTH] = '\0';
+}
+
+/**
+ * Writes text into a line buffer.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param text the text to write
+ *
+ * @return the column after the last character written
+ */
+int lcdPutText(char *line, int col, const char *text){
+    while(col < LCD_MESSAGE_MAX_LENGTH && *text != '\0'){
+        line[col++] = *text++;
+    }
+    return col;
+}
+
+/**
+ * Writes a single character into a line buffer.
+ *
+ * @param line the line buffer
+ * @param col the column to write at
+ * @param c the character to write
+ *
+ * @return the column after the character
+ */
+int lcdPutChar(char *line, int col, char c){
+    if(col >= 0 && col < LCD_MESSAGE_MAX_LENGTH){
+        line[col] = c;
+    }
+    return col + 1;
+}
+
+/**
+ * Writes the digits of a fixed-point number into a line buffer.
+ * The digits are generated from least to most significant, so they are written right to left.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param width the width of the field to right-align the number in, or 0 for its natural width
+ * @param value the number to write, in units of 10^-decimals
+ * @param decimals the number of digits after the decimal point (0 for an integer)
+ *
+ * @return the column after the field
+ */
+int lcdPutNumber(char *line, int col, int width, int value, int decimals){
+    // An int has at most 10 digits, plus a sign, a decimal point and a leading zero
+    char digits[LCD_MESSAGE_MAX_LENGTH+1];
+    int len = 0;
+    unsigned int magnitude = value < 0 ? -(unsigned int) value : (unsigned int) value;
+    do {
+        digits[len++] = '0' + magnitude % 10;
+        magnitude /= 10;
+        if(len == decimals){
+            digits[len++] = '.';
+            if(magnitude == 0){
+                digits[len++] = '0';
+            }
+        }
+    } while((magnitude != 0 || len <= decimals) && len < LCD_MESSAGE_MAX_LENGTH);
+    if(value < 0 && len < LCD_MESSAGE_MAX_LENGTH){
+        digits[len++] = '-';
+    }
+    if(width < len){
+        width = len;
+    }
+    for(int i = 0; i < width - len; i++){
+        lcdPutChar(line, col++, ' ');
+    }
+    while(len > 0){
+        lcdPutChar(line, col++, digits[--len]);
+    }
+    return col;
+}
+
+/**
+ * Writes an integer into a line buffer.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param width the width of the field to right-align the integer in, or 0 to write it left-aligned at its natural width
+ * @param value the integer to write
+ *
+ * @return the column after the field
+ */
+int lcdPutInt(char *line, int col, int width, int value){
+    return lcdPutNumber(line, col, width, value, 0);
+}
+
+/**
+ * Writes a fixed-point number into a line buffer.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param width the width of the field to right-align the number in, or 0 to write it left-aligned at its natural width
+ * @param value the number to write, in units of 10^-decimals
+ * @param decimals the number of digits after the decimal point
+ *
+ * @return the column after the field
+ */
+int lcdPutFixed(char *line, int col, int width, int value, int decimals){
+    return lcdPutNumber(line, col, width, value, decimals);
+}
+
+/**
+ * Writes a voltage into a line buffer, with two decimals and a trailing V.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param width the width of the field to right-align the voltage in (including the V), or 0 for its natural width
+ * @param millivolts the voltage to write, in millivolts
+ *
+ * @return the column after the field
+ */
+int lcdPutVoltage(char *line, int col, int width, int millivolts){
+    int centivolts = (millivolts + (millivolts < 0 ? -5 : 5)) / 10;
+    col = lcdPutNumber(line, col, width > 0 ? width - 1 : 0, centivolts, 2);
+    return lcdPutChar(line, col, 'V');
+}
+
+/**
+ * Writes a horizontal bar graph into a line buffer.
+ *
+ * @param line the line buffer
+ * @param col the column to start writing at
+ * @param width the width of the bar graph
+ * @param value the value to display, clamped to the range [0, full]
+ * @param full the value corresponding to a full bar
+ *
+ * @return the column after the bar graph
+ */
+int lcdPutBar(char *line, int col, int width, int value, int full){
+    int filled = 0;
+    if(full > 0){
+        value = min(max(value, 0), full);
+        filled = (value * width + full/2) / full;
+    }
+    for(int i = 0; i < width; i++){
+        lcdPutChar(line, col++, i < filled ? LCD_BAR_FULL : LCD_BAR_EMPTY);
+    }
+    return col;
+}
+
+/**
+ * Centers the first characters of a line buffer within the line.
+ *
+ * @param line the line buffer
+ * @param len the number of characters at the start of the line to center
+ */
+void lcdCenterLine(char *line, int len){
+    len = min(max(len, 0), LCD_MESSAGE_MAX_LENGTH);
+    int spaces = (LCD_MESSAGE_MAX_LENGTH - len)/2;
+    if(spaces == 0){
+        return;
+    }
+    memmove(line + spaces, line, len);
+    memset(line, ' ', spaces);
+}
+
+/**
+ * Writes text centered in a line buffer, clearing the rest of the line.
+ *
+ * @param line the line buffer
+ * @param text the text to write
+ */
+void lcdPutCenter(char *line, const char *text){
+    lcdLineClear(line);
+    lcdCenterLine(line, lcdPutText(line, 0, text));
+}
+
+/**
+ * Writes two fields into a line buffer, one left-aligned and one right-aligned, clearing the rest of the line.
+ *
+ * @param line the line buffer
+ * @param left the text to left-align
+ * @param right the text to right-align
+ */
+void lcdPutSplit(char *line, const char *left, const char *right){
+    lcdLineClear(line);
+    lcdPutText(line, 0, left);
+    int len = strlen(right);
+    if(len > LCD_MESSAGE_MAX_LENGTH){
+        len = LCD_MESSAGE_MAX_LENGTH;
+    }
+    lcdPutText(line, LCD_MESSAGE_MAX_LENGTH - len, right);
+}
@@ -83,16 +83,9 @@ char* lcdmsg[] = {
  */
 void randlcdmsg(FILE *lcdport, int line){
     int index = rand() % LCD_MESSAGE_COUNT;
-    int spaces = (LCD_MESSAGE_MAX_LENGTH - strlen(lcdmsg[index]))/2;
-    char str[LCD_MESSAGE_MAX_LENGTH+1] = "";
-    for(int i = 0; i < spaces; i++){
-        strcat(str, " ");
-    }
-    strcat(str, lcdmsg[index]);
-    for(int i = 0; i < spaces; i++){
-        strcat(str, " ");
-    }
-    lcdSetText(lcdport, line, str);
+    char str[LCD_MESSAGE_MAX_LENGTH+1];
+    lcdPutCenter(str, lcdmsg[index]);
+    lcdBufferSetText(lcdport, line, str);
 }
 
 /** 
@@ -101,7 +94,7 @@ void randlcdmsg(FILE *lcdport, int line){
  * @param lcdport the port the LCD is connected to
  */
 void screensaver(FILE *lcdport) {
-    lcdSetText(lcdport, 1, LCD_750C_TITLE);
+    lcdBufferSetText(lcdport, 1, LCD_750C_TITLE);
     randlcdmsg(lcdport, 2);
 }
 
@@ -0,0 +1,103 @@
+/** @file memtrack.c
+ * @brief File for stack usage tracking
+ *
+ * This file contains the code for tracking the stack usage of tasks.
+ *
+ * @see memtrack.h
+ */
+
+#include "main.h"
+
+/**
+ * The tracked tasks.
+ */
+TrackedTask trackedTasks[MAX_TRACKED_TASKS];
+
+/**
+ * The number of tracked tasks.
+ */
+int numTrackedTasks = 0;
+
+/**
+ * Runs a tracked task.
+ * The unused part of the stack is painted before the task's function is called.
+ *
+ * @param entry the task's entry in trackedTasks
+ */
+void runTrackedTask(void *entry) {
+    TrackedTask *task = (TrackedTask *) entry;
+    // The address of this local is close to the top of the stack
+    volatile unsigned long top = STACK_PAINT_VALUE;
+    volatile unsigned long *bottom = &top - task->stackDepth + STACK_TOP_ALLOWANCE;
+    volatile unsigned long *end = &top - STACK_PAINT_MARGIN;
+    for (volatile unsigned long *word = bottom; word < end; word++) {
+        *word = STACK_PAINT_VALUE;
+    }
+    task->paintWords = end - bottom;
+    task->paintBottom = bottom;
+    task->code(task->parameters);
+}
+
+/**
+ * Creates a task whose stack usage is tracked.
+ *
+ * @param name the name of the task
+ * @param code the function the task runs
+ * @param stackDepth the size of the task's stack, in words
+ * @param parameters the argument passed to the task's function
+ * @param priority the priority of the task
+ *
+ * @return a handle to the created task, or NULL if an error occurred
+ */
+TaskHandle taskCreateTracked(const char *name, TaskCode code, unsigned int stackDepth, void *parameters, unsigned int priority) {
+    TrackedTask *task = NULL;
+    for (int i = 0; i < numTrackedTasks; i++) {
+        if (strcmp(trackedTasks[i].name, name) == 0) {
+            task = &trackedTasks[i];
+            break;
+        }
+    }
+    if (task == NULL) {
+        if (numTrackedTasks >= MAX_TRACKED_TASKS || stackDepth <= STACK_TOP_ALLOWANCE + STACK_PAINT_MARGIN) {
+            return taskCreate(code, stackDepth, parameters, priority);
+        }
+        task = &trackedTasks[numTrackedTasks++];
+    }
+    task->name = name;
+    task->stackDepth = stackDepth;
+    task->code = code;
+    task->parameters = parameters;
+    task->paintBottom = NULL;
+    task->paintWords = 0;
+    task->handle = taskCreate(runTrackedTask, stackDepth, task, priority);
+    return task->handle;
+}
+
+/**
+ * Finds the number of words of a tracked task's stack that have never been used.
+ *
+ * @param task the tracked task
+ *
+ * @return the number of words never used
+ */
+unsigned int taskStackUnused(const TrackedTask *task) {
+    if (task->paintBottom == NULL) {
+        return task->stackDepth;
+    }
+    unsigned int unused = 0;
+    while (unused < task->paintWords && task->paintBottom[unused] == STACK_PAINT_VALUE) {
+        unused++;
+    }
+    return unused;
+}
+
+/**
+ * Prints the stack usage of every tracked task to the debug UART.
+ */
+void memDump() {
+    printf("Task stacks (words used/size):\n");
+    for (int i = 0; i < numTrackedTasks; i++) {
+        const TrackedTask *task = &trackedTasks[i];
+        printf("%-10s %u/%u\n", task->name, task->stackDepth - taskStackUnused(task), task->stackDepth);
+    }
+}
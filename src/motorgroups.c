@@ -0,0 +1,201 @@
+/** @file motorgroups.c
+ * @brief File for motor group storage
+ *
+ * This file contains the code for the motor group pool and saving it to the Cortex flash memory.
+ *
+ * @see motorgroups.h
+ */
+
+#include "main.h"
+
+/**
+ * Array that stores the motor groups.
+ */
+MotorGroup groups[MAX_MOTOR_GROUPS];
+
+/**
+ * Stores the number of motor groups in use.
+ */
+int numgroups = 0;
+
+/**
+ * The names of the files motor group records alternate between.
+ */
+const char *groupFiles[MOTOR_GROUP_SLOTS] = {"grp0", "grp1"};
+
+/**
+ * The slot holding the newest record, or -1 if there is no record.
+ */
+int groupSlot = -1;
+
+/**
+ * The sequence number of the newest record.
+ */
+unsigned long groupSequence = 0;
+
+/**
+ * Computes the checksum of a motor group record.
+ *
+ * @param header the header of the record
+ * @param data the motor groups of the record
+ *
+ * @return the checksum
+ */
+unsigned short groupRecordCrc(const MotorGroupHeader *header, const MotorGroup *data) {
+    MotorGroupHeader copy = *header;
+    copy.crc = 0;
+    unsigned short crc = crc16(CRC16_INIT, &copy, sizeof(copy));
+    return crc16(crc, data, sizeof(MotorGroup) * header->count);
+}
+
+/**
+ * Reads a motor group record from a slot and checks that it is valid.
+ *
+ * @param slot the slot to read
+ * @param header a pointer to store the header of the record in
+ * @param data an array of MAX_MOTOR_GROUPS groups to store the motor groups of the record in
+ *
+ * @return true if the record is valid, false otherwise
+ */
+bool readGroupRecord(int slot, MotorGroupHeader *header, MotorGroup *data) {
+    FILE *file = fopen(groupFiles[slot], "r");
+    if (file == NULL) {
+        return false;
+    }
+    bool valid = fread(header, sizeof(*header), 1, file) == 1 &&
+            header->magic == MOTOR_GROUP_MAGIC &&
+            header->version == MOTOR_GROUP_VERSION &&
+            header->count <= MAX_MOTOR_GROUPS &&
+            fread(data, sizeof(MotorGroup), header->count, file) == header->count &&
+            groupRecordCrc(header, data) == header->crc;
+    fclose(file);
+    return valid;
+}
+
+/**
+ * Loads the newest valid motor group record from the flash memory.
+ *
+ * @return true if a record was loaded, false otherwise
+ */
+bool loadGroups() {
+    MotorGroupHeader header;
+    MotorGroup data[MAX_MOTOR_GROUPS];
+    int best = -1;
+    unsigned long bestSequence = 0;
+    for (int slot = 0; slot < MOTOR_GROUP_SLOTS; slot++) {
+        if (readGroupRecord(slot, &header, data) && (best == -1 || (long) (header.sequence - bestSequence) > 0)) {
+            best = slot;
+            bestSequence = header.sequence;
+        }
+    }
+    if (best == -1 || !readGroupRecord(best, &header, data)) {
+        return false;
+    }
+    memcpy(groups, data, sizeof(MotorGroup) * header.count);
+    numgroups = header.count;
+    groupSlot = best;
+    groupSequence = header.sequence;
+    return true;
+}
+
+/**
+ * Saves the motor groups to the flash memory.
+ *
+ * @return true if the record was written completely, false otherwise
+ */
+bool saveGroups() {
+    int slot = (groupSlot + 1) % MOTOR_GROUP_SLOTS;
+    MotorGroupHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = MOTOR_GROUP_MAGIC;
+    header.version = MOTOR_GROUP_VERSION;
+    header.count = numgroups;
+    header.sequence = groupSequence + 1;
+    header.crc = groupRecordCrc(&header, groups);
+
+    FILE *file = fopen(groupFiles[slot], "w");
+    if (file == NULL) {
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(groups, sizeof(MotorGroup), numgroups, file) == (size_t) numgroups;
+    fclose(file);
+    if (written) {
+        groupSlot = slot;
+        groupSequence = header.sequence;
+    }
+    return written;
+}
+
+/**
+ * Adds an empty motor group to the pool.
+ *
+ * @return a pointer to the new group, or NULL if the pool is full
+ */
+MotorGroup* addGroup() {
+    if (numgroups >= MAX_MOTOR_GROUPS) {
+        return NULL;
+    }
+    MotorGroup *group = &groups[numgroups++];
+    memset(group, 0, sizeof(*group));
+    return group;
+}
+
+/**
+ * Removes a motor group from the pool.
+ *
+ * @param index the ID number of the group to remove
+ */
+void deleteGroup(int index) {
+    if (index < 0 || index >= numgroups) {
+        return;
+    }
+    memmove(&groups[index], &groups[index+1], sizeof(MotorGroup) * (numgroups - index - 1));
+    numgroups--;
+}
+
+/**
+ * Adds a group to the standard set of motor groups.
+ *
+ * @param name the name of the group
+ * @param ports the motor ports in the group, as a bitmask
+ */
+void addDefaultGroup(const char *name, unsigned short ports) {
+    MotorGroup *group = addGroup();
+    if (group != NULL) {
+        strncpy(group->name, name, LCD_MESSAGE_MAX_LENGTH);
+        group->ports = ports;
+    }
+}
+
+/**
+ * Loads the saved motor groups, or the standard set of groups if none have been saved.
+ */
+void initGroups() {
+    if (loadGroups()) {
+        return;
+    }
+    numgroups = 0;
+    addDefaultGroup("Left Drive", 1 << LEFT_MOTOR);
+    addDefaultGroup("Right Drive", 1 << RIGHT_MOTOR);
+    addDefaultGroup("Strafe Motor", 1 << STRAFE_MOTOR);
+    addDefaultGroup("Full Drive", (1 << LEFT_MOTOR) | (1 << RIGHT_MOTOR) | (1 << STRAFE_MOTOR));
+    addDefaultGroup("Nautilus Shooter", (1 << NAUTILUS_SHOOTER_MOTOR_LEFT) | (1 << NAUTILUS_SHOOTER_MOTOR_RIGHT) | (1 << NAUTILUS_SHOOTER_MOTOR_CENTER));
+    addDefaultGroup("Intake", 1 << INTAKE_ROLLER_MOTOR);
+    addDefaultGroup("Lift", (1 << LIFT_MOTOR_LEFT) | (1 << LIFT_MOTOR_RIGHT));
+    addDefaultGroup("Angle Changer", 1 << SHOOTER_ANGLE_MOTOR);
+}
+
+/**
+ * Runs every motor in a motor group at the same speed.
+ *
+ * @param group the motor group
+ * @param spd the speed to run the motors at
+ */
+void motorGroupSet(const MotorGroup *group, int spd) {
+    for (int port = 1; port <= 10; port++) {
+        if (motorGroupHas(group, port)) {
+            motorSet(port, spd);
+        }
+    }
+}
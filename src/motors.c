@@ -15,6 +15,12 @@ float enc_integral = 0;
 float enc_derivative = 0;
 float enc_previous_error = 0;
 
+/**
+ * Encoder cursor for the drive-straight control loop.
+ * The loop corrects for the difference in distance travelled by each side since the cursor was marked.
+ */
+EncoderCursor straightCursor;
+
 /**
  * Moves the drive straight by using the encoders to make a PID correction loop.
  *
@@ -23,18 +29,18 @@ float enc_previous_error = 0;
 void moveStraight(int speed) {
     speed = constrain(speed, -110, 110);
 
-    float error = encoderGet(rightenc) - encoderGet(leftenc);
+    float error = cursorGet(&straightCursor, ENC_RIGHT) - cursorGet(&straightCursor, ENC_LEFT);
 
     enc_integral += error * 20;
     enc_derivative = (error-enc_previous_error)/20.0;
 
-    move_lr(speed, (int)((float)speed - ((float)speed)/((float)110.0) * (float)(ENCODER_KP * error + ENCODER_KI * enc_integral - ENCODER_KD * enc_derivative)));
+    move_lrCompensated(speed, (int)((float)speed - ((float)speed)/((float)110.0) * (encoderKp * error + encoderKi * enc_integral - encoderKd * enc_derivative)));
     
     enc_previous_error = error;
 }
 
 void resetEncoderVariables(){
-    clearDriveEncoders();
+    cursorReset(&straightCursor);
     enc_integral = 0;
     enc_derivative = 0;
     enc_previous_error = 0;
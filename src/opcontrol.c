@@ -91,8 +91,11 @@ int targetNet(int target){
     float error = -1 * (target - (gyroGet(gyro) % ROTATION_DEG));
     integral += error * 20;
     derivative = (error-previous_error)/100.0;
-    printf("P: %f\tI: %f\tD: %f\n", error, integral, derivative);
-    turn = error * GYRO_KP + integral * GYRO_KI + derivative * GYRO_KD;
+    turn = error * gyroKp + integral * gyroKi + derivative * gyroKd;
+    streamPublish(STREAM_GYRO_TARGET, target);
+    streamPublish(STREAM_GYRO_ERROR, error);
+    streamPublish(STREAM_GYRO_INTEGRAL, integral);
+    streamPublish(STREAM_GYRO_DERIVATIVE, derivative);
     previous_error = error;
     return turn;
 }
@@ -101,7 +104,7 @@ int targetNet(int target){
  * Resets the gyroscope PID variables so it can be used a second time.
  */
 void resetGyroVariables(){
-    gyroReset(gyro);
+    resetGyroHeading();
     integral = 0;
     derivative = 0;
     previous_error = 0;
@@ -129,13 +132,13 @@ void recordJoyInfo(){
                 fieldLoadingThresholdReached = true;
             }
             if(fieldLoadingThresholdReached && digitalRead(SHOOTER_LIMIT) == UNPRESSED) {
-                sht = -25; //holding in place speed
+                sht = shooterHoldSpeed;
             } else {
                 sht = -127;
             }
         } else if(joystickGetDigital(2, 7, JOY_RIGHT)){ //full distance shooting
             if(digitalRead(SHOOTER_LIMIT) == PRESSED){
-                sht = -25; //holding in place speed
+                sht = shooterHoldSpeed;
             } else {
                 sht = -127;
             }
@@ -216,9 +219,11 @@ void recordJoyInfo(){
 
 /**
  * Moves the robot based on the motor state variables.
+ * The drive is compensated for the battery voltage, so a recorded autonomous run plays back
+ * the same on a different battery than it was recorded on.
  */
 void moveRobot(){
-    move(spd, turn, strafe);
+    moveCompensated(spd, turn, strafe);
     shoot(sht);
     intake(intk);
     adjust(ang);
@@ -251,6 +256,8 @@ void operatorControl() {
         playbackAuton();
     }
     while (true) {
+        loopStatsTick(&opcontrolLoop);
+        unsigned long profile = profileBegin();
         if(isOnline() || progSkills == 0){
             if(joystickGetDigital(2, 7, JOY_UP)) {
                 if(!speakerButtonPressed) {
@@ -262,12 +269,12 @@ void operatorControl() {
             }
             if(speakerPlay){
                 if(speakerTask == NULL){
-                    speakerTask = taskCreate(playSpeaker, TASK_DEFAULT_STACK_SIZE, NULL, TASK_PRIORITY_DEFAULT);
+                    speakerTask = taskCreateTracked("Speaker", playSpeaker, TASK_DEFAULT_STACK_SIZE, NULL, TASK_PRIORITY_DEFAULT);
                     speakerPlay = false;
                 }
             } 
             if(lcdDiagTask == NULL){
-                lcdDiagTask = taskCreate(formatLCDDisplay, TASK_DEFAULT_STACK_SIZE, NULL, TASK_PRIORITY_DEFAULT);
+                lcdDiagTask = taskCreateTracked("LCD Menu", formatLCDDisplay, LCD_DIAG_STACK_SIZE, NULL, TASK_PRIORITY_DEFAULT);
             } else if(taskGetState(lcdDiagTask) == TASK_SUSPENDED){
                 taskResume(lcdDiagTask);
             }
@@ -288,8 +295,8 @@ void operatorControl() {
             }
         } else {
             motorStopAll();
-            lcdSetText(LCD_PORT, 1, "Press 7R");
-            lcdPrint(LCD_PORT, 2,   "Last Skills: %d", progSkills);
+            lcdBufferSetText(LCD_PORT, 1, "Press 7R");
+            lcdBufferPrint(LCD_PORT, 2,   "Last Skills: %d", progSkills);
             if (joystickGetDigital(1, 7, JOY_RIGHT) && !joystickGetDigital(1, 7, JOY_UP) && !joystickGetDigital(1, 7, JOY_DOWN) && !isOnline()) {
                 recordAuton();
                 saveAuton();
@@ -297,6 +304,7 @@ void operatorControl() {
                 progSkills = 0;
             }
         }
+        profileEnd(PROFILE_OPCONTROL, profile);
         delay(20);
     }
 }
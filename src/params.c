@@ -0,0 +1,451 @@
+/** @file params.c
+ * @brief File for the runtime parameter registry
+ *
+ * This file contains the parameter variables, the table that describes them,
+ * saving and loading them from the Cortex flash memory, and the debug terminal commands.
+ *
+ * @see params.h
+ */
+
+#include "main.h"
+
+/**
+ * The proportional gain of the gyroscope turning loop.
+ */
+float gyroKp = GYRO_KP;
+
+/**
+ * The integral gain of the gyroscope turning loop.
+ */
+float gyroKi = GYRO_KI;
+
+/**
+ * The derivative gain of the gyroscope turning loop.
+ */
+float gyroKd = GYRO_KD;
+
+/**
+ * The proportional gain of the encoder drive-straight loop.
+ */
+float encoderKp = ENCODER_KP;
+
+/**
+ * The integral gain of the encoder drive-straight loop.
+ */
+float encoderKi = ENCODER_KI;
+
+/**
+ * The derivative gain of the encoder drive-straight loop.
+ */
+float encoderKd = ENCODER_KD;
+
+/**
+ * The ultrasonic range at which the skills routine has reached the other side of the field.
+ */
+int distanceToOtherSide = DISTANCE_TO_OTHER_SIDE;
+
+/**
+ * The angle from the vertical used to shoot into the close goal.
+ */
+int closeGoalAngle = CLOSE_GOAL_ANGLE;
+
+/**
+ * The angle from the vertical used to shoot into the far goal.
+ */
+int farGoalAngle = FAR_GOAL_ANGLE;
+
+/**
+ * The shooter speed that holds it in place once it is loaded.
+ */
+int shooterHoldSpeed = SHOOTER_HOLD_SPEED;
+
+/**
+ * The parameters in the registry, indexed by parameter ID number.
+ */
+const Param params[PARAM_COUNT] = {
+    {"gyro_kp", PARAM_FLOAT, 1, &gyroKp, GYRO_KP, 0, 1000, 0.5},
+    {"gyro_ki", PARAM_FLOAT, 3, &gyroKi, GYRO_KI, 0, 10, 0.001},
+    {"gyro_kd", PARAM_FLOAT, 0, &gyroKd, GYRO_KD, 0, 20000, 25},
+    {"encoder_kp", PARAM_FLOAT, 1, &encoderKp, ENCODER_KP, 0, 100, 0.5},
+    {"encoder_ki", PARAM_FLOAT, 3, &encoderKi, ENCODER_KI, 0, 10, 0.001},
+    {"encoder_kd", PARAM_FLOAT, 1, &encoderKd, ENCODER_KD, 0, 1000, 0.5},
+    {"dist_other_side", PARAM_INT, 0, &distanceToOtherSide, DISTANCE_TO_OTHER_SIDE, 0, 300, 1},
+    {"close_goal_ang", PARAM_INT, 0, &closeGoalAngle, CLOSE_GOAL_ANGLE, -45, 45, 1},
+    {"far_goal_ang", PARAM_INT, 0, &farGoalAngle, FAR_GOAL_ANGLE, -45, 45, 1},
+    {"shooter_hold", PARAM_INT, 0, &shooterHoldSpeed, SHOOTER_HOLD_SPEED, -127, 127, 1}
+};
+
+/**
+ * The names of the files parameter records alternate between.
+ */
+const char *paramFiles[PARAM_SLOTS] = {"prm0", "prm1"};
+
+/**
+ * The slot holding the newest record, or -1 if there is no record.
+ */
+int paramSlot = -1;
+
+/**
+ * The sequence number of the newest record.
+ */
+unsigned long paramSequence = 0;
+
+/**
+ * Object representing the parameter console task.
+ */
+TaskHandle paramConsoleTask = NULL;
+
+/**
+ * Gets the value of a parameter.
+ *
+ * @param id the parameter ID number
+ *
+ * @return the value of the parameter
+ */
+float paramGet(int id) {
+    const Param *param = &params[id];
+    return param->type == PARAM_INT ? *(int *) param->value : *(float *) param->value;
+}
+
+/**
+ * Sets the value of a parameter, limited to its range.
+ *
+ * @param id the parameter ID number
+ * @param value the new value
+ */
+void paramSet(int id, float value) {
+    const Param *param = &params[id];
+    value = constrain(value, param->minimum, param->maximum);
+    if (param->type == PARAM_INT) {
+        *(int *) param->value = (int) round(value);
+    } else {
+        *(float *) param->value = value;
+    }
+}
+
+/**
+ * Sets every parameter back to its default.
+ */
+void paramsReset() {
+    for (int id = 0; id < PARAM_COUNT; id++) {
+        paramSet(id, params[id].defaultValue);
+    }
+}
+
+/**
+ * Finds a parameter by name.
+ *
+ * @param name the name of the parameter
+ *
+ * @return the parameter ID number, or -1 if there is no parameter with that name
+ */
+int paramFind(const char *name) {
+    for (int id = 0; id < PARAM_COUNT; id++) {
+        if (strcmp(params[id].name, name) == 0) {
+            return id;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Computes the checksum of a parameter record.
+ *
+ * @param header the header of the record
+ * @param entries the parameters of the record
+ *
+ * @return the checksum
+ */
+unsigned short paramRecordCrc(const ParamHeader *header, const ParamEntry *entries) {
+    ParamHeader copy = *header;
+    copy.crc = 0;
+    unsigned short crc = crc16(CRC16_INIT, &copy, sizeof(copy));
+    return crc16(crc, entries, sizeof(ParamEntry) * header->count);
+}
+
+/**
+ * Reads a parameter record from a slot and checks that it is valid.
+ *
+ * @param slot the slot to read
+ * @param header a pointer to store the header of the record in
+ * @param entries an array of PARAM_COUNT entries to store the parameters of the record in
+ *
+ * @return true if the record is valid, false otherwise
+ */
+bool readParamRecord(int slot, ParamHeader *header, ParamEntry *entries) {
+    FILE *file = fopen(paramFiles[slot], "r");
+    if (file == NULL) {
+        return false;
+    }
+    bool valid = fread(header, sizeof(*header), 1, file) == 1 &&
+            header->magic == PARAM_MAGIC &&
+            header->version == PARAM_VERSION &&
+            header->count <= PARAM_COUNT &&
+            fread(entries, sizeof(ParamEntry), header->count, file) == header->count &&
+            paramRecordCrc(header, entries) == header->crc;
+    fclose(file);
+    return valid;
+}
+
+/**
+ * Loads the newest valid parameter record from the flash memory.
+ * Saved parameters that are no longer in the registry are ignored.
+ *
+ * @return true if a record was loaded, false otherwise
+ */
+bool loadParams() {
+    ParamHeader header;
+    ParamEntry entries[PARAM_COUNT];
+    int best = -1;
+    unsigned long bestSequence = 0;
+    for (int slot = 0; slot < PARAM_SLOTS; slot++) {
+        if (readParamRecord(slot, &header, entries) && (best == -1 || (long) (header.sequence - bestSequence) > 0)) {
+            best = slot;
+            bestSequence = header.sequence;
+        }
+    }
+    if (best == -1 || !readParamRecord(best, &header, entries)) {
+        return false;
+    }
+    for (int i = 0; i < header.count; i++) {
+        entries[i].name[PARAM_NAME_LENGTH] = '\0';
+        int id = paramFind(entries[i].name);
+        if (id != -1) {
+            paramSet(id, entries[i].value);
+        }
+    }
+    paramSlot = best;
+    paramSequence = header.sequence;
+    return true;
+}
+
+/**
+ * Saves every parameter that differs from its default to the flash memory.
+ *
+ * @return true if the record was written completely, false otherwise
+ */
+bool saveParams() {
+    ParamEntry entries[PARAM_COUNT];
+    memset(entries, 0, sizeof(entries));
+    int count = 0;
+    for (int id = 0; id < PARAM_COUNT; id++) {
+        float value = paramGet(id);
+        if (value != params[id].defaultValue) {
+            strncpy(entries[count].name, params[id].name, PARAM_NAME_LENGTH);
+            entries[count].value = value;
+            count++;
+        }
+    }
+    int slot = (paramSlot + 1) % PARAM_SLOTS;
+    ParamHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = PARAM_MAGIC;
+    header.version = PARAM_VERSION;
+    header.count = count;
+    header.sequence = paramSequence + 1;
+    header.crc = paramRecordCrc(&header, entries);
+
+    FILE *file = fopen(paramFiles[slot], "w");
+    if (file == NULL) {
+        return false;
+    }
+    bool written = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(entries, sizeof(ParamEntry), count, file) == (size_t) count;
+    fclose(file);
+    if (written) {
+        paramSlot = slot;
+        paramSequence = header.sequence;
+    }
+    return written;
+}
+
+/**
+ * Loads the saved parameters. Parameters that were not saved keep their defaults.
+ */
+void initParams() {
+    paramsReset();
+    loadParams();
+}
+
+/**
+ * Prints one parameter to the debug terminal.
+ *
+ * @param id the parameter ID number
+ */
+void paramPrint(int id) {
+    const Param *param = &params[id];
+    if (param->type == PARAM_INT) {
+        printf("param name=%s value=%d default=%d\n", param->name, *(int *) param->value, (int) param->defaultValue);
+    } else {
+        printf("param name=%s value=%.4f default=%.4f\n", param->name, *(float *) param->value, param->defaultValue);
+    }
+}
+
+/**
+ * Prints every parameter to the debug terminal, one per line.
+ */
+void paramDump() {
+    for (int id = 0; id < PARAM_COUNT; id++) {
+        paramPrint(id);
+    }
+}
+
+/**
+ * Parses a decimal number, such as -12, 0.5 or 3825.25.
+ * The C library on the Cortex has no number parsing with a fractional part, so this does it by hand.
+ *
+ * @param text the number, which must not have anything after it
+ * @param value a pointer to store the number in
+ *
+ * @return true if the text was a number, false otherwise
+ */
+bool paramParse(const char *text, float *value) {
+    bool negative = (*text == '-');
+    if (*text == '-' || *text == '+') {
+        text++;
+    }
+    double result = 0;
+    double scale = 1;
+    bool digits = false;
+    bool fraction = false;
+    for (; *text != '\0'; text++) {
+        if (*text >= '0' && *text <= '9') {
+            result = result * 10 + (*text - '0');
+            if (fraction) {
+                scale *= 10;
+            }
+            digits = true;
+        } else if (*text == '.' && !fraction) {
+            fraction = true;
+        } else {
+            return false;
+        }
+    }
+    *value = (negative ? -result : result) / scale;
+    return digits;
+}
+
+/**
+ * Splits the next word off a command, ending it with a null character.
+ *
+ * @param cursor a pointer to the rest of the command, which is moved past the word
+ *
+ * @return the word, or an empty string if there are no words left
+ */
+char* paramNextWord(char **cursor) {
+    char *word = *cursor;
+    while (*word == ' ' || *word == '\t') {
+        word++;
+    }
+    char *end = word;
+    while (*end != '\0' && *end != ' ' && *end != '\t') {
+        end++;
+    }
+    *cursor = (*end != '\0') ? end + 1 : end;
+    *end = '\0';
+    return word;
+}
+
+/**
+ * Runs a command from the debug terminal.
+ *
+ * @param line the command, without its line ending
+ */
+void paramCommand(const char *line) {
+    char buffer[PARAM_COMMAND_LENGTH+1];
+    strncpy(buffer, line, PARAM_COMMAND_LENGTH);
+    buffer[PARAM_COMMAND_LENGTH] = '\0';
+    char *cursor = buffer;
+    char *command = paramNextWord(&cursor);
+    char *name = paramNextWord(&cursor);
+    char *argument = paramNextWord(&cursor);
+    if (command[0] == '\0' || command[0] == '#') {
+        return;
+    }
+    if (strcmp(command, "list") == 0) {
+        paramDump();
+        return;
+    }
+    if (strcmp(command, "save") == 0) {
+        printf("param saved=%d\n", saveParams());
+        return;
+    }
+    if (strcmp(command, "stream") == 0) {
+        int channel = streamFind(name);
+        float period;
+        if (channel == -1) {
+            printf("param error=unknown_channel channel=%s\n", name);
+        } else if (!paramParse(argument, &period) || period < 0 || period > 0xFFFF || period != (int) period) {
+            printf("param error=bad_period channel=%s period=%s\n", name, argument);
+        } else {
+            streamSetPeriod(channel, (unsigned short) period);
+            printf("stream channel=%s period=%u\n", name, streamPeriods[channel]);
+        }
+        return;
+    }
+    if (strcmp(command, "reset") == 0 && strcmp(name, "all") == 0) {
+        paramsReset();
+        paramDump();
+        return;
+    }
+    if (strcmp(command, "get") != 0 && strcmp(command, "set") != 0 && strcmp(command, "reset") != 0) {
+        printf("param error=unknown_command command=%s\n", command);
+        return;
+    }
+    int id = paramFind(name);
+    if (id == -1) {
+        printf("param error=unknown_name name=%s\n", name);
+        return;
+    }
+    if (strcmp(command, "set") == 0) {
+        float value;
+        if (!paramParse(argument, &value)) {
+            printf("param error=bad_value name=%s value=%s\n", name, argument);
+            return;
+        }
+        paramSet(id, value);
+    } else if (strcmp(command, "reset") == 0) {
+        paramSet(id, params[id].defaultValue);
+    }
+    paramPrint(id);
+}
+
+/**
+ * Runs the parameter console task.
+ * Collects the characters typed into the debug terminal into lines, and runs each line as a command.
+ * The terminal is polled rather than read with fgetc(), so that the task never blocks.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void runParamConsole(void *ignore) {
+    char line[PARAM_COMMAND_LENGTH+1];
+    int length = 0;
+    bool overflow = false;
+    while (true) {
+        while (fcount(stdin) > 0) {
+            int c = fgetc(stdin);
+            if (c == '\n' || c == '\r') {
+                line[length] = '\0';
+                if (overflow) {
+                    printf("param error=too_long\n");
+                } else {
+                    paramCommand(line);
+                }
+                length = 0;
+                overflow = false;
+            } else if (length < PARAM_COMMAND_LENGTH) {
+                line[length++] = (char) c;
+            } else {
+                overflow = true;
+            }
+        }
+        delay(PARAM_CONSOLE_PERIOD);
+    }
+}
+
+/**
+ * Starts the task that runs parameter commands typed into the debug terminal.
+ */
+void startParamConsole() {
+    paramConsoleTask = taskCreateTracked("Params", runParamConsole, TASK_DEFAULT_STACK_SIZE, NULL, TASK_PRIORITY_LOWEST + 1);
+}
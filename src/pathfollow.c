@@ -0,0 +1,249 @@
+/** @file pathfollow.c
+ * @brief File for the pure pursuit path follower
+ *
+ * This file contains the code for smoothing and following paths across the field.
+ * Waypoints are read from flash, more points are injected between them, and the result is smoothed.
+ * The smoothed path is followed with adaptive pure pursuit:
+ *     - The robot steers along the arc that passes through a lookahead point on the path
+ *     - The lookahead distance grows with speed
+ *     - The speed drops in tight curves and when approaching the end of the path
+ *     - The strafe motor corrects any sideways distance from the path
+ *     - Once the drive has been characterized, the forward output comes from the feed-forward constants,
+ *       which add the output needed to accelerate
+ *
+ * @see pathfollow.h
+ */
+
+#include "main.h"
+
+/**
+ * The waypoints of the path being followed, with extra points injected between them.
+ */
+point pathOriginal[PATH_MAX_POINTS];
+
+/**
+ * The smoothed path being followed.
+ */
+point pathPoints[PATH_MAX_POINTS];
+
+/**
+ * The curvature of the smoothed path at each point, in 1/inches.
+ */
+float pathCurvature[PATH_MAX_POINTS];
+
+/**
+ * The distance along the smoothed path from each point to the end of the path, in inches.
+ */
+float pathRemaining[PATH_MAX_POINTS];
+
+/**
+ * Returns the distance between two points.
+ *
+ * @param a the first point
+ * @param b the second point
+ *
+ * @return the distance between the points
+ */
+double pointDistance(point a, point b) {
+    return sqrt(sq(b.x - a.x) + sq(b.y - a.y));
+}
+
+/**
+ * Injects points between the waypoints of a path so that no two consecutive points are more than PATH_SPACING apart.
+ * The result is stored in pathOriginal.
+ *
+ * @param start the robot's current position, used as the first point of the path
+ * @param path the waypoints to follow
+ * @param count the number of waypoints
+ *
+ * @return the number of points in the result
+ */
+int injectPathPoints(point start, const waypoint *path, int count) {
+    int n = 0;
+    point prev = start;
+    pathOriginal[n++] = start;
+    for (int i = 0; i < count; i++) {
+        point next = {.x = path[i].x, .y = path[i].y};
+        int steps = (int) ceil(pointDistance(prev, next) / PATH_SPACING);
+        for (int j = 1; j < steps && n < PATH_MAX_POINTS - (count - i); j++) {
+            pathOriginal[n].x = prev.x + (next.x - prev.x) * j / steps;
+            pathOriginal[n].y = prev.y + (next.y - prev.y) * j / steps;
+            n++;
+        }
+        pathOriginal[n++] = next;
+        prev = next;
+    }
+    return n;
+}
+
+/**
+ * Smooths the points in pathOriginal into pathPoints, then computes the curvature and remaining distance of each point.
+ * The endpoints are left in place, and each other point is pulled towards both its original position and its neighbors.
+ *
+ * @param n the number of points in the path
+ */
+void smoothPath(int n) {
+    memcpy(pathPoints, pathOriginal, sizeof(point) * n);
+    double change = 1;
+    for (int iter = 0; iter < PATH_SMOOTH_ITERATIONS && change > 0.001; iter++) {
+        change = 0;
+        for (int i = 1; i < n - 1; i++) {
+            point old = pathPoints[i];
+            pathPoints[i].x += PATH_SMOOTH_DATA * (pathOriginal[i].x - pathPoints[i].x) +
+                PATH_SMOOTH_WEIGHT * (pathPoints[i-1].x + pathPoints[i+1].x - 2 * pathPoints[i].x);
+            pathPoints[i].y += PATH_SMOOTH_DATA * (pathOriginal[i].y - pathPoints[i].y) +
+                PATH_SMOOTH_WEIGHT * (pathPoints[i-1].y + pathPoints[i+1].y - 2 * pathPoints[i].y);
+            change += abs(pathPoints[i].x - old.x) + abs(pathPoints[i].y - old.y);
+        }
+    }
+
+    pathCurvature[0] = 0;
+    pathCurvature[n-1] = 0;
+    for (int i = 1; i < n - 1; i++) {
+        point a = pathPoints[i-1];
+        point b = pathPoints[i];
+        point c = pathPoints[i+1];
+        double cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+        double sides = pointDistance(a, b) * pointDistance(b, c) * pointDistance(a, c);
+        pathCurvature[i] = (sides > 0) ? 2 * abs(cross) / sides : 0;
+    }
+
+    pathRemaining[n-1] = 0;
+    for (int i = n - 2; i >= 0; i--) {
+        pathRemaining[i] = pathRemaining[i+1] + pointDistance(pathPoints[i], pathPoints[i+1]);
+    }
+}
+
+/**
+ * Converts a drive speed into the velocity the characterized drive reaches at that speed.
+ *
+ * @param speed the drive speed, in units of motor speed
+ *
+ * @return the velocity, in inches per second
+ */
+double pathVelocity(int speed) {
+    if (driveFeedforward.kV <= 0) {
+        return 0;
+    }
+    return max(speed - driveFeedforward.kS, 0) / driveFeedforward.kV;
+}
+
+/**
+ * Follows a path of waypoints across the field.
+ * The path is smoothed, then followed with adaptive pure pursuit until the robot reaches the final waypoint.
+ *
+ * @param path the waypoints to follow, in order
+ * @param count the number of waypoints in the path
+ *
+ * @return true if the end of the path was reached, false if following was cancelled or abandoned
+ */
+bool followPath(const waypoint *path, int count) {
+    if (count <= 0) {
+        return true;
+    }
+    count = min(count, PATH_MAX_POINTS - 1);
+    poseSample pose;
+    if (!poseAt(millis(), &pose)) {
+        pose.position = position;
+    }
+    int n = injectPathPoints(pose.position, path, count);
+    smoothPath(n);
+
+    int closest = 0;
+    int speed = 0;
+    // If the drive has been characterized, the speed that keeps the robot moving is known rather than guessed
+    double minSpeed = driveFeedforwardValid ?
+            ceil(driveFeedforward.kS + driveFeedforward.kV * PATH_MIN_VELOCITY) : PATH_MIN_SPEED;
+    double lastVelocity = 0;
+    unsigned long start = millis();
+    unsigned long timeout = PATH_TIMEOUT_BASE + (unsigned long) (PATH_TIMEOUT_PER_INCH * pathRemaining[0]);
+    // The least distance left to the end of the path so far, and when the robot last got closer to it
+    double leastRemaining = pathRemaining[0];
+    unsigned long progressTime = start;
+    unsigned long wakeTime = start;
+    while (true) {
+        if (joystickGetDigital(1, 7, JOY_UP)) {
+            printf("Path following manually cancelled.\n");
+            move(0, 0, 0);
+            return false;
+        }
+        if (millis() - start > timeout) {
+            printf("Path following timed out.\n");
+            move(0, 0, 0);
+            return false;
+        }
+        if (!poseAt(millis(), &pose)) {
+            pose.position = position;
+            pose.heading = fieldHeading();
+        }
+
+        double closestDist = pointDistance(pose.position, pathPoints[closest]);
+        for (int i = closest + 1; i < n; i++) {
+            double dist = pointDistance(pose.position, pathPoints[i]);
+            if (dist < closestDist) {
+                closestDist = dist;
+                closest = i;
+            }
+        }
+        if (pointDistance(pose.position, pathPoints[n-1]) < PATH_END_TOLERANCE) {
+            break;
+        }
+        double remaining = pathRemaining[closest] + closestDist;
+        if (remaining < leastRemaining - PATH_PROGRESS_DISTANCE) {
+            leastRemaining = remaining;
+            progressTime = millis();
+        } else if (millis() - progressTime > PATH_PROGRESS_TIME) {
+            printf("Path following stopped making progress.\n");
+            move(0, 0, 0);
+            return false;
+        }
+
+        double target = PATH_MAX_SPEED;
+        if (pathCurvature[closest] > 0) {
+            target = min(target, PATH_TURN_SPEED / pathCurvature[closest]);
+        }
+        target = min(target, PATH_SLOWDOWN * remaining);
+        target = max(target, minSpeed);
+        speed = constrain((int) target, speed - PATH_MAX_ACCEL, speed + PATH_MAX_ACCEL);
+
+        double lookahead = constrain(PATH_LOOKAHEAD_MIN + PATH_LOOKAHEAD_GAIN * speed, PATH_LOOKAHEAD_MIN, PATH_LOOKAHEAD_MAX);
+        int goal = n - 1;
+        for (int i = closest; i < n; i++) {
+            if (pointDistance(pose.position, pathPoints[i]) >= lookahead) {
+                goal = i;
+                break;
+            }
+        }
+
+        // Transform the lookahead point into the robot's frame (forward, left)
+        double c = cos(pose.heading);
+        double s = sin(pose.heading);
+        double dx = pathPoints[goal].x - pose.position.x;
+        double dy = pathPoints[goal].y - pose.position.y;
+        double left = -dx * s + dy * c;
+        double distSq = sq(dx) + sq(dy);
+        double curvature = (distSq > 0) ? 2 * left / distSq : 0;
+
+        // Positive turn values turn the robot clockwise, so turning towards a point on the left is negative
+        int turnSpd = (int) (-speed * curvature * DRIVE_WHEELBASE / 2);
+        double crossTrack = -(pathPoints[closest].x - pose.position.x) * s + (pathPoints[closest].y - pose.position.y) * c;
+        int strafeSpd = constrain((int) (-PATH_STRAFE_KP * crossTrack), MOTOR_MIN, MOTOR_MAX);
+
+        // If the drive has been characterized, the forward output is the feed-forward output for the velocity
+        // the speed stands for, which adds kA while the speed changes
+        int forward = speed;
+        if (driveFeedforwardValid) {
+            double velocity = pathVelocity(speed);
+            forward = feedforwardOutput(&driveFeedforward, velocity, (velocity - lastVelocity) * 1000.0 / PATH_LOOP_PERIOD);
+            lastVelocity = velocity;
+        }
+        // Drive each side like moveStraight(), where a positive value drives that side forward;
+        // move() takes the opposite sign for the forward speed
+        turnSpd = constrain(turnSpd, MOTOR_MIN, MOTOR_MAX);
+        move_lrCompensated(forward + turnSpd, forward - turnSpd);
+        motorSetCompensated(STRAFE_MOTOR, strafeSpd);
+        taskDelayUntil(&wakeTime, PATH_LOOP_PERIOD);
+    }
+    move(0, 0, 0);
+    return true;
+}
@@ -0,0 +1,149 @@
+/** @file profiler.c
+ * @brief File for the section profiler
+ *
+ * This file contains the code for recording and reporting profiled sections.
+ *
+ * @see profiler.h
+ */
+
+#include "main.h"
+
+/**
+ * The statistics of each profiled section, indexed by section ID number.
+ */
+ProfileSection profileSections[PROFILE_SECTION_COUNT];
+
+/**
+ * The names of each profiled section, indexed by section ID number.
+ */
+const char *profileNames[PROFILE_SECTION_COUNT] = {
+    "OpControl",
+    "Sensors",
+    "LCD Menu",
+    "LCD Flush",
+    "Battery",
+    "Speaker"
+};
+
+/**
+ * The time since the profiler was last reset, in microseconds.
+ * This is 64 bits wide, so it keeps counting after micros() wraps around.
+ */
+unsigned long long profileElapsed = 0;
+
+/**
+ * The micros() value when profileElapsed was last advanced.
+ */
+unsigned long profileLast = 0;
+
+/**
+ * Mutex protecting the elapsed time, which every task with a probe advances.
+ */
+Mutex profileMutex = NULL;
+
+/**
+ * Returns the time between a micros() value and now.
+ * The difference is unsigned, so it is correct across a wrap of micros() as long as less than 2^32 microseconds
+ * (about 71.6 minutes) have passed.
+ *
+ * @param start the earlier micros() value
+ *
+ * @return the time since start, in microseconds
+ */
+unsigned long profileSince(unsigned long start) {
+    return (unsigned long) (micros() - start);
+}
+
+/**
+ * Advances the time since the profiler was reset to now.
+ * Each advance adds an unsigned difference of micros() values, so it stays correct as long as it is called
+ * at least once per wrap of micros(). Every probe calls it, and the battery monitor ends a probe every
+ * BATTERY_SAMPLE_PERIOD milliseconds.
+ *
+ * @return the time since the profiler was reset, in microseconds
+ */
+unsigned long long profileClock() {
+    if (profileMutex == NULL) {
+        return 0;
+    }
+    mutexTake(profileMutex, -1);
+    unsigned long now = micros();
+    profileElapsed += (unsigned long) (now - profileLast);
+    profileLast = now;
+    unsigned long long elapsed = profileElapsed;
+    mutexGive(profileMutex);
+    return elapsed;
+}
+
+/**
+ * Ends a profiled section and records its duration.
+ *
+ * @param section the section ID number
+ * @param start the start time returned by profileBegin()
+ */
+void profileEnd(int section, unsigned long start) {
+    unsigned long duration = profileSince(start);
+    profileClock();
+    ProfileSection *stats = &profileSections[section];
+    if (stats->count == 0 || duration < stats->minimum) {
+        stats->minimum = duration;
+    }
+    if (duration > stats->maximum) {
+        stats->maximum = duration;
+    }
+    stats->count++;
+    stats->total += duration;
+    int bin = 0;
+    unsigned long limit = PROFILE_HISTOGRAM_BASE;
+    while (duration >= limit && bin < PROFILE_HISTOGRAM_BINS - 1) {
+        limit <<= 1;
+        bin++;
+    }
+    stats->histogram[bin]++;
+}
+
+/**
+ * Computes the fraction of time spent in a section since the profiler was reset.
+ *
+ * @param section the section ID number
+ *
+ * @return the CPU usage, in tenths of a percent
+ */
+int profileCpuUsage(int section) {
+    unsigned long long elapsed = profileClock();
+    if (elapsed == 0) {
+        return 0;
+    }
+    return (int) (profileSections[section].total * 1000 / elapsed);
+}
+
+/**
+ * Prints the statistics of every section to the debug UART.
+ */
+void profileDump() {
+    printf("Profile over %lu ms:\n", (unsigned long) (profileClock() / 1000));
+    for (int i = 0; i < PROFILE_SECTION_COUNT; i++) {
+        const ProfileSection *stats = &profileSections[i];
+        int cpu = profileCpuUsage(i);
+        unsigned long average = stats->count == 0 ? 0 : (unsigned long) (stats->total / stats->count);
+        printf("%-10s n=%lu min=%lu avg=%lu max=%lu us cpu=%d.%d%% hist=", profileNames[i], stats->count,
+                stats->minimum, average, stats->maximum, cpu / 10, cpu % 10);
+        for (int bin = 0; bin < PROFILE_HISTOGRAM_BINS; bin++) {
+            printf("%lu%c", stats->histogram[bin], bin == PROFILE_HISTOGRAM_BINS - 1 ? '\n' : ',');
+        }
+    }
+}
+
+/**
+ * Clears the statistics of every section.
+ */
+void profileReset() {
+    if (profileMutex == NULL) {
+        profileMutex = mutexCreate();
+    }
+    mutexTake(profileMutex, -1);
+    memset(profileSections, 0, sizeof(profileSections));
+    profileElapsed = 0;
+    profileLast = micros();
+    mutexGive(profileMutex);
+}
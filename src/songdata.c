@@ -0,0 +1,368 @@
+/** @file songdata.c
+ * @brief File for the precompiled speaker songs
+ *
+ * Generated from songs.rtttl by sim/songc.c; edit songs.rtttl instead of this file.
+ *
+ * @see songs.h
+ */
+
+#include "main.h"
+
+#if SONG_COUNT != 26
+#error "SONG_COUNT does not match the number of songs in songs.rtttl"
+#endif
+
+/**
+ * Notes of Batman.
+ */
+const SongNote songNotes0[27] = {
+    0x5308, 0x5308, 0x5208, 0x5208, 0x5108, 0x5108, 0x5208, 0x5208, 0x5308, 0x5308,
+    0x5208, 0x5208, 0x5108, 0x5108, 0x5208, 0x5208, 0x5308, 0x5408, 0x5108, 0x5208,
+    0x5108, 0x5108, 0x5208, 0x5208, 0x5608, 0x5008, 0x5604
+};
+
+/**
+ * Notes of Spiderman.
+ */
+const SongNote songNotes1[42] = {
+    0x6104, 0x6408, 0xE804, 0x6004, 0x6704, 0x6408, 0xE104, 0x6004, 0x6104, 0x6408,
+    0x6804, 0x6908, 0x6804, 0x6704, 0x6408, 0xE104, 0x6004, 0x6604, 0x6908, 0xF104,
+    0x6004, 0x6B04, 0x6908, 0xE604, 0x6004, 0x6104, 0x6408, 0xE804, 0x6004, 0x6704,
+    0x6408, 0x6104, 0x6004, 0x6908, 0x6802, 0x6004, 0x6708, 0x6704, 0x6408, 0x6604,
+    0x6408, 0x6102
+};
+
+/**
+ * Notes of Star Wars.
+ */
+const SongNote songNotes2[39] = {
+    0x5608, 0x5608, 0x5608, 0xDB02, 0xE602, 0x6408, 0x6308, 0x6108, 0xEB02, 0xE604,
+    0x6408, 0x6308, 0x6108, 0xEB02, 0xE604, 0x6408, 0x6308, 0x6408, 0x6102, 0x6004,
+    0x5608, 0x5608, 0x5608, 0xDB02, 0xE602, 0x6408, 0x6308, 0x6108, 0xEB02, 0xE604,
+    0x6408, 0x6308, 0x6108, 0xEB02, 0xE604, 0x6408, 0x6308, 0x6408, 0x6102
+};
+
+/**
+ * Notes of Final Countdown.
+ */
+const SongNote songNotes3[43] = {
+    0x5C10, 0x5A10, 0x5C04, 0x5504, 0x5004, 0x5008, 0x6110, 0x5C10, 0x6108, 0x5C08,
+    0x5A04, 0x5004, 0x5008, 0x6110, 0x5C10, 0x6104, 0x5504, 0x5004, 0x5008, 0x5A10,
+    0x5810, 0x5A08, 0x5808, 0x5708, 0x5A08, 0xD804, 0x5710, 0x5810, 0xDA04, 0x5810,
+    0x5A10, 0x5C08, 0x5A08, 0x5808, 0x5708, 0x5504, 0x6104, 0xDC02, 0x5C10, 0x6110,
+    0x5C10, 0x5A10, 0x5C01
+};
+
+/**
+ * Notes of Deep Purple-Smoke on the Water.
+ */
+const SongNote songNotes4[28] = {
+    0x4104, 0x4404, 0xC604, 0x4104, 0x4404, 0x4708, 0x4604, 0x4004, 0x4104, 0x4404,
+    0xC604, 0x4404, 0x4104, 0x4002, 0x4008, 0x4104, 0x4404, 0xC604, 0x4104, 0x4404,
+    0x4708, 0x4604, 0x4004, 0x4104, 0x4404, 0xC604, 0x4404, 0x4104
+};
+
+/**
+ * Notes of gbusters.
+ */
+const SongNote songNotes5[28] = {
+    0x5C10, 0x5C10, 0x6408, 0x5C08, 0x6208, 0x5A08, 0x5002, 0x5C10, 0x5C10, 0x5C10,
+    0x5C10, 0x5A08, 0x5C08, 0x5002, 0x5C10, 0x5C10, 0x6408, 0x5C08, 0x6208, 0x5A08,
+    0x5002, 0x5C10, 0x5C10, 0x5C10, 0x5C10, 0x5A08, 0x6208, 0x5C08
+};
+
+/**
+ * Notes of Funky Town.
+ */
+const SongNote songNotes6[25] = {
+    0x6108, 0x6108, 0x5B08, 0x6108, 0x4008, 0x5808, 0x4008, 0x5808, 0x6108, 0x6608,
+    0x6508, 0x6108, 0x4002, 0x6108, 0x6108, 0x5B08, 0x6108, 0x4008, 0x5808, 0x4008,
+    0x5808, 0x6108, 0x6608, 0x6508, 0x6108
+};
+
+/**
+ * Notes of Macarena.
+ */
+const SongNote songNotes7[47] = {
+    0x5608, 0x5608, 0x5608, 0x5604, 0x5608, 0x5608, 0x5608, 0x5608, 0x5608, 0x5608,
+    0x5608, 0x5A08, 0x5108, 0x5108, 0x5604, 0x5608, 0x5608, 0x5604, 0x5608, 0x5608,
+    0x5608, 0x5608, 0x5608, 0x5608, 0x5308, 0x5108, 0x5004, 0x5604, 0x5608, 0x5608,
+    0x5604, 0x5608, 0x5608, 0x5608, 0x5608, 0x5608, 0x5608, 0x5608, 0x5A08, 0x5004,
+    0xE102, 0x5A04, 0x6108, 0x5A08, 0x5608, 0x5004, 0x5002
+};
+
+/**
+ * Notes of Mission Impossible.
+ */
+const SongNote songNotes8[61] = {
+    0x5320, 0x5420, 0x5320, 0x5420, 0x5320, 0x5420, 0x5320, 0x5420, 0x5320, 0x5320,
+    0x5420, 0x5520, 0x5620, 0x5720, 0x5820, 0x5810, 0x5008, 0x5810, 0x5008, 0x5B10,
+    0x5010, 0x6110, 0x5010, 0x5810, 0x5008, 0x5810, 0x5008, 0x5610, 0x5010, 0x5710,
+    0x5010, 0x5810, 0x5008, 0x5810, 0x5008, 0x5B10, 0x5010, 0x6110, 0x5010, 0x5810,
+    0x5008, 0x5810, 0x5008, 0x5610, 0x5010, 0x5710, 0x5010, 0x5B10, 0x5810, 0x5302,
+    0x5020, 0x5B10, 0x5810, 0x5202, 0x5020, 0x5B10, 0x5810, 0x5102, 0x5010, 0x4B10,
+    0x5110
+};
+
+/**
+ * Notes of USA National Anthem.
+ */
+const SongNote songNotes9[28] = {
+    0xD508, 0x5308, 0x5104, 0x5504, 0x5804, 0xE104, 0x5008, 0xE508, 0x6308, 0x6104,
+    0x5504, 0x5704, 0xD804, 0x5008, 0x5804, 0xE504, 0x6308, 0x6104, 0x5C02, 0x5A08,
+    0x5C04, 0xE108, 0x5010, 0x6104, 0x5804, 0x5504, 0x5020, 0x5104
+};
+
+/**
+ * Notes of Bond.
+ */
+const SongNote songNotes10[38] = {
+    0x4020, 0x6210, 0x6420, 0x6420, 0x6410, 0x6408, 0x6210, 0x6210, 0x6210, 0x6210,
+    0x6520, 0x6520, 0x6510, 0x6508, 0x6410, 0x6410, 0x6410, 0x6210, 0x6420, 0x6420,
+    0x6410, 0x6408, 0x6210, 0x6210, 0x6210, 0x6210, 0x6520, 0x6520, 0x6510, 0x6508,
+    0x6410, 0x6310, 0x6210, 0x7210, 0xF104, 0x6910, 0x6710, 0xE904
+};
+
+/**
+ * Notes of GoodBad.
+ */
+const SongNote songNotes11[33] = {
+    0x5020, 0x5B20, 0x6420, 0x5B20, 0x6420, 0xDB08, 0xD710, 0xD910, 0x5404, 0x5B20,
+    0x6420, 0x5B20, 0x6420, 0xDB08, 0xD710, 0xD910, 0x6204, 0x5B20, 0x6420, 0x5B20,
+    0x6420, 0xDB08, 0xD710, 0xD620, 0xD420, 0x5204, 0x5B20, 0x6420, 0x5B20, 0x6420,
+    0xDB08, 0xD910, 0x5404
+};
+
+/**
+ * Notes of MetalGear.
+ */
+const SongNote songNotes12[64] = {
+    0x5504, 0x5304, 0x5102, 0x5308, 0x5508, 0x4A08, 0x5504, 0x5302, 0x5108, 0x5308,
+    0xD504, 0x5A08, 0x5808, 0x5508, 0x5104, 0x5302, 0x5508, 0x5A08, 0x6102, 0x5C08,
+    0x6108, 0x6308, 0x6104, 0x5A02, 0x5808, 0x5A08, 0xDC04, 0x6108, 0x5C04, 0x5A08,
+    0x5808, 0x5A01, 0x5C04, 0x5A04, 0x5802, 0x5A08, 0x5C08, 0x5508, 0x5C04, 0x5A02,
+    0x5808, 0x5A08, 0xDC04, 0x6508, 0x6308, 0x5C08, 0x5804, 0x5A02, 0x5C08, 0x6508,
+    0x6802, 0x6708, 0x6808, 0x6A08, 0x6804, 0x6502, 0x6308, 0x6508, 0xE704, 0x6808,
+    0x6704, 0x6508, 0x6308, 0x6501
+};
+
+/**
+ * Notes of Jeopardy.
+ */
+const SongNote songNotes13[67] = {
+    0x6104, 0x6604, 0x6104, 0x5604, 0x6104, 0x6604, 0x6102, 0x6104, 0x6604, 0x6104,
+    0x6604, 0xEA04, 0x6808, 0x6608, 0x6508, 0x6308, 0x6208, 0x6104, 0x6604, 0x6104,
+    0x5604, 0x6104, 0x6604, 0x6102, 0xE604, 0x6308, 0x6104, 0x5B04, 0x5A04, 0x5804,
+    0x5604, 0x6004, 0x6404, 0x6904, 0x6404, 0x5904, 0x6404, 0x6904, 0x6402, 0x6404,
+    0x6904, 0x6404, 0x6904, 0xF104, 0x6B08, 0x6908, 0x6808, 0x6608, 0x6508, 0x6404,
+    0x6904, 0x6404, 0x5904, 0x6404, 0x6904, 0x6402, 0xE904, 0x6608, 0x6404, 0x6204,
+    0x6104, 0x6004, 0x5B04, 0x6004, 0xD904, 0x6404, 0x6904
+};
+
+/**
+ * Notes of Michael Jackson - Thriller.
+ */
+const SongNote songNotes14[41] = {
+    0xDC18, 0x500F, 0xE310, 0x501F, 0xDC18, 0x500F, 0xE509, 0x501F, 0xE302, 0x5003,
+    0xE309, 0x501F, 0xE210, 0x500A, 0xDC06, 0x5003, 0xDC18, 0x500F, 0xDC10, 0x501F,
+    0xDA31, 0x500A, 0xDA10, 0x501F, 0xD831, 0x501F, 0xD809, 0x501F, 0xD518, 0x500F,
+    0xD80C, 0xDA18, 0x500F, 0xDC10, 0x501F, 0xDA18, 0x500F, 0xDA10, 0x501F, 0xD818,
+    0xDC10
+};
+
+/**
+ * Notes of GunsNRoses_Welcome_To_The_Jungle.
+ */
+const SongNote songNotes15[57] = {
+    0x5110, 0x5010, 0x5110, 0x5010, 0x5104, 0xD110, 0x5020, 0xD110, 0x5020, 0xD110,
+    0x5020, 0xD110, 0x5020, 0x5104, 0x5B10, 0x5010, 0xD110, 0x5020, 0x5108, 0x5B10,
+    0x5010, 0x5B10, 0x5010, 0x5108, 0x5810, 0x5010, 0x5810, 0x5010, 0x5108, 0x5610,
+    0x5010, 0x5610, 0x5010, 0x5108, 0x5410, 0xD008, 0x5110, 0xD008, 0x5B10, 0x5010,
+    0x5108, 0x5108, 0x5B10, 0x5010, 0x5B10, 0x5010, 0x5108, 0x5810, 0x5010, 0x5810,
+    0x5010, 0x5108, 0x5610, 0x5010, 0x5610, 0x5010, 0x5108
+};
+
+/**
+ * Notes of guns_n_roses_sweet_child_o_mine.
+ */
+const SongNote songNotes16[61] = {
+    0x5B08, 0x5B08, 0x5608, 0x5408, 0x6408, 0x5608, 0x6308, 0x5608, 0x5B08, 0x5B08,
+    0x5608, 0x5408, 0x6408, 0x5608, 0x6308, 0x5608, 0x5108, 0x5B08, 0x5608, 0x5408,
+    0x6408, 0x5608, 0x6308, 0x5608, 0x5108, 0x5B08, 0x5608, 0x5408, 0x6408, 0x5608,
+    0x6308, 0x5608, 0x5408, 0x5B08, 0x5608, 0x5408, 0x6408, 0x5608, 0x6308, 0x5608,
+    0x5408, 0x5B08, 0x5608, 0x5408, 0x6408, 0x5608, 0x6308, 0x5608, 0x5B08, 0x5B08,
+    0x5608, 0x5408, 0x6408, 0x5608, 0x6308, 0x5608, 0x5B08, 0x5B08, 0x5608, 0x5408,
+    0x5408
+};
+
+/**
+ * Notes of MCHammer_UCantTouchThis.
+ */
+const SongNote songNotes17[61] = {
+    0xE308, 0x5020, 0x6108, 0x5C08, 0x5A08, 0x5004, 0xDC10, 0x5020, 0x5808, 0x5004,
+    0xDC10, 0x5020, 0x5A10, 0x5A10, 0x5A20, 0xD010, 0x5A20, 0xD010, 0x5A10, 0x5010,
+    0xE308, 0x5010, 0x6108, 0x5C08, 0x5A08, 0x5004, 0x5508, 0x5808, 0x5004, 0xDC10,
+    0x5020, 0x5A20, 0x5010, 0x5A10, 0x5A20, 0xD010, 0x5A20, 0xD010, 0x5A10, 0x5010,
+    0xE308, 0x5020, 0x6108, 0x5C08, 0x5A08, 0x5004, 0xDC10, 0x5020, 0x5808, 0x5004,
+    0xDC10, 0x5020, 0x5A10, 0x5A10, 0x5A20, 0xD010, 0x5A20, 0xD010, 0x5A10, 0x5010,
+    0x5308
+};
+
+/**
+ * Notes of Indiana.
+ */
+const SongNote songNotes18[55] = {
+    0x5504, 0x5008, 0x5608, 0x5808, 0x5008, 0x6101, 0xD008, 0x5304, 0x5008, 0x5508,
+    0x5601, 0xD004, 0x5804, 0x5008, 0x5A08, 0x5C08, 0x5008, 0x6601, 0x5004, 0x5A04,
+    0x5008, 0x5C08, 0x6102, 0x6302, 0x6502, 0x5504, 0x5008, 0x5608, 0x5808, 0x5008,
+    0x6101, 0x5004, 0x6304, 0x5008, 0x6508, 0xE601, 0x5804, 0x5008, 0x5808, 0xE504,
+    0x5008, 0x6304, 0x5008, 0x5808, 0xE504, 0x5008, 0x6304, 0x5008, 0x5808, 0xE604,
+    0x5008, 0x6504, 0x5008, 0x6308, 0x6102
+};
+
+/**
+ * Notes of Zelda1.
+ */
+const SongNote songNotes19[97] = {
+    0x5B04, 0xD604, 0x5B08, 0x5B10, 0x6110, 0x6310, 0x6410, 0x6602, 0x5008, 0x6608,
+    0xE610, 0x6710, 0xE910, 0xEB02, 0xEB10, 0x6910, 0xE710, 0xE908, 0xE710, 0x6602,
+    0x6604, 0x6408, 0x6410, 0x6610, 0x6702, 0x6608, 0x6408, 0x6208, 0x6210, 0x6410,
+    0x6602, 0x6408, 0x6208, 0x6108, 0x6110, 0x6310, 0x6502, 0x6804, 0x6608, 0x5610,
+    0x5610, 0x5608, 0x5610, 0x5610, 0x5608, 0x5610, 0x5610, 0x5608, 0x5608, 0x5B04,
+    0xD604, 0x5B08, 0x5B10, 0x6110, 0x6310, 0x6410, 0x6602, 0x5008, 0x6608, 0xE610,
+    0x6710, 0xE910, 0xEB02, 0x7204, 0x7104, 0x6A02, 0x6604, 0xE702, 0x6B04, 0x6A04,
+    0x6602, 0x6604, 0xE702, 0x6B04, 0x6A04, 0x6602, 0x6304, 0xE402, 0x6704, 0x6604,
+    0x6202, 0x5B04, 0x6104, 0x6310, 0x6502, 0x6804, 0x6608, 0x5610, 0x5610, 0x5608,
+    0x5610, 0x5610, 0x5608, 0x5610, 0x5610, 0x5608, 0x5608
+};
+
+/**
+ * Notes of smb.
+ */
+const SongNote songNotes20[99] = {
+    0x6510, 0x6510, 0x5020, 0x6508, 0x6110, 0x6508, 0x6808, 0x5008, 0x5808, 0x5008,
+    0x6108, 0x5010, 0x5808, 0x5010, 0x5508, 0x5010, 0x5A08, 0x5C08, 0x5B10, 0x5A08,
+    0xD810, 0x6510, 0x6810, 0x6A08, 0x6610, 0x6808, 0x6508, 0x6110, 0x6310, 0x5C08,
+    0x5010, 0x6108, 0x5010, 0x5808, 0x5010, 0x5508, 0x5010, 0x5A08, 0x5C08, 0x5B10,
+    0x5A08, 0xD810, 0x6510, 0x6810, 0x6A08, 0x6610, 0x6808, 0x6508, 0x6110, 0x6310,
+    0x5C08, 0x5008, 0x6810, 0x6710, 0x6610, 0x6410, 0x5010, 0x6510, 0x5010, 0x5910,
+    0x5A10, 0x6110, 0x5010, 0x5A10, 0x6110, 0x6310, 0x5008, 0x6810, 0x6710, 0x6610,
+    0x6410, 0x5010, 0x6510, 0x5010, 0x7110, 0x5010, 0x7110, 0x7110, 0x5004, 0x6810,
+    0x6710, 0x6610, 0x6410, 0x5010, 0x6510, 0x5010, 0x5910, 0x5A10, 0x6110, 0x5010,
+    0x5A10, 0x6110, 0x6310, 0x5008, 0x6410, 0x5008, 0x6310, 0x5008, 0x6110
+};
+
+/**
+ * Notes of smb_under.
+ */
+const SongNote songNotes21[47] = {
+    0x6120, 0x6020, 0x7120, 0x6020, 0x5A20, 0x6020, 0x6A20, 0x6020, 0x5B20, 0x6020,
+    0x6B20, 0x6002, 0x6120, 0x6020, 0x7120, 0x6020, 0x5A20, 0x6020, 0x6A20, 0x6020,
+    0x5B20, 0x6020, 0x6B20, 0x6002, 0x5620, 0x6020, 0x6620, 0x6020, 0x5320, 0x6020,
+    0x6320, 0x6020, 0x5420, 0x6020, 0x6420, 0x6002, 0x5620, 0x6020, 0x6620, 0x6020,
+    0x5320, 0x6020, 0x6320, 0x6020, 0x5420, 0x6020, 0x6420
+};
+
+/**
+ * Notes of smbdeath.
+ */
+const SongNote songNotes22[16] = {
+    0x6120, 0x6120, 0x6120, 0x5008, 0x5C10, 0x6610, 0x5010, 0x6610, 0xE610, 0xE510,
+    0x6310, 0x6110, 0x5010, 0x5510, 0x5010, 0x5110
+};
+
+/**
+ * Notes of BarryManilow_Copacabana.
+ */
+const SongNote songNotes23[56] = {
+    0x5A08, 0x6108, 0x6308, 0xE608, 0xDB10, 0xD004, 0x6608, 0x6508, 0x6308, 0xE508,
+    0xDA10, 0xD004, 0x5A08, 0x6108, 0x6310, 0x5010, 0xE510, 0x6610, 0x5020, 0xE510,
+    0x6610, 0x5020, 0x6520, 0x6620, 0xE508, 0x5010, 0x6108, 0x5908, 0xDC10, 0x5020,
+    0x5C10, 0x5010, 0x5C08, 0x5A10, 0xDC10, 0xD010, 0x5A08, 0x6108, 0x6308, 0xE608,
+    0x5B08, 0xD004, 0x6608, 0x6508, 0x6308, 0xE508, 0xDA10, 0xD004, 0x5A08, 0x6108,
+    0xE310, 0x5020, 0x6508, 0x6610, 0x5010, 0x6510
+};
+
+/**
+ * Notes of Imperial.
+ */
+const SongNote songNotes24[24] = {
+    0x5504, 0x5504, 0x5504, 0x5108, 0x5010, 0x5810, 0x5504, 0x5108, 0x5010, 0x5810,
+    0x5504, 0x5004, 0x5C04, 0x5C04, 0x5C04, 0x6108, 0x5010, 0x5810, 0x5404, 0x5108,
+    0x5010, 0x5810, 0x5504, 0x5008
+};
+
+/**
+ * Notes of Rocky.
+ */
+const SongNote songNotes25[29] = {
+    0x5510, 0xD808, 0xDA02, 0x5A10, 0xDC08, 0xD502, 0x5510, 0xD808, 0xDA02, 0x5A10,
+    0xDC08, 0x5501, 0x5008, 0x5310, 0x5110, 0xD308, 0x5110, 0x5310, 0x5502, 0x5010,
+    0x6110, 0x6110, 0x5C08, 0x5C10, 0x5A08, 0x5A10, 0x5804, 0x6108, 0x5C01
+};
+
+/**
+ * Master list of all songs, in the order of songs.rtttl.
+ */
+const Song songs[SONG_COUNT] = {
+    {songNotes0, 27, 180},
+    {songNotes1, 42, 200},
+    {songNotes2, 39, 180},
+    {songNotes3, 43, 125},
+    {songNotes4, 28, 112},
+    {songNotes5, 28, 112},
+    {songNotes6, 25, 125},
+    {songNotes7, 47, 180},
+    {songNotes8, 61, 100},
+    {songNotes9, 28, 120},
+    {songNotes10, 38, 80},
+    {songNotes11, 33, 56},
+    {songNotes12, 64, 125},
+    {songNotes13, 67, 125},
+    {songNotes14, 41, 112},
+    {songNotes15, 57, 210},
+    {songNotes16, 61, 120},
+    {songNotes17, 61, 133},
+    {songNotes18, 55, 250},
+    {songNotes19, 97, 125},
+    {songNotes20, 99, 100},
+    {songNotes21, 47, 100},
+    {songNotes22, 16, 90},
+    {songNotes23, 56, 120},
+    {songNotes24, 24, 100},
+    {songNotes25, 29, 100},
+};
+
+#ifdef SIMULATOR
+/**
+ * The RTTTL each song was compiled from.
+ */
+const char * const songSources[SONG_COUNT] = {
+    "Batman:d=8,o=5,b=180:d,d,c#,c#,c,c,c#,c#,d,d,c#,c#,c,c,c#,c#,d,d#,c,c#,c,c,c#,c#,f,p,4f",
+    "Spiderman:d=4,o=6,b=200:c,8d#,g.,p,f#,8d#,c.,p,c,8d#,g,8g#,g,f#,8d#,c.,p,f,8g#,c.7,p,a#,8g#,f.,p,c,8d#,g.,p,f#,8d#,c,p,8g#,2g,p,8f#,f#,8d#,f,8d#,2c",
+    "Star Wars:d=8,o=6,b=180:f5,f5,f5,2a#5.,2f.,d#,d,c,2a#.,4f.,d#,d,c,2a#.,4f.,d#,d,d#,2c,4p,f5,f5,f5,2a#5.,2f.,d#,d,c,2a#.,4f.,d#,d,c,2a#.,4f.,d#,d,d#,2c",
+    "Final Countdown:d=16,o=5,b=125:b,a,4b,4e,4p,8p,c6,b,8c6,8b,4a,4p,8p,c6,b,4c6,4e,4p,8p,a,g,8a,8g,8f#,8a,4g.,f#,g,4a.,g,a,8b,8a,8g,8f#,4e,4c6,2b.,b,c6,b,a,1b",
+    "Deep Purple-Smoke on the Water:d=4,o=4,b=112:c,d#,f.,c,d#,8f#,f,p,c,d#,f.,d#,c,2p,8p,c,d#,f.,c,d#,8f#,f,p,c,d#,f.,d#,c",
+    "gbusters:d=4,o=5,b=112:16b,16b,8d#6,8b,8c#6,8a,2p,16b,16b,16b,16b,8a,8b,2p,16b,16b,8d#6,8b,8c#6,8a,2p,16b,16b,16b,16b,8a,8c#6,8b",
+    "Funky Town:d=8,o=4,b=125:c6,c6,a#5,c6,p,g5,p,g5,c6,f6,e6,c6,2p,c6,c6,a#5,c6,p,g5,p,g5,c6,f6,e6,c6",
+    "Macarena:d=8,o=5,b=180:f,f,f,4f,f,f,f,f,f,f,f,a,c,c,4f,f,f,4f,f,f,f,f,f,f,d,c,4p,4f,f,f,4f,f,f,f,f,f,f,f,a,4p,2c.6,4a,c6,a,f,4p,2p",
+    "Mission Impossible:d=16,o=5,b=100:32d,32d#,32d,32d#,32d,32d#,32d,32d#,32d,32d,32d#,32e,32f,32f#,32g,g,8p,g,8p,a#,p,c6,p,g,8p,g,8p,f,p,f#,p,g,8p,g,8p,a#,p,c6,p,g,8p,g,8p,f,p,f#,p,a#,g,2d,32p,a#,g,2c#,32p,a#,g,2c,p,a#4,c",
+    "USA National Anthem:d=8,o=5,b=120:e.,d,4c,4e,4g,4c6.,p,e6.,d6,4c6,4e,4f#,4g.,p,4g,4e6.,d6,4c6,2b,a,4b,c6.,16p,4c6,4g,4e,32p,4c",
+    "Bond:d=4,o=4,b=80:32p,16c#6,32d#6,32d#6,16d#6,8d#6,16c#6,16c#6,16c#6,16c#6,32e6,32e6,16e6,8e6,16d#6,16d#6,16d#6,16c#6,32d#6,32d#6,16d#6,8d#6,16c#6,16c#6,16c#6,16c#6,32e6,32e6,16e6,8e6,16d#6,16d6,16c#6,16c#7,c.7,16g#6,16f#6,g#.6",
+    "GoodBad:d=4,o=5,b=56:32p,32a#,32d#6,32a#,32d#6,8a#.,16f#.,16g#.,d#,32a#,32d#6,32a#,32d#6,8a#.,16f#.,16g#.,c#6,32a#,32d#6,32a#,32d#6,8a#.,16f#.,32f.,32d#.,c#,32a#,32d#6,32a#,32d#6,8a#.,16g#.,d#",
+    "MetalGear:d=8,o=6,b=125:4e5,4d5,2c5,d5,e5,a4,4e5,2d5,c5,d5,4e.5,a5,g5,e5,4c5,2d5,e5,a5,2c,b5,c,d,4c,2a5,g5,a5,4b.5,c,4b5,a5,g5,1a5,4b5,4a5,2g5,a5,b5,e5,4b5,2a5,g5,a5,4b.5,e,d,b5,4g5,2a5,b5,e,2g,f#,g,a,4g,2e,d,e,4f#.,g,4f#,e,d,1e",
+    "Jeopardy:d=4,o=6,b=125:c,f,c,f5,c,f,2c,c,f,c,f,a.,8g,8f,8e,8d,8c#,c,f,c,f5,c,f,2c,f.,8d,c,a#5,a5,g5,f5,p,d#,g#,d#,g#5,d#,g#,2d#,d#,g#,d#,g#,c.7,8a#,8g#,8g,8f,8e,d#,g#,d#,g#5,d#,g#,2d#,g#.,8f,d#,c#,c,p,a#5,p,g#.5,d#,g#",
+    "Michael Jackson - Thriller:d=31,o=5,b=112:24b., 15p, 16d.6, p, 24b., 15p, 9e.6, p, 2d.6, 3p, 9d.6, p, 16c#.6, 10p, 6b., 3p, 24b., 15p, 16b., p, 49a., 10p, 16a., p, 49g., p, 9g., p, 24e., 15p, 12g., 153, 24a., 15p, 16b., p, 24a., 15p, 16a., p, 24g., 153, 16b., 1",
+    "GunsNRoses_Welcome_To_The_Jungle:d=4,o=5,b=210:16c, 16p, 16c, 16p, c, 16c., 32p, 16c., 32p, 16c., 32p, 16c., 32p, c, 16a#, 16p, 16c., 32p, 8c, 16a#, 16p, 16a#, 16p, 8c, 16g, 16p, 16g, 16p, 8c, 16f, 16p, 16f, 16p, 8c, 16d#, 8p., 16c, 8p., 16a#, 16p, 8c, 8c, 16a#, 16p, 16a#, 16p, 8c, 16g, 16p, 16g, 16p, 8c, 16f, 16p, 16f, 16p, 8c, 1",
+    "guns_n_roses_sweet_child_o_mine:d=4,o=5,b=120:8a#, 8a#, 8f, 8d#, 8d#6, 8f, 8d6, 8f, 8a#, 8a#, 8f, 8d#, 8d#6, 8f, 8d6, 8f, 8c, 8a#, 8f, 8d#, 8d#6, 8f, 8d6, 8f, 8c, 8a#, 8f, 8d#, 8d#6, 8f, 8d6, 8f, 8d#, 8a#, 8f, 8d#, 8d#6, 8f, 8d6, 8f, 8d#, 8a#, 8f, 8d#, 8d#6, 8f, 8d6, 8f, 8a#, 8a#, 8f, 8d#, 8d#6, 8f, 8d6, 8f, 8a#, 8a#, 8f, 8d#, 8d#",
+    "MCHammer_UCantTouchThis:d=4,o=5,b=133:8d.6, 32p, 8c6, 8b, 8a, p, 16b., 32p, 8g, p, 16b., 32p, 16a, 16a, 32a, 16p., 32a, 16p., 16a, 16p, 8d.6, 16p, 8c6, 8b, 8a, p, 8e, 8g, p, 16b., 32p, 32a, 16p, 16a, 32a, 16p., 32a, 16p., 16a, 16p, 8d.6, 32p, 8c6, 8b, 8a, p, 16b., 32p, 8g, p, 16b., 32p, 16a, 16a, 32a, 16p., 32a, 16p., 16a, 16p, 8d ",
+    "Indiana:d=4,o=5,b=250:e,8p,8f,8g,8p,1c6,8p.,d,8p,8e,1f,p.,g,8p,8a,8b,8p,1f6,p,a,8p,8b,2c6,2d6,2e6,e,8p,8f,8g,8p,1c6,p,d6,8p,8e6,1f.6,g,8p,8g,e.6,8p,d6,8p,8g,e.6,8p,d6,8p,8g,f.6,8p,e6,8p,8d6,2c6",
+    "Zelda1:d=4,o=5,b=125:a#,f.,8a#,16a#,16c6,16d6,16d#6,2f6,8p,8f6,16f.6,16f#6,16g#.6,2a#.6,16a#.6,16g#6,16f#.6,8g#.6,16f#.6,2f6,f6,8d#6,16d#6,16f6,2f#6,8f6,8d#6,8c#6,16c#6,16d#6,2f6,8d#6,8c#6,8c6,16c6,16d6,2e6,g6,8f6,16f,16f,8f,16f,16f,8f,16f,16f,8f,8f,a#,f.,8a#,16a#,16c6,16d6,16d#6,2f6,8p,8f6,16f.6,16f#6,16g#.6,2a#.6,c#7,c7,2a6,f6,2f#.6,a#6,a6,2f6,f6,2f#.6,a#6,a6,2f6,d6,2d#.6,f#6,f6,2c#6,a#,c6,16d6,2e6,g6,8f6,16f,16f,8f,16f,16f,8f,16f,16f,8f,8f",
+    "smb:d=4,o=5,b=100:16e6,16e6,32p,8e6,16c6,8e6,8g6,8p,8g,8p,8c6,16p,8g,16p,8e,16p,8a,8b,16a#,8a,16g.,16e6,16g6,8a6,16f6,8g6,8e6,16c6,16d6,8b,16p,8c6,16p,8g,16p,8e,16p,8a,8b,16a#,8a,16g.,16e6,16g6,8a6,16f6,8g6,8e6,16c6,16d6,8b,8p,16g6,16f#6,16f6,16d#6,16p,16e6,16p,16g#,16a,16c6,16p,16a,16c6,16d6,8p,16g6,16f#6,16f6,16d#6,16p,16e6,16p,16c7,16p,16c7,16c7,p,16g6,16f#6,16f6,16d#6,16p,16e6,16p,16g#,16a,16c6,16p,16a,16c6,16d6,8p,16d#6,8p,16d6,8p,16c6",
+    "smb_under:d=4,o=6,b=100:32c,32p,32c7,32p,32a5,32p,32a,32p,32a#5,32p,32a#,2p,32c,32p,32c7,32p,32a5,32p,32a,32p,32a#5,32p,32a#,2p,32f5,32p,32f,32p,32d5,32p,32d,32p,32d#5,32p,32d#,2p,32f5,32p,32f,32p,32d5,32p,32d,32p,32d#5,32p,32d#",
+    "smbdeath:d=4,o=5,b=90:32c6,32c6,32c6,8p,16b,16f6,16p,16f6,16f.6,16e.6,16d6,16c6,16p,16e,16p,16c",
+    "BarryManilow_Copacabana:d=4,o=5,b=120:8a, 8c6, 8d6, 8f.6, 16a#., p., 8f6, 8e6, 8d6, 8e.6, 16a., p., 8a, 8c6, 16d6, 16p, 16e.6, 16f6, 32p, 16e.6, 16f6, 32p, 32e6, 32f6, 8e.6, 16p, 8c6, 8g#, 16b., 32p, 16b, 16p, 8b, 16a, 16b., 16p., 8a, 8c6, 8d6, 8f.6, 8a#, p., 8f6, 8e6, 8d6, 8e.6, 16a., p., 8a, 8c6, 16d.6, 32p, 8e6, 16f6, 16p, 16e6",
+    "Imperial:d=4, o=5, b=100:e, e, e, 8c, 16p, 16g, e, 8c, 16p, 16g, e, p, b, b, b, 8c6, 16p, 16g, d#, 8c, 16p, 16g, e, 8p",
+    "Rocky:d=4,o=5,b=100:16e,8g.,2a.,16a,8b.,2e.,1 6e,8g.,2a.,16a,8b.,1e,8p,16d,16c,8d.,16c,16d,2e,16p,16c6,16c6,8b,16b,8a,16a,g,8c6,1b",
+};
+#endif
@@ -0,0 +1,54 @@
+/** @file songs.c
+ * @brief File for the speaker song player
+ *
+ * This file contains the code for playing the precompiled songs in songdata.c over the speaker.
+ *
+ * @see songs.h
+ */
+
+#include "main.h"
+
+/**
+ * The RTTTL name of each pitch, indexed by pitch number.
+ */
+const char songPitchNames[SONG_PITCHES + 1][3] = {"p", "c", "c#", "d", "d#", "e", "f", "f#", "g", "g#", "a", "a#", "b"};
+
+/**
+ * Plays a song over the speaker, one note at a time.
+ *
+ * @param song the song
+ */
+void playSong(const Song *song) {
+    char rtttl[SONG_RTTTL_LENGTH];
+    for (int i = 0; i < song->count; i++) {
+        SongNote note = song->notes[i];
+        unsigned long profile = profileBegin();
+        // The note's duration and octave go in the defaults, so the note itself is only its name
+        snprintf(rtttl, sizeof(rtttl), "n:d=%d,o=%d,b=%d:%s%s", SONG_NOTE_DURATION(note), SONG_NOTE_OCTAVE(note),
+                 song->tempo, songPitchNames[min(SONG_NOTE_PITCH(note), SONG_PITCHES)],
+                 SONG_NOTE_DOTTED(note) ? "." : "");
+        profileEnd(PROFILE_SPEAKER, profile);
+        speakerPlayRtttl(rtttl);
+    }
+}
+
+/**
+ * Returns a random song from the master list.
+ *
+ * @return a pointer to the song
+ */
+const Song* randsong() {
+    int index = rand() % SONG_COUNT;
+    return &songs[index];
+}
+
+/**
+ * Plays a song over the speaker.
+ * This task plays a random song from the array of songs.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void playSpeaker(void *ignore) {
+    playSong(randsong());
+    speakerTask = NULL;
+}
@@ -0,0 +1,107 @@
+/** @file telemetry.c
+ * @brief File for the performance telemetry
+ *
+ * This file contains the code for the performance telemetry.
+ * Recording is kept to a few integer operations per sample, so it can stay enabled during matches.
+ * The statistics are written by a single task each and only read by the LCD, so no locking is used;
+ * a torn read only affects one frame of the display.
+ *
+ * @see telemetry.h
+ */
+
+#include "main.h"
+
+/**
+ * Timing statistics of the operator control loop.
+ */
+LoopStats opcontrolLoop = {"OpControl", 20000, 0, 0, 0, 0, 0, 0};
+
+/**
+ * Timing statistics of the sensor task loop.
+ */
+LoopStats sensorLoop = {"Sensors", SENSOR_POLL_PERIOD * 1000, 0, 0, 0, 0, 0, 0};
+
+/**
+ * The number of motor output samples that were not zero.
+ */
+unsigned long motorActiveSamples = 0;
+
+/**
+ * The number of motor output samples that were at full power.
+ */
+unsigned long motorSaturatedSamples = 0;
+
+/**
+ * Clears the timing statistics of a loop.
+ *
+ * @param stats the statistics to clear
+ */
+void loopStatsReset(LoopStats *stats) {
+    stats->last = 0;
+    stats->average = 0;
+    stats->maxJitter = 0;
+    stats->worstOverrun = 0;
+    stats->overruns = 0;
+    stats->ticks = 0;
+    stats->period = 0;
+}
+
+/**
+ * Records one iteration of a loop.
+ *
+ * @param stats the statistics of the loop
+ */
+void loopStatsTick(LoopStats *stats) {
+    unsigned long now = micros();
+    if (stats->last != 0) {
+        unsigned long period = now - stats->last;
+        stats->period = period;
+        if (stats->ticks == 0) {
+            stats->average = period;
+        } else {
+            stats->average += ((long) period - (long) stats->average) >> LOOP_STATS_AVERAGE_SHIFT;
+        }
+        unsigned long jitter = period > stats->target ? period - stats->target : stats->target - period;
+        if (jitter > stats->maxJitter) {
+            stats->maxJitter = jitter;
+        }
+        if (period > stats->target) {
+            if (period - stats->target > stats->worstOverrun) {
+                stats->worstOverrun = period - stats->target;
+            }
+            if (period - stats->target > 1000) {
+                stats->overruns++;
+            }
+        }
+        stats->ticks++;
+    }
+    // micros() can return 0 after it wraps, which would look like a reset
+    stats->last = now != 0 ? now : 1;
+}
+
+/**
+ * Samples the motor outputs.
+ */
+void sampleTelemetry() {
+    for (int port = 1; port <= 10; port++) {
+        int output = motorGet(port);
+        if (output != 0) {
+            motorActiveSamples++;
+            if (abs(output) >= MOTOR_MAX) {
+                motorSaturatedSamples++;
+            }
+        }
+    }
+}
+
+/**
+ * Clears all telemetry, so that minimums and maximums are recorded from this point on.
+ */
+void resetTelemetry() {
+    loopStatsReset(&opcontrolLoop);
+    loopStatsReset(&sensorLoop);
+    resetBatteryStats();
+    profileReset();
+    motorActiveSamples = 0;
+    motorSaturatedSamples = 0;
+}
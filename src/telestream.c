@@ -0,0 +1,320 @@
+/** @file telestream.c
+ * @brief File for the binary telemetry stream
+ *
+ * Channels are sampled on the stream task's ticks, so a channel's period is counted in ticks
+ * and all channels with the same period are sampled in the same packet.
+ *
+ * @see telestream.h
+ */
+
+#include "main.h"
+
+/**
+ * Factors that scale a value to fixed point, indexed by number of decimals.
+ */
+const double streamScales[] = {1, 10, 100, 1000};
+
+/**
+ * The last value published to each channel, indexed by channel ID number.
+ * Values are single precision so that they can be written and read atomically.
+ */
+volatile float streamValues[STREAM_CHANNEL_COUNT];
+
+/**
+ * The sampling period of each channel, in milliseconds, indexed by channel ID number.
+ */
+unsigned short streamPeriods[STREAM_CHANNEL_COUNT];
+
+/**
+ * Whether the telemetry stream is being sent.
+ */
+bool streamEnabled = false;
+
+/**
+ * Object representing the telemetry stream task.
+ */
+TaskHandle streamTask = NULL;
+
+/**
+ * The sequence number of the next packet.
+ */
+unsigned char streamSequence = 0;
+
+/**
+ * Reads the gyroscope angle.
+ */
+double streamReadGyro() {
+    return gyro != NULL ? gyroGet(gyro) : 0;
+}
+
+/**
+ * Reads the turning speed of the drive motors.
+ */
+double streamReadTurn() {
+    return turn;
+}
+
+/**
+ * Reads the output of the left drive motor.
+ */
+double streamReadLeftMotor() {
+    return motorGet(LEFT_MOTOR);
+}
+
+/**
+ * Reads the output of the right drive motor.
+ */
+double streamReadRightMotor() {
+    return motorGet(RIGHT_MOTOR);
+}
+
+/**
+ * Reads the accumulated tick count of the left drive encoder.
+ */
+double streamReadLeftEncoder() {
+    return driveEncoderGet(ENC_LEFT);
+}
+
+/**
+ * Reads the accumulated tick count of the right drive encoder.
+ */
+double streamReadRightEncoder() {
+    return driveEncoderGet(ENC_RIGHT);
+}
+
+/**
+ * Reads the accumulated tick count of the horizontal encoder.
+ */
+double streamReadHorizontalEncoder() {
+    return driveEncoderGet(ENC_HORIZONTAL);
+}
+
+/**
+ * Reads the robot's X-coordinate on the field.
+ */
+double streamReadPositionX() {
+    return position.x;
+}
+
+/**
+ * Reads the robot's Y-coordinate on the field.
+ */
+double streamReadPositionY() {
+    return position.y;
+}
+
+/**
+ * Reads the robot's heading on the field, in degrees.
+ */
+double streamReadHeading() {
+    return degrees(fieldHeading());
+}
+
+/**
+ * Reads the ultrasonic sensor range.
+ */
+double streamReadSonar() {
+    return sonar != NULL ? ultrasonicGet(sonar) : -1;
+}
+
+/**
+ * Reads the main battery voltage.
+ */
+double streamReadBattery() {
+    return powerLevelMain();
+}
+
+/**
+ * Reads the most recent operator control loop period.
+ */
+double streamReadOpcontrolPeriod() {
+    return opcontrolLoop.period;
+}
+
+/**
+ * The telemetry stream channels, indexed by channel ID number.
+ */
+const StreamChannel streamChannels[STREAM_CHANNEL_COUNT] = {
+    {"gyro", 0, 10, streamReadGyro},
+    {"gyro_target", 0, 10, NULL},
+    {"gyro_error", 1, 10, NULL},
+    {"gyro_integral", 1, 10, NULL},
+    {"gyro_derivative", 3, 10, NULL},
+    {"turn", 0, 10, streamReadTurn},
+    {"left_motor", 0, 20, streamReadLeftMotor},
+    {"right_motor", 0, 20, streamReadRightMotor},
+    {"left_enc", 0, 20, streamReadLeftEncoder},
+    {"right_enc", 0, 20, streamReadRightEncoder},
+    {"horizontal_enc", 0, 20, streamReadHorizontalEncoder},
+    {"x", 2, 50, streamReadPositionX},
+    {"y", 2, 50, streamReadPositionY},
+    {"heading", 0, 50, streamReadHeading},
+    {"sonar", 0, 50, streamReadSonar},
+    {"battery", 0, 100, streamReadBattery},
+    {"opcontrol_us", 0, 20, streamReadOpcontrolPeriod}
+};
+
+/**
+ * Writes a 16-bit value into a packet, least significant byte first.
+ *
+ * @param packet the position in the packet to write to
+ * @param value the value
+ */
+void streamPut16(unsigned char *packet, unsigned short value) {
+    packet[0] = value & 0xFF;
+    packet[1] = value >> 8;
+}
+
+/**
+ * Writes a 32-bit value into a packet, least significant byte first.
+ *
+ * @param packet the position in the packet to write to
+ * @param value the value
+ */
+void streamPut32(unsigned char *packet, unsigned long value) {
+    streamPut16(packet, value & 0xFFFF);
+    streamPut16(packet + 2, value >> 16);
+}
+
+/**
+ * Appends the CRC to a packet and sends it COBS-encoded over the stream's UART, followed by a zero byte.
+ *
+ * @param packet the packet, with STREAM_MAX_PACKET bytes of space
+ * @param length the length of the packet, without the CRC
+ */
+void streamSend(unsigned char *packet, unsigned int length) {
+    unsigned char encoded[COBS_MAX_ENCODED(STREAM_MAX_PACKET) + 1];
+    streamPut16(&packet[length], crc16(CRC16_INIT, packet, length));
+    unsigned int size = cobsEncode(packet, length + 2, encoded);
+    encoded[size++] = 0;
+    fwrite(encoded, 1, size, STREAM_PORT);
+}
+
+/**
+ * Sends a packet describing a channel.
+ *
+ * @param channel the channel ID number
+ */
+void streamDescribe(int channel) {
+    unsigned char packet[STREAM_MAX_PACKET];
+    const StreamChannel *info = &streamChannels[channel];
+    unsigned int length = strlen(info->name);
+    length = min(length, STREAM_NAME_LENGTH);
+    packet[0] = STREAM_PACKET_CHANNEL;
+    packet[1] = streamSequence++;
+    packet[2] = channel;
+    packet[3] = info->decimals;
+    streamPut16(&packet[4], streamPeriods[channel]);
+    memcpy(&packet[6], info->name, length);
+    streamSend(packet, 6 + length);
+}
+
+/**
+ * Samples every channel that is due on a tick, and sends the samples in one packet.
+ *
+ * @param tick the number of stream task ticks since the stream was enabled
+ */
+void streamSample(unsigned long tick) {
+    unsigned char packet[STREAM_MAX_PACKET];
+    unsigned int length = 6;
+    for (int channel = 0; channel < STREAM_CHANNEL_COUNT; channel++) {
+        unsigned long ticks = streamPeriods[channel] / STREAM_PERIOD;
+        if (ticks == 0 || tick % ticks != 0) {
+            continue;
+        }
+        const StreamChannel *info = &streamChannels[channel];
+        double value = (info->read != NULL) ? info->read() : streamValues[channel];
+        packet[length] = channel;
+        streamPut32(&packet[length + 1], (unsigned long) (long) round(value * streamScales[info->decimals]));
+        length += 5;
+    }
+    if (length == 6) {
+        return;
+    }
+    packet[0] = STREAM_PACKET_SAMPLES;
+    packet[1] = streamSequence++;
+    streamPut32(&packet[2], millis());
+    streamSend(packet, length);
+}
+
+/**
+ * Runs the telemetry stream task.
+ * Samples the channels every STREAM_PERIOD milliseconds and describes them every STREAM_DESCRIBE_PERIOD milliseconds.
+ *
+ * @param ignore does nothing - required by task definition
+ */
+void runTelemetryStream(void *ignore) {
+    unsigned long wakeTime = millis();
+    unsigned long tick = 0;
+    while (true) {
+        if (!streamEnabled) {
+            tick = 0;
+        } else {
+            if (tick % (STREAM_DESCRIBE_PERIOD / STREAM_PERIOD) == 0) {
+                for (int channel = 0; channel < STREAM_CHANNEL_COUNT; channel++) {
+                    streamDescribe(channel);
+                }
+            }
+            streamSample(tick);
+            tick++;
+        }
+        taskDelayUntil(&wakeTime, STREAM_PERIOD);
+    }
+}
+
+/**
+ * Opens the stream's UART and starts the telemetry stream task.
+ */
+void startTelemetryStream() {
+    for (int channel = 0; channel < STREAM_CHANNEL_COUNT; channel++) {
+        streamPeriods[channel] = streamChannels[channel].period;
+        streamValues[channel] = 0;
+    }
+    usartInit(STREAM_PORT, STREAM_BAUD, SERIAL_8N1);
+    streamTask = taskCreateTracked("Stream", runTelemetryStream, TASK_DEFAULT_STACK_SIZE, NULL, TASK_PRIORITY_LOWEST + 1);
+}
+
+/**
+ * Finds a channel by name.
+ *
+ * @param name the name of the channel
+ *
+ * @return the channel ID number, or -1 if there is no channel with that name
+ */
+int streamFind(const char *name) {
+    for (int channel = 0; channel < STREAM_CHANNEL_COUNT; channel++) {
+        if (strcmp(streamChannels[channel].name, name) == 0) {
+            return channel;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Sets the sampling period of a channel.
+ *
+ * @param channel the channel ID number
+ * @param period the sampling period in milliseconds, or 0 to stop sampling the channel
+ */
+void streamSetPeriod(int channel, unsigned short period) {
+    if (channel >= 0 && channel < STREAM_CHANNEL_COUNT) {
+        streamPeriods[channel] = period - period % STREAM_PERIOD;
+    }
+}
+
+/**
+ * Sets the value of a channel that does not read its own value.
+ *
+ * @param channel the channel ID number
+ * @param value the value
+ */
+void streamPublish(int channel, double value) {
+    streamValues[channel] = value;
+}
+
+/**
+ * Enables the telemetry stream if it is disabled, or disables it if it is enabled.
+ */
+void streamToggle() {
+    streamEnabled = !streamEnabled;
+}
@@ -0,0 +1,154 @@
+/** @file wallrange.c
+ * @brief File for ultrasonic wall-ranging localization code
+ *
+ * This file contains the code for correcting the robot's field position using the ultrasonic sensor.
+ * Each reading is treated as a range to the field wall along the robot's current heading.
+ * Readings with no echo, readings out of range, and readings taken at a steep angle to the wall are ignored.
+ * The remaining readings are median filtered and gated against the position estimate before being applied.
+ * Since each reading is slightly old, it is compared against the robot's pose at the time it was taken.
+ *
+ * @see wallrange.h
+ */
+
+#include "main.h"
+
+/**
+ * Number of wall-ranging measurements that have corrected the robot's position.
+ */
+unsigned int wallRangeAccepted = 0;
+
+/**
+ * Number of wall-ranging measurements that have been rejected.
+ */
+unsigned int wallRangeRejected = 0;
+
+/**
+ * Most recent valid ultrasonic readings, in centimeters.
+ */
+int wallRangeHistory[WALLRANGE_FILTER_SIZE];
+
+/**
+ * Number of valid readings stored in the history buffer.
+ */
+int wallRangeCount = 0;
+
+/**
+ * Index in the history buffer that the next reading will be written to.
+ */
+int wallRangeIndex = 0;
+
+/**
+ * The wall that the readings in the history buffer were taken against.
+ */
+fieldWall wallRangeWall = WALL_NONE;
+
+/**
+ * Discards any buffered ultrasonic readings.
+ */
+void resetWallRange() {
+    wallRangeCount = 0;
+    wallRangeIndex = 0;
+    wallRangeWall = WALL_NONE;
+}
+
+/**
+ * Determines which wall the robot is facing squarely enough to range against.
+ *
+ * @param heading the robot's heading in radians
+ *
+ * @return the wall being faced, or WALL_NONE if the robot is at too steep an angle to every wall
+ */
+fieldWall facingWall(double heading) {
+    double c = cos(heading);
+    double s = sin(heading);
+    double limit = cos(radians(WALLRANGE_MAX_ANGLE));
+    if (c >= limit) {
+        return WALL_X_HIGH;
+    } else if (c <= -limit) {
+        return WALL_X_LOW;
+    } else if (s >= limit) {
+        return WALL_Y_HIGH;
+    } else if (s <= -limit) {
+        return WALL_Y_LOW;
+    }
+    return WALL_NONE;
+}
+
+/**
+ * Returns the median of the readings in the history buffer.
+ *
+ * @return the median reading, in centimeters
+ */
+int wallRangeMedian() {
+    int sorted[WALLRANGE_FILTER_SIZE];
+    memcpy(sorted, wallRangeHistory, sizeof(sorted));
+    for (int i = 1; i < WALLRANGE_FILTER_SIZE; i++) {
+        int val = sorted[i];
+        int j = i - 1;
+        while (j >= 0 && sorted[j] > val) {
+            sorted[j + 1] = sorted[j];
+            j--;
+        }
+        sorted[j + 1] = val;
+    }
+    return sorted[WALLRANGE_FILTER_SIZE / 2];
+}
+
+/**
+ * Corrects the robot's position using the current ultrasonic reading.
+ * The reading is taken as the range to the field wall along the robot's heading,
+ * and the X or Y coordinate of the position constrained by that wall is corrected.
+ *
+ * @return true if the position was corrected, false if the reading was rejected
+ */
+bool updateWallRange() {
+    int reading = ultrasonicGet(sonar);
+    unsigned long measured = millis() - WALLRANGE_LATENCY;
+    poseSample pose;
+    if (!poseAt(measured, &pose)) {
+        pose.position = position;
+        pose.heading = fieldHeading();
+    }
+    fieldWall wall = facingWall(pose.heading);
+
+    if (wall != wallRangeWall) {
+        resetWallRange();
+        wallRangeWall = wall;
+    }
+    if (wall == WALL_NONE || reading < WALLRANGE_MIN_CM || reading > WALLRANGE_MAX_CM) {
+        wallRangeRejected++;
+        return false;
+    }
+
+    wallRangeHistory[wallRangeIndex] = reading;
+    wallRangeIndex = (wallRangeIndex + 1) % WALLRANGE_FILTER_SIZE;
+    if (wallRangeCount < WALLRANGE_FILTER_SIZE) {
+        wallRangeCount++;
+        return false;
+    }
+
+    double range = wallRangeMedian() / CM_PER_INCH + SONAR_OFFSET;
+    double error;
+    switch (wall) {
+        case WALL_X_HIGH:
+        case WALL_X_LOW:
+            error = ((wall == WALL_X_HIGH ? FIELD_LENGTH : 0) - range * cos(pose.heading)) - pose.position.x;
+            break;
+        default:
+            error = ((wall == WALL_Y_HIGH ? FIELD_LENGTH : 0) - range * sin(pose.heading)) - pose.position.y;
+            break;
+    }
+
+    if (abs(error) > WALLRANGE_GATE) {
+        wallRangeRejected++;
+        return false;
+    }
+
+    if (wall == WALL_X_HIGH || wall == WALL_X_LOW) {
+        correctPosition(measured, WALLRANGE_GAIN * error, 0);
+    } else {
+        correctPosition(measured, 0, WALLRANGE_GAIN * error);
+    }
+    wallRangeAccepted++;
+    return true;
+}